@@ -184,9 +184,21 @@ void CoordPanel::_init_coord_indexes() {
 }
 
 void CoordPanel::_init_connection() {
-    QObject::connect(shared_core_data_->get_info_dispatcher(),
-                     &InfoDispatcher::info_updated, this,
-                     &CoordPanel::_update_info);
+    // 打孔机型还显示主轴坐标和打孔深度
+    uint32_t update_mask = InfoChange_Axis | InfoChange_VOffset;
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    update_mask |= InfoChange_Drill;
+#endif
+
+    QObject::connect(
+        shared_core_data_->get_info_dispatcher(),
+        &InfoDispatcher::info_changed, this,
+        [this, update_mask](const move::MotionInfo &info,
+                            uint32_t change_mask) {
+            if (change_mask & update_mask) {
+                _update_info(info);
+            }
+        });
 
     QObject::connect(
         ui->comboBox_select_coord_index,
@@ -24,6 +24,9 @@
 namespace edm {
 namespace app {
 
+// update_display 的最小重新绘图间隔 (约30fps), 数据推入再快也不会更频繁地绘图
+static constexpr int s_min_replot_interval_ms = 33;
+
 DataDisplayer::DataDisplayer(int x_points, QWidget *parent)
     : QWidget(parent), ui(new Ui::DataDisplayer) {
     ui->setupUi(this);
@@ -53,6 +56,16 @@ DataDisplayer::DataDisplayer(int x_points, QWidget *parent)
     // init xpoints
     _set_xpoints(x_points);
 
+    // 刷新限速: 间隔太短的刷新推迟到此定时器中, 保证最后一次数据会被画出
+    deferred_replot_timer_ = new QTimer(this);
+    deferred_replot_timer_->setSingleShot(true);
+    connect(deferred_replot_timer_, &QTimer::timeout, this, [this]() {
+        if (this->isVisible()) {
+            _replot();
+        }
+    });
+    last_replot_timer_.start();
+
     _init_buttons();
     _update_settings_from_ui();
     _replot();
@@ -64,9 +77,9 @@ int DataDisplayer::add_data_item(const DisplayedDataDesc &data_desc) {
     _DataInfo data;
     data.data_desc = data_desc;
 
-    // init vec
-    data.raw_data_vec.resize(_get_plotting_points_count(data));
-    data.raw_data_vec.fill(0.0);
+    // init ring buffer
+    data.series = new RingSeriesData(_get_plotting_points_count(data));
+    _resize_data_vec(data);
 
     // init ui data if first (scale zero visible)
     _set_ui_data_desc_from_member_data_desc();
@@ -86,8 +99,8 @@ int DataDisplayer::add_data_item(const DisplayedDataDesc &data_desc) {
                            data.data_desc.line_width);
     }
 
-    // set curve init samples
-    _update_curve_from_vec(data);
+    // curve 持有 series, 之后直接从环形缓冲取点, 不再拷贝
+    data.curve->setData(data.series);
 
     datas_.push_back(data);
 
@@ -108,8 +121,7 @@ bool DataDisplayer::push_data(int index, double v) {
 
     auto &data = datas_[index];
 
-    data.raw_data_vec.pop_front();
-    data.raw_data_vec.push_back(v);
+    data.series->ring().push(v);
 
     return true;
 }
@@ -119,7 +131,13 @@ void DataDisplayer::update_display() {
         return;
     }
 
-    _replot();
+    const auto elapsed = last_replot_timer_.elapsed();
+    if (elapsed >= s_min_replot_interval_ms) {
+        _replot();
+    } else if (!deferred_replot_timer_->isActive()) {
+        deferred_replot_timer_->start(
+            static_cast<int>(s_min_replot_interval_ms - elapsed));
+    }
 }
 
 void DataDisplayer::set_axis_title(QwtPlot::Axis axis, const QString &title,
@@ -235,7 +253,6 @@ void DataDisplayer::_set_xpoints(int x_points) {
     ui->sb_points->setValue(x_points_);
 
     if (old_x_points != x_points_) {
-        _reset_x_vec(); // 重新设置x_vec_
         ui->qwtPlot->setAxisScale(QwtPlot::xBottom, 0, x_points_ - 1);
 
         for (auto &data : datas_) {
@@ -278,14 +295,14 @@ void DataDisplayer::_update_label_data() {
 
     auto &data = datas_[index];
     
-    auto last_data = data.raw_data_vec.back();
+    auto last_data = data.series->ring().back();
 
     ui->lb_show_data->setText(QString::number(last_data));
 }
 
 void DataDisplayer::_clear() {
     for (auto &data : datas_) {
-        data.raw_data_vec.fill(0.0);
+        data.series->ring().fill(0.0);
     }
 }
 
@@ -294,12 +311,18 @@ void DataDisplayer::_replot() {
         return;
     }
 
+    last_replot_timer_.restart();
+    deferred_replot_timer_->stop();
+
+    // 按画布像素列数抽取, 点数多时只画每列的min/max
+    const int columns = ui->qwtPlot->canvas()->width();
+
     for (auto &data : datas_) {
         if (!data.data_desc.visible) {
             continue;
         }
 
-        _update_curve_from_vec(data);
+        data.series->prepare(columns);
     }
 
     _update_label_data();
@@ -315,29 +338,6 @@ void DataDisplayer::_update_settings_from_ui() {
     _set_yright_scale(ui->sb_right_ymin->value(), ui->sb_right_ymax->value());
 }
 
-void DataDisplayer::_resize_plotted_vector(QVector<double> &vec,
-                                           int new_length) {
-    if (vec.size() == new_length || new_length <= 0) {
-        return;
-    }
-
-    if (vec.size() > new_length) {
-        // 删除vec靠前的一部分, 以达到new_length长度
-        vec = vec.mid(vec.size() - new_length);
-
-        Q_ASSERT(vec.size() == new_length);
-    } else {
-        // vec前面增加一部分0, 以达到new_length长度
-        QVector<double> zero_vec;
-        zero_vec.resize(new_length - vec.size());
-        zero_vec.fill(0);
-
-        vec = zero_vec + vec;
-
-        Q_ASSERT(vec.size() == new_length);
-    }
-}
-
 void DataDisplayer::_set_ui_data_desc_from_member_data_desc() {
     auto index = ui->comboBox_item_select->currentIndex();
     if (index < 0)
@@ -351,36 +351,13 @@ void DataDisplayer::_set_ui_data_desc_from_member_data_desc() {
     ui->pb_item_visible->setChecked(data.data_desc.visible);
 }
 
-void DataDisplayer::_update_curve_from_vec(DataDisplayer::_DataInfo &data) {
-    int plotting_size = _get_plotting_points_count(data);
-    int x_vec_start_offset = x_points_ - plotting_size;
-    Q_ASSERT(x_vec_start_offset >= 0 && x_vec_start_offset < x_points_);
-    Q_ASSERT(data.raw_data_vec.size() == plotting_size);
-
-    data.curve->setSamples(x_vec_.data() + x_vec_start_offset,
-                           data.raw_data_vec.data(), plotting_size);
-}
-
 void DataDisplayer::_resize_data_vec(DataDisplayer::_DataInfo &data) {
     int plotting_size = _get_plotting_points_count(data);
-    if (plotting_size == data.raw_data_vec.size()) {
-        return;
-    }
-
-    _resize_plotted_vector(data.raw_data_vec, plotting_size);
 
-    Q_ASSERT(data.raw_data_vec.size() == plotting_size);
-}
+    data.series->ring().resize(plotting_size);
 
-void DataDisplayer::_reset_x_vec() {
-    if (x_points_ == x_vec_.size()) {
-        return;
-    }
-
-    x_vec_.resize(x_points_);
-    for (int i = 0; i < x_points_; ++i) {
-        x_vec_[i] = i;
-    }
+    // 点数少于窗口点数时靠右对齐
+    data.series->set_x_offset(x_points_ - plotting_size);
 }
 
 int DataDisplayer::_get_plotting_points_count(
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QElapsedTimer>
+#include <QTimer>
 #include <QWidget>
 #include <qcolor.h>
 #include <qmessagebox.h>
@@ -11,6 +13,8 @@
 #include <qwt_plot_curve.h>
 #include <qwt_legend.h>
 
+#include "RingSeriesData.h"
+
 namespace Ui {
 class DataDisplayer;
 }
@@ -44,7 +48,7 @@ public:
     // 压入对应编号的一个数据
     bool push_data(int index, double v);
 
-    // 刷新显示
+    // 刷新显示; 限制最高帧率, 两次刷新间隔太短时推迟到定时器中刷新
     void update_display();
 
     // 设置坐标轴的名称, 颜色接口
@@ -73,15 +77,12 @@ private:
 
     void _clear();
 
-    // 重新绘图: 从各个data的vec更新curve的sample, 并重新绘图
+    // 重新绘图: 各curve按画布宽度准备抽取的点, 并重新绘图
     void _replot();
 
     // 从ui获取绘图参数(x轴点数, y轴最大,最小值)保存到成员变量, 但是不重新绘图, 需要手动调用_replot
     void _update_settings_from_ui();
 
-    // 调整vec的长度, 保持尾端最新数据不被擦除, 擦除和新增0数据都在数组前端进行
-    void _resize_plotted_vector(QVector<double>& vec, int new_length);
-
     // 根据ui中combobox选定的数据index, 从成员数据描述中, 更新ui显示的数据设定(visible, ofs, scale)
     void _set_ui_data_desc_from_member_data_desc();
 
@@ -90,7 +91,7 @@ private:
     Ui::DataDisplayer *ui;
 
     // canvas show scale:
-    int x_points_;
+    int x_points_ {0};
     double left_y_min_;
     double left_y_max_;
     double right_y_min_;
@@ -98,15 +99,17 @@ private:
 
     bool data_input_enable_ {true};
     bool plot_enable_ {true};
+
+    QElapsedTimer last_replot_timer_; // 距上次重新绘图的时间
+    QTimer *deferred_replot_timer_ {nullptr};
     
 private: // member datas
 
-    QVector<double> x_vec_;
-
     struct _DataInfo {
         struct DisplayedDataDesc data_desc;
 
-        QVector<double> raw_data_vec;
+        // 数据环形缓冲, 由curve持有 (setData), curve析构时释放
+        RingSeriesData* series;
 
         QwtPlotCurve* curve;
     };
@@ -116,15 +119,9 @@ private: // member datas
     QwtLegend* legend_;
 
 private:
-    // 从data的data_vec数组, 更新curve的数据
-    void _update_curve_from_vec(_DataInfo& data);
-
-    // 根据x_points_, data的max_points设定, 对data_vec进行resize
+    // 根据x_points_, data的max_points设定, 对环形缓冲进行resize, 并设定x偏移
     void _resize_data_vec(_DataInfo& data);
 
-    // 根据x_points, 设定x_vec_
-    void _reset_x_vec();
-
     // 获取当前实际的可绘制点数(考虑data设置的max点数, 以及当前x_points_指定的总点数, 总点数可能会小于data设置的max点数)
     int _get_plotting_points_count(const _DataInfo& data) const;
 };
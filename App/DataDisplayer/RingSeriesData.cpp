@@ -0,0 +1,77 @@
+#include "RingSeriesData.h"
+
+#include <algorithm>
+
+namespace edm {
+namespace app {
+
+void DataRingBuffer::resize(std::size_t length) {
+    if (length == 0) {
+        length = 1;
+    }
+
+    if (length == buf_.size()) {
+        return;
+    }
+
+    std::vector<double> new_buf(length, 0.0);
+
+    const std::size_t keep = std::min(length, buf_.size());
+    const std::size_t src_begin = buf_.size() - keep;
+    const std::size_t dst_begin = length - keep;
+    for (std::size_t i = 0; i < keep; ++i) {
+        new_buf[dst_begin + i] = at(src_begin + i);
+    }
+
+    buf_.swap(new_buf);
+    head_ = 0;
+}
+
+void RingSeriesData::prepare(int columns) {
+    const std::size_t n = ring_.size();
+
+    if (columns <= 0 || n <= static_cast<std::size_t>(columns) * 2) {
+        decimated_ = false;
+        decimated_points_.clear();
+        return;
+    }
+
+    decimated_ = true;
+    decimated_points_.clear();
+    decimated_points_.reserve(static_cast<std::size_t>(columns) * 2);
+
+    for (int c = 0; c < columns; ++c) {
+        const std::size_t begin = n * c / columns;
+        const std::size_t end = n * (c + 1) / columns;
+        if (begin >= end) {
+            continue;
+        }
+
+        std::size_t min_i = begin, max_i = begin;
+        double min_v = ring_.at(begin), max_v = min_v;
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            const double v = ring_.at(i);
+            if (v < min_v) {
+                min_v = v;
+                min_i = i;
+            } else if (v > max_v) {
+                max_v = v;
+                max_i = i;
+            }
+        }
+
+        // 按时间先后输出, 保持波形走向
+        if (min_i <= max_i) {
+            decimated_points_.emplace_back(x_offset_ + min_i, min_v);
+            if (max_i != min_i) {
+                decimated_points_.emplace_back(x_offset_ + max_i, max_v);
+            }
+        } else {
+            decimated_points_.emplace_back(x_offset_ + max_i, max_v);
+            decimated_points_.emplace_back(x_offset_ + min_i, min_v);
+        }
+    }
+}
+
+} // namespace app
+} // namespace edm
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <QPointF>
+#include <QRectF>
+
+#include <qwt_series_data.h>
+
+namespace edm {
+namespace app {
+
+// 定长环形缓冲: 始终是满的 (初始为0), push 覆盖最旧的数据, O(1)
+class DataRingBuffer final {
+public:
+    explicit DataRingBuffer(std::size_t length = 1) { resize(length); }
+
+    std::size_t size() const { return buf_.size(); }
+
+    // i = 0 为最旧的数据
+    double at(std::size_t i) const {
+        std::size_t j = head_ + i;
+        if (j >= buf_.size()) {
+            j -= buf_.size();
+        }
+        return buf_[j];
+    }
+
+    double back() const { return at(buf_.size() - 1); }
+
+    void push(double v) {
+        buf_[head_] = v;
+        if (++head_ == buf_.size()) {
+            head_ = 0;
+        }
+    }
+
+    void fill(double v) {
+        std::fill(buf_.begin(), buf_.end(), v);
+        head_ = 0;
+    }
+
+    // 调整长度, 保留尾端最新的数据, 新增的0补在前端
+    void resize(std::size_t length);
+
+private:
+    std::vector<double> buf_;
+    std::size_t head_{0}; // 最旧数据的位置
+};
+
+/**
+ * 环形缓冲到 Qwt 曲线的适配 (不拷贝数据):
+ * 曲线通过 setData 持有此对象, 绘图时直接从环形缓冲取点.
+ *
+ * 点数超过画布像素列数的2倍时, 按像素列做 min/max 抽取:
+ * 每列只输出该列内的最小值和最大值两点 (按时间先后), 尖峰不会丢失,
+ * 绘制的点数与数据长度无关, 只与画布宽度有关.
+ */
+class RingSeriesData final : public QwtSeriesData<QPointF> {
+public:
+    explicit RingSeriesData(std::size_t length) : ring_(length) {}
+
+    DataRingBuffer &ring() { return ring_; }
+    const DataRingBuffer &ring() const { return ring_; }
+
+    // 第一个点的x值 (数据点数小于窗口点数时靠右对齐)
+    void set_x_offset(double x_offset) { x_offset_ = x_offset; }
+
+    // 重新绘图前调用: 按画布宽度 (像素列数) 决定是否抽取, 并计算抽取的点
+    void prepare(int columns);
+
+public: // QwtSeriesData
+    size_t size() const override {
+        return decimated_ ? decimated_points_.size() : ring_.size();
+    }
+
+    QPointF sample(size_t i) const override {
+        if (decimated_) {
+            return decimated_points_[i];
+        }
+        return QPointF(x_offset_ + i, ring_.at(i));
+    }
+
+    // y轴为固定刻度, x轴由窗口点数设定, 不参与自动缩放
+    QRectF boundingRect() const override { return cachedBoundingRect; }
+
+private:
+    DataRingBuffer ring_;
+    double x_offset_{0.0};
+
+    bool decimated_{false};
+    std::vector<QPointF> decimated_points_; // 复用, 避免每帧分配
+};
+
+} // namespace app
+} // namespace edm
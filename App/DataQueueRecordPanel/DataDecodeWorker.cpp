@@ -0,0 +1,72 @@
+#include "DataDecodeWorker.h"
+
+#include "Motion/MotionSharedData/MotionSharedData.h"
+#include "config.h"
+
+namespace edm {
+namespace app {
+
+namespace {
+struct metatype_register__ {
+    metatype_register__() {
+        qRegisterMetaType<DataDecodeWorker::CancelToken>(
+            "edm::app::DataDecodeWorker::CancelToken");
+    }
+};
+static struct metatype_register__ mt_register__;
+} // namespace
+
+void DataDecodeWorker::slot_decode(int data_index,
+                                   const QStringList &bin_filenames,
+                                   bool include_header,
+                                   CancelToken cancel_token) {
+    auto &cancel_flag = *cancel_token;
+
+    const int file_count = bin_filenames.size();
+    for (int i = 0; i < file_count && !cancel_flag; ++i) {
+        const auto &bin_filename = bin_filenames[i];
+
+        // 只在百分比变化时发出信号, 避免刷屏GUI事件队列
+        int last_percent = -1;
+        auto progress_cb = [&](uint64_t done, uint64_t total) {
+            int percent = total == 0 ? 100 : (int)(done * 100 / total);
+            if (percent != last_percent) {
+                last_percent = percent;
+                emit sig_progress(i, file_count, percent);
+            }
+        };
+
+        std::optional<QString> decode_filename;
+        if (data_index == 1) {
+            decode_filename = move::MotionSharedData::instance()
+                                  ->get_data_record_instance1()
+                                  ->decode_one_file(bin_filename, include_header,
+                                                    progress_cb, &cancel_flag);
+        }
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+        else if (data_index == 2) {
+            decode_filename = move::MotionSharedData::instance()
+                                  ->get_data_record_instance2()
+                                  ->decode_one_file(bin_filename, include_header,
+                                                    progress_cb, &cancel_flag);
+        }
+#endif
+        else if (data_index == 3) {
+            decode_filename = move::MotionSharedData::instance()
+                                  ->get_channel_record_instance()
+                                  ->decode_one_file(bin_filename, progress_cb,
+                                                    &cancel_flag);
+        }
+
+        if (cancel_flag) {
+            break;
+        }
+
+        emit sig_file_decoded(bin_filename, decode_filename.value_or(QString{}));
+    }
+
+    emit sig_finished(cancel_flag);
+}
+
+} // namespace app
+} // namespace edm
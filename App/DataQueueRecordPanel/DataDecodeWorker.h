@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+
+namespace edm {
+namespace app {
+
+// 记录文件解码Worker, 运行在独立QThread中, 避免阻塞GUI
+class DataDecodeWorker : public QObject {
+    Q_OBJECT
+public:
+    // 每个任务一个取消标志, 由GUI线程在提交任务时创建;
+    // 任务还在队列中时取消也不会丢失
+    using CancelToken = std::shared_ptr<std::atomic_bool>;
+
+    explicit DataDecodeWorker(QObject *parent = nullptr)
+        : QObject(parent) {}
+
+public slots:
+    // data_index: 1 -> DataRecordInstance1, 2 -> DataRecordInstance2,
+    //             3 -> ChannelRecordInstance (include_header 无效, 总是输出)
+    void slot_decode(int data_index, const QStringList &bin_filenames,
+                     bool include_header,
+                     edm::app::DataDecodeWorker::CancelToken cancel_token);
+
+signals:
+    // percent: 当前文件的解码进度 (0~100)
+    void sig_progress(int file_index, int file_count, int percent);
+
+    // decode_filename 为空表示失败
+    void sig_file_decoded(const QString &bin_filename,
+                          const QString &decode_filename);
+
+    void sig_finished(bool canceled);
+};
+
+} // namespace app
+} // namespace edm
+
+Q_DECLARE_METATYPE(edm::app::DataDecodeWorker::CancelToken)
@@ -9,6 +9,8 @@
 #include <QFile>
 #include <QFileDialog>
 #include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidgetItem>
 #include <fstream>
 #include <qfiledialog.h>
 #include <qpushbutton.h>
@@ -35,13 +37,25 @@ DataQueueRecordPanel::DataQueueRecordPanel(SharedCoreData *shared_core_data,
 
     _init_dirs();
 
+    _init_decode_worker();
+
     _init_record_data1();
     _init_record_data2();
 
+    _init_event_capture();
+
+    _init_record_channels();
+
     _init_audio_record();
 }
 
-DataQueueRecordPanel::~DataQueueRecordPanel() { delete ui; }
+DataQueueRecordPanel::~DataQueueRecordPanel() {
+    _cancel_decode();
+    decode_thread_->quit();
+    decode_thread_->wait();
+
+    delete ui;
+}
 
 static void _check_and_create_dir(const QString &dir_str) {
     QDir dir;
@@ -67,6 +81,247 @@ void DataQueueRecordPanel::_init_dirs() {
     _check_and_create_dir(GCodeTimeReportSaveDir);
 }
 
+void DataQueueRecordPanel::_init_event_capture() {
+    connect(ui->pb_event_capture_1, &QPushButton::clicked, this,
+            [this](bool checked) { _set_event_capture(1, checked); });
+    connect(ui->pb_event_capture_2, &QPushButton::clicked, this,
+            [this](bool checked) { _set_event_capture(2, checked); });
+
+    if (SystemSettings::instance().get_event_capture_settings().auto_start) {
+        _set_event_capture(1, true);
+        _set_event_capture(2, true);
+    }
+}
+
+void DataQueueRecordPanel::_set_event_capture(int data_index, bool enable) {
+    auto pb = data_index == 1 ? ui->pb_event_capture_1 : ui->pb_event_capture_2;
+
+    auto apply = [&](auto instance) {
+        if (!enable) {
+            instance->stop_event_capture();
+            pb->setChecked(false);
+            emit shared_core_data_->sig_info_message(
+                QString{"Stop Event Capture %0"}.arg(data_index));
+            return;
+        }
+
+        auto ret = instance->start_event_capture();
+        pb->setChecked(ret);
+        if (ret) {
+            emit shared_core_data_->sig_info_message(
+                QString{"Start Event Capture %0 Success"}.arg(data_index));
+        } else {
+            emit shared_core_data_->sig_error_message(
+                QString{"Start Event Capture %0 Failed"}.arg(data_index));
+        }
+    };
+
+    if (data_index == 1) {
+        apply(move::MotionSharedData::instance()->get_data_record_instance1());
+    }
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    else if (data_index == 2) {
+        apply(move::MotionSharedData::instance()->get_data_record_instance2());
+    }
+#endif
+    else {
+        pb->setChecked(false);
+    }
+}
+
+void DataQueueRecordPanel::_init_decode_worker() {
+    decode_thread_ = new QThread(this);
+    decode_worker_ = new DataDecodeWorker;
+    decode_worker_->moveToThread(decode_thread_);
+
+    connect(decode_thread_, &QThread::finished, decode_worker_,
+            &QObject::deleteLater);
+    connect(this, &DataQueueRecordPanel::_sig_decode, decode_worker_,
+            &DataDecodeWorker::slot_decode);
+
+    decode_progress_dialog_ = new QProgressDialog(this);
+    decode_progress_dialog_->setWindowTitle(tr("Decode"));
+    decode_progress_dialog_->setWindowModality(Qt::WindowModal);
+    decode_progress_dialog_->setRange(0, 100);
+    decode_progress_dialog_->setAutoClose(false);
+    decode_progress_dialog_->setAutoReset(false);
+    decode_progress_dialog_->reset(); // 停止构造时启动的自动显示定时器
+    decode_progress_dialog_->hide();
+
+    // 只置位当前任务的原子标志, 直接在GUI线程调用
+    connect(decode_progress_dialog_, &QProgressDialog::canceled, this,
+            [this]() { _cancel_decode(); });
+
+    connect(decode_worker_, &DataDecodeWorker::sig_progress, this,
+            [this](int file_index, int file_count, int percent) {
+                decode_progress_dialog_->setLabelText(
+                    tr("Decoding file %0 / %1 ...")
+                        .arg(file_index + 1)
+                        .arg(file_count));
+                decode_progress_dialog_->setValue(percent);
+            });
+
+    connect(decode_worker_, &DataDecodeWorker::sig_file_decoded, this,
+            [this](const QString &bin_filename, const QString &decode_filename) {
+                if (!decode_filename.isEmpty()) {
+                    emit shared_core_data_->sig_info_message(
+                        QString{"Decode Success, saved to: %0"}.arg(
+                            decode_filename));
+                } else {
+                    emit shared_core_data_->sig_error_message(
+                        QString{"Decode Failed, file: %0"}.arg(bin_filename));
+                }
+            });
+
+    connect(decode_worker_, &DataDecodeWorker::sig_finished, this,
+            [this](bool canceled) {
+                decode_progress_dialog_->reset();
+                decode_progress_dialog_->hide();
+                ui->pb_decode_1->setEnabled(true);
+                ui->pb_decode_2->setEnabled(true);
+                ui->pb_decode_channels->setEnabled(true);
+
+                if (canceled) {
+                    emit shared_core_data_->sig_warn_message("Decode Canceled");
+                }
+            });
+
+    decode_thread_->start();
+}
+
+void DataQueueRecordPanel::_start_decode(int data_index,
+                                         const QStringList &bin_filenames,
+                                         bool include_header) {
+    if (bin_filenames.isEmpty()) {
+        return;
+    }
+
+    // 解码期间禁止再次触发
+    ui->pb_decode_1->setEnabled(false);
+    ui->pb_decode_2->setEnabled(false);
+    ui->pb_decode_channels->setEnabled(false);
+
+    decode_progress_dialog_->setLabelText(tr("Decoding ..."));
+    decode_progress_dialog_->setValue(0);
+    decode_progress_dialog_->show();
+
+    decode_cancel_token_ = std::make_shared<std::atomic_bool>(false);
+    emit _sig_decode(data_index, bin_filenames, include_header,
+                     decode_cancel_token_);
+}
+
+void DataQueueRecordPanel::_cancel_decode() {
+    if (decode_cancel_token_) {
+        *decode_cancel_token_ = true;
+    }
+}
+
+void DataQueueRecordPanel::_init_record_channels() {
+    const auto &channels = move::MotionSharedData::instance()
+                               ->get_channel_record_instance()
+                               ->registry()
+                               .channels();
+
+    auto tw = ui->tw_record_channels;
+    tw->setRowCount(channels.size());
+    for (int i = 0; i < (int)channels.size(); ++i) {
+        auto item =
+            new QTableWidgetItem(QString::fromStdString(channels[i].name));
+        item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+        item->setCheckState(Qt::Unchecked);
+        tw->setItem(i, 0, item);
+
+        auto sb = new QSpinBox(tw);
+        sb->setRange(1, 10000);
+        sb->setValue(1);
+        tw->setCellWidget(i, 1, sb);
+    }
+    tw->resizeColumnToContents(0);
+
+    connect(ui->pb_start_record_channels, &QPushButton::clicked, this,
+            [this](bool checked) {
+                if (checked) {
+                    _start_record_channels();
+                } else {
+                    _stop_record_channels();
+                }
+            });
+
+    connect(ui->pb_decode_channels, &QPushButton::clicked, this, [this]() {
+        auto bin_filenames = QFileDialog::getOpenFileNames(
+            this, tr("Select Bin Files"),
+            move::MotionSharedData::instance()->RecordData1BinDir);
+
+        _start_decode(3, bin_filenames, true);
+    });
+}
+
+util::RecordChannelSelection
+DataQueueRecordPanel::_get_record_channel_selection() const {
+    util::RecordChannelSelection selection;
+
+    auto tw = ui->tw_record_channels;
+    for (int i = 0; i < tw->rowCount(); ++i) {
+        auto item = tw->item(i, 0);
+        if (item->checkState() != Qt::Checked) {
+            continue;
+        }
+
+        auto sb = qobject_cast<QSpinBox *>(tw->cellWidget(i, 1));
+        selection.items.push_back(
+            {item->text().toStdString(), (uint32_t)sb->value()});
+    }
+
+    return selection;
+}
+
+void DataQueueRecordPanel::_start_record_channels() {
+    ui->pb_start_record_channels->setChecked(true);
+
+    auto selection = _get_record_channel_selection();
+    if (selection.items.empty()) {
+        emit shared_core_data_->sig_warn_message("No Record Channel Selected");
+        ui->pb_start_record_channels->setChecked(false);
+        return;
+    }
+
+    auto ret = move::MotionSharedData::instance()
+                   ->get_channel_record_instance()
+                   ->start_record(selection);
+
+    if (ret) {
+        // 记录中不允许修改选择
+        ui->tw_record_channels->setEnabled(false);
+        emit shared_core_data_->sig_info_message(
+            QString{"Start Record Channels Success, %0 channels"}.arg(
+                selection.items.size()));
+    } else {
+        emit shared_core_data_->sig_error_message(
+            "Start Record Channels Failed");
+        ui->pb_start_record_channels->setChecked(false);
+    }
+}
+
+void DataQueueRecordPanel::_stop_record_channels() {
+    ui->pb_start_record_channels->setChecked(false);
+
+    move::MotionSharedData::instance()
+        ->get_channel_record_instance()
+        ->stop_record(true);
+
+    ui->tw_record_channels->setEnabled(true);
+
+    emit shared_core_data_->sig_info_message("Stop Record Channels Success");
+}
+
+void DataQueueRecordPanel::slot_start_record_channels() {
+    _start_record_channels();
+}
+
+void DataQueueRecordPanel::slot_stop_record_channels() {
+    _stop_record_channels();
+}
+
 void DataQueueRecordPanel::_start_audio_record() {
 #ifdef EDM_ENABLE_AUDIO_RECORD
     ui->pb_start_audio_record->setChecked(false); // remain unchecked
@@ -316,22 +571,7 @@ void DataQueueRecordPanel::_init_record_data1() {
             this, tr("Select Bin Files"),
             move::MotionSharedData::instance()->RecordData1BinDir);
 
-        for (const auto &bin_filename : bin_filenames) {
-            auto decode_filename =
-                move::MotionSharedData::instance()
-                    ->get_data_record_instance1()
-                    ->decode_one_file(bin_filename,
-                                      ui->cb_include_header_1->isChecked());
-
-            if (decode_filename) {
-                emit shared_core_data_->sig_info_message(
-                    QString{"Decode Success, saved to: %0"}.arg(
-                        *decode_filename));
-            } else {
-                emit shared_core_data_->sig_error_message(
-                    QString{"Decode Failed, file: %0"}.arg(bin_filename));
-            }
-        }
+        _start_decode(1, bin_filenames, ui->cb_include_header_1->isChecked());
     });
 
     connect(ui->pb_print_header_1, &QPushButton::clicked, this, [this]() {
@@ -438,22 +678,7 @@ void DataQueueRecordPanel::_init_record_data2() {
             this, tr("Select Bin Files"),
             move::MotionSharedData::instance()->RecordData1BinDir);
 
-        for (const auto &bin_filename : bin_filenames) {
-            auto decode_filename =
-                move::MotionSharedData::instance()
-                    ->get_data_record_instance2()
-                    ->decode_one_file(bin_filename,
-                                      ui->cb_include_header_2->isChecked());
-
-            if (decode_filename) {
-                emit shared_core_data_->sig_info_message(
-                    QString{"Decode Success, saved to: %0"}.arg(
-                        *decode_filename));
-            } else {
-                emit shared_core_data_->sig_error_message(
-                    QString{"Decode Failed, file: %0"}.arg(bin_filename));
-            }
-        }
+        _start_decode(2, bin_filenames, ui->cb_include_header_2->isChecked());
     });
 
     connect(ui->pb_print_header_2, &QPushButton::clicked, this, [this]() {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QProgressDialog>
+#include <QThread>
 #include <QWidget>
 
 #include "SharedCoreData/SharedCoreData.h"
@@ -9,6 +11,8 @@
 
 #include "SystemSettings/SystemSettings.h"
 
+#include "DataDecodeWorker.h"
+
 namespace Ui {
 class DataQueueRecordPanel;
 }
@@ -34,6 +38,14 @@ public slots: // 用于外部
     void slot_start_audio_record();
     void slot_stop_audio_record();
 
+    void slot_start_record_channels();
+    void slot_stop_record_channels();
+
+signals:
+    void _sig_decode(int data_index, const QStringList &bin_filenames,
+                     bool include_header,
+                     edm::app::DataDecodeWorker::CancelToken cancel_token);
+
 private:
     void _start_record_data1();
     void _stop_record_data1();
@@ -44,6 +56,9 @@ private:
     void _start_audio_record();
     void _stop_audio_record();
 
+    void _start_record_channels();
+    void _stop_record_channels();
+
 private:
     void _init_dirs();
 
@@ -62,11 +77,30 @@ private:
     // audio record
     void _init_audio_record();
 
+    // 通道记录 (运行时选择通道和抽取系数)
+    void _init_record_channels();
+    util::RecordChannelSelection _get_record_channel_selection() const;
+
+    // 事件触发记录
+    void _init_event_capture();
+    void _set_event_capture(int data_index, bool enable);
+
+    // 后台解码
+    void _init_decode_worker();
+    void _start_decode(int data_index, const QStringList &bin_filenames,
+                       bool include_header);
+    void _cancel_decode();
+
 private:
     Ui::DataQueueRecordPanel *ui;
 
     SharedCoreData* shared_core_data_;
 
+    QThread *decode_thread_{nullptr};
+    DataDecodeWorker *decode_worker_{nullptr};
+    DataDecodeWorker::CancelToken decode_cancel_token_; // 当前解码任务
+    QProgressDialog *decode_progress_dialog_{nullptr};
+
     // const QString DataSaveRootDir = QString::fromStdString(SystemSettings::instance().get_datasave_dir());
     // const QString RecordData1BinDir = DataSaveRootDir + "/MotionRecordData/Bin/";
     // const QString RecordData1DecodeDir = DataSaveRootDir + "/MotionRecordData/Decode/";
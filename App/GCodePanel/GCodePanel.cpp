@@ -6,9 +6,13 @@
 #include <QMessageBox>
 #include <qslider.h>
 
+#include <algorithm>
+#include <limits>
+
 #include "Logger/LogMacro.h"
 
 #include "DataQueueRecordPanel/DataQueueRecordPanel.h"
+#include "Utils/UnitConverter/UnitConverter.h"
 
 constexpr static const int s_statusbar_timeout = 10000;
 
@@ -24,6 +28,8 @@ GCodePanel::GCodePanel(SharedCoreData *shared_core_data,
     ui->setupUi(this);
 
     _init_codeeditor_layout();
+    _init_parse_worker();
+    _init_toolpath_preview();
     _init_button_slots();
     _init_autogcode_connections();
     _init_handbox_auto_signals();
@@ -56,7 +62,13 @@ void GCodePanel::_update_ui_time_info() {
     ui->lb_total_elapsed->setText(QString::number(total_elapsed_time) + "s");
 }
 
-GCodePanel::~GCodePanel() { delete ui; }
+GCodePanel::~GCodePanel() {
+    _cancel_parse();
+    parse_thread_->quit();
+    parse_thread_->wait();
+
+    delete ui;
+}
 
 void GCodePanel::_init_codeeditor_layout() {
     auto layout = new QGridLayout(ui->widget_editor);
@@ -84,10 +96,25 @@ void GCodePanel::_init_button_slots() {
     connect(ui->pb_estop, &QPushButton::clicked, this,
             &GCodePanel::_slot_estop);
     connect(ui->pb_ack, &QPushButton::clicked, this, &GCodePanel::_slot_ack);
+    connect(ui->pb_estimate_time, &QPushButton::clicked, this,
+            &GCodePanel::_slot_estimate);
+    connect(ui->pb_toolpath_preview, &QPushButton::clicked, this,
+            &GCodePanel::_slot_toolpath_preview);
 
     connect(ui->pb_generate_time_report, &QPushButton::clicked, this,
             [this]() {
                 auto str_vec = task_manager_->get_gcode_runner()->get_time_report();
+                // 有同一程序 (内容相同) 的预估时, 附上预估与实际的对比
+                if (last_estimate_ && !last_estimate_hash_.empty() &&
+                    last_estimate_hash_ == last_run_hash_) {
+                    double measured_feed = 0.0;
+                    auto cmp_vec = last_estimate_->compare(
+                        task_manager_->get_gcode_runner()->gcode_list(), 20,
+                        &measured_feed);
+                    str_vec.insert(str_vec.end(), cmp_vec.begin(),
+                                   cmp_vec.end());
+                    _calibrate_estimate_g01_feed(measured_feed);
+                }
                 QString str;
                 for (const auto &s : str_vec) {
                     str += QString::fromStdString(s) + "\n";
@@ -209,6 +236,14 @@ void GCodePanel::_init_handbox_auto_signals() {
 }
 
 void GCodePanel::_slot_edit(bool checked) {
+    if (checked && gcode_editor_->isPaged()) {
+        // 分页模式下编辑器中只有一页, 不能编辑保存
+        ui->pb_edit->setChecked(false);
+        QMessageBox::warning(this, "Edit",
+                             "File is too large to edit in the panel.");
+        return;
+    }
+
     if (checked) {
         // 使能编辑
         _set_ui_edit_enable(true);
@@ -335,15 +370,35 @@ void GCodePanel::_slot_loadfile() {
 }
 
 void GCodePanel::_slot_start() {
+    if (parse_running_) {
+        return; // 正在解析
+    }
+
     this->shared_core_data_->send_ioboard_bz_once();
 
+    _start_parse(false);
+}
+
+void GCodePanel::_slot_estimate() {
+    if (parse_running_) {
+        return; // 正在解析
+    }
+
+    _start_parse(true);
+}
+
+bool GCodePanel::_start_parse(bool for_estimate) {
+    const char *op_str = for_estimate ? "Estimate" : "Start";
+
     auto filename = ui->le_current_file->text();
     if (filename.isEmpty() || filename.isNull()) {
         QMessageBox::critical(this, "start error",
-                              QString("Start Gcode Failed, No File choosed"));
+                              QString("%0 Gcode Failed, No File choosed")
+                                  .arg(op_str));
         emit this->shared_core_data_->sig_error_message(
-            "Start Gcode Failed, No File choosed", s_statusbar_timeout);
-        return;
+            QString("%0 Gcode Failed, No File choosed").arg(op_str),
+            s_statusbar_timeout);
+        return false;
     }
 
     auto whole_filename = gcode_root_dir_ + filename;
@@ -351,83 +406,153 @@ void GCodePanel::_slot_start() {
     if (!_load_from_file(whole_filename)) {
         QMessageBox::critical(
             this, "start error",
-            QString("Start Gcode Failed, File Open Failed: \n%0")
-                .arg(whole_filename));
+            QString("%0 Gcode Failed, File Open Failed: \n%1")
+                .arg(op_str, whole_filename));
         emit this->shared_core_data_->sig_error_message(
-            QString("Start Gcode Failed, File Open Failed: \n%0")
-                .arg(whole_filename),
+            QString("%0 Gcode Failed, File Open Failed: \n%1")
+                .arg(op_str, whole_filename),
             s_statusbar_timeout);
-        return;
+        return false;
     }
 
-    std::string filename_stdstr = whole_filename.toStdString();
-
-    try {
-        edm::interpreter::RS274InterpreterWrapper::instance()
-            ->set_rs274_py_module_dir(
-                EDM_ROOT_DIR + this->shared_core_data_->get_system_settings()
-                                   .get_interp_module_path_relative_to_root());
-
-        auto parse_json_ret =
-            edm::interpreter::RS274InterpreterWrapper::instance()
-                ->parse_file_to_json(filename_stdstr);
-
-        try {
-            auto gcode_lists_opt =
-                edm::task::GCodeTaskConverter::MakeGCodeTaskListFromJson(
-                    parse_json_ret);
-
-            if (!gcode_lists_opt) {
-                s_logger->warn("MakeGCodeTaskListFromJson failed");
-                QMessageBox::critical(
-                    this, "start error",
-                    "Start Gcode Failed: Generate GCode List Failed.");
-                emit this->shared_core_data_->sig_error_message(
-                    "Start Gcode Failed: Generate GCode List Failed.",
-                    s_statusbar_timeout);
-                return;
-            } else {
-                s_logger->info("MakeGCodeTaskListFromJson ok");
-
-                auto vec = std::move(*gcode_lists_opt);
-
-                // give to task manager
-                auto ret = this->task_manager_->operation_gcode_start(vec);
-
-                if (!ret) {
-                    QMessageBox::critical(
-                        this, "start error",
-                        "Start Gcode Failed: TaskManager Start Failed");
-                    emit this->shared_core_data_->sig_error_message(
-                        "Start Gcode Failed: TaskManager Start Failed",
-                        s_statusbar_timeout);
+    // 解析在后台线程进行, 第一块任务解析出来后即开始加工 (流水线),
+    // 见 _slot_parse_stream_ready; 预估时等解析完再计算
+    const auto module_dir = QString::fromStdString(
+        EDM_ROOT_DIR + this->shared_core_data_->get_system_settings()
+                           .get_interp_module_path_relative_to_root());
+
+    ++parse_job_id_;
+    parse_running_ = true;
+    parse_for_estimate_ = for_estimate;
+    // 预估时没有消费者, 程序流不限长度
+    parse_stream_ =
+        for_estimate ? std::make_shared<task::GCodeProgramStream>(
+                           std::numeric_limits<std::size_t>::max())
+                     : std::make_shared<task::GCodeProgramStream>();
+    parse_stream_started_ = false;
+    ui->pb_start->setEnabled(false);
+    ui->pb_estimate_time->setEnabled(false);
+
+    parse_progress_dialog_->setLabelText(
+        QString("Parsing %0 ...").arg(filename));
+    parse_progress_dialog_->setValue(0);
+    parse_progress_dialog_->show();
+
+    parse_cancel_token_ = std::make_shared<std::atomic_bool>(false);
+    emit _sig_parse(parse_job_id_, whole_filename, module_dir, parse_stream_,
+                    parse_cancel_token_);
+    return true;
+}
+
+void GCodePanel::_cancel_parse() {
+    if (parse_cancel_token_) {
+        *parse_cancel_token_ = true;
+    }
+    if (parse_stream_) {
+        parse_stream_->cancel(); // 唤醒可能阻塞在程序流上的worker
+    }
+}
+
+void GCodePanel::_init_parse_worker() {
+    parse_thread_ = new QThread(this);
+    parse_worker_ = new GCodeParseWorker(
+        shared_core_data_->get_system_settings().get_gcode_cache_dir());
+    parse_worker_->moveToThread(parse_thread_);
+
+    connect(parse_thread_, &QThread::finished, parse_worker_,
+            &QObject::deleteLater);
+    connect(this, &GCodePanel::_sig_parse, parse_worker_,
+            &GCodeParseWorker::slot_parse);
+
+    parse_progress_dialog_ = new QProgressDialog(this);
+    parse_progress_dialog_->setWindowTitle("Parse GCode");
+    parse_progress_dialog_->setRange(0, 100);
+    parse_progress_dialog_->setMinimumDuration(300); // 小程序不弹出
+    parse_progress_dialog_->setAutoClose(false);
+    parse_progress_dialog_->setAutoReset(false);
+    parse_progress_dialog_->reset(); // 停止构造时启动的自动显示定时器
+    parse_progress_dialog_->hide();
+
+    // 非模态, 解析期间其他界面 (急停等) 照常可用;
+    // 只置位当前任务的原子标志, 直接在GUI线程调用
+    connect(parse_progress_dialog_, &QProgressDialog::canceled, this,
+            &GCodePanel::_cancel_parse);
+
+    connect(parse_worker_, &GCodeParseWorker::sig_progress, this,
+            [this](int job_id, int line_number, int line_count) {
+                if (job_id != parse_job_id_ || line_count <= 0) {
                     return;
                 }
-            }
-        } catch (const std::exception &e) {
-            QMessageBox::critical(
-                this, "start error",
-                QString("Start Gcode Failed, MakeGCodeTaskListFromJson "
-                        "Exception: \n%0")
-                    .arg(e.what()));
-            emit this->shared_core_data_->sig_error_message(
-                QString("Start Gcode Failed, MakeGCodeTaskListFromJson "
-                        "Exception: %0")
-                    .arg(e.what()),
-                s_statusbar_timeout);
-            return;
-        }
-    } catch (const std::exception &e) {
-        QMessageBox::critical(
-            this, "start error",
-            QString("Start Gcode Failed, Parse Error: \n%0").arg(e.what()));
+                parse_progress_dialog_->setValue(
+                    std::clamp(line_number * 100 / line_count, 0, 100));
+            });
+
+    connect(parse_worker_, &GCodeParseWorker::sig_stream_ready, this,
+            &GCodePanel::_slot_parse_stream_ready);
+    connect(parse_worker_, &GCodeParseWorker::sig_finished, this,
+            &GCodePanel::_slot_parse_finished);
+
+    parse_thread_->start();
+}
+
+void GCodePanel::_init_toolpath_preview() {
+    toolpath_preview_ = new ToolpathPreview(this);
+    toolpath_preview_->setWindowFlags(Qt::Window);
+    toolpath_preview_->resize(800, 600);
+    toolpath_preview_->hide();
+
+    // 实时位置, 只在坐标变化且窗口可见时转换
+    connect(shared_core_data_->get_info_dispatcher(),
+            &InfoDispatcher::info_changed, this,
+            [this](const move::MotionInfo &info, uint32_t change_mask) {
+                if (!(change_mask & InfoChange_Axis) ||
+                    !toolpath_preview_->isVisible()) {
+                    return;
+                }
+
+                move::axis_t mach_pos;
+                if (!shared_core_data_->get_coord_system()
+                         ->get_cm()
+                         .motor_to_machine(info.curr_cmd_axis_blu, mach_pos)) {
+                    return;
+                }
+                toolpath_preview_->set_current_pos(
+                    {util::UnitConverter::blu2mm(mach_pos[0]),
+                     util::UnitConverter::blu2mm(mach_pos[1]),
+                     util::UnitConverter::blu2mm(mach_pos[2])});
+            });
+}
+
+void GCodePanel::_slot_toolpath_preview() {
+    toolpath_preview_->show();
+    toolpath_preview_->raise();
+    toolpath_preview_->activateWindow();
+}
+
+void GCodePanel::_slot_parse_stream_ready(int job_id) {
+    if (job_id != parse_job_id_ || !parse_stream_ || parse_stream_started_ ||
+        parse_for_estimate_) {
+        return;
+    }
+
+    // 其余部分继续在后台解析
+    parse_progress_dialog_->reset();
+    parse_progress_dialog_->hide();
+
+    // give to task manager
+    if (!this->task_manager_->operation_gcode_start(parse_stream_)) {
+        _cancel_parse();
+        QMessageBox::critical(this, "start error",
+                              "Start Gcode Failed: TaskManager Start Failed");
         emit this->shared_core_data_->sig_error_message(
-            QString("Start Gcode Failed, Parse Error: \n%0").arg(e.what()),
+            "Start Gcode Failed: TaskManager Start Failed",
             s_statusbar_timeout);
         return;
     }
 
     // start success
+    parse_stream_started_ = true;
+    last_run_hash_.clear(); // 解析完成时再设置
 
     // 设置编辑按钮不可用
     this->_set_editbutton_enable(false);
@@ -435,6 +560,119 @@ void GCodePanel::_slot_start() {
     this->_set_machining_ui_started();
 }
 
+void GCodePanel::_slot_parse_finished(GCodeParseResult::ptr result) {
+    if (result->job_id != parse_job_id_) {
+        return; // 过期的任务
+    }
+
+    parse_running_ = false;
+    auto stream = std::move(parse_stream_); // 置空
+    parse_progress_dialog_->reset();
+    parse_progress_dialog_->hide();
+    ui->pb_estimate_time->setEnabled(true);
+
+    s_logger->info("GCode parse over, {} tasks{}{}{}{}", result->task_count,
+                   result->cache_hit ? " (cache hit)" : "",
+                   result->canceled ? " (canceled)" : "",
+                   result->error.isEmpty() ? "" : ", error: ",
+                   result->error.toStdString());
+
+    if (parse_stream_started_) {
+        last_run_hash_ = result->content_hash;
+
+        // 已在加工, 出错时由 GCodeRunner 加工到出错位置时中止
+        if (!result->canceled && !result->error.isEmpty()) {
+            emit this->shared_core_data_->sig_error_message(
+                QString("GCode Parse Error, will stop when reached: %0")
+                    .arg(result->error),
+                s_statusbar_timeout);
+        }
+        return;
+    }
+
+    ui->pb_start->setEnabled(true);
+
+    const char *op_str = parse_for_estimate_ ? "Estimate" : "Start";
+
+    if (result->canceled) {
+        emit this->shared_core_data_->sig_warn_message(
+            QString("%0 Gcode Canceled").arg(op_str), s_statusbar_timeout);
+        return;
+    }
+
+    if (!result->error.isEmpty()) {
+        QMessageBox::critical(
+            this, "start error",
+            QString("%0 Gcode Failed, Parse Error: \n%1")
+                .arg(op_str, result->error));
+        emit this->shared_core_data_->sig_error_message(
+            QString("%0 Gcode Failed, Parse Error: \n%1")
+                .arg(op_str, result->error),
+            s_statusbar_timeout);
+        return;
+    }
+
+    if (parse_for_estimate_) {
+        _estimate_parsed(stream, ui->le_current_file->text(),
+                         result->content_hash);
+    }
+}
+
+void GCodePanel::_estimate_parsed(const task::GCodeProgramStream::ptr &stream,
+                                  const QString &filename,
+                                  const std::string &content_hash) {
+    std::vector<task::GCodeTaskBase::ptr> gcode_list;
+    stream->fetch(gcode_list);
+
+    // 从当前指令位置开始预估, 与实际加工的起点一致
+    task::GCodeTimeEstimator::Options options;
+    options.start_motor_pos =
+        shared_core_data_->get_info_dispatcher()->get_info().curr_cmd_axis_blu;
+    options.g01_feed_mm_min =
+        shared_core_data_->get_system_settings().get_estimate_g01_feed_mm_min();
+
+    last_estimate_ = task::GCodeTimeEstimator::Estimate(
+        gcode_list, shared_core_data_->get_coord_system(), options);
+    last_estimate_hash_ = content_hash;
+
+    // 刀路预览在后台构建, 窗口由刀路预览按钮打开
+    toolpath_preview_->setWindowTitle("Toolpath Preview - " + filename);
+    const auto coord_sys = shared_core_data_->get_coord_system();
+    toolpath_preview_->set_program(std::move(gcode_list), coord_sys->get_cm(),
+                                   coord_sys->get_current_coord_index(),
+                                   options.start_motor_pos);
+
+    QString str;
+    for (const auto &s : last_estimate_->report()) {
+        s_logger->info("estimate: {}", s);
+        str += QString::fromStdString(s) + "\n";
+    }
+
+    QMessageBox box(QMessageBox::Information, "Estimate",
+                    QString("%0\nEstimated time: %1 s")
+                        .arg(filename)
+                        .arg(last_estimate_->total_s, 0, 'f', 1),
+                    QMessageBox::Ok, this);
+    box.setDetailedText(str);
+    box.exec();
+}
+
+void GCodePanel::_calibrate_estimate_g01_feed(double measured_feed_mm_min) {
+    if (measured_feed_mm_min <= 0.0) {
+        return;
+    }
+
+    auto &sys_settings = SystemSettings::instance();
+    s_logger->info("estimate G01 nominal feed calibrated: {} -> {:.3f} mm/min",
+                   sys_settings.get_estimate_g01_feed_mm_min(),
+                   measured_feed_mm_min);
+
+    sys_settings.set_estimate_g01_feed_mm_min(measured_feed_mm_min);
+    if (!sys_settings.save_to_file()) {
+        s_logger->error("save to file failed");
+    }
+}
+
 void GCodePanel::_slot_pause() {
     this->shared_core_data_->send_ioboard_bz_once();
 
@@ -527,23 +765,8 @@ void GCodePanel::_slot_ack() {
 }
 
 bool GCodePanel::_load_from_file(const QString &filename) {
-    gcode_editor_->clear();
-
-    QFile file(filename);
-    if (!file.exists()) {
-        return false;
-    }
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return false;
-    }
-
-    gcode_editor_->setPlainText(file.readAll());
-    gcode_editor_->document()->setModified(false);
-
-    file.close();
-
-    return true;
+    // 大文件按页载入, 不整个读入编辑器
+    return gcode_editor_->loadFile(filename);
 }
 
 bool GCodePanel::_save_to_file(const QString &filename) {
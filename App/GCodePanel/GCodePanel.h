@@ -4,17 +4,20 @@
 
 #include "SharedCoreData/SharedCoreData.h"
 #include "TaskManager/TaskManager.h"
-#include "TaskManager/GCodeTaskConverter.h"
 #include "TaskManager/GCodeTask.h"
+#include "TaskManager/GCodeTimeEstimator.h"
 
 #include <QGridLayout>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QMessageBox>
+#include <QProgressDialog>
+#include <QThread>
 
 #include "codeeditor/codeeditor.h"
 
-#include "Interpreter/rs274pyInterpreter/RS274InterpreterWrapper.h"
+#include "GCodeParseWorker.h"
+#include "ToolpathPreview/ToolpathPreview.h"
 
 namespace Ui {
 class GCodePanel;
@@ -39,6 +42,12 @@ private:
 
     void _init_handbox_auto_signals();
 
+    void _init_parse_worker();
+    void _init_toolpath_preview();
+    // 读入当前文件并开始后台解析; for_estimate: 只预估不加工
+    bool _start_parse(bool for_estimate);
+    void _cancel_parse();
+
 private:
     void _slot_edit(bool checked);
     void _slot_save();
@@ -47,6 +56,20 @@ private:
     void _slot_loadfile();
 
     void _slot_start();
+    // 离线预估加工时间 (不运动), 解析完成后在 _slot_parse_finished 中计算
+    void _slot_estimate();
+    // 打开刀路预览窗口 (显示最近一次预估的程序)
+    void _slot_toolpath_preview();
+    // 第一块任务已解析出来, 开始加工
+    void _slot_parse_stream_ready(int job_id);
+    // 后台解析结束
+    void _slot_parse_finished(GCodeParseResult::ptr result);
+    void _estimate_parsed(const task::GCodeProgramStream::ptr &stream,
+                          const QString &filename,
+                          const std::string &content_hash);
+
+    // 用实际加工的G01平均进给速度校准预估的名义进给速度
+    void _calibrate_estimate_g01_feed(double measured_feed_mm_min);
     void _slot_pause();
     void _slot_resume();
     void _slot_stop();
@@ -74,6 +97,12 @@ private:
 private:
     void _update_ui_time_info();
 
+signals:
+    void _sig_parse(int job_id, const QString &filename,
+                    const QString &module_dir,
+                    edm::task::GCodeProgramStream::ptr stream,
+                    edm::app::GCodeParseWorker::CancelToken cancel_token);
+
 private:
     Ui::GCodePanel *ui;
 
@@ -82,6 +111,23 @@ private:
 
     CodeEditor* gcode_editor_;
 
+    QThread *parse_thread_{nullptr};
+    GCodeParseWorker *parse_worker_{nullptr};
+    QProgressDialog *parse_progress_dialog_{nullptr};
+    int parse_job_id_{0};
+    bool parse_running_{false};
+    task::GCodeProgramStream::ptr parse_stream_; // 当前解析任务的程序流
+    GCodeParseWorker::CancelToken parse_cancel_token_; // 当前解析任务的取消标志
+    bool parse_stream_started_{false}; // 已开始流水线加工
+    bool parse_for_estimate_{false}; // 当前解析任务用于预估, 不加工
+
+    ToolpathPreview *toolpath_preview_{nullptr}; // 独立窗口
+
+    task::GCodeTimeEstimate::ptr last_estimate_;
+    // 预估/最近一次加工的程序内容哈希, 一致时生成报告才对比
+    std::string last_estimate_hash_;
+    std::string last_run_hash_;
+
     const QString gcode_root_dir_ {QStringLiteral(EDM_ROOT_DIR "/gcode/")};
 };
 
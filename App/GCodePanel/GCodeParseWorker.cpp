@@ -0,0 +1,248 @@
+#include "GCodeParseWorker.h"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+
+#include "Interpreter/rs274pyInterpreter/RS274InterpreterWrapper.h"
+#include "TaskManager/GCodeTaskConverter.h"
+#include "TaskManager/IsoGCodeParser.h"
+
+#include "Logger/LogMacro.h"
+
+EDM_STATIC_LOGGER_NAME(s_logger, "interp");
+
+namespace edm {
+namespace app {
+
+namespace {
+struct metatype_register__ {
+    metatype_register__() {
+        qRegisterMetaType<GCodeParseResult::ptr>(
+            "edm::app::GCodeParseResult::ptr");
+        qRegisterMetaType<task::GCodeProgramStream::ptr>(
+            "edm::task::GCodeProgramStream::ptr");
+        qRegisterMetaType<GCodeParseWorker::CancelToken>(
+            "edm::app::GCodeParseWorker::CancelToken");
+    }
+};
+static struct metatype_register__ mt_register__;
+} // namespace
+
+// ISO G代码每解析这么多行报告一次进度, 检查一次取消
+static constexpr int s_iso_progress_interval = 4096;
+
+// 流水线每块的命令数: 第一块越小开始加工越早, 太小则分块开销大
+static constexpr std::size_t s_chunk_size = 1024;
+
+static int _count_lines(const std::string &filename) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        return 0;
+    }
+
+    int lines = 0;
+    char last = '\n';
+    std::vector<char> buf(64 * 1024);
+    while (ifs) {
+        ifs.read(buf.data(), buf.size());
+        auto n = ifs.gcount();
+        lines += std::count(buf.data(), buf.data() + n, '\n');
+        if (n > 0) {
+            last = buf[n - 1];
+        }
+    }
+
+    return last == '\n' ? lines : lines + 1;
+}
+
+GCodeParseWorker::GCodeParseWorker(const std::string &cache_dir,
+                                   QObject *parent)
+    : QObject(parent), program_cache_(cache_dir) {}
+
+void GCodeParseWorker::slot_parse(int job_id, const QString &filename,
+                                  const QString &module_dir,
+                                  task::GCodeProgramStream::ptr stream,
+                                  CancelToken cancel_token) {
+    stream_ = std::move(stream);
+    cancel_token_ = std::move(cancel_token);
+
+    auto result = std::make_shared<GCodeParseResult>();
+    result->job_id = job_id;
+
+    const auto filename_stdstr = filename.toStdString();
+    result->content_hash =
+        interpreter::RS274ProgramCache::ProgramHash(filename_stdstr)
+            .value_or(std::string{});
+
+    try {
+        if (task::IsoGCodeParser::IsIsoGCodeFile(filename_stdstr)) {
+            _parse_iso(*result, filename_stdstr);
+        } else {
+            _parse_python(*result, filename_stdstr, module_dir.toStdString());
+        }
+    } catch (const std::exception &e) {
+        result->error = QString::fromStdString(e.what());
+    }
+
+    // 被GUI取消, 或加工停止时程序流被取消
+    if (*cancel_token_ ||
+        stream_->state() == task::GCodeProgramStream::State::Canceled) {
+        result->canceled = true;
+        result->error.clear();
+        stream_->cancel();
+    } else if (!result->error.isEmpty()) {
+        stream_->fail(result->error.toStdString());
+    } else {
+        stream_->finish();
+    }
+
+    stream_.reset();
+    cancel_token_.reset();
+
+    emit sig_finished(result);
+}
+
+bool GCodeParseWorker::_push_chunk(
+    GCodeParseResult &result, std::vector<task::GCodeTaskBase::ptr> &&chunk) {
+    if (chunk.empty()) {
+        return !*cancel_token_;
+    }
+
+    const bool first = result.task_count == 0;
+    result.task_count += chunk.size();
+
+    if (!stream_->push(std::move(chunk))) {
+        return false;
+    }
+
+    if (first) {
+        emit sig_stream_ready(result.job_id);
+    }
+
+    return !*cancel_token_;
+}
+
+void GCodeParseWorker::_parse_python(GCodeParseResult &result,
+                                     const std::string &filename,
+                                     const std::string &module_dir) {
+    const int line_count = _count_lines(filename);
+
+    std::optional<std::string> key;
+    if (!result.content_hash.empty()) {
+        key = program_cache_.make_key(result.content_hash, module_dir);
+    }
+    if (key) {
+        auto records = program_cache_.load(*key);
+        if (records) {
+            s_logger->info("gcode cache hit: {}, {} commands", *key,
+                           records->commands.size());
+            result.cache_hit = true;
+
+            auto tasks_opt =
+                task::GCodeTaskConverter::MakeGCodeTaskListFromRecords(
+                    *records);
+            if (!tasks_opt) {
+                result.error = "Generate GCode List Failed.";
+                return;
+            }
+
+            _push_chunk(result, std::move(*tasks_opt));
+            emit sig_progress(result.job_id, line_count, line_count);
+            return;
+        }
+    }
+
+    interpreter::RS274InterpreterWrapper::instance()->set_rs274_py_module_dir(
+        module_dir);
+
+    // 各块合并为整个程序, 解析成功后写入缓存
+    interpreter::RS274CommandRecords merged;
+
+    interpreter::RS274InterpreterWrapper::instance()
+        ->parse_file_to_record_chunks(
+            filename,
+            [&](interpreter::RS274CommandRecords &&chunk) {
+                auto tasks_opt =
+                    task::GCodeTaskConverter::MakeGCodeTaskListFromRecords(
+                        chunk);
+                if (!tasks_opt) {
+                    throw std::runtime_error("Generate GCode List Failed.");
+                }
+
+                if (key) {
+                    merged.append(chunk);
+                }
+
+                return _push_chunk(result, std::move(*tasks_opt));
+            },
+            s_chunk_size,
+            [&](int line_number) {
+                emit sig_progress(result.job_id, line_number, line_count);
+                return !*cancel_token_;
+            });
+
+    if (result.task_count == 0) {
+        result.error = "No GCode In File";
+        return;
+    }
+
+    if (key) {
+        program_cache_.store(*key, merged);
+    }
+
+    emit sig_progress(result.job_id, line_count, line_count);
+}
+
+void GCodeParseWorker::_parse_iso(GCodeParseResult &result,
+                                  const std::string &filename) {
+    const int line_count = _count_lines(filename);
+
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        result.error = QString::fromStdString("File Open Failed: " + filename);
+        return;
+    }
+
+    task::IsoGCodeParser parser;
+    std::vector<task::GCodeTaskBase::ptr> chunk;
+    auto cb = [&chunk](task::GCodeTaskBase::ptr t) {
+        chunk.push_back(std::move(t));
+    };
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(ifs, line) && !parser.is_program_end()) {
+        ++line_number;
+        parser.parse_line(line, line_number, cb);
+
+        if (chunk.size() >= s_chunk_size) {
+            if (!_push_chunk(result, std::move(chunk))) {
+                return;
+            }
+            chunk.clear();
+        }
+
+        if (line_number % s_iso_progress_interval == 0) {
+            if (*cancel_token_) {
+                return;
+            }
+            emit sig_progress(result.job_id, line_number, line_count);
+        }
+    }
+
+    if (!_push_chunk(result, std::move(chunk))) {
+        return;
+    }
+
+    if (result.task_count == 0) {
+        result.error = "No GCode In File";
+        return;
+    }
+
+    emit sig_progress(result.job_id, line_count, line_count);
+}
+
+} // namespace app
+} // namespace edm
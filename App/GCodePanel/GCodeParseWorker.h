@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Interpreter/rs274pyInterpreter/RS274ProgramCache.h"
+#include "TaskManager/GCodeProgramStream.h"
+
+namespace edm {
+namespace app {
+
+// 一次解析的结果
+struct GCodeParseResult {
+    using ptr = std::shared_ptr<GCodeParseResult>;
+
+    int job_id{0};
+    bool canceled{false};
+    QString error; // 为空表示成功
+    bool cache_hit{false};
+    std::size_t task_count{0};
+
+    // 程序文件内容哈希 (RS274ProgramCache::ProgramHash), 读取失败为空
+    std::string content_hash;
+};
+
+/**
+ * G代码解析Worker, 运行在独立QThread中:
+ * Python解释器的初始化、解析和销毁都在此线程中进行 (GIL也只在此线程),
+ * GUI线程不再调用解释器, 解析大程序时界面保持响应.
+ *
+ * - Python程序先查缓存, 未命中再解析并写入缓存; ISO G代码直接原生解析
+ * - 解析结果按块转换为 GCodeTaskBase 推入程序流 (流水线), 第一块推入后
+ *   发出 sig_stream_ready, 此时即可开始加工, 其余部分边加工边解析
+ * - 解析过程中发出 sig_progress (按已解析到的行号), 置位任务的取消标志可中止
+ * - 结束时发出 sig_finished; 出错时程序流置为 Failed, 加工到出错位置时中止
+ */
+class GCodeParseWorker : public QObject {
+    Q_OBJECT
+public:
+    // 每个任务一个取消标志, 由GUI线程在提交任务时创建;
+    // 任务还在队列中时取消也不会丢失
+    using CancelToken = std::shared_ptr<std::atomic_bool>;
+
+    GCodeParseWorker(const std::string &cache_dir,
+                     QObject *parent = nullptr);
+
+public slots:
+    // module_dir: rs274.py 所在目录; 解析出的任务推入 stream
+    void slot_parse(int job_id, const QString &filename,
+                    const QString &module_dir,
+                    edm::task::GCodeProgramStream::ptr stream,
+                    edm::app::GCodeParseWorker::CancelToken cancel_token);
+
+signals:
+    // line_count: 文件总行数
+    void sig_progress(int job_id, int line_number, int line_count);
+
+    // 第一块任务已推入程序流
+    void sig_stream_ready(int job_id);
+
+    void sig_finished(edm::app::GCodeParseResult::ptr result);
+
+private:
+    void _parse_python(GCodeParseResult &result, const std::string &filename,
+                       const std::string &module_dir);
+
+    void _parse_iso(GCodeParseResult &result, const std::string &filename);
+
+    // 推入一块任务, 第一块时发出 sig_stream_ready; 程序流被取消返回false
+    bool _push_chunk(GCodeParseResult &result,
+                     std::vector<task::GCodeTaskBase::ptr> &&chunk);
+
+private:
+    interpreter::RS274ProgramCache program_cache_;
+
+    // 当前解析任务的程序流和取消标志, 只在worker线程访问
+    task::GCodeProgramStream::ptr stream_;
+    CancelToken cancel_token_;
+};
+
+} // namespace app
+} // namespace edm
+
+Q_DECLARE_METATYPE(edm::app::GCodeParseResult::ptr)
+Q_DECLARE_METATYPE(edm::task::GCodeProgramStream::ptr)
+Q_DECLARE_METATYPE(edm::app::GCodeParseWorker::CancelToken)
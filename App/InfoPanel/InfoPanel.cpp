@@ -24,7 +24,12 @@ InfoPanel::~InfoPanel() { delete ui; }
 
 void InfoPanel::_init_info_slot() {
     connect(shared_core_data_->get_info_dispatcher(),
-            &InfoDispatcher::info_updated, this, &InfoPanel::_update_info);
+            &InfoDispatcher::info_changed, this,
+            [this](const move::MotionInfo &info, uint32_t change_mask) {
+                if (change_mask & InfoChange_State) {
+                    _update_info(info);
+                }
+            });
     
     // connect(shared_core_data_->get_zynq_connect_ctrler().get(),
     //         &zynq::ZynqConnectController::sig_zynq_tcp_socket_state_changed,
@@ -0,0 +1,211 @@
+#include "LogListModel.h"
+
+#include <QColor>
+#include <QDateTime>
+
+#include <algorithm>
+
+namespace edm {
+namespace app {
+
+LogListModel::LogListModel(std::size_t capacity, QObject *parent)
+    : QAbstractListModel(parent), capacity_(std::max<std::size_t>(capacity, 1)) {
+    ring_.reserve(capacity_);
+}
+
+void LogListModel::push(const spdlog::details::log_msg &msg) {
+    std::lock_guard guard(pending_mutex_);
+
+    // GUI长时间不刷新时, 待处理队列也不超过环形缓冲容量
+    if (pending_.size() >= capacity_) {
+        pending_.pop_front();
+        ++pending_dropped_;
+    }
+
+    // 超长消息在这里截断, 不在utf8多字节字符中间截断
+    auto len = std::min(msg.payload.size(), MaxMessageLength);
+    if (len < msg.payload.size()) {
+        while (len > 0 &&
+               (static_cast<unsigned char>(msg.payload[len]) & 0xC0) == 0x80) {
+            --len;
+        }
+    }
+
+    pending_.push_back(
+        {msg.time, msg.level, std::string{msg.payload.data(), len}});
+}
+
+int LogListModel::flush_pending() {
+    {
+        std::lock_guard guard(pending_mutex_);
+        pending_swap_.swap(pending_);
+        overwritten_count_ += pending_dropped_;
+        pending_dropped_ = 0;
+    }
+
+    if (pending_swap_.empty()) {
+        return 0;
+    }
+
+    // 一批超过容量时只保留最后 capacity_ 条
+    auto begin = pending_swap_.begin();
+    if (pending_swap_.size() > capacity_) {
+        overwritten_count_ += pending_swap_.size() - capacity_;
+        begin = pending_swap_.end() - capacity_;
+    }
+    const auto batch_size = static_cast<std::size_t>(pending_swap_.end() - begin);
+
+    // 先移除将被覆盖的行
+    const auto new_count = ring_count_ + batch_size;
+    if (new_count > capacity_) {
+        const auto evict = new_count - capacity_;
+        _evict_before(first_seq_ + evict);
+        first_seq_ += evict;
+        ring_count_ -= evict;
+        overwritten_count_ += evict;
+    }
+
+    // 写入环形缓冲
+    const auto batch_first_seq = next_seq_;
+    for (auto it = begin; it != pending_swap_.end(); ++it) {
+        LogListEntry e;
+        e.time = it->time;
+        e.level = it->level;
+        e.message = QString::fromUtf8(it->payload.data(),
+                                      static_cast<int>(it->payload.size()));
+
+        if (ring_.size() < capacity_) {
+            ring_.push_back(std::move(e));
+        } else {
+            ring_[next_seq_ % capacity_] = std::move(e);
+        }
+        ++next_seq_;
+        ++ring_count_;
+    }
+    pending_swap_.clear();
+
+    // 过滤后插入视图
+    std::vector<uint64_t> new_rows;
+    for (auto seq = batch_first_seq; seq < next_seq_; ++seq) {
+        if (_match(_entry(seq))) {
+            new_rows.push_back(seq);
+        }
+    }
+
+    if (new_rows.empty()) {
+        return 0;
+    }
+
+    const int first_row = static_cast<int>(rows_.size());
+    beginInsertRows(QModelIndex(), first_row,
+                    first_row + static_cast<int>(new_rows.size()) - 1);
+    rows_.insert(rows_.end(), new_rows.begin(), new_rows.end());
+    endInsertRows();
+
+    return static_cast<int>(new_rows.size());
+}
+
+void LogListModel::_evict_before(uint64_t new_first_seq) {
+    std::size_t n = 0;
+    while (n < rows_.size() && rows_[n] < new_first_seq) {
+        ++n;
+    }
+
+    if (n == 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), 0, static_cast<int>(n) - 1);
+    rows_.erase(rows_.begin(), rows_.begin() + n);
+    endRemoveRows();
+}
+
+void LogListModel::clear() {
+    {
+        std::lock_guard guard(pending_mutex_);
+        pending_.clear();
+        pending_dropped_ = 0;
+    }
+
+    beginResetModel();
+    ring_.clear();
+    rows_.clear();
+    first_seq_ = next_seq_ = 0;
+    ring_count_ = 0;
+    overwritten_count_ = 0;
+    endResetModel();
+}
+
+void LogListModel::set_filter(spdlog::level::level_enum min_level) {
+    filter_level_ = min_level;
+    _rebuild_rows();
+}
+
+void LogListModel::_rebuild_rows() {
+    beginResetModel();
+    rows_.clear();
+    for (auto seq = first_seq_; seq < next_seq_; ++seq) {
+        if (_match(_entry(seq))) {
+            rows_.push_back(seq);
+        }
+    }
+    endResetModel();
+}
+
+bool LogListModel::_match(const LogListEntry &e) const {
+    return e.level >= filter_level_;
+}
+
+int LogListModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(rows_.size());
+}
+
+QVariant LogListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 ||
+        index.row() >= static_cast<int>(rows_.size())) {
+        return {};
+    }
+
+    const auto &e = _entry(rows_[index.row()]);
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            e.time.time_since_epoch())
+                            .count();
+        const auto level_sv = spdlog::level::to_string_view(e.level);
+        return QStringLiteral("[%1] [%2] %3")
+            .arg(QDateTime::fromMSecsSinceEpoch(ms).toString(
+                     "yyyy-MM-dd hh:mm:ss"),
+                 QString::fromLatin1(level_sv.data(), level_sv.size()),
+                 e.message);
+    }
+    case Qt::BackgroundRole:
+        switch (e.level) {
+        case spdlog::level::level_enum::debug:
+            return QColor{0, 191, 255};
+        case spdlog::level::level_enum::info:
+            return QColor{0, 238, 118};
+        case spdlog::level::level_enum::warn:
+            return QColor{255, 193, 37};
+        case spdlog::level::level_enum::err:
+        case spdlog::level::level_enum::critical:
+            return QColor{255, 69, 0};
+        default:
+            return {};
+        }
+    case Qt::ForegroundRole:
+        if (e.level >= spdlog::level::level_enum::err) {
+            return QColor{Qt::white};
+        }
+        return {};
+    default:
+        return {};
+    }
+}
+
+} // namespace app
+} // namespace edm
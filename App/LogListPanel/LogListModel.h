@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+
+namespace edm {
+namespace app {
+
+// 日志列表的一条记录
+struct LogListEntry {
+    spdlog::log_clock::time_point time;
+    spdlog::level::level_enum level{spdlog::level::trace};
+    QString message;
+};
+
+/**
+ * 日志列表模型:
+ * - 所有日志保存在固定容量的环形缓冲中, 满了覆盖最旧的;
+ *   push() 时即按 MaxMessageLength 截断消息, 环形缓冲与待处理队列
+ *   各不超过 capacity 条, 默认参数下总内存约 50MB 以内
+ * - 日志线程调用 push() 只放入待处理队列 (加锁), GUI定时调用 flush_pending()
+ *   批量插入, 避免每条日志都触发一次视图刷新
+ * - 等级过滤在模型中完成, 视图只看到过滤后的行
+ * - 显示文本在 data() 中按需生成, 配合 QListView::setUniformItemSizes
+ *   只有可见行会被格式化
+ */
+class LogListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static constexpr std::size_t DefaultCapacity = 20000;
+    static constexpr std::size_t MaxMessageLength = 512; // utf8 字节
+
+    explicit LogListModel(std::size_t capacity = DefaultCapacity,
+                          QObject *parent = nullptr);
+
+    // 任意线程调用
+    void push(const spdlog::details::log_msg &msg);
+
+    // GUI线程调用, 把待处理的日志插入模型; 返回插入(过滤后)的行数
+    int flush_pending();
+
+    void clear();
+
+    // 过滤: 最低等级
+    void set_filter(spdlog::level::level_enum min_level);
+
+    inline std::size_t capacity() const { return capacity_; }
+    inline std::size_t total_count() const { return ring_count_; }
+    inline uint64_t overwritten_count() const { return overwritten_count_; }
+
+public:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+private:
+    struct _PendingEntry {
+        spdlog::log_clock::time_point time;
+        spdlog::level::level_enum level;
+        std::string payload; // 已截断
+    };
+
+    inline const LogListEntry &_entry(uint64_t seq) const {
+        return ring_[seq % capacity_];
+    }
+
+    bool _match(const LogListEntry &e) const;
+
+    // 移除序号小于 new_first_seq 的行 (被覆盖之前调用)
+    void _evict_before(uint64_t new_first_seq);
+
+    void _rebuild_rows();
+
+private:
+    const std::size_t capacity_;
+
+    // 环形缓冲, 记录序号 seq 存放在 ring_[seq % capacity_]
+    std::vector<LogListEntry> ring_;
+    uint64_t first_seq_{0}; // 最旧的一条
+    uint64_t next_seq_{0};
+    std::size_t ring_count_{0};
+    uint64_t overwritten_count_{0};
+
+    std::deque<uint64_t> rows_; // 过滤后的行 -> 记录序号
+
+    spdlog::level::level_enum filter_level_{spdlog::level::trace};
+
+    std::mutex pending_mutex_;
+    std::deque<_PendingEntry> pending_;
+    std::deque<_PendingEntry> pending_swap_;
+    uint64_t pending_dropped_{0};
+};
+
+} // namespace app
+} // namespace edm
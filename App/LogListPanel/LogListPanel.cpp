@@ -11,9 +11,9 @@
 #include <functional>
 #include <memory>
 
-#include <qcolor.h>
-#include <qnamespace.h>
-#include <qpushbutton.h>
+#include <QComboBox>
+#include <QPushButton>
+#include <QScrollBar>
 #include <spdlog/sinks/callback_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <string>
@@ -32,6 +32,11 @@ LogListPanel::LogListPanel(SharedCoreData *shared_core_data, QWidget *parent)
       shared_core_data_(shared_core_data) {
     ui->setupUi(this);
 
+    model_ = new LogListModel(LogListModel::DefaultCapacity, this);
+    ui->listView->setModel(model_);
+    ui->listView->setUniformItemSizes(true); // 只计算可见行
+    ui->listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
     auto callback_sink = std::make_shared<spdlog::sinks::callback_sink_st>(
         std::bind_front(&LogListPanel::_logged_callback, this));
     callback_sink->set_level(spdlog::level::trace);
@@ -53,61 +58,57 @@ LogListPanel::LogListPanel(SharedCoreData *shared_core_data, QWidget *parent)
     s_logger->swap(*loglist_logger_);
     loglist_logger_ = s_logger;
 
-    formatter_.set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");
-
     shared_core_data_->set_loglist_logger(loglist_logger_);
 
     _init_pb();
+    _init_filter();
+
+    flush_timer_ = new QTimer(this);
+    connect(flush_timer_, &QTimer::timeout, this, &LogListPanel::_flush_model);
+    flush_timer_->start(100);
 }
 
 void LogListPanel::_init_pb() {
     connect(ui->pb_clear, &QPushButton::clicked, this, [this]() {
-        ui->listWidget->clear();
+        model_->clear();
+        _flush_model();
     });
 }
 
-void LogListPanel::_logged_callback(const spdlog::details::log_msg &msg) {
-    // auto content_str = std::string{msg.payload.begin(), msg.payload.end()};
-
-    // auto level_strv = spdlog::level::to_string_view(msg.level);
-    // auto level_str = std::string{level_strv.begin(), level_strv.end()};
+void LogListPanel::_init_filter() {
+    for (auto level : {spdlog::level::trace, spdlog::level::debug,
+                       spdlog::level::info, spdlog::level::warn,
+                       spdlog::level::err, spdlog::level::critical}) {
+        auto sv = spdlog::level::to_string_view(level);
+        ui->cb_level->addItem(QString::fromLatin1(sv.data(), sv.size()),
+                              static_cast<int>(level));
+    }
 
-    // auto time = std::chrono::time_point_cast<std::chrono::seconds>(msg.time);
-    // auto time_str = EDM_FMT::format("[{:%F %T}]", time);
+    connect(ui->cb_level, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]() {
+                model_->set_filter(static_cast<spdlog::level::level_enum>(
+                    ui->cb_level->currentData().toInt()));
+                ui->listView->scrollToBottom();
+            });
+}
 
-    // qDebug().noquote() << QString::fromStdString(time_str)
-    //                    << QString::fromStdString(level_str);
+void LogListPanel::_flush_model() {
+    // 滚动条在底部时才自动滚动, 便于查看历史日志
+    auto scroll_bar = ui->listView->verticalScrollBar();
+    bool at_bottom = scroll_bar->value() == scroll_bar->maximum();
 
-    spdlog::memory_buf_t dest;
-    formatter_.format(msg, dest);
-    auto str = std::string{dest.begin(), dest.end()};
-    if (str.ends_with('\n')) {
-        str.pop_back();
+    if (model_->flush_pending() > 0 && at_bottom) {
+        ui->listView->scrollToBottom();
     }
 
-    ui->listWidget->addItem(QString::fromStdString(str));
-    auto item = ui->listWidget->item(ui->listWidget->count() - 1);
-    if (item) {
-        switch (msg.level) {
-        case spdlog::level::level_enum::debug:
-            item->setBackground(QColor{0, 191, 255});
-            break;
-        default:
-        case spdlog::level::level_enum::trace:
-            break;
-        case spdlog::level::level_enum::info:
-            item->setBackground(QColor{0, 238, 118});
-            break;
-        case spdlog::level::level_enum::warn:
-            item->setBackground(QColor{255, 193, 37});
-            break;
-        case spdlog::level::level_enum::err:
-        case spdlog::level::level_enum::critical:
-            item->setBackground(QColor{255, 69, 0});
-            item->setForeground(Qt::white);
-            break;
-        }
-    }
+    ui->lb_count->setText(QString("%1 / %2")
+                              .arg(model_->total_count())
+                              .arg(model_->capacity()));
+}
+
+void LogListPanel::_logged_callback(const spdlog::details::log_msg &msg) {
+    // 可能在任意线程调用, 只放入模型的待处理队列
+    model_->push(msg);
 }
 
 LogListPanel::~LogListPanel() { delete ui; }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QTimer>
 #include <QWidget>
 #include <string>
 
@@ -12,6 +13,8 @@
 
 #include "SharedCoreData/SharedCoreData.h"
 
+#include "LogListModel.h"
+
 namespace Ui {
 class LogListPanel;
 }
@@ -34,6 +37,10 @@ private:
     void _logged_callback(const spdlog::details::log_msg& msg);
 
     void _init_pb();
+    void _init_filter();
+
+    // 定时把缓存的日志批量插入模型
+    void _flush_model();
 
 private:
     Ui::LogListPanel *ui;
@@ -41,7 +48,8 @@ private:
 
     log::logger_ptr loglist_logger_;
 
-    spdlog::pattern_formatter formatter_;
+    LogListModel *model_;
+    QTimer *flush_timer_;
 };
 
 } // namespace app
@@ -307,8 +307,12 @@ void MainWindow::_init_tab_monitor() {
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 void MainWindow::_init_tab_breakout_monitor() {
     connect(shared_core_data_->get_info_dispatcher(),
-            &InfoDispatcher::info_updated, this,
-            [this](const edm::move::MotionInfo &info) {
+            &InfoDispatcher::info_changed, this,
+            [this](const edm::move::MotionInfo &info, uint32_t change_mask) {
+                if (!(change_mask & InfoChange_State)) {
+                    return;
+                }
+
                 if (info.KnDetected()) {
                     ui->lb_dir_has_kn->setText(QStringLiteral("有峭度"));
                     ui->lb_dir_has_kn->setStyleSheet(
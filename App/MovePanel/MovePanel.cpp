@@ -99,9 +99,11 @@ void MovePanel::_init_button_cb() {
             });
 
     connect(shared_core_data_->get_info_dispatcher(),
-            &InfoDispatcher::info_updated, this,
-            [this](const move::MotionInfo &info) {
-                ui->pb_drill_spindle->setChecked(info.is_spindle_on);
+            &InfoDispatcher::info_changed, this,
+            [this](const move::MotionInfo &info, uint32_t change_mask) {
+                if (change_mask & InfoChange_Drill) {
+                    ui->pb_drill_spindle->setChecked(info.is_spindle_on);
+                }
             });
 
 #else
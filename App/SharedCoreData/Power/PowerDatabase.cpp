@@ -28,49 +28,56 @@ PowerDatabase::~PowerDatabase() { delete ui; }
 
 bool PowerDatabase::get_eleparam_from_index(
     uint32_t index, power::EleParam_dkd_t &output) const {
-    QString cmd = QString{"SELECT * FROM %0 WHERE E_INDEX = %1"}
-                      .arg(EleTableName)
-                      .arg(index);
-
-    QSqlQuery q;
-    q.exec(cmd);
-    if (!q.next()) {
+    auto itr = eleparam_cache_.find(index);
+    if (itr == eleparam_cache_.end()) {
         return false;
     }
 
-    _get_eleparam_from_record(q.record(), output);
+    output = itr->second;
     return true;
 }
 
 bool PowerDatabase::exist_index(uint32_t index) const {
-    QString cmd = QString{"SELECT EXISTS(SELECT 1 FROM %0 WHERE E_INDEX = %1);"}
-                      .arg(EleTableName)
-                      .arg(index);
-    QSqlQuery q;
-    q.exec(cmd);
-    q.next();
-    bool ret = (q.value(0).toInt() != 0);
-    q.finish();
-    return ret;
+    return eleparam_cache_.find(index) != eleparam_cache_.end();
 }
 
 std::optional<power::EleParam_dkd_t>
 PowerDatabase::get_one_valid_eleparam() const {
-    std::optional<power::EleParam_dkd_t> ret{std::nullopt};
+    // 与原先 SELECT * 的行为一致, 返回序号最小的一条
+    const power::EleParam_dkd_t *ret = nullptr;
+    for (const auto &[index, param] : eleparam_cache_) {
+        if (!ret || index < ret->upper_index) {
+            ret = &param;
+        }
+    }
 
-    QString cmd = QString{"SELECT * FROM %0;"}.arg(EleTableName);
+    if (!ret) {
+        return std::nullopt;
+    }
+    return *ret;
+}
 
-    QSqlQuery q;
-    q.exec(cmd);
-    if (!q.next()) {
-        return ret;
+bool PowerDatabase::_reload_cache() {
+    QSqlQuery q{this->database_};
+    q.setForwardOnly(true);
+    if (!q.prepare(QString{"SELECT * FROM %0"}.arg(EleTableName)) ||
+        !q.exec()) {
+        s_logger->error("power db: reload cache failed: {}",
+                        q.lastError().text().toStdString());
+        return false;
     }
 
-    power::EleParam_dkd_t p;
-    _get_eleparam_from_record(q.record(), p);
-    ret = p;
+    decltype(eleparam_cache_) cache;
+    while (q.next()) {
+        power::EleParam_dkd_t p;
+        _get_eleparam_from_record(q.record(), p);
+        cache.emplace(p.upper_index, p);
+    }
+    q.finish();
 
-    return ret;
+    eleparam_cache_.swap(cache);
+    s_logger->debug("power db: {} eleparams cached", eleparam_cache_.size());
+    return true;
 }
 
 void PowerDatabase::_init_database() {
@@ -172,6 +179,11 @@ void PowerDatabase::_init_database() {
 
     // 刷新显示
     this->_update_tableview();
+
+    // 加载缓存
+    if (!_reload_cache()) {
+        throw exception{"power database: load eleparam cache failed"};
+    }
 }
 
 void PowerDatabase::_init_button_slots() {
@@ -253,9 +265,17 @@ bool PowerDatabase::_create_table_with_default_params() {
     q.finish();
 
     // create table finished
+    // 预编译插入语句, 在一个事务中插入默认行
+    this->database_.transaction();
+    q.prepare(R"(INSERT INTO "main"."eleparam" DEFAULT VALUES;)");
     for (int i = 0; i < 10; ++i) {
-        q.exec(R"(INSERT INTO "main"."eleparam" DEFAULT VALUES;)");
+        if (!q.exec()) {
+            s_logger->error("insert default eleparam failed, {}",
+                            q.lastError().text().toStdString());
+        }
     }
+    q.finish();
+    this->database_.commit();
 
     // TODO
     return true;
@@ -275,14 +295,22 @@ bool PowerDatabase::_drop_table(const QString &table_name) {
 }
 
 void PowerDatabase::_slot_tableedit_confirm() {
+    // 所有修改在一个事务中提交 (model 内部使用预编译语句), 失败则整体回滚
+    this->database_.transaction();
     if (!table_model_->submitAll()) {
         s_logger->error("power db error: submit all failed");
+        this->database_.rollback();
         QMessageBox::critical(this, tr("error"),
                               tr("submit failed, revert, error:\n") +
                                   table_model_->lastError().text());
         table_model_->revertAll();
+    } else {
+        this->database_.commit();
     }
 
+    // 表格被修改, 更新缓存
+    _reload_cache();
+
     _set_table_editable(false);
     _update_tableview();
 
@@ -355,6 +383,7 @@ void PowerDatabase::_slot_choose_eleparam_index() {
 
 void PowerDatabase::_slot_table_refresh() {
     this->_update_tableview();
+    this->_reload_cache();
 
     // test
 
@@ -17,6 +17,7 @@
 #include "QtDependComponents/PowerController/EleparamDefine.h"
 
 #include <optional>
+#include <unordered_map>
 
 namespace Ui {
 class PowerDatabase;
@@ -33,13 +34,16 @@ public:
     ~PowerDatabase();
 
 public: // 接口
+    // 查询都从内存缓存中读取, 不访问数据库 (缓存在启动时和表格编辑提交后加载)
+    // 只能在GUI线程调用
+
     // 根据电参数号, 获取电参数结构体
-    // 如果index存在, 数据库会创建一个新的对应于index的电参数结构体并返回true
+    // 如果index存在, 将对应的电参数拷贝到output并返回true
     // 如果index不存在, 返回false
     bool get_eleparam_from_index(uint32_t index,
                                  power::EleParam_dkd_t &output) const;
 
-    // 获取是否存在某一个电参数号的信息, 每次调用都会触发数据库搜索
+    // 获取是否存在某一个电参数号的信息
     bool exist_index(uint32_t index) const;
 
     // 获取一条记录(用于初始化)
@@ -62,6 +66,9 @@ private:
     bool _check_table_valid() const; // 检查表格各列是否正确
     bool _drop_table(const QString &table_name); // 删除表格
 
+    // 从数据库重新加载全部电参数到缓存
+    bool _reload_cache();
+
 private: // 表格编辑操作 槽函数
     void _slot_tableedit_confirm();
     void _slot_tableedit_add();
@@ -88,6 +95,9 @@ private:
     QSqlDatabase database_;       // 数据库对象
     QSqlTableModel *table_model_; // 数据表模型
 
+    // 电参数缓存, E_INDEX -> 电参数
+    std::unordered_map<uint32_t, power::EleParam_dkd_t> eleparam_cache_;
+
 private:
     // 数据库页面编辑状态
     // bool enable_edit_{false};
@@ -58,6 +58,12 @@ public:
     }
     inline bool is_machbit_on() const { return power_ctrler_->is_machbit_on(); }
 
+    // 标志位已由运动线程直发设置, 只刷新IO并通知界面
+    inline void sync_power_flags() {
+        power_ctrler_->update_eleparam_and_send();
+        emit sig_power_flag_changed();
+    }
+
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     inline void set_power_on(bool on) {
         power_ctrler_->set_power_on(on);
@@ -25,27 +25,32 @@ namespace app {
 // 因为PowerController不是线程安全的
 class MotionEventVoltageEnable : public QEvent {
 public:
-    MotionEventVoltageEnable(bool voltage_enable)
-        : QEvent(type), voltage_enable_(voltage_enable) {}
+    MotionEventVoltageEnable(bool voltage_enable, uint32_t seq)
+        : QEvent(type), voltage_enable_(voltage_enable), seq_(seq) {}
     constexpr static const QEvent::Type type =
         QEvent::Type(EDM_CUSTOM_QTEVENT_TYPE_MotionVoltageEnable);
 
     auto voltage_enable() const { return voltage_enable_; }
+    auto seq() const { return seq_; }
 
 private:
     bool voltage_enable_;
+    uint32_t seq_;
 };
 
 class MotionEventMachOn : public QEvent {
 public:
-    MotionEventMachOn(bool mach_on) : QEvent(type), mach_on_(mach_on) {}
+    MotionEventMachOn(bool mach_on, uint32_t seq)
+        : QEvent(type), mach_on_(mach_on), seq_(seq) {}
     constexpr static const QEvent::Type type =
         QEvent::Type(EDM_CUSTOM_QTEVENT_TYPE_MotionMachOn);
 
     auto mach_on() const { return mach_on_; }
+    auto seq() const { return seq_; }
 
 private:
     bool mach_on_;
+    uint32_t seq_;
 };
 
 class MotionEventTriggerBzOnce : public QEvent {
@@ -269,8 +274,16 @@ void SharedCoreData::customEvent(QEvent *e) {
     case MotionEventVoltageEnable::type: {
 //#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
         auto vol_enable_event = static_cast<MotionEventVoltageEnable *>(e);
-        this->power_manager_->set_machbit_on(
-            vol_enable_event->voltage_enable());
+        // 已有更新的门控命令, 丢弃
+        if (vol_enable_event->seq() == voltage_gate_seq_) {
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN) && defined(EDM_CAN_ENABLE_DIRECT_SEND)
+            // 标志位已在运动线程中设置, 这里不再写入
+            this->power_manager_->sync_power_flags();
+#else
+            this->power_manager_->set_machbit_on(
+                vol_enable_event->voltage_enable());
+#endif
+        }
 //#endif
         e->accept();
         break;
@@ -278,8 +291,9 @@ void SharedCoreData::customEvent(QEvent *e) {
 
     case MotionEventMachOn::type: {
         auto mach_on_event = static_cast<MotionEventMachOn *>(e);
-        this->power_manager_->set_highpower_on(mach_on_event->mach_on());
-        this->power_ctrler_->update_eleparam_and_send();
+        if (mach_on_event->seq() == mach_on_seq_) {
+            this->power_manager_->set_highpower_on(mach_on_event->mach_on());
+        }
         e->accept();
         break;
     }
@@ -501,14 +515,22 @@ void SharedCoreData::_init_motionthread_cb() {
     motion_cbs_.cb_enable_voltage_gate = [this](bool arg) -> void {
         s_logger->trace("push voltage gate command: {}", arg);
 
+        const uint32_t seq = voltage_gate_seq_.fetch_add(1) + 1;
+
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN) && defined(EDM_CAN_ENABLE_DIRECT_SEND)
+        // 电压门控对时间敏感: 设置标志位并唤醒直发通道 (wait-free),
+        // 下面的命令仍然排队到主线程, 用于同步IO与界面
+        this->power_ctrler_->send_machbit_direct(arg);
+#endif
+
         // postevent本身可能会耗时较多但是线程安全,
         // 而global_cmd_queue_这个队列是相当空闲的 操作电压的操作无须特别实时,
         // 所以优先保证motion操作电压的函数可以快速返回
         auto run_cmd = global::CommandCommonFunctionFactory::bind(
-            [this](bool _enable) {
+            [this, seq](bool _enable) {
                 // send 3 times
                 QCoreApplication::postEvent(
-                    this, new MotionEventVoltageEnable(_enable));
+                    this, new MotionEventVoltageEnable(_enable, seq));
             },
             arg);
 
@@ -517,10 +539,19 @@ void SharedCoreData::_init_motionthread_cb() {
     };
 
     motion_cbs_.cb_mach_on = [this](bool arg) -> void {
+        const uint32_t seq = mach_on_seq_.fetch_add(1) + 1;
+
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN) && defined(EDM_CAN_ENABLE_DIRECT_SEND)
+        // 关高频直接发出; 开高频要先吸合继电器, 仍由主线程处理
+        if (!arg) {
+            this->power_ctrler_->send_highpower_direct(false);
+        }
+#endif
+
         auto run_cmd = global::CommandCommonFunctionFactory::bind(
-            [this](bool _mach_on) {
-                QCoreApplication::postEvent(this,
-                                            new MotionEventMachOn(_mach_on));
+            [this, seq](bool _mach_on) {
+                QCoreApplication::postEvent(
+                    this, new MotionEventMachOn(_mach_on, seq));
             },
             arg);
 
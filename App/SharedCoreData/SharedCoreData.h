@@ -165,6 +165,11 @@ private:
     // std::function<void(bool)> cb_enable_votalge_gate_;
     // std::function<void(bool)> cb_mach_on_;
 
+    // 运动线程发出的电压门控/高频命令的序号, 主线程只执行最新的一条,
+    // 被取代的排队命令直接丢弃, 不会用旧值覆盖标志位
+    std::atomic_uint32_t voltage_gate_seq_{0};
+    std::atomic_uint32_t mach_on_seq_{0};
+
 private:
     log::logger_ptr loglist_logger_ {nullptr};
 
@@ -0,0 +1,96 @@
+#include "GCodeProgramStream.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace edm {
+
+namespace task {
+
+GCodeProgramStream::GCodeProgramStream(std::size_t max_pending_tasks)
+    : max_pending_tasks_(std::max<std::size_t>(max_pending_tasks, 1)) {}
+
+bool GCodeProgramStream::push(std::vector<GCodeTaskBase::ptr> &&chunk) {
+    std::unique_lock lock(mutex_);
+
+    cv_not_full_.wait(lock, [this]() {
+        return state_ != State::Producing ||
+               pending_.size() < max_pending_tasks_;
+    });
+
+    if (state_ != State::Producing) {
+        return false;
+    }
+
+    pushed_count_ += chunk.size();
+    std::move(chunk.begin(), chunk.end(), std::back_inserter(pending_));
+    chunk.clear();
+
+    return true;
+}
+
+void GCodeProgramStream::finish() {
+    std::lock_guard guard(mutex_);
+    if (state_ == State::Producing) {
+        state_ = State::Finished;
+    }
+}
+
+void GCodeProgramStream::fail(std::string error_str) {
+    std::lock_guard guard(mutex_);
+    if (state_ == State::Producing) {
+        state_ = State::Failed;
+        error_str_ = std::move(error_str);
+    }
+}
+
+GCodeProgramStream::State
+GCodeProgramStream::fetch(std::vector<GCodeTaskBase::ptr> &out) {
+    {
+        std::lock_guard guard(mutex_);
+
+        if (!pending_.empty()) {
+            std::move(pending_.begin(), pending_.end(),
+                      std::back_inserter(out));
+            pending_.clear();
+        }
+
+        if (state_ != State::Producing) {
+            return state_;
+        }
+    }
+
+    cv_not_full_.notify_all();
+    return State::Producing;
+}
+
+void GCodeProgramStream::cancel() {
+    {
+        std::lock_guard guard(mutex_);
+        if (state_ == State::Producing) {
+            state_ = State::Canceled;
+        }
+        pending_.clear();
+    }
+
+    cv_not_full_.notify_all();
+}
+
+GCodeProgramStream::State GCodeProgramStream::state() const {
+    std::lock_guard guard(mutex_);
+    return state_;
+}
+
+std::string GCodeProgramStream::error_str() const {
+    std::lock_guard guard(mutex_);
+    return error_str_;
+}
+
+std::size_t GCodeProgramStream::pushed_count() const {
+    std::lock_guard guard(mutex_);
+    return pushed_count_;
+}
+
+} // namespace task
+
+} // namespace edm
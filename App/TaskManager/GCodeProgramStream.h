@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GCodeTaskBase.h"
+
+namespace edm {
+
+namespace task {
+
+/**
+ * 流水线加工的程序流 (有界队列):
+ * 解析线程 (生产者) 每解析出一块任务就推入, GCodeRunner (消费者, GUI线程)
+ * 不必等整个程序解析完, 取到第一块即可开始加工.
+ *
+ * - 待取任务数达到上限时 push 阻塞, 直到消费者取走或流被取消
+ * - 解析出错时 fail, 已推入的任务照常执行, 执行到出错位置时再中止
+ * - 消费者停止加工时 cancel, 唤醒并中止生产者
+ */
+class GCodeProgramStream final {
+public:
+    using ptr = std::shared_ptr<GCodeProgramStream>;
+
+    enum class State {
+        Producing, // 仍在解析
+        Finished,  // 解析完成, 所有任务已推入
+        Failed,    // 解析出错, 见 error_str()
+        Canceled   // 被取消
+    };
+
+    explicit GCodeProgramStream(std::size_t max_pending_tasks = 64 * 1024);
+
+public: // 生产者
+    // 队列满时阻塞; 流被取消时返回false
+    bool push(std::vector<GCodeTaskBase::ptr> &&chunk);
+
+    void finish();
+    void fail(std::string error_str);
+
+public: // 消费者
+    // 取走所有待取任务追加到 out, 不阻塞;
+    // 返回取走后的状态: 返回 Finished/Failed 时之后不会再有新的任务
+    State fetch(std::vector<GCodeTaskBase::ptr> &out);
+
+    void cancel();
+
+public:
+    State state() const;
+    std::string error_str() const;
+
+    // 已推入的任务总数 (用于显示)
+    std::size_t pushed_count() const;
+
+private:
+    const std::size_t max_pending_tasks_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_not_full_;
+
+    std::deque<GCodeTaskBase::ptr> pending_;
+    std::size_t pushed_count_{0};
+
+    State state_{State::Producing};
+    std::string error_str_;
+};
+
+} // namespace task
+
+} // namespace edm
@@ -15,6 +15,7 @@
 
 #include <QCoreApplication>
 #include <QDateTime>
+#include <algorithm>
 #include <bits/chrono.h>
 #include <chrono>
 #include <cstddef>
@@ -67,6 +68,9 @@ bool GCodeRunner::start(const std::vector<GCodeTaskBase::ptr> &gcode_list) {
     gcode_list_ = gcode_list;
     curr_gcode_num_ = 0;
     total_elapsed_time_ = std::chrono::system_clock::duration::zero();
+    program_stream_error_str_.clear();
+    block_gap_stat_ = {};
+    last_motion_over_valid_ = false;
 
     if (!_check_gcode_list_at_first()) {
         return false; //! set abort inside _check_xxx()
@@ -77,12 +81,52 @@ bool GCodeRunner::start(const std::vector<GCodeTaskBase::ptr> &gcode_list) {
     return true;
 }
 
+bool GCodeRunner::start(GCodeProgramStream::ptr program_stream) {
+    if (state_ != State::Stopped) {
+        s_logger->error("GCodeRunner start failed: not stopped");
+        return false;
+    }
+
+    if (!program_stream) {
+        s_logger->error("GCodeRunner start failed: no program stream");
+        return false;
+    }
+
+    gcode_list_.clear();
+    curr_gcode_num_ = 0;
+    total_elapsed_time_ = std::chrono::system_clock::duration::zero();
+    block_gap_stat_ = {};
+    last_motion_over_valid_ = false;
+
+    program_stream_ = std::move(program_stream);
+    program_stream_error_str_.clear();
+
+    if (!_fetch_program_stream()) {
+        return false; //! set abort inside _fetch_program_stream()
+    }
+
+    if (gcode_list_.empty() && !program_stream_) {
+        _abort(program_stream_error_str_.empty()
+                   ? "check err: no gcode"
+                   : EDM_FMT::format("parse err: {}",
+                                     program_stream_error_str_));
+        return false;
+    }
+
+    s_logger->info("GCodeRunner start (pipelined), {} gcode ready",
+                   gcode_list_.size());
+
+    update_timer_->start(update_timer_regular_peroid_ms_);
+    _switch_to_state(State::ReadyToStart);
+    return true;
+}
+
 bool GCodeRunner::pause() {
     if (this->is_over()) {
         return false;
     }
 
-    auto curr_gcode = gcode_list_[curr_gcode_num_];
+    auto curr_gcode = _current_gcode();
 
     switch (state_) {
     case State::WaitingForResumed:
@@ -136,7 +180,7 @@ bool GCodeRunner::resume() {
         return false;
     }
 
-    auto curr_gcode = gcode_list_[curr_gcode_num_];
+    auto curr_gcode = _current_gcode();
 
     switch (state_) {
     case State::Paused: {
@@ -187,7 +231,7 @@ bool GCodeRunner::stop() {
         return false;
     }
 
-    auto curr_gcode = gcode_list_[curr_gcode_num_];
+    auto curr_gcode = _current_gcode();
 
     switch (state_) {
     case State::WaitingForResumed:
@@ -279,6 +323,20 @@ std::vector<std::string> GCodeRunner::get_time_report() const {
         str_vec.push_back(str);
     }
 
+    if (block_gap_stat_.count > 0) {
+        using ms = std::chrono::duration<double, std::milli>;
+        str_vec.push_back(EDM_FMT::format(
+            "block gap: {} gaps, avg {:.2f} ms, max {:.2f} ms, total {:.1f} ms",
+            block_gap_stat_.count,
+            ms(block_gap_stat_.total).count() / block_gap_stat_.count,
+            ms(block_gap_stat_.max).count(),
+            ms(block_gap_stat_.total).count()));
+    }
+    if (block_gap_stat_.chained > 0) {
+        str_vec.push_back(EDM_FMT::format("chained blocks: {}",
+                                          block_gap_stat_.chained));
+    }
+
     return str_vec;
 }
 
@@ -322,6 +380,51 @@ bool GCodeRunner::_cmd_emergency_stop() {
 }
 
 void GCodeRunner::_run_once() {
+    // 重入 (WaitforCmdTobeAccepted 中处理事件时到达的信号/定时器):
+    // 记下, 由外层循环再运行一次
+    if (in_run_once_) {
+        run_again_flag_ = true;
+        return;
+    }
+
+    in_run_once_ = true;
+
+    int steps = 0;
+    do {
+        run_again_flag_ = false;
+        _run_state_machine_once();
+    } while (run_again_flag_ && ++steps < max_steps_per_turn_);
+
+    in_run_once_ = false;
+
+    // 超过单轮次数限制, 剩下的放到下一轮事件循环
+    if (run_again_flag_) {
+        run_again_flag_ = false;
+        _schedule_run_once();
+    }
+}
+
+void GCodeRunner::_schedule_run_once() {
+    if (in_run_once_) {
+        run_again_flag_ = true;
+        return;
+    }
+
+    if (run_once_queued_) {
+        return;
+    }
+
+    run_once_queued_ = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            run_once_queued_ = false;
+            _run_once();
+        },
+        Qt::QueuedConnection);
+}
+
+void GCodeRunner::_run_state_machine_once() {
     // 直接获取最新的info
 #ifdef EDM_MOTION_INFO_GET_USE_ATOMIC
     shared_core_data_->get_motion_thread_ctrler()->load_at_info_cache(
@@ -351,9 +454,14 @@ void GCodeRunner::_run_once() {
         break;
     }
     case State::Paused: {
-        // Do Nothing here
-        auto curr_gcode = gcode_list_[curr_gcode_num_];
-        if (curr_gcode->timer().state() != TaskTimer::State::Paused) {
+        // 暂停前运动线程可能已接续到缓冲中的块
+        if (!queued_blocks_.empty() && !_sync_queued_blocks()) {
+            break;
+        }
+
+        auto curr_gcode = _current_gcode();
+        if (curr_gcode &&
+            curr_gcode->timer().state() != TaskTimer::State::Paused) {
             curr_gcode->timer().pause();
             s_logger->warn(
                 "in GCodeRunner::Paused: timer state not paused, paused now, gcode_num: {}, "
@@ -373,8 +481,9 @@ void GCodeRunner::_run_once() {
     }
     case State::Stopped: {
         // Do Nothing here
-        auto curr_gcode = gcode_list_[curr_gcode_num_];
-        if (curr_gcode->timer().state() != TaskTimer::State::Stopped) {
+        auto curr_gcode = _current_gcode();
+        if (curr_gcode &&
+            curr_gcode->timer().state() != TaskTimer::State::Stopped) {
             curr_gcode->timer().stop();
             s_logger->warn(
                 "in GCodeRunner::Stopped: timer state not stopped, stopped now, gcode_num: {}, "
@@ -398,7 +507,23 @@ void GCodeRunner::_run_once() {
 }
 
 bool GCodeRunner::_check_gcode_list_at_first() {
-    for (const auto &g : gcode_list_) {
+    if (!_check_gcode_tasks(0)) {
+        return false;
+    }
+
+    // 判断最后一个是不是M02
+
+    if (gcode_list_.back()->type() != GCodeTaskType::ProgramEndCommand) {
+        _abort("check err: last gcode is not m02");
+        return false;
+    }
+
+    return true;
+}
+
+bool GCodeRunner::_check_gcode_tasks(std::size_t first) {
+    for (std::size_t i = first; i < gcode_list_.size(); ++i) {
+        const auto &g = gcode_list_[i];
         // 判断电参数号是否存在
         if (g->type() == GCodeTaskType::EleparamSetCommand) {
             auto eg = std::static_pointer_cast<GCodeTaskEleparamSet>(g);
@@ -423,14 +548,74 @@ bool GCodeRunner::_check_gcode_list_at_first() {
         }
     }
 
-    // 判断最后一个是不是M02
+    return true;
+}
 
-    if (gcode_list_.back()->type() != GCodeTaskType::ProgramEndCommand) {
-        _abort("check err: last gcode is not m02");
+bool GCodeRunner::_fetch_program_stream() {
+    if (!program_stream_) {
+        return true;
+    }
+
+    const auto first = gcode_list_.size();
+    const auto stream_state = program_stream_->fetch(gcode_list_);
+
+    if (!_check_gcode_tasks(first)) {
         return false;
     }
 
-    return true;
+    switch (stream_state) {
+    case GCodeProgramStream::State::Producing:
+        return true;
+    case GCodeProgramStream::State::Finished: {
+        s_logger->info("GCodeRunner program stream finished, {} gcode",
+                       gcode_list_.size());
+        program_stream_.reset();
+
+        if (gcode_list_.empty() ||
+            gcode_list_.back()->type() != GCodeTaskType::ProgramEndCommand) {
+            _abort("check err: last gcode is not m02");
+            return false;
+        }
+        return true;
+    }
+    case GCodeProgramStream::State::Failed: {
+        // 已取到的任务照常执行, 执行到出错位置时中止
+        program_stream_error_str_ = program_stream_->error_str();
+        s_logger->warn("GCodeRunner program stream failed at gcode {}: {}",
+                       gcode_list_.size(), program_stream_error_str_);
+        program_stream_.reset();
+        return true;
+    }
+    case GCodeProgramStream::State::Canceled:
+    default:
+        program_stream_.reset();
+        _abort("program stream canceled");
+        return false;
+    }
+}
+
+bool GCodeRunner::_wait_for_program_stream() {
+    if (!_fetch_program_stream()) {
+        return false;
+    }
+
+    if (curr_gcode_num_ < gcode_list_.size()) {
+        return true;
+    }
+
+    if (program_stream_) {
+        // 加工追上了解析, 等待 (CurrentNodeIniting 是快速周期)
+        s_logger->debug("GCodeRunner waiting for program stream, gcode_num: {}",
+                        curr_gcode_num_);
+        return false;
+    }
+
+    if (!program_stream_error_str_.empty()) {
+        _abort(EDM_FMT::format("parse err: {}", program_stream_error_str_));
+    } else {
+        _abort("_check_to_next_gcode: gcode overflow");
+    }
+    return false;
 }
 
 void GCodeRunner::_abort(std::string_view error_str) {
@@ -441,6 +626,7 @@ void GCodeRunner::_abort(std::string_view error_str) {
     _cmd_emergency_stop();
 
     _reset_state();
+    _log_block_gap_stat();
     last_error_str_ = error_str;
     emit sig_auto_stopped(true);
 }
@@ -451,6 +637,7 @@ void GCodeRunner::_end() {
     _switch_to_state(State::Stopped);
 
     _reset_state();
+    _log_block_gap_stat();
     last_error_str_.clear();
     emit sig_auto_stopped(false);
 
@@ -475,6 +662,25 @@ void GCodeRunner::_end() {
     // }
 }
 
+void GCodeRunner::_log_block_gap_stat() const {
+    if (block_gap_stat_.chained > 0) {
+        s_logger->info("GCodeRunner chained blocks: {}",
+                       block_gap_stat_.chained);
+    }
+
+    if (block_gap_stat_.count == 0) {
+        return;
+    }
+
+    using ms = std::chrono::duration<double, std::milli>;
+    s_logger->info("GCodeRunner block gap: {} gaps, avg {:.2f} ms, max {:.2f} "
+                   "ms, total {:.1f} ms",
+                   block_gap_stat_.count,
+                   ms(block_gap_stat_.total).count() / block_gap_stat_.count,
+                   ms(block_gap_stat_.max).count(),
+                   ms(block_gap_stat_.total).count());
+}
+
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 void GCodeRunner::_drill_record_data(bool start) {
     if (!SystemSettings::instance().get_drill_settings().auto_record_data) {
@@ -507,15 +713,25 @@ void GCodeRunner::_check_to_next_gcode() {
     // next gcode
     ++curr_gcode_num_;
 
-    if (curr_gcode_num_ >= gcode_list_.size()) {
-        _abort("_check_to_next_gcode: gcode overflow");
+    // 流水线模式, 快执行完已取到的任务时再从程序流取
+    if (program_stream_ &&
+        gcode_list_.size() - curr_gcode_num_ < program_stream_low_water_) {
+        if (!_fetch_program_stream()) {
+            return;
+        }
+    }
+
+    if (curr_gcode_num_ >= gcode_list_.size() && !program_stream_) {
+        _abort(program_stream_error_str_.empty()
+                   ? "_check_to_next_gcode: gcode overflow"
+                   : EDM_FMT::format("parse err: {}",
+                                     program_stream_error_str_));
         // _end();
         return;
     }
 
+    // 同一轮事件循环中立即开始下一个node (见 _switch_to_state)
     _switch_to_state(State::CurrentNodeIniting);
-
-    QTimer::singleShot(50, [this](){_run_once();});
 }
 
 void GCodeRunner::_reset_state() {
@@ -531,12 +747,211 @@ void GCodeRunner::_reset_state() {
                         curr_gcode_num_);
     }
 
+    _clear_queued_blocks();
+
+    // 停止时中止仍在解析的程序流
+    if (program_stream_) {
+        program_stream_->cancel();
+        program_stream_.reset();
+    }
+
     // curr_gcode_num_ = -1; //! reset to -1, means the state is un-inited
     update_timer_->stop();
     // gcode_list_.clear();
     delay_pause_flag_ = false;
 }
 
+// 可以放入运动块缓冲的node: 不会提前结束 (接触感知), 结束位置可以预先算出
+static bool _is_queueable_gcode(const GCodeTaskBase::ptr &gcode) {
+    switch (gcode->type()) {
+    case GCodeTaskType::G00MotionCommand: {
+        auto g00_gcode = std::static_pointer_cast<GCodeTaskG00Motion>(gcode);
+        return !g00_gcode->touch_detect_enable() &&
+               !g00_gcode->is_touch_motion();
+    }
+    case GCodeTaskType::G01MotionCommand:
+    case GCodeTaskType::DelayCommand:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool GCodeRunner::_make_auto_block(int gcode_num, move::axis_t &motor_pos,
+                                   move::AutoBlock &block) const {
+    auto gcode = gcode_list_[gcode_num];
+    if (!_is_queueable_gcode(gcode)) {
+        return false;
+    }
+
+    block.block_id = gcode_num;
+
+    if (gcode->type() == GCodeTaskType::DelayCommand) {
+        block.type = move::AutoBlock::Type::G04;
+        block.delay_s = std::static_pointer_cast<GCodeTaskDeley>(gcode)->delay_s();
+        return true;
+    }
+
+    auto coord_system = shared_core_data_->get_coord_system();
+
+    int coord_index;
+    GCodeCoordinateMode coord_mode;
+    const std::vector<std::optional<double>> *cmd_values;
+    if (gcode->type() == GCodeTaskType::G00MotionCommand) {
+        auto g00_gcode = std::static_pointer_cast<GCodeTaskG00Motion>(gcode);
+        coord_index = g00_gcode->coord_index();
+        coord_mode = g00_gcode->coord_mode();
+        cmd_values = &g00_gcode->cmd_values();
+
+        block.type = move::AutoBlock::Type::G00;
+        block.speed_param = TaskHelper::GetDefaultSpeedparam();
+        block.speed_param.cruise_v =
+            util::UnitConverter::mm_min2blu_s(g00_gcode->feed_speed());
+        if (block.speed_param.cruise_v <= 0.0)
+            block.speed_param.cruise_v = 1.0; // for safe
+    } else {
+        auto g01_gcode = std::static_pointer_cast<GCodeTaskG01Motion>(gcode);
+        coord_index = g01_gcode->coord_index();
+        coord_mode = g01_gcode->coord_mode();
+        cmd_values = &g01_gcode->cmd_values();
+
+        block.type = move::AutoBlock::Type::G01;
+    }
+
+    // 出错的情况都交给正常启动流程处理 (报错/中止/跳过)
+    if (!coord_system->exist_coordinate_index(coord_index)) {
+        return false;
+    }
+
+    move::axis_t mach_start_pos;
+    coord_system->get_cm().motor_to_machine(motor_pos, mach_start_pos);
+
+    move::axis_t mach_target_pos{0.0};
+    std::string err_str;
+    if (!TaskHelper::CalcMachTargetPos(coord_system->get_cm(), coord_mode,
+                                       coord_index, *cmd_values, mach_start_pos,
+                                       mach_target_pos, err_str)) {
+        return false;
+    }
+
+    if (move::MotionUtils::IsAxisTheSame(mach_start_pos, mach_target_pos)) {
+        return false;
+    }
+
+    auto curr_dir =
+        move::MotionUtils::CalcAxisUnitVector(mach_start_pos, mach_target_pos);
+    if (!TaskHelper::CheckPosandnegSoftLimit(coord_system, mach_target_pos,
+                                             curr_dir)) {
+        return false;
+    }
+
+    coord_system->get_cm().machine_to_motor(mach_target_pos, block.target_pos);
+
+    if (block.type == move::AutoBlock::Type::G01) {
+        move::axis_t jump_dir = move::MotionUtils::CalcAxisUnitVector(
+            mach_target_pos, mach_start_pos);
+        block.max_jump_height_from_begin = TaskHelper::GetMaxLengthOnCurrentDir(
+            coord_system, jump_dir, mach_start_pos);
+    }
+
+    motor_pos = block.target_pos;
+    return true;
+}
+
+void GCodeRunner::_queue_next_blocks() {
+    auto curr_gcode = _current_gcode();
+    if (!curr_gcode || !_is_queueable_gcode(curr_gcode) ||
+        queued_blocks_.size() >= max_queued_blocks_) {
+        return;
+    }
+
+    int next_num =
+        queued_blocks_.empty() ? curr_gcode_num_ + 1 : queued_blocks_.back() + 1;
+    auto end_motor_pos = queued_end_motor_pos_;
+
+    std::vector<move::AutoBlock> blocks;
+    while (queued_blocks_.size() + blocks.size() < max_queued_blocks_ &&
+           next_num < static_cast<int>(gcode_list_.size())) {
+        move::AutoBlock block;
+        if (!_make_auto_block(next_num, end_motor_pos, block)) {
+            break;
+        }
+
+        blocks.push_back(block);
+        ++next_num;
+    }
+
+    if (blocks.empty()) {
+        return;
+    }
+
+    auto queue_cmd =
+        std::make_shared<move::MotionCommandAutoQueueBlocks>(blocks);
+    shared_core_data_->get_motion_cmd_queue()->push_command(queue_cmd);
+
+    TaskHelper::WaitforCmdTobeAccepted(queue_cmd, 1000);
+    if (!queue_cmd->is_accepted()) {
+        if (!queue_cmd->is_ignored()) {
+            // 超时: 不能确定运动线程是否会执行这些块
+            _abort("abort: queue blocks timeout");
+        }
+        // 被忽略: 当前块已结束或缓冲已满, 后续node照常逐个启动
+        return;
+    }
+
+    for (const auto &block : blocks) {
+        queued_blocks_.push_back(block.block_id);
+    }
+    queued_end_motor_pos_ = end_motor_pos;
+
+    s_logger->trace("GCodeRunner queued blocks: {} ~ {}",
+                    blocks.front().block_id, blocks.back().block_id);
+}
+
+bool GCodeRunner::_sync_queued_blocks() {
+    const int running_block_id = local_info_cache_.auto_block_id;
+
+    bool switched = false;
+    while (!queued_blocks_.empty() &&
+           queued_blocks_.front() <= running_block_id) {
+        // 当前node已由运动线程执行完毕, 运动线程直接接续了下一个块
+        auto over_gcode = gcode_list_[curr_gcode_num_];
+        over_gcode->timer().stop();
+        total_elapsed_time_ += over_gcode->timer().elapsed_time();
+
+        curr_gcode_num_ = queued_blocks_.front();
+        queued_blocks_.pop_front();
+        ++block_gap_stat_.chained;
+
+        auto curr_gcode = gcode_list_[curr_gcode_num_];
+        curr_gcode->timer().restart();
+        if (state_ == State::WaitingForPaused || state_ == State::Paused) {
+            curr_gcode->timer().pause(); // 与 pause() 中的计时一致
+        }
+        s_loglist->trace("GCodeRunner chained node: {}, line: {}, code: {}",
+                         curr_gcode_num_, curr_gcode->line_number(),
+                         curr_gcode->get_gcode_str());
+        switched = true;
+    }
+
+    if (!switched) {
+        return true;
+    }
+
+    emit sig_autogcode_switched_to_line(
+        gcode_list_[curr_gcode_num_]->line_number());
+
+    // 流水线模式, 快执行完已取到的任务时再从程序流取
+    if (program_stream_ &&
+        gcode_list_.size() - curr_gcode_num_ < program_stream_low_water_) {
+        return _fetch_program_stream();
+    }
+
+    return true;
+}
+
+void GCodeRunner::_clear_queued_blocks() { queued_blocks_.clear(); }
+
 void GCodeRunner::_init_help_connections() {
     auto info_dispatcher = shared_core_data_->get_info_dispatcher();
 
@@ -547,9 +962,15 @@ void GCodeRunner::_init_help_connections() {
             &GCodeRunner::_run_once);
     connect(info_dispatcher, &InfoDispatcher::sig_auto_stopped, this,
             &GCodeRunner::_run_once);
+    connect(info_dispatcher, &InfoDispatcher::sig_auto_block_switched, this,
+            &GCodeRunner::_run_once);
 }
 
 void GCodeRunner::_state_current_node_initing() {
+    if (curr_gcode_num_ >= gcode_list_.size() && !_wait_for_program_stream()) {
+        return;
+    }
+
     assert(curr_gcode_num_ < gcode_list_.size());
     auto curr_gcode = gcode_list_[curr_gcode_num_];
     assert(curr_gcode);
@@ -602,53 +1023,14 @@ void GCodeRunner::_state_current_node_initing() {
 
         // 根据增量/绝对模式给出 机床坐标系目标位置
         move::axis_t mach_target_pos{0.0};
-        const auto &cmd_values = g00_gcode->cmd_values();
-        if (g00_gcode->coord_mode() == GCodeCoordinateMode::IncrementMode) {
-            // inc
-            mach_target_pos = mach_start_pos;
-            for (std::size_t i = 0; i < EDM_AXIS_NUM; ++i) {
-                if (cmd_values[i]) {
-                    mach_target_pos[i] +=
-                        util::UnitConverter::mm2blu(*(cmd_values[i]));
-                }
-            }
-        } else {
-            // abs, 目前只有工件坐标系模式, 没有机床坐标系模式
-            uint32_t coord_index = g00_gcode->coord_index();
-
-            // 先将输入的机床坐标起点转化为坐标系坐标起点
-            move::axis_t coord_start_pos;
-            bool ret1 = shared_core_data_->get_coord_system()
-                            ->get_cm()
-                            .machine_to_coord(coord_index, mach_start_pos,
-                                              coord_start_pos);
-            if (!ret1) {
-                _abort(EDM_FMT::format("abort: g00 machine_to_coord failed: {}",
-                                       coord_index));
-                break;
-            }
-
-            // 根据cmd_values设定coord_target_pos
-            move::axis_t coord_target_pos;
-            for (std::size_t i = 0; i < coord::Coordinate::Size; ++i) {
-                if (cmd_values[i]) {
-                    coord_target_pos[i] =
-                        util::UnitConverter::mm2blu(*(cmd_values[i]));
-                } else {
-                    coord_target_pos[i] = coord_start_pos[i];
-                }
-            }
-
-            // 再转化为 MachTargetPos
-            bool ret2 = shared_core_data_->get_coord_system()
-                            ->get_cm()
-                            .coord_to_machine(coord_index, coord_target_pos,
-                                              mach_target_pos);
-            if (!ret2) {
-                _abort(EDM_FMT::format("abort: g00 coord_to_machine failed: {}",
-                                       coord_index));
-                break;
-            }
+        std::string calc_err_str;
+        if (!TaskHelper::CalcMachTargetPos(
+                shared_core_data_->get_coord_system()->get_cm(),
+                g00_gcode->coord_mode(), g00_gcode->coord_index(),
+                g00_gcode->cmd_values(), mach_start_pos, mach_target_pos,
+                calc_err_str)) {
+            _abort(EDM_FMT::format("abort: g00 {}", calc_err_str));
+            break;
         }
 
         if (move::MotionUtils::IsAxisTheSame(mach_start_pos, mach_target_pos)) {
@@ -754,6 +1136,9 @@ void GCodeRunner::_state_current_node_initing() {
 
         _switch_to_state(State::Running);
 
+        queued_end_motor_pos_ = motor_target_pos;
+        _queue_next_blocks();
+
         break;
     }
     case GCodeTaskType::G01MotionCommand: {
@@ -780,53 +1165,14 @@ void GCodeRunner::_state_current_node_initing() {
 
         // 根据增量/绝对模式给出 机床坐标系目标位置
         move::axis_t mach_target_pos{0.0};
-        const auto &cmd_values = g01_gcode->cmd_values();
-        if (g01_gcode->coord_mode() == GCodeCoordinateMode::IncrementMode) {
-            // inc
-            mach_target_pos = mach_start_pos;
-            for (std::size_t i = 0; i < EDM_AXIS_NUM; ++i) {
-                if (cmd_values[i]) {
-                    mach_target_pos[i] +=
-                        util::UnitConverter::mm2blu(*(cmd_values[i]));
-                }
-            }
-        } else {
-            // abs, 目前只有工件坐标系模式, 没有机床坐标系模式
-            uint32_t coord_index = g01_gcode->coord_index();
-
-            // 先将输入的机床坐标起点转化为坐标系坐标起点
-            move::axis_t coord_start_pos;
-            bool ret1 = shared_core_data_->get_coord_system()
-                            ->get_cm()
-                            .machine_to_coord(coord_index, mach_start_pos,
-                                              coord_start_pos);
-            if (!ret1) {
-                _abort(EDM_FMT::format("abort: g01 machine_to_coord failed: {}",
-                                       coord_index));
-                break;
-            }
-
-            // 根据cmd_values设定coord_target_pos
-            move::axis_t coord_target_pos;
-            for (std::size_t i = 0; i < coord::Coordinate::Size; ++i) {
-                if (cmd_values[i]) {
-                    coord_target_pos[i] =
-                        util::UnitConverter::mm2blu(*(cmd_values[i]));
-                } else {
-                    coord_target_pos[i] = coord_start_pos[i];
-                }
-            }
-
-            // 再转化为 MachTargetPos
-            bool ret2 = shared_core_data_->get_coord_system()
-                            ->get_cm()
-                            .coord_to_machine(coord_index, coord_target_pos,
-                                              mach_target_pos);
-            if (!ret2) {
-                _abort(EDM_FMT::format("abort: g01 coord_to_machine failed: {}",
-                                       coord_index));
-                break;
-            }
+        std::string calc_err_str;
+        if (!TaskHelper::CalcMachTargetPos(
+                shared_core_data_->get_coord_system()->get_cm(),
+                g01_gcode->coord_mode(), g01_gcode->coord_index(),
+                g01_gcode->cmd_values(), mach_start_pos, mach_target_pos,
+                calc_err_str)) {
+            _abort(EDM_FMT::format("abort: g01 {}", calc_err_str));
+            break;
         }
 
         if (move::MotionUtils::IsAxisTheSame(mach_start_pos, mach_target_pos)) {
@@ -874,6 +1220,9 @@ void GCodeRunner::_state_current_node_initing() {
 
         s_loglist->trace("GCodeRunner G01 Started");
 
+        queued_end_motor_pos_ = motor_target_pos;
+        _queue_next_blocks();
+
         break;
     }
     case GCodeTaskType::DelayCommand: {
@@ -892,6 +1241,9 @@ void GCodeRunner::_state_current_node_initing() {
         }
 
         _switch_to_state(State::Running);
+
+        queued_end_motor_pos_ = local_info_cache_.curr_cmd_axis_blu;
+        _queue_next_blocks();
         break;
     }
     case GCodeTaskType::PauseCommand: {
@@ -1116,6 +1468,14 @@ void GCodeRunner::_state_running() {
             local_info_cache_.sub_line_number);
     }
 
+    // 运动线程已接续执行到缓冲中的块
+    if (!queued_blocks_.empty()) {
+        if (!_sync_queued_blocks()) {
+            return;
+        }
+        curr_gcode = gcode_list_[curr_gcode_num_];
+    }
+
     // Motion GCode, 此处进行状态轮训, 转换状态
     switch (local_info_cache_.main_mode) {
     case move::MotionMainMode::Auto: {
@@ -1125,6 +1485,9 @@ void GCodeRunner::_state_running() {
             delay_pause_flag_ = false;
             emit sig_auto_paused();
             break;
+        case move::MotionAutoState::NormalMoving:
+            _queue_next_blocks();
+            break;
         default:
             break;
         }
@@ -1132,6 +1495,11 @@ void GCodeRunner::_state_running() {
     }
     case move::MotionMainMode::Idle: {
         // 表明当前gcode执行完毕, 与AutoStopped都可
+        last_motion_over_time_ = std::chrono::steady_clock::now();
+        last_motion_over_valid_ = true;
+
+        // 缓冲中未执行的块 (接续失败), 之后照常逐个启动
+        _clear_queued_blocks();
 
         //! 检查G00接触感知报警
         if (curr_gcode->type() == GCodeTaskType::G00MotionCommand) {
@@ -1272,6 +1640,11 @@ void GCodeRunner::_state_running_non_motion(GCodeTaskBase::ptr curr_gcode) {
 }
 
 void GCodeRunner::_state_waiting_for_paused() {
+    // 运动线程可能已接续到缓冲中的块, 先同步当前node
+    if (!queued_blocks_.empty() && !_sync_queued_blocks()) {
+        return;
+    }
+
     auto curr_gcode = gcode_list_[curr_gcode_num_];
     assert(curr_gcode->is_motion_task());
 
@@ -1308,6 +1681,10 @@ void GCodeRunner::_state_waiting_for_paused() {
 }
 
 void GCodeRunner::_state_waiting_for_resumed() {
+    if (!queued_blocks_.empty() && !_sync_queued_blocks()) {
+        return;
+    }
+
     auto curr_gcode = gcode_list_[curr_gcode_num_];
     assert(curr_gcode->is_motion_task());
 
@@ -1359,6 +1736,10 @@ void GCodeRunner::_state_waiting_for_resumed() {
 
 void GCodeRunner::_state_waiting_for_stopped() {
     // 这里意味着这是外界用户人为输入了停止命令, 结束整个G代码
+    if (!queued_blocks_.empty() && !_sync_queued_blocks()) {
+        return;
+    }
+
     auto curr_gcode = gcode_list_[curr_gcode_num_];
     assert(curr_gcode->is_motion_task());
 
@@ -1464,7 +1845,29 @@ void GCodeRunner::_switch_to_state(State new_state) {
         update_timer_->setInterval(update_timer_regular_peroid_ms_);
     }
 
+    // 运动块被运动线程接收, 统计与上一个运动块结束之间的空闲时间
+    if (state_ == State::CurrentNodeIniting && new_state == State::Running) {
+        auto curr_gcode = _current_gcode();
+        if (curr_gcode && curr_gcode->is_motion_task() &&
+            last_motion_over_valid_) {
+            auto gap = std::chrono::steady_clock::now() - last_motion_over_time_;
+            ++block_gap_stat_.count;
+            block_gap_stat_.total += gap;
+            block_gap_stat_.max = std::max(block_gap_stat_.max, gap);
+            last_motion_over_valid_ = false;
+        }
+    }
+
     state_ = new_state;
+
+    // 不需要等待运动线程的状态, 立即推进, 不等定时器
+    auto curr_gcode = _current_gcode();
+    if (new_state == State::ReadyToStart ||
+        new_state == State::CurrentNodeIniting ||
+        (new_state == State::Running && curr_gcode &&
+         !curr_gcode->is_motion_task())) {
+        _schedule_run_once();
+    }
 }
 
 } // namespace task
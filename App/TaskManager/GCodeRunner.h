@@ -2,6 +2,7 @@
 
 #include "GCodeTask.h"
 #include "GCodeTaskConverter.h"
+#include "GCodeProgramStream.h"
 
 #include "TaskHelper.h"
 
@@ -12,6 +13,10 @@
 #include <QObject>
 #include <QTimer>
 #include <chrono>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace edm
 {
@@ -30,6 +35,8 @@ public:
     bool is_over() const { return state_ == State::Stopped; }
 
     bool start(const std::vector<GCodeTaskBase::ptr> &gcode_list);
+    // 流水线启动: 程序流中已有的任务即可开始加工, 其余的边加工边取
+    bool start(GCodeProgramStream::ptr program_stream);
     bool pause();
     bool resume();
     bool stop();
@@ -44,6 +51,9 @@ public:
     int current_gcode_num() const { return curr_gcode_num_; }
     int total_gcode_num() const { return gcode_list_.size(); }
 
+    // 最近一次加工的任务列表 (含各node计时), 用于与预估对比
+    const auto &gcode_list() const { return gcode_list_; }
+
     auto current_node_elapsed_time() const {
         if (curr_gcode_num_ < gcode_list_.size()) {
             auto curr_gcode = gcode_list_[curr_gcode_num_];
@@ -61,6 +71,17 @@ public:
 
     std::vector<std::string> get_time_report() const;
 
+    // 块间空闲时间统计: 上一个运动块结束被检测到, 到下一个运动块被运动线程接收
+    // 块间间隔依赖运动线程与EtherCAT, 无法在 tests/ 中单独做基准测试,
+    // 因此在实际加工中统计: 每次加工结束写入日志, 并附在时间报告末尾
+    struct BlockGapStat {
+        std::size_t count{0};
+        std::chrono::steady_clock::duration total{0};
+        std::chrono::steady_clock::duration max{0};
+        std::size_t chained{0}; // 由运动块缓冲接续的块数 (没有空闲)
+    };
+    const auto &block_gap_stat() const { return block_gap_stat_; }
+
 signals:
     void sig_auto_started();
     void sig_auto_paused();
@@ -87,19 +108,52 @@ private:
 #endif
 
 private: 
-    // 定时器触发, 或任意命令触发, 或任意信号到达也触发, 状态机完全由轮询状态完成, 不依赖信号
+    // 由InfoDispatcher的运动信号驱动, 状态可以立即推进时在同一轮事件循环中连续运行;
+    // 定时器只作为看门狗. 状态机完全由轮询状态完成, 不依赖信号的内容
     void _run_once();
+    void _run_state_machine_once();
+
+    // 状态可以立即推进: 在 _run_once 中则本轮继续运行, 否则投递到事件循环
+    void _schedule_run_once();
 
     bool _check_gcode_list_at_first();
+    // 检查 gcode_list_ 中从 first 开始的任务 (电参数号, 坐标系号)
+    bool _check_gcode_tasks(std::size_t first);
+
+    // 流水线模式: 从程序流取新的任务并检查, 出错时中止并返回false
+    bool _fetch_program_stream();
+    // 流水线模式: 当前node尚未解析出来时调用, 可以继续返回true;
+    // 仍在解析返回false (定时器稍后重试); 解析出错或程序流结束则中止
+    bool _wait_for_program_stream();
+
+    // 当前node, 流水线模式下等待后续任务时为空
+    GCodeTaskBase::ptr _current_gcode() const {
+        return curr_gcode_num_ < gcode_list_.size() ? gcode_list_[curr_gcode_num_]
+                                                    : nullptr;
+    }
 
     void _abort(std::string_view error_str);
     void _end(); // 正常结束
 
     void _check_to_next_gcode();
 
+    // 运动块缓冲: 当前运动块运行中, 把紧随其后的简单运动块
+    // (无接触感知的G00, G01, G04) 算好目标位置预先提交给运动线程,
+    // 由运动线程在当前块结束时直接接续; 遇到其他node即停止预提交
+    void _queue_next_blocks();
+    // node -> 运动块, motor_pos 输入块起点, 输出块终点;
+    // 不能放入缓冲 (或出错, 交给正常启动流程处理) 返回false
+    bool _make_auto_block(int gcode_num, move::axis_t &motor_pos,
+                          move::AutoBlock &block) const;
+    // 根据info中的块号, 结束运动线程已执行完的node; 出错中止时返回false
+    bool _sync_queued_blocks();
+    void _clear_queued_blocks();
+
     // 重置状态
     void _reset_state();
 
+    void _log_block_gap_stat() const;
+
     void _init_help_connections();
 
 private:
@@ -142,6 +196,12 @@ private:
     std::vector<GCodeTaskBase::ptr> gcode_list_;
     int curr_gcode_num_{0};
 
+    // 流水线模式的程序流, 全部取完后置空
+    GCodeProgramStream::ptr program_stream_;
+    std::string program_stream_error_str_; // 程序流解析出错
+    // 已取到的任务中, 未执行的少于此数时再从程序流取
+    static constexpr std::size_t program_stream_low_water_ = 256;
+
     std::chrono::system_clock::duration total_elapsed_time_{0};
 
     std::string last_error_str_;
@@ -149,6 +209,24 @@ private:
     // solve pause fail.
     bool delay_pause_flag_ {false}; // 延迟暂停(下一个状态暂停)
 
+    bool in_run_once_{false};      // 防止重入 (等待命令接收时会处理事件)
+    bool run_again_flag_{false};   // 本轮 _run_once 需要再运行一次
+    bool run_once_queued_{false};  // 已投递到事件循环
+    // 一轮事件循环中最多连续推进的次数, 避免大量非运动块阻塞GUI
+    static constexpr int max_steps_per_turn_ = 64;
+
+    // 运动块缓冲: 已提交给运动线程但还未开始执行的node序号,
+    // 及最后一个块的终点 (电机坐标), 下一个块从这里算起
+    std::deque<int> queued_blocks_;
+    move::axis_t queued_end_motor_pos_{0.0};
+    static constexpr std::size_t max_queued_blocks_ = 8;
+    static_assert(max_queued_blocks_ <= move::AutoBlockFifoCapacity);
+
+    // 块间空闲时间
+    BlockGapStat block_gap_stat_;
+    std::chrono::steady_clock::time_point last_motion_over_time_;
+    bool last_motion_over_valid_{false};
+
     // 记录时间
 };
 
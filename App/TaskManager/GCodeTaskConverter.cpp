@@ -578,6 +578,220 @@ GCodeTaskConverter::MakeGCodeTaskListFromJson(const json::value &j) {
     return gcode_task_list;
 }
 
+static std::vector<std::optional<double>>
+_record_coords(const double *coords, uint32_t axis_mask) {
+    std::vector<std::optional<double>> values;
+    values.resize(6);
+    for (std::size_t i = 0; i < 6; ++i) {
+        if (axis_mask & (1u << i)) {
+            values[i] = coords[i];
+        }
+    }
+    return values;
+}
+
+static std::optional<GCodeCoordinateMode> _record_coord_mode(int32_t mode) {
+    switch (mode) {
+    case static_cast<int32_t>(GCodeCoordinateMode::AbsoluteMode):
+        return GCodeCoordinateMode::AbsoluteMode;
+    case static_cast<int32_t>(GCodeCoordinateMode::IncrementMode):
+        return GCodeCoordinateMode::IncrementMode;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<GCodeTaskBase::ptr> GCodeTaskConverter::_MakeGCodeTaskFromRecord(
+    const interpreter::RS274CommandRecords &records,
+    const interpreter::RS274CommandRecord &r) {
+    using namespace interpreter;
+
+    std::optional<GCodeTaskBase::ptr> make_ret{std::nullopt};
+
+    switch (static_cast<GCodeTaskType>(r.type)) {
+    case GCodeTaskType::G00MotionCommand: {
+        auto coord_mode = _record_coord_mode(r.coord_mode);
+        if (!coord_mode) {
+            s_logger->error("GCodeTaskConverter record g00: CoordinateMode err: {}",
+                            r.coord_mode);
+            return std::nullopt;
+        }
+
+        make_ret = std::make_shared<GCodeTaskG00Motion>(
+            !(r.flags & RecordFlagM05IgnoreTouchDetect),
+            static_cast<bool>(r.flags & RecordFlagG00Touch), r.feed_speed,
+            r.coord_index, *coord_mode, _record_coords(r.coords, r.axis_mask),
+            r.line_number, -1);
+        break;
+    }
+
+    case GCodeTaskType::G01MotionCommand: {
+        auto coord_mode = _record_coord_mode(r.coord_mode);
+        if (!coord_mode) {
+            s_logger->error("GCodeTaskConverter record g01: CoordinateMode err: {}",
+                            r.coord_mode);
+            return std::nullopt;
+        }
+
+        make_ret = std::make_shared<GCodeTaskG01Motion>(
+            r.coord_index, *coord_mode, _record_coords(r.coords, r.axis_mask),
+            r.line_number, -1);
+        break;
+    }
+
+    case GCodeTaskType::CoordinateIndexCommand:
+        make_ret = std::make_shared<GCodeTaskCoordinateIndex>(
+            r.coord_index, r.line_number, -1);
+        break;
+
+    case GCodeTaskType::EleparamSetCommand:
+        make_ret = std::make_shared<GCodeTaskEleparamSet>(r.int_value,
+                                                          r.line_number, -1);
+        break;
+
+    case GCodeTaskType::DelayCommand:
+        make_ret =
+            std::make_shared<GCodeTaskDeley>(r.real_value, r.line_number, -1);
+        break;
+
+    case GCodeTaskType::ProgramEndCommand:
+        make_ret = std::make_shared<GCodeTaskProgramEnd>(r.line_number, -1);
+        break;
+
+    case GCodeTaskType::PauseCommand:
+        make_ret = std::make_shared<GCodeTaskPauseCommand>(r.line_number, -1);
+        break;
+
+    case GCodeTaskType::CoordSetZeroCommand: {
+        std::vector<bool> set_zero_axis_list(6);
+        for (std::size_t i = 0; i < 6; ++i) {
+            set_zero_axis_list[i] = r.axis_mask & (1u << i);
+        }
+
+        make_ret = std::make_shared<GCodeTaskCoordSetZeroCommand>(
+            set_zero_axis_list, r.line_number, -1);
+        break;
+    }
+
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    // 不是小孔时, 忽略此条
+    case GCodeTaskType::DrillMotionCommand: {
+        move::DrillStartParams start_params;
+
+        start_params.depth_um = util::UnitConverter::mm2um(r.real_value);
+        start_params.holdtime_ms = r.int_value;
+        start_params.touch = r.flags & RecordFlagDrillTouch;
+        start_params.breakout = r.flags & RecordFlagDrillBreakout;
+        start_params.back = r.flags & RecordFlagDrillBack;
+
+        if (r.flags & RecordFlagHasSpindleSpeed) {
+            start_params.spindle_speed_blu_ms_opt = r.real_value2;
+        } else {
+            start_params.spindle_speed_blu_ms_opt = std::nullopt;
+        }
+
+        make_ret = std::make_shared<GCodeTaskDrillMotion>(start_params,
+                                                          r.line_number, -1);
+        break;
+    }
+#endif
+
+    case GCodeTaskType::G01GroupMotionCommand: {
+        if (static_cast<std::size_t>(r.point_first) + r.point_count >
+            records.points.size()) {
+            s_logger->error("GCodeTaskConverter record g01_group: points out "
+                            "of range, {} + {} > {}",
+                            r.point_first, r.point_count, records.points.size());
+            return std::nullopt;
+        }
+
+        std::vector<GCodeTaskG01GroupMotion::G01GroupPoint> point_vec;
+        point_vec.reserve(r.point_count);
+
+        for (uint32_t i = 0; i < r.point_count; ++i) {
+            const auto &p = records.points[r.point_first + i];
+
+            auto coord_mode = _record_coord_mode(p.coord_mode);
+            if (!coord_mode) {
+                s_logger->error(
+                    "GCodeTaskConverter record g01_group: CoordinateMode err: {}",
+                    p.coord_mode);
+                return std::nullopt;
+            }
+
+            GCodeTaskG01GroupMotion::G01GroupPoint point;
+            point.coord_mode = *coord_mode;
+            point.line_number = p.line_number;
+            point.cmd_values = _record_coords(p.coords, p.axis_mask);
+            point.feedrate = p.feed_speed;
+
+            point_vec.push_back(std::move(point));
+        }
+
+        make_ret = std::make_shared<GCodeTaskG01GroupMotion>(
+            r.coord_index, point_vec, r.line_number, -1);
+        break;
+    }
+
+    //! 以下命令虽然构造, 但是实际无操作
+    case GCodeTaskType::CoordinateModeCommand:
+        make_ret = std::make_shared<GCodeTaskCoordinateMode>(r.line_number, -1);
+        break;
+
+    case GCodeTaskType::FeedSpeedSetCommand:
+        make_ret = std::make_shared<GCodeTaskFeedSpeedSet>(r.line_number, -1);
+        break;
+
+    case GCodeTaskType::Undefined:
+        s_logger->error("GCodeTaskConverter: type is undefined.");
+        return std::nullopt; // failed
+
+    default:
+        s_logger->warn("Ignore task: {}", r.type);
+        return nullptr; // ignored
+    }
+
+    if (r.str_size > 0) {
+        (*make_ret)->set_gcode_str(
+            std::string{records.str(r.str_offset, r.str_size)});
+    }
+
+    if (r.flags & RecordFlagHasOptions) {
+        (*make_ret)->set_options(records.options(r));
+    }
+
+    return make_ret;
+}
+
+std::optional<std::vector<GCodeTaskBase::ptr>>
+GCodeTaskConverter::MakeGCodeTaskListFromRecords(
+    const interpreter::RS274CommandRecords &records) {
+
+    if (records.commands.empty()) {
+        s_logger->error("MakeGCodeTaskListFromRecords: records is empty");
+        return std::nullopt;
+    }
+
+    std::vector<GCodeTaskBase::ptr> gcode_task_list;
+    gcode_task_list.reserve(records.commands.size());
+
+    for (std::size_t i = 0; i < records.commands.size(); ++i) {
+        auto ret = _MakeGCodeTaskFromRecord(records, records.commands[i]);
+        if (!ret) {
+            s_logger->error(
+                "MakeGCodeTaskListFromRecords: process record[{}] failed", i);
+            return std::nullopt;
+        }
+
+        if (*ret) {
+            // not ignored (not nullptr)
+            gcode_task_list.push_back(std::move(*ret));
+        }
+    }
+
+    return gcode_task_list;
+}
+
 } // namespace task
 
 } // namespace edm
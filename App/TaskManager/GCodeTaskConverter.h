@@ -5,6 +5,8 @@
 #include <memory>
 #include <json.hpp>
 
+#include "Interpreter/rs274pyInterpreter/RS274CommandRecord.h"
+
 #include <optional>
 
 namespace edm
@@ -21,6 +23,15 @@ private:
 
 public:
     static std::optional<std::vector<GCodeTaskBase::ptr>> MakeGCodeTaskListFromJson(const json::value& j);
+
+    // 从解释器输出的二进制记录直接生成, 不经过json
+    static std::optional<std::vector<GCodeTaskBase::ptr>>
+    MakeGCodeTaskListFromRecords(const interpreter::RS274CommandRecords &records);
+
+private:
+    static std::optional<GCodeTaskBase::ptr>
+    _MakeGCodeTaskFromRecord(const interpreter::RS274CommandRecords &records,
+                             const interpreter::RS274CommandRecord &r);
 };
 
 } // namespace task
@@ -0,0 +1,371 @@
+#include "GCodeTimeEstimator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+
+#include "GCodeTask.h"
+#include "TaskHelper.h"
+
+#include "Motion/MotionUtils/MotionUtils.h"
+#include "Motion/Moveruntime/Moveruntime.h"
+#include "SystemSettings/SystemSettings.h"
+#include "Utils/Format/edm_format.h"
+#include "Utils/UnitConverter/UnitConverter.h"
+
+namespace edm {
+
+namespace task {
+
+static const char *_type_str(GCodeTaskType type) {
+    switch (type) {
+    case GCodeTaskType::G00MotionCommand:
+        return "G00";
+    case GCodeTaskType::G01MotionCommand:
+        return "G01";
+    case GCodeTaskType::G01GroupMotionCommand:
+        return "G01Group";
+    case GCodeTaskType::DelayCommand:
+        return "G04";
+    default:
+        return "-";
+    }
+}
+
+// 秒 -> "hh:mm:ss"
+static std::string _hms_str(double seconds) {
+    auto s = static_cast<long long>(std::llround(seconds));
+    return EDM_FMT::format("{:02}:{:02}:{:02}", s / 3600, (s / 60) % 60,
+                           s % 60);
+}
+
+std::vector<std::pair<int, double>> GCodeTimeEstimate::per_line() const {
+    std::map<int, double> line_map;
+    for (const auto &item : items) {
+        line_map[item.line_number] += item.seconds;
+    }
+
+    return {line_map.begin(), line_map.end()};
+}
+
+std::vector<const GCodeTimeEstimate::Item *>
+GCodeTimeEstimate::slowest(std::size_t n) const {
+    std::vector<const Item *> ptrs;
+    ptrs.reserve(items.size());
+    for (const auto &item : items) {
+        ptrs.push_back(&item);
+    }
+
+    n = std::min(n, ptrs.size());
+    std::partial_sort(
+        ptrs.begin(), ptrs.begin() + n, ptrs.end(),
+        [](const Item *a, const Item *b) { return a->seconds > b->seconds; });
+    ptrs.resize(n);
+    return ptrs;
+}
+
+std::vector<std::string> GCodeTimeEstimate::report(std::size_t slowest_n) const {
+    std::vector<std::string> str_vec;
+
+    str_vec.push_back(EDM_FMT::format(
+        "estimate total: {} ({:.1f} s), G00 {:.1f} s, G04 {:.1f} s, "
+        "G01 {:.1f} s ({:.3f} mm at nominal feed {} mm/min)",
+        _hms_str(total_s), total_s, g00_s, g04_s, g01_s, g01_length_mm,
+        g01_feed_mm_min));
+
+    if (unknown_count > 0) {
+        str_vec.push_back(EDM_FMT::format(
+            "not estimated (drill, M00): {} nodes", unknown_count));
+    }
+    if (error_count > 0) {
+        str_vec.push_back(EDM_FMT::format(
+            "target calc failed (will abort when run): {} nodes", error_count));
+    }
+
+    str_vec.push_back("slowest blocks (* = nominal):");
+    for (const auto *item : slowest(slowest_n)) {
+        str_vec.push_back(EDM_FMT::format(
+            "[{:8.1f}s]{} line: {}, {}, {:.3f} mm", item->seconds,
+            item->nominal ? "*" : " ", item->line_number,
+            _type_str(item->type), item->length_mm));
+    }
+
+    return str_vec;
+}
+
+std::vector<std::string>
+GCodeTimeEstimate::compare(const std::vector<GCodeTaskBase::ptr> &measured_list,
+                           std::size_t top_n,
+                           double *measured_g01_feed_mm_min) const {
+    // 预估按node汇总 (G01组各段合并到组)
+    std::map<int, double> predicted_map;
+    std::map<int, double> g01_length_map;
+    for (const auto &item : items) {
+        predicted_map[item.gcode_num] += item.seconds;
+        if (item.type == GCodeTaskType::G01MotionCommand ||
+            item.type == GCodeTaskType::G01GroupMotionCommand) {
+            g01_length_map[item.gcode_num] += item.length_mm;
+        }
+    }
+
+    struct Row {
+        int gcode_num;
+        double predicted;
+        double measured;
+    };
+    std::vector<Row> rows;
+
+    double predicted_sum = 0.0, measured_sum = 0.0;
+    double g01_measured_s = 0.0, g01_measured_mm = 0.0;
+    for (std::size_t i = 0; i < measured_list.size(); ++i) {
+        const auto &gcode = measured_list[i];
+        if (gcode->timer().state() != TaskTimer::State::Stopped) {
+            continue; // 没执行完的
+        }
+
+        const double measured =
+            std::chrono::duration<double>(gcode->timer().elapsed_time())
+                .count();
+        auto it = predicted_map.find(static_cast<int>(i));
+        const double predicted = it == predicted_map.end() ? 0.0 : it->second;
+
+        predicted_sum += predicted;
+        measured_sum += measured;
+
+        auto lit = g01_length_map.find(static_cast<int>(i));
+        if (lit != g01_length_map.end()) {
+            g01_measured_s += measured;
+            g01_measured_mm += lit->second;
+        }
+
+        rows.push_back({static_cast<int>(i), predicted, measured});
+    }
+
+    std::vector<std::string> str_vec;
+    str_vec.push_back(EDM_FMT::format(
+        "estimate vs measured ({} nodes done): predicted {} ({:.1f} s), "
+        "measured {} ({:.1f} s)",
+        rows.size(), _hms_str(predicted_sum), predicted_sum,
+        _hms_str(measured_sum), measured_sum));
+
+    const double g01_measured_feed =
+        g01_measured_s > 0.0 ? g01_measured_mm / g01_measured_s * 60.0 : 0.0;
+    if (measured_g01_feed_mm_min) {
+        *measured_g01_feed_mm_min = g01_measured_feed;
+    }
+
+    if (g01_measured_s > 0.0) {
+        str_vec.push_back(EDM_FMT::format(
+            "G01 measured avg feed: {:.3f} mm/min (nominal {} mm/min)",
+            g01_measured_feed, g01_feed_mm_min));
+    }
+
+    top_n = std::min(top_n, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + top_n, rows.end(),
+                      [](const Row &a, const Row &b) {
+                          return std::abs(a.measured - a.predicted) >
+                                 std::abs(b.measured - b.predicted);
+                      });
+
+    str_vec.push_back("largest differences:");
+    for (std::size_t i = 0; i < top_n; ++i) {
+        const auto &r = rows[i];
+        const auto &gcode = measured_list[r.gcode_num];
+        str_vec.push_back(EDM_FMT::format(
+            "[{:+8.1f}s] line: {}, predicted {:.1f} s, measured {:.1f} s, "
+            "code: {}",
+            r.measured - r.predicted, gcode->line_number(), r.predicted,
+            r.measured, gcode->get_gcode_str()));
+    }
+
+    return str_vec;
+}
+
+GCodeTimeEstimate::ptr
+GCodeTimeEstimator::Estimate(const std::vector<GCodeTaskBase::ptr> &gcode_list,
+                             coord::CoordinateSystem::ptr coord_system,
+                             const Options &options) {
+    auto est = std::make_shared<GCodeTimeEstimate>();
+    est->g01_feed_mm_min = options.g01_feed_mm_min;
+
+    // 坐标系的本地副本: 程序中的置零只修改副本, 不影响实际坐标系
+    coord::CoordinateManager cm;
+    cm.set_global_offset(coord_system->get_cm().get_global_offset());
+    auto coordinates_map = coord_system->get_cm().get_coordinates_map();
+    cm.set_coordinates_map(std::move(coordinates_map));
+    int curr_coord_index =
+        static_cast<int>(coord_system->get_current_coord_index());
+
+    const double cycle_s =
+        SystemSettings::instance().get_motion_cycle_us() / 1000000.0;
+    const double g01_feed_blu_s =
+        util::UnitConverter::mm_min2blu_s(options.g01_feed_mm_min);
+
+    // 虚拟的当前位置 (电机坐标)
+    move::axis_t motor_pos = options.start_motor_pos;
+
+    // 计算目标位置 (电机坐标), 失败返回false
+    auto f_calc_target = [&](GCodeCoordinateMode coord_mode, int coord_index,
+                             const std::vector<std::optional<double>> &values,
+                             move::axis_t &motor_target) -> bool {
+        move::axis_t mach_start_pos, mach_target_pos;
+        cm.motor_to_machine(motor_pos, mach_start_pos);
+
+        std::string err_str;
+        if (!TaskHelper::CalcMachTargetPos(cm, coord_mode, coord_index, values,
+                                           mach_start_pos, mach_target_pos,
+                                           err_str)) {
+            return false;
+        }
+
+        return cm.machine_to_motor(mach_target_pos, motor_target);
+    };
+
+    // G01 段: 按名义进给速度
+    auto f_add_g01 = [&](int gcode_num, int line_number, GCodeTaskType type,
+                         const move::axis_t &motor_target) {
+        const auto length_blu =
+            move::MotionUtils::CalcAxisLength(motor_pos, motor_target);
+
+        GCodeTimeEstimate::Item item;
+        item.gcode_num = gcode_num;
+        item.line_number = line_number;
+        item.type = type;
+        item.length_mm = util::UnitConverter::blu2mm(length_blu);
+        item.seconds = g01_feed_blu_s > 0.0 ? length_blu / g01_feed_blu_s : 0.0;
+        item.nominal = true;
+
+        est->g01_s += item.seconds;
+        est->g01_length_mm += item.length_mm;
+        est->items.push_back(item);
+
+        motor_pos = motor_target;
+    };
+
+    move::Moveruntime mrt;
+
+    for (std::size_t i = 0; i < gcode_list.size(); ++i) {
+        const auto &gcode = gcode_list[i];
+        const int gcode_num = static_cast<int>(i);
+
+        switch (gcode->type()) {
+        case GCodeTaskType::G00MotionCommand: {
+            auto g00_gcode =
+                std::static_pointer_cast<GCodeTaskG00Motion>(gcode);
+
+            move::axis_t motor_target;
+            if (!f_calc_target(g00_gcode->coord_mode(),
+                               g00_gcode->coord_index(),
+                               g00_gcode->cmd_values(), motor_target)) {
+                ++est->error_count;
+                break;
+            }
+
+            const auto length_blu =
+                move::MotionUtils::CalcAxisLength(motor_pos, motor_target);
+
+            auto speed = TaskHelper::GetDefaultSpeedparam();
+            speed.cruise_v =
+                util::UnitConverter::mm_min2blu_s(g00_gcode->feed_speed());
+            if (speed.cruise_v <= 0.0)
+                speed.cruise_v = 1.0; // 与 GCodeRunner 一致
+
+            GCodeTimeEstimate::Item item;
+            item.gcode_num = gcode_num;
+            item.line_number = gcode->line_number();
+            item.type = gcode->type();
+            item.length_mm = util::UnitConverter::blu2mm(length_blu);
+            if (length_blu > 0.0 && mrt.plan(speed, length_blu)) {
+                item.seconds = mrt.get_planned_cycles() * cycle_s;
+            }
+            // 碰边动作碰到即停, 按走完全程估计
+            item.nominal = g00_gcode->is_touch_motion();
+
+            est->g00_s += item.seconds;
+            est->items.push_back(item);
+
+            motor_pos = motor_target;
+            break;
+        }
+        case GCodeTaskType::G01MotionCommand: {
+            auto g01_gcode =
+                std::static_pointer_cast<GCodeTaskG01Motion>(gcode);
+
+            move::axis_t motor_target;
+            if (!f_calc_target(g01_gcode->coord_mode(),
+                               g01_gcode->coord_index(),
+                               g01_gcode->cmd_values(), motor_target)) {
+                ++est->error_count;
+                break;
+            }
+
+            f_add_g01(gcode_num, gcode->line_number(), gcode->type(),
+                      motor_target);
+            break;
+        }
+        case GCodeTaskType::G01GroupMotionCommand: {
+            auto group_gcode =
+                std::static_pointer_cast<GCodeTaskG01GroupMotion>(gcode);
+
+            for (const auto &point : group_gcode->points()) {
+                move::axis_t motor_target;
+                if (!f_calc_target(point.coord_mode,
+                                   group_gcode->coord_index(),
+                                   point.cmd_values, motor_target)) {
+                    ++est->error_count;
+                    break;
+                }
+
+                f_add_g01(gcode_num,
+                          point.line_number >= 0 ? point.line_number
+                                                 : gcode->line_number(),
+                          gcode->type(), motor_target);
+            }
+            break;
+        }
+        case GCodeTaskType::DelayCommand: {
+            auto g04_gcode = std::static_pointer_cast<GCodeTaskDeley>(gcode);
+
+            GCodeTimeEstimate::Item item;
+            item.gcode_num = gcode_num;
+            item.line_number = gcode->line_number();
+            item.type = gcode->type();
+            item.seconds = g04_gcode->delay_s();
+
+            est->g04_s += item.seconds;
+            est->items.push_back(item);
+            break;
+        }
+        case GCodeTaskType::CoordinateIndexCommand: {
+            curr_coord_index =
+                std::static_pointer_cast<GCodeTaskCoordinateIndex>(gcode)
+                    ->coord_index();
+            break;
+        }
+        case GCodeTaskType::CoordSetZeroCommand: {
+            auto csz_gcode =
+                std::static_pointer_cast<GCodeTaskCoordSetZeroCommand>(gcode);
+            if (!TaskHelper::ApplyCoordSetZero(cm, curr_coord_index,
+                                               csz_gcode->set_zero_axis_list(),
+                                               motor_pos)) {
+                ++est->error_count;
+            }
+            break;
+        }
+        case GCodeTaskType::DrillMotionCommand:
+        case GCodeTaskType::PauseCommand:
+            ++est->unknown_count;
+            break;
+        default:
+            break;
+        }
+    }
+
+    est->total_s = est->g00_s + est->g01_s + est->g04_s;
+    return est;
+}
+
+} // namespace task
+
+} // namespace edm
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Coordinate/CoordinateSystem.h"
+#include "GCodeTaskBase.h"
+#include "Motion/MoveDefines.h"
+
+namespace edm {
+
+namespace task {
+
+// 程序预估结果
+struct GCodeTimeEstimate {
+    using ptr = std::shared_ptr<GCodeTimeEstimate>;
+
+    // 一个有耗时的块 (G00/G01/G04, G01组中的每一段)
+    struct Item {
+        int gcode_num{-1};   // node序号
+        int line_number{-1}; // G01组中为各段的行号
+        GCodeTaskType type{GCodeTaskType::Undefined};
+        double seconds{0.0};
+        double length_mm{0.0}; // 运动长度
+        bool nominal{false}; // G01/接触感知G00: 实际时间取决于放电/碰边, 按名义值估计
+    };
+
+    std::vector<Item> items;
+
+    double total_s{0.0};
+    double g00_s{0.0};
+    double g01_s{0.0}; // 按名义进给速度
+    double g04_s{0.0};
+    double g01_length_mm{0.0};
+    double g01_feed_mm_min{0.0}; // 预估使用的G01名义进给速度
+
+    int unknown_count{0}; // 无法估计的node (打孔, M00等)
+    int error_count{0};   // 目标位置计算失败的node (实际运行时会中止)
+
+    // 按行号汇总 (行号, 秒), 按行号升序
+    std::vector<std::pair<int, double>> per_line() const;
+
+    // 最慢的n个块
+    std::vector<const Item *> slowest(std::size_t n) const;
+
+    // 文字报告: 汇总及最慢的块
+    std::vector<std::string> report(std::size_t slowest_n = 20) const;
+
+    // 与实际运行的计时 (TaskTimer) 对比, 按行号汇总,
+    // 列出 实际 - 预估 相差最多的行; 只统计已执行完的node
+    // measured_g01_feed_mm_min: 输出实际的G01平均进给速度, 用于校准名义进给速度
+    // (没有执行完的G01时为0)
+    std::vector<std::string>
+    compare(const std::vector<GCodeTaskBase::ptr> &measured_list,
+            std::size_t top_n = 20,
+            double *measured_g01_feed_mm_min = nullptr) const;
+};
+
+/**
+ * G代码程序离线预估 (dry-run):
+ * 按 GCodeRunner 相同的方式逐个计算各块的目标位置, 用虚拟时钟计时, 不发送任何运动命令.
+ *
+ * - G00 用实际的 Moveruntime 规划器规划, 时间 = 规划周期数 * 运动周期
+ * - G04 为设定的延时
+ * - G01 是伺服放电加工, 速度取决于放电状态, 只能按名义进给速度估计;
+ *   名义进给速度来自 SystemSettings, 实际运行后由对比报告中的平均进给速度校准
+ * - 打孔, M00 等无法估计, 只计数
+ */
+class GCodeTimeEstimator final {
+public:
+    struct Options {
+        move::axis_t start_motor_pos{0.0}; // 起点 (电机坐标, blu)
+        double g01_feed_mm_min{0.5};      // G01 名义进给速度
+    };
+
+    static GCodeTimeEstimate::ptr
+    Estimate(const std::vector<GCodeTaskBase::ptr> &gcode_list,
+             coord::CoordinateSystem::ptr coord_system, const Options &options);
+};
+
+} // namespace task
+
+} // namespace edm
@@ -0,0 +1,452 @@
+#include "IsoGCodeParser.h"
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+
+#include "Logger/LogMacro.h"
+#include "Utils/Format/edm_format.h"
+
+EDM_STATIC_LOGGER_NAME(s_logger, "interp");
+
+namespace edm {
+
+namespace task {
+
+IsoGCodeParseException::IsoGCodeParseException(int line_number,
+                                               std::string_view desc)
+    : line_number_(line_number), desc_(desc) {
+    what_msg_ = EDM_FMT::format("(line {}): {}", line_number_, desc_);
+}
+
+// 一段 (一行) 中的字
+struct IsoGCodeParser::_Block {
+    static constexpr std::size_t MaxCodes = 8;
+
+    std::array<int, MaxCodes> g{};
+    std::size_t g_count{0};
+    std::array<int, MaxCodes> m{};
+    std::size_t m_count{0};
+
+    std::array<std::optional<double>, AxisNum> axis{};
+    std::optional<double> f, e, p, t;
+
+    bool has_g(int code) const {
+        for (std::size_t i = 0; i < g_count; ++i) {
+            if (g[i] == code) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_m(int code) const {
+        for (std::size_t i = 0; i < m_count; ++i) {
+            if (m[i] == code) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_axis() const {
+        for (const auto &a : axis) {
+            if (a) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void IsoGCodeParser::reset() {
+    coord_mode_ = GCodeCoordinateMode::Undefined;
+    coord_index_ = -1;
+    feed_speed_ = -1;
+    motion_mode_ = -1;
+    program_end_ = false;
+}
+
+static std::string_view _trim(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// 解析字的数值, pos 指向字母后一个字符, 返回后指向数值之后
+static std::optional<double> _parse_number(std::string_view line,
+                                           std::size_t &pos) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+        ++pos;
+    }
+
+    auto start = pos;
+    bool neg = false;
+    if (pos < line.size() && (line[pos] == '+' || line[pos] == '-')) {
+        neg = line[pos] == '-';
+        ++pos;
+    }
+
+    // from_chars 不接受 '+' 号
+    double value = 0.0;
+    auto [ptr, ec] =
+        std::from_chars(line.data() + pos, line.data() + line.size(), value,
+                        std::chars_format::fixed);
+    if (ec != std::errc{}) {
+        pos = start;
+        return std::nullopt;
+    }
+
+    pos = ptr - line.data();
+    return neg ? -value : value;
+}
+
+static std::optional<int> _as_int(double v) {
+    auto r = std::round(v);
+    if (std::abs(v - r) > 1e-9) {
+        return std::nullopt;
+    }
+    return static_cast<int>(r);
+}
+
+void IsoGCodeParser::_check_motion_environment(int line_number) const {
+    if (coord_mode_ == GCodeCoordinateMode::Undefined) {
+        throw IsoGCodeParseException(line_number, "CoordinateMode Undefined");
+    }
+
+    if (motion_mode_ < 0) {
+        throw IsoGCodeParseException(line_number, "MotionMode Undefined");
+    }
+
+    if (coord_index_ < 0) {
+        throw IsoGCodeParseException(line_number, "Coordinate Not Set");
+    }
+
+    if (feed_speed_ < 0) {
+        throw IsoGCodeParseException(line_number, "Feed Speed Not Set");
+    }
+}
+
+void IsoGCodeParser::parse_line(std::string_view raw_line, int line_number,
+                                const TaskCallback &cb) {
+    if (program_end_) {
+        return; // M02之后忽略
+    }
+
+    auto line = _trim(raw_line);
+    if (line.empty() || line.front() == '%') {
+        return;
+    }
+
+    _Block block;
+    bool has_word = false;
+
+    auto error = [line_number](std::string_view desc) {
+        throw IsoGCodeParseException(line_number, desc);
+    };
+
+    std::size_t pos = 0;
+    while (pos < line.size()) {
+        char c = line[pos];
+
+        if (c == ' ' || c == '\t' || c == '/') {
+            ++pos;
+            continue;
+        }
+
+        if (c == ';') {
+            break; // 行尾注释
+        }
+
+        if (c == '(') {
+            auto end = line.find(')', pos);
+            if (end == std::string_view::npos) {
+                error("Comment Not Closed");
+            }
+            pos = end + 1;
+            continue;
+        }
+
+        char letter = static_cast<char>(
+            std::toupper(static_cast<unsigned char>(c)));
+        ++pos;
+
+        auto value = _parse_number(line, pos);
+        if (!value) {
+            error(EDM_FMT::format("Word '{}' Value Not Valid", letter));
+        }
+        has_word = true;
+
+        auto set_once = [&](std::optional<double> &dst) {
+            if (dst) {
+                error(EDM_FMT::format("Word '{}' Repeated", letter));
+            }
+            dst = *value;
+        };
+
+        switch (letter) {
+        case 'N':
+            break; // 段号, 忽略
+        case 'G':
+        case 'M': {
+            auto code = _as_int(*value);
+            if (!code) {
+                error(EDM_FMT::format("{}{} Not Supported", letter, *value));
+            }
+
+            auto &codes = letter == 'G' ? block.g : block.m;
+            auto &count = letter == 'G' ? block.g_count : block.m_count;
+            if (count >= codes.size()) {
+                error(EDM_FMT::format("Too Many {} Codes", letter));
+            }
+            codes[count++] = *code;
+            break;
+        }
+        case 'X':
+            set_once(block.axis[0]);
+            break;
+        case 'Y':
+            set_once(block.axis[1]);
+            break;
+        case 'Z':
+            set_once(block.axis[2]);
+            break;
+        case 'B':
+            set_once(block.axis[3]);
+            break;
+        case 'C':
+            set_once(block.axis[4]);
+            break;
+        case 'A':
+            set_once(block.axis[5]);
+            break;
+        case 'F':
+            set_once(block.f);
+            break;
+        case 'E':
+            set_once(block.e);
+            break;
+        case 'P':
+            set_once(block.p);
+            break;
+        case 'T':
+            set_once(block.t);
+            break;
+        default:
+            error(EDM_FMT::format("Word '{}' Not Supported", letter));
+        }
+    }
+
+    if (!has_word) {
+        return;
+    }
+
+    const std::string code_str{line};
+    auto emit_task = [&](GCodeTaskBase::ptr task) {
+        task->set_gcode_str(code_str);
+        cb(std::move(task));
+    };
+
+    // 检查G代码
+    bool dwell = false;
+    for (std::size_t i = 0; i < block.g_count; ++i) {
+        switch (block.g[i]) {
+        case 0:
+        case 1:
+        case 4:
+        case 90:
+        case 91:
+            break;
+        default:
+            if (block.g[i] >= 53 && block.g[i] <= 59) {
+                break;
+            }
+            error(EDM_FMT::format("G{:02d} Not Supported", block.g[i]));
+        }
+    }
+
+    for (std::size_t i = 0; i < block.m_count; ++i) {
+        switch (block.m[i]) {
+        case 0:
+        case 2:
+        case 5:
+        case 30:
+            break;
+        default:
+            error(EDM_FMT::format("M{:02d} Not Supported", block.m[i]));
+        }
+    }
+
+    // 1. 电参数
+    if (block.e) {
+        auto index = _as_int(*block.e);
+        if (!index || *index < 0 || *index >= 1000) {
+            error(EDM_FMT::format("Eleparam Index ({}) Out of Range",
+                                  *block.e));
+        }
+        emit_task(std::make_shared<GCodeTaskEleparamSet>(*index, line_number));
+    }
+
+    // 2. 进给率
+    if (block.f) {
+        auto speed = _as_int(*block.f);
+        if (!speed || *speed <= 0) {
+            error(EDM_FMT::format("Feed Speed Value ({}) Out of Range",
+                                  *block.f));
+        }
+        feed_speed_ = *speed;
+        emit_task(std::make_shared<GCodeTaskFeedSpeedSet>(line_number));
+    }
+
+    // 3. 坐标模式, 坐标系
+    if (block.has_g(90) && block.has_g(91)) {
+        error("G90 and G91 In One Block");
+    }
+    if (block.has_g(90) || block.has_g(91)) {
+        coord_mode_ = block.has_g(90) ? GCodeCoordinateMode::AbsoluteMode
+                                      : GCodeCoordinateMode::IncrementMode;
+        emit_task(std::make_shared<GCodeTaskCoordinateMode>(line_number));
+    }
+
+    for (int index = 53; index <= 59; ++index) {
+        if (block.has_g(index)) {
+            coord_index_ = index;
+            emit_task(
+                std::make_shared<GCodeTaskCoordinateIndex>(index, line_number));
+        }
+    }
+
+    // 4. 运动模式 (模态)
+    if (block.has_g(0) && block.has_g(1)) {
+        error("G00 and G01 In One Block");
+    }
+    if (block.has_g(0)) {
+        motion_mode_ = 0;
+    } else if (block.has_g(1)) {
+        motion_mode_ = 1;
+    }
+
+    // 5. 延时 / 运动
+    if (block.has_g(4)) {
+        dwell = true;
+
+        // G04 X1.5 / G04 T1.5 (秒), G04 P1500 (毫秒)
+        std::optional<double> delay_s;
+        if (block.axis[0]) {
+            delay_s = *block.axis[0];
+            block.axis[0].reset();
+        } else if (block.t) {
+            delay_s = *block.t;
+        } else if (block.p) {
+            delay_s = *block.p / 1000.0;
+        }
+
+        if (!delay_s) {
+            error("G04 Delay Time Not Set");
+        }
+        if (*delay_s < 0) {
+            error(EDM_FMT::format("Delay Time ({}) Out of Range", *delay_s));
+        }
+        if (block.has_axis()) {
+            error("G04 With Axis Words");
+        }
+
+        emit_task(std::make_shared<GCodeTaskDeley>(*delay_s, line_number));
+    } else if (block.p || block.t) {
+        error("P/T Word Without G04");
+    }
+
+    if (!dwell && block.has_axis()) {
+        _check_motion_environment(line_number);
+
+        std::vector<std::optional<double>> values(block.axis.begin(),
+                                                  block.axis.end());
+
+        if (motion_mode_ == 0) {
+            bool m05 = block.has_m(5);
+            emit_task(std::make_shared<GCodeTaskG00Motion>(
+                !m05, false, feed_speed_, coord_index_, coord_mode_, values,
+                line_number));
+        } else {
+            emit_task(std::make_shared<GCodeTaskG01Motion>(
+                coord_index_, coord_mode_, values, line_number));
+        }
+    }
+
+    // 6. 暂停 / 结束
+    if (block.has_m(0)) {
+        emit_task(std::make_shared<GCodeTaskPauseCommand>(line_number));
+    }
+
+    if (block.has_m(2) || block.has_m(30)) {
+        program_end_ = true;
+        emit_task(std::make_shared<GCodeTaskProgramEnd>(line_number));
+    }
+}
+
+void IsoGCodeParser::ParseFile(const std::string &filename,
+                               const TaskCallback &cb) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        throw IsoGCodeParseException(0, "File Open Failed: " + filename);
+    }
+
+    IsoGCodeParser parser;
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(ifs, line)) {
+        ++line_number;
+        parser.parse_line(line, line_number, cb);
+
+        if (parser.is_program_end()) {
+            break;
+        }
+    }
+
+    s_logger->debug("IsoGCodeParser: {} lines parsed", line_number);
+}
+
+std::vector<GCodeTaskBase::ptr>
+IsoGCodeParser::ParseFileToTaskList(const std::string &filename) {
+    std::vector<GCodeTaskBase::ptr> task_list;
+    ParseFile(filename, [&task_list](GCodeTaskBase::ptr task) {
+        task_list.push_back(std::move(task));
+    });
+
+    if (task_list.empty()) {
+        throw IsoGCodeParseException(0, "No GCode In File");
+    }
+
+    return task_list;
+}
+
+bool IsoGCodeParser::IsIsoGCodeFile(std::string_view filename) {
+    auto slash = filename.find_last_of("/\\");
+    if (slash != std::string_view::npos) {
+        filename.remove_prefix(slash + 1);
+    }
+
+    auto dot = filename.rfind('.');
+    if (dot == std::string_view::npos) {
+        return false; // 无扩展名的按Python程序处理
+    }
+
+    std::string ext{filename.substr(dot + 1)};
+    for (auto &ch : ext) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+
+    return ext == "nc" || ext == "iso" || ext == "gcode" || ext == "ngc" ||
+           ext == "tap" || ext == "cnc";
+}
+
+} // namespace task
+
+} // namespace edm
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "GCodeTask.h"
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace edm {
+
+namespace task {
+
+// ISO G代码解析错误, 带行号
+class IsoGCodeParseException : public std::exception {
+public:
+    IsoGCodeParseException(int line_number, std::string_view desc);
+
+    const char *what() const noexcept override { return what_msg_.c_str(); }
+
+    auto line_number() const noexcept { return line_number_; }
+    const auto &desc() const noexcept { return desc_; }
+
+private:
+    int line_number_;
+    std::string desc_;
+    std::string what_msg_;
+};
+
+/**
+ * 原生 ISO G代码 (纯文本) 流式解析器, 不经过Python解释器和json,
+ * 逐行直接生成 GCodeTaskBase 对象, 与 rs274.py 解释出的任务一致.
+ *
+ * 支持:
+ *  G00 G01 (模态), G04 (X/T: 秒, P: 毫秒), G90 G91, G53~G59,
+ *  F (进给率), E (电参数号), M00, M02/M30, 与G00同段的 M05 (忽略接触感知)
+ *  轴字 X Y Z B C A, 段号 N, 注释 (...) 和 ;, 程序首尾的 %
+ *
+ * 同一段内的执行顺序: E F G90/G91 G5x -> G04 -> G00/G01 -> M00/M02
+ * M02之后的内容忽略 (与rs274.py一致)
+ */
+class IsoGCodeParser final {
+public:
+    using TaskCallback = std::function<void(GCodeTaskBase::ptr)>;
+
+    IsoGCodeParser() { reset(); }
+
+    void reset();
+
+    // 解析一行, 生成的任务依次交给cb; 出错抛出 IsoGCodeParseException
+    void parse_line(std::string_view line, int line_number,
+                    const TaskCallback &cb);
+
+    auto is_program_end() const { return program_end_; }
+
+public:
+    // 逐行读取文件解析 (内存占用与文件大小无关), 出错抛出异常
+    static void ParseFile(const std::string &filename, const TaskCallback &cb);
+
+    // 解析整个文件为任务列表, 出错抛出异常
+    static std::vector<GCodeTaskBase::ptr>
+    ParseFileToTaskList(const std::string &filename);
+
+    // 是否按ISO G代码文件处理 (.nc .iso .gcode .ngc .tap .cnc)
+    static bool IsIsoGCodeFile(std::string_view filename);
+
+private:
+    static constexpr std::size_t AxisNum = 6; // x y z b c a
+
+    struct _Block;
+
+    void _check_motion_environment(int line_number) const;
+
+private:
+    // 模态
+    GCodeCoordinateMode coord_mode_;
+    int coord_index_;
+    int feed_speed_;
+    int motion_mode_; // -1: 未定义, 0: G00, 1: G01
+
+    bool program_end_;
+};
+
+} // namespace task
+
+} // namespace edm
@@ -4,6 +4,9 @@
 #include <QDateTime>
 #include <optional>
 #include <string>
+#include <vector>
+
+#include "GCodeTaskBase.h"
 
 #include "Coordinate/Coordinate.h"
 #include "Coordinate/CoordinateSystem.h"
@@ -40,6 +43,81 @@ public:
         return cmd->is_accepted();
     }
 
+    // 根据增量/绝对模式, 由G00/G01的坐标值计算机床坐标系目标位置
+    // 失败时 err_str 给出原因
+    static bool
+    CalcMachTargetPos(const coord::CoordinateManager &cm,
+                      GCodeCoordinateMode coord_mode, int coord_index,
+                      const std::vector<std::optional<double>> &cmd_values,
+                      const move::axis_t &mach_start_pos,
+                      move::axis_t &mach_target_pos, std::string &err_str) {
+        if (coord_mode == GCodeCoordinateMode::IncrementMode) {
+            // inc
+            mach_target_pos = mach_start_pos;
+            for (std::size_t i = 0; i < EDM_AXIS_NUM; ++i) {
+                if (cmd_values[i]) {
+                    mach_target_pos[i] +=
+                        util::UnitConverter::mm2blu(*(cmd_values[i]));
+                }
+            }
+            return true;
+        }
+
+        // abs, 目前只有工件坐标系模式, 没有机床坐标系模式
+
+        // 先将输入的机床坐标起点转化为坐标系坐标起点
+        move::axis_t coord_start_pos;
+        if (!cm.machine_to_coord(coord_index, mach_start_pos,
+                                 coord_start_pos)) {
+            err_str =
+                EDM_FMT::format("machine_to_coord failed: {}", coord_index);
+            return false;
+        }
+
+        // 根据cmd_values设定coord_target_pos
+        move::axis_t coord_target_pos;
+        for (std::size_t i = 0; i < coord::Coordinate::Size; ++i) {
+            if (cmd_values[i]) {
+                coord_target_pos[i] =
+                    util::UnitConverter::mm2blu(*(cmd_values[i]));
+            } else {
+                coord_target_pos[i] = coord_start_pos[i];
+            }
+        }
+
+        // 再转化为 MachTargetPos
+        if (!cm.coord_to_machine(coord_index, coord_target_pos,
+                                 mach_target_pos)) {
+            err_str =
+                EDM_FMT::format("coord_to_machine failed: {}", coord_index);
+            return false;
+        }
+
+        return true;
+    }
+
+    // 坐标系置零 (CoordSetZeroCommand): 与 GCodeRunner 相同,
+    // 将 coord_index 坐标系中置零的轴的偏置设为当前位置 (电机坐标)
+    static bool ApplyCoordSetZero(coord::CoordinateManager &cm, int coord_index,
+                                  const std::vector<bool> &set_zero_axis_list,
+                                  const move::axis_t &curr_motor_pos) {
+        auto offset_opt = cm.get_coord_offset(coord_index);
+        if (!offset_opt) {
+            return false;
+        }
+
+        auto new_offset = *offset_opt;
+        for (std::size_t i = 0;
+             i < coord::Coordinate::Size && i < set_zero_axis_list.size();
+             ++i) {
+            if (set_zero_axis_list[i]) {
+                new_offset[i] = curr_motor_pos[i];
+            }
+        }
+
+        return cm.set_coord_offset(coord_index, new_offset);
+    }
+
     static bool CheckPosandnegSoftLimit(coord::CoordinateSystem::ptr coord_sys,
                                         const move::axis_t &mach_pos, const move::axis_t& dir) {
         const auto &pos_sl = coord_sys->get_pos_soft_limit();
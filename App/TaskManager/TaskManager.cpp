@@ -45,6 +45,11 @@ bool TaskManager::operation_gcode_start(
     return gcode_runner_->start(gcode_list);
 }
 
+bool TaskManager::operation_gcode_start(
+    GCodeProgramStream::ptr program_stream) {
+    return gcode_runner_->start(std::move(program_stream));
+}
+
 bool TaskManager::operation_gcode_pause() { return gcode_runner_->pause(); }
 
 bool TaskManager::operation_gcode_resume() { return gcode_runner_->resume(); }
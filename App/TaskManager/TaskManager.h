@@ -36,6 +36,8 @@ public: // GUI命令接口
 
     bool
     operation_gcode_start(const std::vector<GCodeTaskBase::ptr> &gcode_list);
+    // 流水线启动, 边解析边加工
+    bool operation_gcode_start(GCodeProgramStream::ptr program_stream);
     bool operation_gcode_pause();
     bool operation_gcode_resume();
     bool operation_gcode_stop();
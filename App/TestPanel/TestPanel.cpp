@@ -27,9 +27,11 @@ TestPanel::TestPanel(SharedCoreData *shared_core_data, QWidget *parent)
 
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     connect(shared_core_data_->get_info_dispatcher(),
-            &InfoDispatcher::info_updated, this,
-            [this](const edm::move::MotionInfo &info) {
-                ui->dsb_show_spindle_blu->setValue(info.spindle_axis_blu);
+            &InfoDispatcher::info_changed, this,
+            [this](const edm::move::MotionInfo &info, uint32_t change_mask) {
+                if (change_mask & InfoChange_Drill) {
+                    ui->dsb_show_spindle_blu->setValue(info.spindle_axis_blu);
+                }
             });
 
     connect(ui->pb_start_spindle, &QPushButton::clicked, this, [this]() {
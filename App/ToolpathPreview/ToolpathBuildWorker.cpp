@@ -0,0 +1,49 @@
+#include "ToolpathBuildWorker.h"
+
+#include <chrono>
+
+#include "Logger/LogMacro.h"
+
+EDM_STATIC_LOGGER(s_logger, EDM_LOGGER_ROOT());
+
+namespace edm {
+namespace app {
+
+namespace {
+struct metatype_register__ {
+    metatype_register__() {
+        qRegisterMetaType<ToolpathBuildInput::ptr>(
+            "edm::app::ToolpathBuildInput::ptr");
+        qRegisterMetaType<ToolpathData::ptr>("edm::app::ToolpathData::ptr");
+    }
+};
+static struct metatype_register__ mt_register__;
+} // namespace
+
+void ToolpathBuildWorker::slot_build(ToolpathBuildInput::ptr input) {
+    if (*input->cancel_token) {
+        return; // 已有更新的任务
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    auto data =
+        ToolpathBuilder::Build(input->gcode_list, input->cm, input->coord_index,
+                               input->start_motor_pos, *input->cancel_token);
+    if (!data) {
+        s_logger->debug("toolpath build canceled: job {}", input->job_id);
+        return;
+    }
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - t0)
+                        .count();
+    s_logger->info("toolpath built: {} segments, {} levels, {} errors, {} us",
+                   data->segment_count, data->levels.size(), data->error_count,
+                   us);
+
+    emit sig_finished(input->job_id, data);
+}
+
+} // namespace app
+} // namespace edm
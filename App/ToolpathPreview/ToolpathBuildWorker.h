@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QObject>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "ToolpathBuilder.h"
+
+namespace edm {
+namespace app {
+
+// 一次刀路构建的输入, 整体在线程间传递
+struct ToolpathBuildInput {
+    using ptr = std::shared_ptr<ToolpathBuildInput>;
+
+    int job_id{0};
+
+    // 每个任务一个取消标志, 由GUI线程在提交任务时创建;
+    // 任务还在队列中时取消也不会丢失
+    std::shared_ptr<std::atomic_bool> cancel_token{
+        std::make_shared<std::atomic_bool>(false)};
+
+    std::vector<task::GCodeTaskBase::ptr> gcode_list;
+    coord::CoordinateManager cm; // 坐标系快照
+    uint32_t coord_index{54};    // 起始的当前坐标系
+    move::axis_t start_motor_pos{0.0};
+};
+
+/**
+ * 刀路构建Worker, 运行在独立QThread中, 构建大程序的刀路及各细节层次时界面保持响应.
+ * 提交新任务前GUI线程置位旧任务的取消标志: 正在进行的旧任务被中止,
+ * 排队中的旧任务直接跳过.
+ */
+class ToolpathBuildWorker : public QObject {
+    Q_OBJECT
+public:
+    explicit ToolpathBuildWorker(QObject *parent = nullptr)
+        : QObject(parent) {}
+
+public slots:
+    void slot_build(edm::app::ToolpathBuildInput::ptr input);
+
+signals:
+    // 被中止时不发出
+    void sig_finished(int job_id, edm::app::ToolpathData::ptr data);
+};
+
+} // namespace app
+} // namespace edm
+
+Q_DECLARE_METATYPE(edm::app::ToolpathBuildInput::ptr)
+Q_DECLARE_METATYPE(edm::app::ToolpathData::ptr)
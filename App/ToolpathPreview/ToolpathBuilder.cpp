@@ -0,0 +1,246 @@
+#include "ToolpathBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "TaskManager/GCodeTask.h"
+#include "TaskManager/TaskHelper.h"
+#include "Utils/UnitConverter/UnitConverter.h"
+
+namespace edm {
+namespace app {
+
+// 最粗的层的点数目标, 点数少于此值后不再生成更粗的层
+static constexpr std::size_t s_min_level_points = 2000;
+// 最多层数 (含原始层)
+static constexpr int s_max_levels = 12;
+// 第1层的误差 (mm), 之后每层加倍
+static constexpr double s_first_tolerance = 0.001;
+
+const ToolpathLevel &ToolpathData::level_for(double max_tolerance) const {
+    std::size_t i = 0;
+    while (i + 1 < levels.size() && levels[i + 1].tolerance <= max_tolerance) {
+        ++i;
+    }
+    return levels[i];
+}
+
+static ToolpathPoint _to_point(const move::axis_t &mach_pos) {
+    return {util::UnitConverter::blu2mm(mach_pos[0]),
+            util::UnitConverter::blu2mm(mach_pos[1]),
+            util::UnitConverter::blu2mm(mach_pos[2])};
+}
+
+ToolpathData::ptr
+ToolpathBuilder::Build(const std::vector<task::GCodeTaskBase::ptr> &gcode_list,
+                       coord::CoordinateManager &cm, uint32_t coord_index,
+                       const move::axis_t &start_motor_pos,
+                       const std::atomic_bool &cancel_flag) {
+    auto data = std::make_shared<ToolpathData>();
+
+    ToolpathLevel base;
+
+    move::axis_t mach_pos;
+    cm.motor_to_machine(start_motor_pos, mach_pos);
+
+    // 当前坐标系, 置零 (CoordSetZeroCommand) 作用于此坐标系
+    int curr_coord_index = static_cast<int>(coord_index);
+
+    // 追加一段到 base, 类型变化时开始新的折线
+    auto f_add = [&](ToolpathRun::Type type, const move::axis_t &mach_target) {
+        if (base.runs.empty() || base.runs.back().type != type) {
+            ToolpathRun run;
+            run.type = type;
+            run.begin = base.points.size();
+            base.points.push_back(_to_point(mach_pos));
+            data->box.expand(base.points.back());
+            run.end = base.points.size();
+            base.runs.push_back(run);
+        }
+
+        base.points.push_back(_to_point(mach_target));
+        data->box.expand(base.points.back());
+        base.runs.back().end = base.points.size();
+        ++data->segment_count;
+
+        mach_pos = mach_target;
+    };
+
+    auto f_target = [&](task::GCodeCoordinateMode coord_mode, int coord_index,
+                        const std::vector<std::optional<double>> &values,
+                        move::axis_t &mach_target) {
+        std::string err_str;
+        if (!task::TaskHelper::CalcMachTargetPos(cm, coord_mode, coord_index,
+                                                 values, mach_pos, mach_target,
+                                                 err_str)) {
+            ++data->error_count;
+            return false;
+        }
+        return true;
+    };
+
+    for (std::size_t i = 0; i < gcode_list.size(); ++i) {
+        if ((i & 0xFFF) == 0 && cancel_flag) {
+            return nullptr;
+        }
+
+        const auto &gcode = gcode_list[i];
+        move::axis_t mach_target;
+
+        switch (gcode->type()) {
+        case task::GCodeTaskType::G00MotionCommand: {
+            auto g00 = std::static_pointer_cast<task::GCodeTaskG00Motion>(gcode);
+            if (f_target(g00->coord_mode(), g00->coord_index(),
+                         g00->cmd_values(), mach_target)) {
+                f_add(ToolpathRun::Type::Rapid, mach_target);
+            }
+            break;
+        }
+        case task::GCodeTaskType::G01MotionCommand: {
+            auto g01 = std::static_pointer_cast<task::GCodeTaskG01Motion>(gcode);
+            if (f_target(g01->coord_mode(), g01->coord_index(),
+                         g01->cmd_values(), mach_target)) {
+                f_add(ToolpathRun::Type::Cut, mach_target);
+            }
+            break;
+        }
+        case task::GCodeTaskType::G01GroupMotionCommand: {
+            auto group =
+                std::static_pointer_cast<task::GCodeTaskG01GroupMotion>(gcode);
+            for (const auto &point : group->points()) {
+                if (!f_target(point.coord_mode, group->coord_index(),
+                              point.cmd_values, mach_target)) {
+                    break;
+                }
+                f_add(ToolpathRun::Type::Cut, mach_target);
+            }
+            break;
+        }
+        case task::GCodeTaskType::CoordinateIndexCommand: {
+            curr_coord_index =
+                std::static_pointer_cast<task::GCodeTaskCoordinateIndex>(gcode)
+                    ->coord_index();
+            break;
+        }
+        case task::GCodeTaskType::CoordSetZeroCommand: {
+            auto csz =
+                std::static_pointer_cast<task::GCodeTaskCoordSetZeroCommand>(
+                    gcode);
+            // 与 GCodeRunner 相同, 以电机坐标的当前位置作为新的偏置
+            move::axis_t motor_pos;
+            cm.machine_to_motor(mach_pos, motor_pos);
+            if (!task::TaskHelper::ApplyCoordSetZero(
+                    cm, curr_coord_index, csz->set_zero_axis_list(),
+                    motor_pos)) {
+                ++data->error_count;
+            }
+            break;
+        }
+        // 打孔 (DrillMotionCommand) 只在 S 轴上进给, 不改变 X/Y/Z,
+        // 有意不绘制; 其余非运动指令不影响刀路
+        default:
+            break;
+        }
+    }
+
+    data->levels.push_back(std::move(base));
+
+    double tolerance = s_first_tolerance;
+    while (static_cast<int>(data->levels.size()) < s_max_levels &&
+           data->levels.back().points.size() > s_min_level_points) {
+        if (cancel_flag) {
+            return nullptr;
+        }
+
+        // 从上一层简化, 结果与从原始层简化相差不超过各层误差之和 (< 2倍)
+        auto level = _make_level(data->levels.back(), tolerance);
+        data->levels.push_back(std::move(level));
+        tolerance *= 2.0;
+    }
+
+    return data;
+}
+
+ToolpathLevel ToolpathBuilder::_make_level(const ToolpathLevel &base,
+                                           double tolerance) {
+    ToolpathLevel level;
+    level.tolerance = tolerance;
+    level.points.reserve(base.points.size() / 2);
+    level.runs.reserve(base.runs.size());
+
+    for (const auto &run : base.runs) {
+        ToolpathRun new_run = run;
+        new_run.begin = level.points.size();
+        _simplify(base.points.data() + run.begin, run.end - run.begin,
+                  tolerance, level.points);
+        new_run.end = level.points.size();
+        level.runs.push_back(new_run);
+    }
+
+    return level;
+}
+
+// 点 p 到线段 ab 的距离的平方
+static double _dist2_to_segment(const ToolpathPoint &p, const ToolpathPoint &a,
+                                const ToolpathPoint &b) {
+    const double abx = b.x - a.x, aby = b.y - a.y, abz = b.z - a.z;
+    const double apx = p.x - a.x, apy = p.y - a.y, apz = p.z - a.z;
+    const double len2 = abx * abx + aby * aby + abz * abz;
+
+    double t = 0.0;
+    if (len2 > 0.0) {
+        t = std::clamp((apx * abx + apy * aby + apz * abz) / len2, 0.0, 1.0);
+    }
+
+    const double dx = apx - t * abx, dy = apy - t * aby, dz = apz - t * abz;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void ToolpathBuilder::_simplify(const ToolpathPoint *pts, std::size_t n,
+                                double tolerance,
+                                std::vector<ToolpathPoint> &out) {
+    if (n <= 2) {
+        out.insert(out.end(), pts, pts + n);
+        return;
+    }
+
+    // 迭代的 Douglas-Peucker (百万级的点, 不用递归)
+    std::vector<bool> keep(n, false);
+    keep[0] = keep[n - 1] = true;
+
+    const double tol2 = tolerance * tolerance;
+
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.emplace_back(0, n - 1);
+    while (!stack.empty()) {
+        const auto [first, last] = stack.back();
+        stack.pop_back();
+
+        double max_d2 = 0.0;
+        std::size_t max_i = first;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            const double d2 = _dist2_to_segment(pts[i], pts[first], pts[last]);
+            if (d2 > max_d2) {
+                max_d2 = d2;
+                max_i = i;
+            }
+        }
+
+        if (max_d2 > tol2) {
+            keep[max_i] = true;
+            stack.emplace_back(first, max_i);
+            stack.emplace_back(max_i, last);
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keep[i]) {
+            out.push_back(pts[i]);
+        }
+    }
+}
+
+} // namespace app
+} // namespace edm
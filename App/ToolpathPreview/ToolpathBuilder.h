@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Coordinate/CoordinateManager.h"
+#include "Motion/MoveDefines.h"
+#include "TaskManager/GCodeTaskBase.h"
+
+namespace edm {
+namespace app {
+
+// 刀路中的一个点 (机床坐标, mm)
+struct ToolpathPoint {
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+};
+
+struct ToolpathBox {
+    ToolpathPoint min{1e300, 1e300, 1e300};
+    ToolpathPoint max{-1e300, -1e300, -1e300};
+
+    bool valid() const { return min.x <= max.x; }
+
+    void expand(const ToolpathPoint &p) {
+        min.x = std::min(min.x, p.x);
+        min.y = std::min(min.y, p.y);
+        min.z = std::min(min.z, p.z);
+        max.x = std::max(max.x, p.x);
+        max.y = std::max(max.y, p.y);
+        max.z = std::max(max.z, p.z);
+    }
+};
+
+// 同一类型的一段连续折线
+struct ToolpathRun {
+    enum class Type : uint8_t { Rapid, Cut };
+
+    Type type{Type::Cut};
+    std::size_t begin{0}; // 在 points 中的下标, [begin, end)
+    std::size_t end{0};
+};
+
+// 一个细节层次: 按 tolerance 简化后的所有折线
+struct ToolpathLevel {
+    double tolerance{0.0}; // 简化误差上限 (mm), 第0层为0, 即原始数据
+    std::vector<ToolpathPoint> points;
+    std::vector<ToolpathRun> runs;
+};
+
+// 构建好的刀路, 构建后只读, 可在线程间传递
+struct ToolpathData {
+    using ptr = std::shared_ptr<const ToolpathData>;
+
+    std::vector<ToolpathLevel> levels; // tolerance 递增
+    ToolpathBox box;
+    std::size_t segment_count{0}; // 原始线段数
+    int error_count{0};           // 目标位置计算失败的node
+
+    // 选择误差不超过 max_tolerance 的最粗的层
+    const ToolpathLevel &level_for(double max_tolerance) const;
+};
+
+/**
+ * 从 GCodeTaskBase 列表构建刀路 (在后台线程中调用):
+ * 按 GCodeRunner 相同的方式计算各块的目标位置, 得到 G00/G01 折线,
+ * 再用 Douglas-Peucker 按逐级加倍的误差简化出多个细节层次,
+ * 显示时按缩放比例选择层次, 绘制的点数与程序长度基本无关.
+ */
+class ToolpathBuilder final {
+public:
+    // cm: 坐标系快照 (构建期间不能被外部修改, 程序中的置零直接修改快照);
+    // coord_index: 起始的当前坐标系; start_motor_pos: 起点, 电机坐标
+    static ToolpathData::ptr
+    Build(const std::vector<task::GCodeTaskBase::ptr> &gcode_list,
+          coord::CoordinateManager &cm, uint32_t coord_index,
+          const move::axis_t &start_motor_pos,
+          const std::atomic_bool &cancel_flag);
+
+private:
+    // 简化一段折线, 保留的点追加到 out
+    static void _simplify(const ToolpathPoint *pts, std::size_t n,
+                          double tolerance, std::vector<ToolpathPoint> &out);
+
+    static ToolpathLevel _make_level(const ToolpathLevel &base,
+                                     double tolerance);
+};
+
+} // namespace app
+} // namespace edm
@@ -0,0 +1,316 @@
+#include "ToolpathPreview.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace edm {
+namespace app {
+
+// 投影缓存中每块折线的最多点数
+static constexpr int s_chunk_points = 4096;
+// 选择细节层次: 简化误差不超过这么多像素
+static constexpr double s_lod_pixel_tolerance = 0.5;
+
+ToolpathPreview::ToolpathPreview(QWidget *parent) : QWidget(parent) {
+    setWindowTitle("Toolpath Preview");
+    setMinimumSize(400, 300);
+    setMouseTracking(false);
+
+    cb_view_ = new QComboBox(this);
+    cb_view_->addItem("XY", static_cast<int>(View::XY));
+    cb_view_->addItem("XZ", static_cast<int>(View::XZ));
+    cb_view_->addItem("YZ", static_cast<int>(View::YZ));
+    cb_view_->addItem("ISO", static_cast<int>(View::Iso));
+    cb_view_->move(4, 4);
+    connect(cb_view_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int index) {
+                set_view(static_cast<View>(cb_view_->itemData(index).toInt()));
+            });
+
+    build_thread_ = new QThread(this);
+    build_worker_ = new ToolpathBuildWorker();
+    build_worker_->moveToThread(build_thread_);
+
+    connect(build_thread_, &QThread::finished, build_worker_,
+            &QObject::deleteLater);
+    connect(this, &ToolpathPreview::_sig_build, build_worker_,
+            &ToolpathBuildWorker::slot_build);
+    connect(build_worker_, &ToolpathBuildWorker::sig_finished, this,
+            &ToolpathPreview::_slot_build_finished);
+
+    build_thread_->start();
+}
+
+ToolpathPreview::~ToolpathPreview() {
+    _cancel_build(); // 中止正在进行的构建
+    build_thread_->quit();
+    build_thread_->wait();
+}
+
+void ToolpathPreview::set_program(
+    std::vector<task::GCodeTaskBase::ptr> gcode_list,
+    const coord::CoordinateManager &cm, uint32_t coord_index,
+    const move::axis_t &start_motor_pos) {
+    auto input = std::make_shared<ToolpathBuildInput>();
+    input->job_id = ++build_job_id_;
+    input->gcode_list = std::move(gcode_list);
+    input->cm.set_global_offset(cm.get_global_offset());
+    auto coordinates_map = cm.get_coordinates_map();
+    input->cm.set_coordinates_map(std::move(coordinates_map));
+    input->coord_index = coord_index;
+    input->start_motor_pos = start_motor_pos;
+
+    building_ = true;
+    _cancel_build();
+    build_cancel_token_ = input->cancel_token;
+    emit _sig_build(input);
+
+    update();
+}
+
+void ToolpathPreview::_cancel_build() {
+    if (build_cancel_token_) {
+        *build_cancel_token_ = true;
+    }
+}
+
+void ToolpathPreview::_slot_build_finished(int job_id, ToolpathData::ptr data) {
+    if (job_id != build_job_id_) {
+        return; // 过期的任务
+    }
+
+    building_ = false;
+    data_ = std::move(data);
+    projected_level_ = nullptr;
+    projected_.clear();
+
+    fit();
+}
+
+void ToolpathPreview::set_current_pos(const ToolpathPoint &pos) {
+    has_pos_ = true;
+    curr_pos_ = pos;
+
+    if (isVisible()) {
+        update(); // 刀路用缓存图, 只重画位置标记
+    }
+}
+
+void ToolpathPreview::set_view(View view) {
+    if (view == view_) {
+        return;
+    }
+
+    view_ = view;
+    cb_view_->setCurrentIndex(cb_view_->findData(static_cast<int>(view)));
+    fit();
+}
+
+QPointF ToolpathPreview::_project(const ToolpathPoint &p) const {
+    switch (view_) {
+    case View::XZ:
+        return {p.x, p.z};
+    case View::YZ:
+        return {p.y, p.z};
+    case View::Iso:
+        // 等轴测: x轴向右下, y轴向左下 (各30度), z轴向上
+        return {(p.x - p.y) * 0.8660254037844386, p.z - (p.x + p.y) * 0.5};
+    case View::XY:
+    default:
+        return {p.x, p.y};
+    }
+}
+
+QTransform ToolpathPreview::_world_to_screen() const {
+    QTransform t;
+    t.translate(width() / 2.0, height() / 2.0);
+    t.scale(scale_, -scale_); // 屏幕y向下
+    t.translate(-center_.x(), -center_.y());
+    return t;
+}
+
+void ToolpathPreview::fit() {
+    if (!data_ || !data_->box.valid()) {
+        _invalidate_path_cache();
+        return;
+    }
+
+    // 包围盒8个角点投影后的范围
+    const auto &b = data_->box;
+    QRectF rect;
+    bool first = true;
+    for (int i = 0; i < 8; ++i) {
+        const ToolpathPoint corner{(i & 1) ? b.max.x : b.min.x,
+                                   (i & 2) ? b.max.y : b.min.y,
+                                   (i & 4) ? b.max.z : b.min.z};
+        const QPointF p = _project(corner);
+        if (first) {
+            rect = QRectF(p, QSizeF(0, 0));
+            first = false;
+        } else {
+            rect = rect.united(QRectF(p, QSizeF(0, 0)));
+        }
+    }
+
+    center_ = rect.center();
+
+    const double w = std::max(rect.width(), 1e-3);
+    const double h = std::max(rect.height(), 1e-3);
+    scale_ = 0.9 * std::min(width() / w, height() / h);
+
+    _invalidate_path_cache();
+}
+
+void ToolpathPreview::_update_projection(const ToolpathLevel &level) {
+    if (projected_level_ == &level && projected_view_ == view_) {
+        return;
+    }
+
+    projected_.clear();
+
+    for (const auto &run : level.runs) {
+        // 分块, 相邻块共用端点
+        std::size_t begin = run.begin;
+        while (begin + 1 < run.end) {
+            const std::size_t end =
+                std::min(run.end, begin + static_cast<std::size_t>(s_chunk_points));
+
+            ProjectedChunk chunk;
+            chunk.type = run.type;
+            chunk.poly.reserve(static_cast<int>(end - begin));
+            for (std::size_t i = begin; i < end; ++i) {
+                chunk.poly.append(_project(level.points[i]));
+            }
+            // 水平/竖直的线包围盒面积为0, 稍微扩大, 否则 intersects 总为false
+            chunk.bounds = chunk.poly.boundingRect().adjusted(-1e-6, -1e-6,
+                                                              1e-6, 1e-6);
+            projected_.push_back(std::move(chunk));
+
+            begin = end - 1;
+        }
+    }
+
+    projected_level_ = &level;
+    projected_view_ = view_;
+}
+
+void ToolpathPreview::_render_path_cache() {
+    const qreal dpr = devicePixelRatioF();
+    if (path_cache_.size() != size() * dpr) {
+        path_cache_ = QPixmap(size() * dpr);
+        path_cache_.setDevicePixelRatio(dpr);
+    }
+    path_cache_.fill(Qt::black);
+    path_cache_valid_ = true;
+
+    if (!data_ || data_->levels.empty()) {
+        return;
+    }
+
+    const auto &level = data_->level_for(s_lod_pixel_tolerance / scale_);
+    _update_projection(level);
+
+    const QTransform t = _world_to_screen();
+    const QRectF visible = t.inverted().mapRect(QRectF(rect()));
+
+    QPainter painter(&path_cache_);
+    painter.setTransform(t);
+
+    QPen rapid_pen(Qt::darkGray);
+    rapid_pen.setCosmetic(true);
+    QPen cut_pen(Qt::green);
+    cut_pen.setCosmetic(true);
+
+    for (const auto &chunk : projected_) {
+        if (!chunk.bounds.intersects(visible)) {
+            continue; // 不可见
+        }
+
+        painter.setPen(chunk.type == ToolpathRun::Type::Rapid ? rapid_pen
+                                                              : cut_pen);
+        painter.drawPolyline(chunk.poly);
+    }
+}
+
+void ToolpathPreview::paintEvent(QPaintEvent * /* event */) {
+    if (!path_cache_valid_) {
+        _render_path_cache();
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, path_cache_);
+
+    // 实时位置
+    if (has_pos_) {
+        const QPointF p = _world_to_screen().map(_project(curr_pos_));
+        painter.setPen(QPen(Qt::red, 2));
+        painter.drawLine(p - QPointF(8, 0), p + QPointF(8, 0));
+        painter.drawLine(p - QPointF(0, 8), p + QPointF(0, 8));
+    }
+
+    // 状态
+    QString status;
+    if (building_) {
+        status = "Building ...";
+    } else if (!data_) {
+        status = "No toolpath";
+    } else {
+        const auto &level = data_->level_for(s_lod_pixel_tolerance / scale_);
+        status = QString("%0 segments, drawing %1 points (tol %2 mm)")
+                     .arg(data_->segment_count)
+                     .arg(level.points.size())
+                     .arg(level.tolerance);
+        if (data_->error_count > 0) {
+            status += QString(", %0 errors").arg(data_->error_count);
+        }
+    }
+    painter.setPen(Qt::white);
+    painter.drawText(rect().adjusted(4, 4, -4, -4),
+                     Qt::AlignRight | Qt::AlignTop, status);
+}
+
+void ToolpathPreview::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    _invalidate_path_cache();
+}
+
+void ToolpathPreview::wheelEvent(QWheelEvent *event) {
+    const double factor = std::pow(1.0015, event->angleDelta().y());
+
+    // 以鼠标位置为中心缩放
+    const QPointF mouse = event->position();
+    const QPointF world_before = _world_to_screen().inverted().map(mouse);
+    scale_ = std::clamp(scale_ * factor, 1e-3, 1e7);
+    const QPointF world_after = _world_to_screen().inverted().map(mouse);
+    center_ += world_before - world_after;
+
+    _invalidate_path_cache();
+    event->accept();
+}
+
+void ToolpathPreview::mousePressEvent(QMouseEvent *event) {
+    last_mouse_pos_ = event->pos();
+}
+
+void ToolpathPreview::mouseMoveEvent(QMouseEvent *event) {
+    if (!(event->buttons() & Qt::LeftButton)) {
+        return;
+    }
+
+    const QPoint delta = event->pos() - last_mouse_pos_;
+    last_mouse_pos_ = event->pos();
+
+    center_ -= QPointF(delta.x() / scale_, -delta.y() / scale_);
+    _invalidate_path_cache();
+}
+
+void ToolpathPreview::mouseDoubleClickEvent(QMouseEvent * /* event */) {
+    fit();
+}
+
+} // namespace app
+} // namespace edm
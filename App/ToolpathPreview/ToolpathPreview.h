@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QComboBox>
+#include <QPixmap>
+#include <QPolygonF>
+#include <QThread>
+#include <QWidget>
+
+#include <vector>
+
+#include "ToolpathBuildWorker.h"
+
+namespace edm {
+namespace app {
+
+/**
+ * 刀路预览:
+ * - 刀路在后台线程构建 (ToolpathBuildWorker), 带多个细节层次
+ * - 按当前缩放选择层次 (误差 < 半个像素), 只投影一次, 缩放平移不重新计算
+ * - 刀路画到缓存图中, 实时位置更新时只重画位置标记
+ * - 滚轮缩放, 左键拖动平移, 双击适应窗口; XY/XZ/YZ 及等轴测视图
+ */
+class ToolpathPreview : public QWidget {
+    Q_OBJECT
+public:
+    enum class View { XY, XZ, YZ, Iso };
+
+    explicit ToolpathPreview(QWidget *parent = nullptr);
+    ~ToolpathPreview();
+
+    // 在后台构建刀路; cm 拷贝一份快照, coord_index 为当前坐标系,
+    // start_motor_pos 为起点 (电机坐标)
+    void set_program(std::vector<task::GCodeTaskBase::ptr> gcode_list,
+                     const coord::CoordinateManager &cm, uint32_t coord_index,
+                     const move::axis_t &start_motor_pos);
+
+    // 实时位置 (机床坐标, mm)
+    void set_current_pos(const ToolpathPoint &pos);
+
+    void set_view(View view);
+
+    // 适应窗口
+    void fit();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+signals:
+    void _sig_build(edm::app::ToolpathBuildInput::ptr input);
+
+private:
+    void _slot_build_finished(int job_id, ToolpathData::ptr data);
+
+    // 置位当前构建任务的取消标志
+    void _cancel_build();
+
+    QPointF _project(const ToolpathPoint &p) const;
+    QTransform _world_to_screen() const;
+
+    // 确保投影缓存是当前层次和视图的
+    void _update_projection(const ToolpathLevel &level);
+
+    // 重画刀路缓存图
+    void _render_path_cache();
+
+    void _invalidate_path_cache() {
+        path_cache_valid_ = false;
+        update();
+    }
+
+private:
+    QThread *build_thread_{nullptr};
+    ToolpathBuildWorker *build_worker_{nullptr};
+    int build_job_id_{0};
+    std::shared_ptr<std::atomic_bool> build_cancel_token_; // 当前构建任务
+    bool building_{false};
+
+    ToolpathData::ptr data_;
+
+    // 投影缓存: 折线按最多 s_chunk_points 个点分块, 便于按可见范围裁剪
+    struct ProjectedChunk {
+        ToolpathRun::Type type;
+        QPolygonF poly;
+        QRectF bounds;
+    };
+    const ToolpathLevel *projected_level_{nullptr};
+    View projected_view_{View::XY};
+    std::vector<ProjectedChunk> projected_;
+
+    QPixmap path_cache_;
+    bool path_cache_valid_{false};
+
+    View view_{View::XY};
+    double scale_{1.0};   // 像素/mm
+    QPointF center_;      // 视图中心 (投影后的坐标, mm)
+    QPoint last_mouse_pos_;
+
+    bool has_pos_{false};
+    ToolpathPoint curr_pos_;
+
+    QComboBox *cb_view_{nullptr};
+};
+
+} // namespace app
+} // namespace edm
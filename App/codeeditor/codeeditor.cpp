@@ -50,9 +50,21 @@
 
 #include "codeeditor.h"
 
+#include <QFile>
+#include <QFileInfo>
 #include <QPainter>
+#include <QScrollBar>
 #include <QTextBlock>
 
+#include <algorithm>
+
+// 超过此大小的文件用分页模式
+static constexpr qint64 s_paged_file_size = 2 * 1024 * 1024;
+// 分页模式每页的行数
+static constexpr int s_page_lines = 4000;
+// 超过此行数的文档用懒高亮 (只高亮可见的块)
+static constexpr int s_lazy_highlight_lines = 2000;
+
 //![constructor]
 
 CodeEditor::CodeEditor(QWidget *parent) : QPlainTextEdit(parent)
@@ -75,6 +87,157 @@ CodeEditor::CodeEditor(QWidget *parent) : QPlainTextEdit(parent)
     this->setTabStopDistance(4 * fontMetrics().horizontalAdvance(' '));
 
     highlighter = new Highlighter(this->document());
+
+    highlightTimer = new QTimer(this);
+    highlightTimer->setSingleShot(true);
+    highlightTimer->setInterval(0);
+    connect(highlightTimer, &QTimer::timeout, this, &CodeEditor::highlightVisibleBlocks);
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &CodeEditor::onScrollValueChanged);
+}
+
+bool CodeEditor::loadFile(const QString &filename)
+{
+    clearContent();
+
+    QFile file(filename);
+    if (!file.exists()) {
+        return false;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    if (file.size() <= s_paged_file_size) {
+        const QString text = QString::fromUtf8(file.readAll());
+        highlighter->setLazy(text.count(QLatin1Char('\n')) > s_lazy_highlight_lines);
+        setPlainText(text);
+        document()->setModified(false);
+        return true;
+    }
+
+    // 建立行索引, 只读取一遍, 不解码
+    lineOffsets.clear();
+    lineOffsets.push_back(0);
+
+    qint64 pos = 0;
+    QByteArray buf;
+    while (!(buf = file.read(1024 * 1024)).isEmpty()) {
+        const char *data = buf.constData();
+        for (int i = 0; i < buf.size(); ++i) {
+            if (data[i] == '\n') {
+                lineOffsets.push_back(pos + i + 1);
+            }
+        }
+        pos += buf.size();
+    }
+    if (lineOffsets.back() != pos) {
+        lineOffsets.push_back(pos); // 最后一行没有换行符
+    }
+
+    pagedFilename = filename;
+    setReadOnly(true);
+    highlighter->setLazy(true);
+
+    return loadPage(0);
+}
+
+void CodeEditor::clearContent()
+{
+    pagedFilename.clear();
+    lineOffsets.clear();
+    pageFirstLine = 0;
+    clear();
+}
+
+int CodeEditor::clampPageFirstLine(int firstLine) const
+{
+    const int totalLines = static_cast<int>(lineOffsets.size()) - 1;
+    return std::clamp(firstLine, 0, std::max(0, totalLines - s_page_lines));
+}
+
+bool CodeEditor::loadPage(int firstLine)
+{
+    const int totalLines = static_cast<int>(lineOffsets.size()) - 1;
+    firstLine = clampPageFirstLine(firstLine);
+    const int lastLine = std::min(totalLines, firstLine + s_page_lines);
+
+    QFile file(pagedFilename);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(lineOffsets[firstLine])) {
+        return false;
+    }
+
+    QByteArray bytes = file.read(lineOffsets[lastLine] - lineOffsets[firstLine]);
+    if (bytes.endsWith('\n')) {
+        bytes.chop(1); // 避免页尾多出一个空行
+    }
+
+    pageLoading = true;
+    pageFirstLine = firstLine;
+    setPlainText(QString::fromUtf8(bytes));
+    document()->setModified(false);
+    pageLoading = false;
+
+    lineNumberArea->update();
+    return true;
+}
+
+void CodeEditor::onScrollValueChanged(int value)
+{
+    if (!isPaged() || pageLoading) {
+        return;
+    }
+
+    auto *bar = verticalScrollBar();
+    const int totalLines = static_cast<int>(lineOffsets.size()) - 1;
+
+    // 滚动到页尾/页首时, 换为向后/向前移动半页的页, 保持当前可见的行不动
+    int newFirst = pageFirstLine;
+    if (value >= bar->maximum() && pageFirstLine + blockCount() < totalLines) {
+        newFirst = clampPageFirstLine(pageFirstLine + s_page_lines / 2);
+    } else if (value <= bar->minimum() && pageFirstLine > 0) {
+        newFirst = clampPageFirstLine(pageFirstLine - s_page_lines / 2);
+    }
+    if (newFirst == pageFirstLine) {
+        return;
+    }
+
+    const int topFileLine = pageFirstLine + firstVisibleBlock().blockNumber();
+    const int cursorFileLine = pageFirstLine + textCursor().blockNumber();
+
+    if (!loadPage(newFirst)) {
+        return;
+    }
+
+    // 恢复光标 (当前加工行标记) 和可见位置
+    const int cursorLocal = cursorFileLine - pageFirstLine;
+    if (cursorLocal >= 0 && cursorLocal < blockCount()) {
+        setTextCursor(QTextCursor(document()->findBlockByNumber(cursorLocal)));
+    }
+    pageLoading = true;
+    bar->setValue(topFileLine - pageFirstLine);
+    pageLoading = false;
+}
+
+void CodeEditor::highlightVisibleBlocks()
+{
+    if (!highlighter->isLazy()) {
+        return;
+    }
+
+    const int viewBottom = viewport()->rect().bottom();
+
+    QTextBlock block = firstVisibleBlock();
+    qreal top = blockBoundingGeometry(block).translated(contentOffset()).top();
+    while (block.isValid() && top <= viewBottom) {
+        if (block.userState() == Highlighter::UnhighlightedState) {
+            highlighter->highlightBlockNow(block);
+        }
+
+        top += blockBoundingRect(block).height();
+        block = block.next();
+    }
 }
 
 void CodeEditor::moveCursorToLine(uint32_t line)
@@ -95,11 +258,19 @@ void CodeEditor::moveCursorToLine(uint32_t line)
 
     // this->setTextCursor(s.cursor);
 
-    auto c = this->textCursor();
-    c.movePosition(
-                QTextCursor::Start, QTextCursor::MoveAnchor, 1);
-    c.movePosition(QTextCursor::Down, QTextCursor::MoveAnchor, line - 1);
-    this->setTextCursor(c);
+    int local = static_cast<int>(line) - 1 - lineOffset();
+
+    // 分页模式下目标行不在当前页 (或靠近页边), 载入以目标行为中心的页
+    if (isPaged() && (local < s_page_lines / 8 || local >= blockCount() - s_page_lines / 8)) {
+        const int newFirst = clampPageFirstLine(static_cast<int>(line) - 1 - s_page_lines / 2);
+        if (newFirst != pageFirstLine && loadPage(newFirst)) {
+            local = static_cast<int>(line) - 1 - lineOffset();
+        }
+    }
+
+    // 按块号直接定位, 不逐行移动光标
+    auto block = document()->findBlockByNumber(std::clamp(local, 0, blockCount() - 1));
+    this->setTextCursor(QTextCursor(block));
 }
 
 //![constructor]
@@ -109,7 +280,7 @@ void CodeEditor::moveCursorToLine(uint32_t line)
 int CodeEditor::lineNumberAreaWidth()
 {
     int digits = 1;
-    int max = qMax(1, blockCount());
+    int max = qMax(1, isPaged() ? static_cast<int>(lineOffsets.size()) - 1 : blockCount());
     while (max >= 10) {
         max /= 10;
         ++digits;
@@ -142,6 +313,9 @@ void CodeEditor::updateLineNumberArea(const QRect &rect, int dy)
 
     if (rect.contains(viewport()->rect()))
         updateLineNumberAreaWidth(0);
+
+    if (highlighter->isLazy() && !highlightTimer->isActive())
+        highlightTimer->start();
 }
 
 //![slotUpdateRequest]
@@ -204,7 +378,7 @@ void CodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
 //![extraAreaPaintEvent_2]
     while (block.isValid() && top <= event->rect().bottom()) {
         if (block.isVisible() && bottom >= event->rect().top()) {
-            QString number = QString::number(blockNumber + 1);
+            QString number = QString::number(lineOffset() + blockNumber + 1);
             if (blockNumber == cursor_block_num) {
                 painter.setPen(Qt::black);
             } else {
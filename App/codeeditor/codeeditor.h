@@ -54,6 +54,9 @@
 #include <QPlainTextEdit>
 
 #include <QTextEdit>
+#include <QTimer>
+
+#include <vector>
 
 #include "highlighter.h"
 
@@ -75,8 +78,18 @@ class CodeEditor : public QPlainTextEdit
 public:
     CodeEditor(QWidget *parent = nullptr);
 
+    // line 为文件行号 (1起); 分页模式下不在当前页时先载入所在的页
     void moveCursorToLine(uint32_t line);
 
+    // 载入文件: 小文件整个载入; 大文件只建立行索引, 按页载入 (只读, 不可编辑)
+    bool loadFile(const QString &filename);
+
+    // 是否处于大文件分页模式
+    bool isPaged() const { return !pagedFilename.isEmpty(); }
+
+    // 清空内容并退出分页模式
+    void clearContent();
+
 public:
 
     void lineNumberAreaPaintEvent(QPaintEvent *event);
@@ -90,10 +103,31 @@ private slots:
     void highlightCurrentLine();
     void updateLineNumberArea(const QRect &rect, int dy);
 
+private:
+    // 懒高亮时, 高亮当前可见的未高亮块
+    void highlightVisibleBlocks();
+
+    // 分页模式: 载入从 firstLine (0起) 开始的一页
+    bool loadPage(int firstLine);
+    // 页首行号限制在文件范围内 (最后一页也是整页)
+    int clampPageFirstLine(int firstLine) const;
+    // 分页模式: 滚动到页首/页尾时载入相邻的页
+    void onScrollValueChanged(int value);
+
+    // 当前页中第一行的文件行号偏移 (非分页模式为0)
+    int lineOffset() const { return pageFirstLine; }
+
 private:
     QWidget *lineNumberArea;
 
     Highlighter *highlighter;
+    QTimer *highlightTimer; // 合并多次滚动/刷新请求, 在事件循环中高亮一次
+
+    // 大文件分页
+    QString pagedFilename;
+    std::vector<qint64> lineOffsets; // 每行在文件中的起始字节位置, 最后一项为文件长度
+    int pageFirstLine{0};
+    bool pageLoading{false};
 };
 
 //![codeeditordefinition]
@@ -54,116 +54,175 @@
 Highlighter::Highlighter(QTextDocument *parent)
     : QSyntaxHighlighter(parent)
 {
-    HighlightingRule rule;
+    numberFormat.setForeground(QColor("#FF8C00"));
 
-    // 数字, 放在最上面
-    intnumberFormat.setForeground(QColor("#FF8C00"));
-    rule.pattern = QRegularExpression(QStringLiteral(R"(\b\d+\b)"));
-    rule.format = intnumberFormat;
-    highlightingRules.append(rule);
-
-    doublenumberFormat.setForeground(QColor("#FF8C00"));
-    rule.pattern = QRegularExpression(QStringLiteral(R"(\b\d+\.\d*|^\d*\.\d+\b)"));
-    rule.format = doublenumberFormat;
-    highlightingRules.append(rule);
-
-    // 运算符, = + - > <
+    // 运算符, = + - > < * /
     operatorFormat.setForeground(QColor("#1E90FF"));
-    rule.pattern = QRegularExpression(QStringLiteral(R"([=\-\+><\*\/])"));
-    rule.format = operatorFormat;
-    highlightingRules.append(rule);
 
     functionFormat.setFontWeight(QFont::Bold);
     functionFormat.setForeground(QColor("#1E90FF"));
-    rule.pattern = QRegularExpression(QStringLiteral("\\b[A-Za-z0-9_]+(?=\\()"));
-    rule.format = functionFormat;
-    highlightingRules.append(rule);
 
     keywordFormat.setFontWeight(QFont::Bold);
     keywordFormat.setForeground(QColor("#c678dd"));
-    keywordFormat.setFontWeight(QFont::Bold);
-    const QString keywordPatterns[] = {
-        QStringLiteral("\\bimport\\b"), QStringLiteral("\\bfrom\\b"), QStringLiteral("\\bin\\b"),
-        QStringLiteral("\\bdouble\\b"), QStringLiteral("\\benum\\b"), QStringLiteral("\\bint\\b"),
-        QStringLiteral("\\bstr\\b"), QStringLiteral("\\bfloat\\b"), QStringLiteral("\\bas\\b"),
-        QStringLiteral("\\bTrue\\b"), QStringLiteral("\\bFalse\\b"), QStringLiteral("\\None\\b"),
-        QStringLiteral("\\band\\b"), QStringLiteral("\\bassert\\b"), QStringLiteral("\\bbreak\\b"),
-        QStringLiteral("\\bclass\\b"), QStringLiteral("\\bcontinue\\b"), QStringLiteral("\\bdef\\b"),
-        QStringLiteral("\\bdel\\b"), QStringLiteral("\\bif\\b"), QStringLiteral("\\belif\\b"),
-        QStringLiteral("\\belse\\b"), QStringLiteral("\\bexcept\\b"), QStringLiteral("\\btry\\b"),
-        QStringLiteral("\\bfinally\\b"), QStringLiteral("\\bis\\b"), QStringLiteral("\\bglobal\\b"),
-        QStringLiteral("\\blambda\\b"), QStringLiteral("\\bor\\b"), QStringLiteral("\\bwhile\\b"),
-        QStringLiteral("\\bwith\\b"), QStringLiteral("\\breturn\\b"), QStringLiteral("\\braise\\b"),
-        QStringLiteral("\\bnot\\b"), QStringLiteral("\\byield\\b"), QStringLiteral("\\bfor\\b"),
+    keywords = {
+        QStringLiteral("import"), QStringLiteral("from"), QStringLiteral("in"),
+        QStringLiteral("double"), QStringLiteral("enum"), QStringLiteral("int"),
+        QStringLiteral("str"), QStringLiteral("float"), QStringLiteral("as"),
+        QStringLiteral("True"), QStringLiteral("False"), QStringLiteral("None"),
+        QStringLiteral("and"), QStringLiteral("assert"), QStringLiteral("break"),
+        QStringLiteral("class"), QStringLiteral("continue"), QStringLiteral("def"),
+        QStringLiteral("del"), QStringLiteral("if"), QStringLiteral("elif"),
+        QStringLiteral("else"), QStringLiteral("except"), QStringLiteral("try"),
+        QStringLiteral("finally"), QStringLiteral("is"), QStringLiteral("global"),
+        QStringLiteral("lambda"), QStringLiteral("or"), QStringLiteral("while"),
+        QStringLiteral("with"), QStringLiteral("return"), QStringLiteral("raise"),
+        QStringLiteral("not"), QStringLiteral("yield"), QStringLiteral("for"),
     };
-    for (const QString &pattern : keywordPatterns) {
-        rule.pattern = QRegularExpression(pattern);
-        rule.format = keywordFormat;
-        highlightingRules.append(rule);
-    }
 
     // specific RS274Interpreter class
     classFormat.setFontWeight(QFont::Bold);
     classFormat.setForeground(Qt::darkMagenta);
-    rule.pattern = QRegularExpression(QStringLiteral(R"(\bRS274Interpreter\b)"));
-    rule.format = classFormat;
-    highlightingRules.append(rule);
 
     quotationFormat.setForeground(Qt::darkGreen);
-    rule.pattern = QRegularExpression(QStringLiteral("\".*\""));
-    rule.format = quotationFormat;
-    highlightingRules.append(rule);
-
-    quotation2Format.setForeground(Qt::darkGreen);
-    rule.pattern = QRegularExpression(QStringLiteral("\'.*\'"));
-    rule.format = quotation2Format;
-    highlightingRules.append(rule);
 
     singleLineCommentFormat.setForeground(Qt::gray);
-    rule.pattern = QRegularExpression(QStringLiteral("#[^\n]*"));
-    rule.format = singleLineCommentFormat;
-    highlightingRules.append(rule);
 
     multiLineCommentFormat.setForeground(Qt::red);
-    commentStartExpression = QRegularExpression(QStringLiteral("/\\*"));
-    commentEndExpression = QRegularExpression(QStringLiteral("\\*/"));
 }
 //! [6]
 
+void Highlighter::highlightBlockNow(const QTextBlock &block)
+{
+    forcedBlockNumber_ = block.blockNumber();
+    rehighlightBlock(block);
+    forcedBlockNumber_ = -1;
+}
+
 //! [7]
 void Highlighter::highlightBlock(const QString &text)
 {
-    for (const HighlightingRule &rule : qAsConst(highlightingRules)) {
-        QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
-        while (matchIterator.hasNext()) {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
-        }
+    // 懒高亮时跳过未请求的块, 保持未高亮状态; 状态不变也就不会连带高亮下一块
+    if (lazy_ && currentBlock().blockNumber() != forcedBlockNumber_) {
+        setCurrentBlockState(UnhighlightedState);
+        return;
     }
-//! [7] //! [8]
+
     setCurrentBlockState(0);
-//! [8]
-
-//! [9]
-    int startIndex = 0;
-    if (previousBlockState() != 1)
-        startIndex = text.indexOf(commentStartExpression);
-
-//! [9] //! [10]
-    while (startIndex >= 0) {
-//! [10] //! [11]
-        QRegularExpressionMatch match = commentEndExpression.match(text, startIndex);
-        int endIndex = match.capturedStart();
-        int commentLength = 0;
-        if (endIndex == -1) {
-            setCurrentBlockState(1);
-            commentLength = text.length() - startIndex;
-        } else {
-            commentLength = endIndex - startIndex
-                            + match.capturedLength();
+
+    int start = 0;
+    if (previousBlockState() == 1) {
+        start = _highlightMultiLineComment(text, 0);
+        if (start < 0) {
+            return;
         }
-        setFormat(startIndex, commentLength, multiLineCommentFormat);
-        startIndex = text.indexOf(commentStartExpression, startIndex + commentLength);
+    }
+
+    _tokenize(text, start);
+}
+//! [7]
+
+int Highlighter::_highlightMultiLineComment(const QString &text, int start)
+{
+    const int end = text.indexOf(QLatin1String("*/"), start);
+    if (end < 0) {
+        setFormat(start, text.length() - start, multiLineCommentFormat);
+        setCurrentBlockState(1);
+        return -1;
+    }
+
+    setFormat(start, end + 2 - start, multiLineCommentFormat);
+    return end + 2;
+}
+
+static inline bool _isWordChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+void Highlighter::_tokenize(const QString &text, int start)
+{
+    const int n = text.length();
+    int i = start;
+
+    while (i < n) {
+        const QChar c = text.at(i);
+        const QChar next = i + 1 < n ? text.at(i + 1) : QChar();
+
+        // 单行注释
+        if (c == QLatin1Char('#')) {
+            setFormat(i, n - i, singleLineCommentFormat);
+            return;
+        }
+
+        // 多行注释
+        if (c == QLatin1Char('/') && next == QLatin1Char('*')) {
+            i = _highlightMultiLineComment(text, i);
+            if (i < 0) {
+                return;
+            }
+            continue;
+        }
+
+        // 字符串, 到相同的引号或行尾
+        if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            const int end = text.indexOf(c, i + 1);
+            const int len = (end < 0 ? n : end + 1) - i;
+            setFormat(i, len, quotationFormat);
+            i += len;
+            continue;
+        }
+
+        // 数字: 123, 1.5, 1., .5 (标识符中的数字不算, 见下面的标识符分支)
+        if (c.isDigit() || (c == QLatin1Char('.') && next.isDigit())) {
+            int j = i;
+            while (j < n && text.at(j).isDigit()) {
+                ++j;
+            }
+            if (j < n && text.at(j) == QLatin1Char('.')) {
+                ++j;
+                while (j < n && text.at(j).isDigit()) {
+                    ++j;
+                }
+            }
+            setFormat(i, j - i, numberFormat);
+            i = j;
+            continue;
+        }
+
+        // 标识符: 关键字, 函数调用, RS274Interpreter
+        if (c.isLetter() || c == QLatin1Char('_')) {
+            int j = i + 1;
+            while (j < n && _isWordChar(text.at(j))) {
+                ++j;
+            }
+
+            const QString word = text.mid(i, j - i);
+            if (keywords.contains(word)) {
+                setFormat(i, j - i, keywordFormat);
+            } else if (word == QLatin1String("RS274Interpreter")) {
+                setFormat(i, j - i, classFormat);
+            } else if (j < n && text.at(j) == QLatin1Char('(')) {
+                setFormat(i, j - i, functionFormat);
+            }
+
+            i = j;
+            continue;
+        }
+
+        switch (c.unicode()) {
+        case '=':
+        case '-':
+        case '+':
+        case '>':
+        case '<':
+        case '*':
+        case '/':
+            setFormat(i, 1, operatorFormat);
+            break;
+        default:
+            break;
+        }
+
+        ++i;
     }
 }
-//! [11]
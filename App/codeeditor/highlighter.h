@@ -51,9 +51,10 @@
 #ifndef HIGHLIGHTER_H
 #define HIGHLIGHTER_H
 
+#include <QSet>
 #include <QSyntaxHighlighter>
+#include <QTextBlock>
 #include <QTextCharFormat>
-#include <QRegularExpression>
 
 QT_BEGIN_NAMESPACE
 class QTextDocument;
@@ -67,30 +68,40 @@ class Highlighter : public QSyntaxHighlighter
 public:
     Highlighter(QTextDocument *parent = 0);
 
+    // 未高亮的块的状态 (QTextBlock::userState 的默认值)
+    static constexpr int UnhighlightedState = -1;
+
+    // 懒高亮 (用于大文件): 文档变化时不高亮, 只高亮编辑器通过
+    // highlightBlockNow 请求的块 (可见的块)
+    void setLazy(bool lazy) { lazy_ = lazy; }
+    bool isLazy() const { return lazy_; }
+
+    void highlightBlockNow(const QTextBlock &block);
+
 protected:
     void highlightBlock(const QString &text) override;
 
 private:
-    struct HighlightingRule
-    {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    QVector<HighlightingRule> highlightingRules;
+    // 单遍扫描的分词高亮, 代替逐条正则匹配
+    void _tokenize(const QString &text, int start);
+
+    // 返回注释结束后的位置; 到行尾仍未结束时返回 -1
+    int _highlightMultiLineComment(const QString &text, int start);
+
+private:
+    QSet<QString> keywords;
 
-    QRegularExpression commentStartExpression;
-    QRegularExpression commentEndExpression;
+    bool lazy_{false};
+    int forcedBlockNumber_{-1}; // 懒高亮时, 正在按请求高亮的块
 
     QTextCharFormat keywordFormat;
     QTextCharFormat classFormat;
     QTextCharFormat singleLineCommentFormat;
     QTextCharFormat multiLineCommentFormat;
     QTextCharFormat quotationFormat;
-    QTextCharFormat quotation2Format;
     QTextCharFormat functionFormat;
 
-    QTextCharFormat intnumberFormat;
-    QTextCharFormat doublenumberFormat;
+    QTextCharFormat numberFormat;
     QTextCharFormat operatorFormat;
 };
 //! [0]
@@ -547,7 +547,8 @@ void EcatManager::_soem_conf_servo_default_op() {
 bool EcatManager::_soem_check_receive_valid(int wkc) {
     const int expected_wkc = (servo_num_ + io_num_) * 3;
     if (wkc < expected_wkc || wkc < 0) {
-        s_logger->warn("soem wkc not ok: {}", wkc);
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                             "soem wkc not ok: {}", wkc);
         return false;
     } else {
         return true;
@@ -562,18 +563,21 @@ bool EcatManager::_igh_check_receive_valid() {
     ecrt_master_state(igh_master_, &master_state);
 
     if (master_state.slaves_responding != servo_num_ + io_num_) [[unlikely]] {
-        s_logger->warn("igh slaves_responding: {}",
-                       (int)master_state.slaves_responding);
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                             "igh slaves_responding: {}",
+                             (int)master_state.slaves_responding);
         return false;
     }
 
     if (!master_state.link_up) [[unlikely]] {
-        s_logger->warn("igh link down");
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn, "igh link down");
         return false;
     }
 
     if (master_state.al_states != 0b1000) [[unlikely]] {
-        s_logger->warn("igh al_states: {:4b}", (uint8_t)master_state.al_states);
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                             "igh al_states: {:4b}",
+                             (uint8_t)master_state.al_states);
         return false;
     }
 
@@ -585,16 +589,17 @@ bool EcatManager::_igh_check_receive_valid() {
         ecrt_domain_state(igh_domain_vec_[i], &domain_state);
 
         if (domain_state.working_counter != 3) [[unlikely]] {
-            // s_logger->warn("igh domain {} wkc {}", i,
-            //                (int)domain_state.working_counter);
-            // 先注释掉不打印, 太多了
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "igh domain {} wkc {}", i,
+                                 (int)domain_state.working_counter);
             return false;
         }
 
         if (domain_state.wc_state != ec_wc_state_t::EC_WC_COMPLETE)
             [[unlikely]] {
-            s_logger->warn("igh domain {} wc_state {}", i,
-                           (int)domain_state.wc_state);
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "igh domain {} wc_state {}", i,
+                                 (int)domain_state.wc_state);
             return false;
         }
     }
@@ -604,15 +609,17 @@ bool EcatManager::_igh_check_receive_valid() {
 
         if (domain_state.working_counter != 3 * (servo_num_ + io_num_))
             [[unlikely]] {
-            s_logger->warn("igh domain wkc {}",
-                           (int)domain_state.working_counter);
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "igh domain wkc {}",
+                                 (int)domain_state.working_counter);
             return false;
         }
 
         if (domain_state.wc_state != ec_wc_state_t::EC_WC_COMPLETE)
             [[unlikely]] {
-            s_logger->warn("igh domain wc_state {}",
-                           (int)domain_state.wc_state);
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "igh domain wc_state {}",
+                                 (int)domain_state.wc_state);
             return false;
         }
     }
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace edm {
+namespace interpreter {
+
+// rs274.py get_command_records() 输出的二进制命令记录,
+// 布局与 rs274.py 中的 _COMMAND_RECORD / _POINT_RECORD 一致 (小端, 无填充)
+constexpr int RS274CommandRecordVersion = 1;
+
+enum RS274CommandRecordFlag : uint32_t {
+    RecordFlagM05IgnoreTouchDetect = 1u << 0,
+    RecordFlagG00Touch = 1u << 1,
+    RecordFlagDrillTouch = 1u << 2,
+    RecordFlagDrillBreakout = 1u << 3,
+    RecordFlagDrillBack = 1u << 4,
+    RecordFlagHasSpindleSpeed = 1u << 5,
+    RecordFlagHasOptions = 1u << 6,
+};
+
+struct RS274CommandRecord {
+    double coords[6];   // x y z b c a, 有值的轴见 axis_mask
+    double real_value;  // DelayTime / DrillDepth (mm)
+    double real_value2; // DrillSpindleSpeed
+
+    int32_t type;        // 与 GCodeTaskType 取值相同
+    int32_t line_number;
+    int32_t coord_mode;  // 与 GCodeCoordinateMode 取值相同, -1: 无
+    int32_t coord_index; // -1: 无
+    int32_t feed_speed;  // -1: 无
+    int32_t int_value;   // EleparamIndex / DrillHoldTime (ms)
+
+    uint32_t flags;     // RS274CommandRecordFlag
+    uint32_t axis_mask; // Coordinates有值的轴 / SetZeroAxisList, bit0: x
+    uint32_t str_offset; // CommandStr 在字符串池中的位置
+    uint32_t str_size;
+    uint32_t opt_offset; // Options 在字符串池中的位置, 每项以'\0'结尾
+    uint32_t opt_size;
+    uint32_t point_first; // G01GroupPoints 在点记录数组中的位置
+    uint32_t point_count;
+};
+static_assert(sizeof(RS274CommandRecord) == 120);
+
+struct RS274PointRecord {
+    double coords[6];
+
+    int32_t coord_mode;
+    int32_t line_number;
+    int32_t feed_speed;
+
+    uint32_t axis_mask;
+    uint32_t str_offset;
+    uint32_t str_size;
+};
+static_assert(sizeof(RS274PointRecord) == 72);
+
+// 一次解析得到的全部记录
+struct RS274CommandRecords {
+    std::vector<RS274CommandRecord> commands;
+    std::vector<RS274PointRecord> points;
+    std::string string_pool;
+
+    // 越界返回空串
+    std::string_view str(uint32_t offset, uint32_t size) const {
+        if (static_cast<std::size_t>(offset) + size > string_pool.size()) {
+            return {};
+        }
+        return std::string_view{string_pool}.substr(offset, size);
+    }
+
+    // 追加一块独立的记录 (分块解析的结果合并为整个程序), 修正各偏移
+    void append(const RS274CommandRecords &chunk) {
+        const auto pool_base = static_cast<uint32_t>(string_pool.size());
+        const auto point_base = static_cast<uint32_t>(points.size());
+
+        for (auto r : chunk.commands) {
+            r.str_offset += pool_base;
+            r.opt_offset += pool_base;
+            r.point_first += point_base;
+            commands.push_back(r);
+        }
+
+        for (auto p : chunk.points) {
+            p.str_offset += pool_base;
+            points.push_back(p);
+        }
+
+        string_pool += chunk.string_pool;
+    }
+
+    std::vector<std::string> options(const RS274CommandRecord &r) const {
+        std::vector<std::string> ret;
+        auto sv = str(r.opt_offset, r.opt_size);
+        while (!sv.empty()) {
+            auto end = sv.find('\0');
+            if (end == std::string_view::npos) {
+                end = sv.size();
+            }
+            ret.emplace_back(sv.substr(0, end));
+            sv.remove_prefix(std::min(end + 1, sv.size()));
+        }
+        return ret;
+    }
+};
+
+} // namespace interpreter
+} // namespace edm
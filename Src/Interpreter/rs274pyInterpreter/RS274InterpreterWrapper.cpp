@@ -2,6 +2,7 @@
 
 #include <Python.h>
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -10,6 +11,7 @@
 #include <boost/python/exec.hpp>
 #include <boost/python/extract.hpp>
 #include <boost/python/import.hpp>
+#include <boost/python/tuple.hpp>
 
 // log
 #include "Logger/LogMacro.h"
@@ -61,6 +63,133 @@ static void py_add_module_path(const char *module_path) {
     module_sys_path_append(module_path);
 }
 
+using ProgressCallback = RS274InterpreterWrapper::ProgressCallback;
+
+// rs274.set_progress_hook 的回调, self 是保存 ProgressCallback 指针的 capsule
+static PyObject *py_progress_hook(PyObject *self, PyObject *args) {
+    auto progress_cb = static_cast<const ProgressCallback *>(
+        PyCapsule_GetPointer(self, "edm.rs274.progress_cb"));
+    if (!progress_cb) {
+        return nullptr;
+    }
+
+    int line_number = 0;
+    if (!PyArg_ParseTuple(args, "i", &line_number)) {
+        return nullptr;
+    }
+
+    return PyBool_FromLong((*progress_cb)(line_number));
+}
+
+static PyMethodDef s_progress_hook_def = {"progress_hook", py_progress_hook,
+                                          METH_VARARGS, nullptr};
+
+// progress_cb 需在解析结束前一直有效
+static void py_set_progress_hook(const ProgressCallback *progress_cb) {
+    bp::object capsule{bp::handle<>(PyCapsule_New(
+        const_cast<ProgressCallback *>(progress_cb),
+        "edm.rs274.progress_cb", nullptr))};
+    bp::object hook{
+        bp::handle<>(PyCFunction_New(&s_progress_hook_def, capsule.ptr()))};
+
+    bp::import("rs274").attr("set_progress_hook")(hook);
+}
+
+// 通过buffer协议把 bytes 对象的内容拷贝出来, 长度必须是 sizeof(T) 的整数倍
+template <typename T>
+static void py_buffer_copy_to(bp::object obj, T *dst_begin, std::size_t size) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj.ptr(), &view, PyBUF_SIMPLE) != 0) {
+        bp::throw_error_already_set();
+    }
+
+    if (static_cast<std::size_t>(view.len) != size) {
+        PyBuffer_Release(&view);
+        throw RS274InterpreterException("record error", "buffer size mismatch");
+    }
+
+    if (size > 0) {
+        std::memcpy(dst_begin, view.buf, size);
+    }
+    PyBuffer_Release(&view);
+}
+
+template <typename T>
+static void py_buffer_to_vector(bp::object obj, std::vector<T> &out) {
+    auto len = bp::len(obj);
+    if (len % sizeof(T) != 0) {
+        throw RS274InterpreterException(
+            "record error", "buffer size " + std::to_string(len) +
+                                " is not a multiple of record size " +
+                                std::to_string(sizeof(T)));
+    }
+
+    out.resize(len / sizeof(T));
+    py_buffer_copy_to(obj, out.data(), len);
+}
+
+// (版本号, 命令记录, G01组点记录, 字符串池) -> RS274CommandRecords
+static RS274CommandRecords py_records_from_tuple(const bp::tuple &t) {
+    if (bp::len(t) != 4) {
+        throw RS274InterpreterException("record error", "record tuple size");
+    }
+
+    int version = bp::extract<int>(bp::object{t[0]});
+    if (version != RS274CommandRecordVersion) {
+        throw RS274InterpreterException(
+            "record error",
+            "record version mismatch: " + std::to_string(version));
+    }
+
+    RS274CommandRecords records;
+    py_buffer_to_vector(bp::object{t[1]}, records.commands);
+    py_buffer_to_vector(bp::object{t[2]}, records.points);
+
+    bp::object pool{t[3]};
+    records.string_pool.resize(bp::len(pool));
+    py_buffer_copy_to(pool, records.string_pool.data(),
+                      records.string_pool.size());
+
+    return records;
+}
+
+using ChunkCallback = RS274InterpreterWrapper::ChunkCallback;
+
+// rs274.set_chunk_hook 的回调, self 是保存 ChunkCallback 指针的 capsule
+// C++异常不能穿过Python栈帧, 转为Python异常
+static PyObject *py_chunk_hook(PyObject *self, PyObject *args) {
+    auto chunk_cb = static_cast<const ChunkCallback *>(
+        PyCapsule_GetPointer(self, "edm.rs274.chunk_cb"));
+    if (!chunk_cb) {
+        return nullptr;
+    }
+
+    try {
+        bp::tuple t{bp::handle<>(bp::borrowed(args))};
+        return PyBool_FromLong((*chunk_cb)(py_records_from_tuple(t)));
+    } catch (const bp::error_already_set &) {
+        return nullptr;
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        return nullptr;
+    }
+}
+
+static PyMethodDef s_chunk_hook_def = {"chunk_hook", py_chunk_hook,
+                                       METH_VARARGS, nullptr};
+
+// chunk_cb 需在解析结束前一直有效
+static void py_set_chunk_hook(const ChunkCallback *chunk_cb,
+                              std::size_t chunk_size) {
+    bp::object capsule{bp::handle<>(
+        PyCapsule_New(const_cast<ChunkCallback *>(chunk_cb),
+                      "edm.rs274.chunk_cb", nullptr))};
+    bp::object hook{
+        bp::handle<>(PyCFunction_New(&s_chunk_hook_def, capsule.ptr()))};
+
+    bp::import("rs274").attr("set_chunk_hook")(hook, chunk_size);
+}
+
 static void py_print_keys_of_dict(bp::object dict_object) {
     bp::dict d(dict_object);
 
@@ -112,8 +241,22 @@ public:
     RS274InterpreterWrapper::json_value
     parse_file_to_json(std::string_view filename);
 
+    RS274CommandRecords parse_file_to_records(
+        std::string_view filename,
+        const RS274InterpreterWrapper::ProgressCallback &progress_cb);
+
+    void parse_file_to_record_chunks(
+        std::string_view filename,
+        const RS274InterpreterWrapper::ChunkCallback &chunk_cb,
+        std::size_t chunk_size,
+        const RS274InterpreterWrapper::ProgressCallback &progress_cb);
+
 private:
-    bp::object get_parsed_py_interpreter_instance(std::string_view filename);
+    bp::object get_parsed_py_interpreter_instance(
+        std::string_view filename,
+        const RS274InterpreterWrapper::ProgressCallback *progress_cb = nullptr,
+        const RS274InterpreterWrapper::ChunkCallback *chunk_cb = nullptr,
+        std::size_t chunk_size = 0);
 
     void handle_py_exception_and_throw();
 
@@ -123,7 +266,10 @@ private:
 };
 
 bp::object RS274InterpreterWrapperImpl::get_parsed_py_interpreter_instance(
-    std::string_view filename) {
+    std::string_view filename,
+    const RS274InterpreterWrapper::ProgressCallback *progress_cb,
+    const RS274InterpreterWrapper::ChunkCallback *chunk_cb,
+    std::size_t chunk_size) {
     py_add_module_path(
         RS274InterpreterWrapper::instance()->get_rs274_py_module_dir().data());
 
@@ -138,6 +284,14 @@ bp::object RS274InterpreterWrapperImpl::get_parsed_py_interpreter_instance(
              main_module_namespace_); // 必须如此导入,
                                       // 才能将rs274模块导入到__main__作用域中
 
+    if (progress_cb && *progress_cb) {
+        py_set_progress_hook(progress_cb);
+    }
+
+    if (chunk_cb && *chunk_cb) {
+        py_set_chunk_hook(chunk_cb, chunk_size);
+    }
+
     // 在__main__作用域, 运行目标文件
     bp::object ignored = bp::exec_file(filename.data(), main_module_namespace_);
 
@@ -224,6 +378,50 @@ RS274InterpreterWrapperImpl::parse_file_to_json(std::string_view filename) {
     // do not handle other exceptions
 }
 
+RS274CommandRecords RS274InterpreterWrapperImpl::parse_file_to_records(
+    std::string_view filename,
+    const RS274InterpreterWrapper::ProgressCallback &progress_cb) {
+    PythonInterpreterWrapper wrapper;
+
+    try {
+        bp::object interp_instance =
+            get_parsed_py_interpreter_instance(filename, &progress_cb);
+
+        // (版本号, 命令记录, G01组点记录, 字符串池)
+        return py_records_from_tuple(
+            bp::tuple{interp_instance.attr("get_command_records")()});
+
+    } catch (const bp::error_already_set &) {
+        s_logger->error("parse_file_to_records error occured");
+
+        handle_py_exception_and_throw();
+
+        throw;
+    }
+}
+
+void RS274InterpreterWrapperImpl::parse_file_to_record_chunks(
+    std::string_view filename, const ChunkCallback &chunk_cb,
+    std::size_t chunk_size,
+    const RS274InterpreterWrapper::ProgressCallback &progress_cb) {
+    PythonInterpreterWrapper wrapper;
+
+    try {
+        bp::object interp_instance = get_parsed_py_interpreter_instance(
+            filename, &progress_cb, &chunk_cb, chunk_size);
+
+        // 最后不足一块的命令
+        interp_instance.attr("flush_chunk")();
+
+    } catch (const bp::error_already_set &) {
+        s_logger->error("parse_file_to_record_chunks error occured");
+
+        handle_py_exception_and_throw();
+
+        throw;
+    }
+}
+
 void RS274InterpreterWrapperImpl::handle_py_exception_and_throw() {
     static const char *_unknown_err_type_str = "Unknown Err Type";
     static const char *_unknown_err_value_str = "Unknown Err Value";
@@ -305,5 +503,21 @@ RS274InterpreterWrapper::parse_file_to_json(std::string_view filename) {
     return impl_->parse_file_to_json(filename);
 }
 
+RS274CommandRecords RS274InterpreterWrapper::parse_file_to_records(
+    std::string_view filename, const ProgressCallback &progress_cb) {
+    auto impl_ = std::make_shared<RS274InterpreterWrapperImpl>();
+
+    return impl_->parse_file_to_records(filename, progress_cb);
+}
+
+void RS274InterpreterWrapper::parse_file_to_record_chunks(
+    std::string_view filename, const ChunkCallback &chunk_cb,
+    std::size_t chunk_size, const ProgressCallback &progress_cb) {
+    auto impl_ = std::make_shared<RS274InterpreterWrapperImpl>();
+
+    impl_->parse_file_to_record_chunks(filename, chunk_cb, chunk_size,
+                                       progress_cb);
+}
+
 } // namespace interpreter
 } // namespace edm
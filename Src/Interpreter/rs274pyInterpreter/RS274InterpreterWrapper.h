@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -10,6 +11,8 @@
 
 #include "json.hpp" // meojson
 
+#include "RS274CommandRecord.h"
+
 namespace edm {
 namespace interpreter {
 
@@ -64,6 +67,28 @@ public:
     // thrown json返回
     static json_value parse_file_to_json(std::string_view filename);
 
+    // 解析进度回调: 参数为当前解析到的行号, 返回false时中止解析
+    // (解析抛出 RS274InterpreterException); 每解析若干条命令调用一次
+    using ProgressCallback = std::function<bool(int line_number)>;
+
+    // static method: parse a file, if an error happens, an exception will be
+    // thrown 二进制记录返回 (不经过json, 用于大程序)
+    static RS274CommandRecords
+    parse_file_to_records(std::string_view filename,
+                          const ProgressCallback &progress_cb = {});
+
+    // 分块回调: 每块是独立的记录 (字符串池和G01组点下标均从0开始),
+    // 返回false时中止解析
+    using ChunkCallback = std::function<bool(RS274CommandRecords &&chunk)>;
+
+    // static method: 流水线解析, 每解释出 chunk_size 条命令就交给 chunk_cb,
+    // 不等待整个文件执行完; 出错时已交出的块仍然有效, 随后抛出异常
+    static void
+    parse_file_to_record_chunks(std::string_view filename,
+                                const ChunkCallback &chunk_cb,
+                                std::size_t chunk_size = 1024,
+                                const ProgressCallback &progress_cb = {});
+
 public:
     // member functions
 
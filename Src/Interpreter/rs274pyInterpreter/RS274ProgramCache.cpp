@@ -0,0 +1,275 @@
+#include "RS274ProgramCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Logger/LogMacro.h"
+#include "Utils/Format/edm_format.h"
+
+EDM_STATIC_LOGGER_NAME(s_logger, "interp");
+
+namespace fs = std::filesystem;
+
+namespace edm {
+namespace interpreter {
+
+namespace {
+
+constexpr char CacheMagic[8] = {'E', 'D', 'M', 'R', 'S', '2', '7', '4'};
+constexpr const char *CacheFileExt = ".rs274c";
+
+struct _CacheHeader {
+    char magic[8];
+    uint32_t record_version;
+    uint32_t header_size;
+    uint64_t command_count;
+    uint64_t point_count;
+    uint64_t pool_size;
+    uint64_t payload_hash;
+};
+static_assert(sizeof(_CacheHeader) == 48);
+
+// FNV-1a 64
+class _Hasher {
+public:
+    void update(const void *data, std::size_t size) {
+        auto p = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            h_ ^= p[i];
+            h_ *= 0x100000001b3ull;
+        }
+        size_ += size;
+    }
+
+    inline auto value() const { return h_; }
+    inline auto size() const { return size_; }
+
+private:
+    uint64_t h_{0xcbf29ce484222325ull};
+    uint64_t size_{0};
+};
+
+bool _hash_file(const std::string &filename, _Hasher &hasher) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+
+    std::vector<char> buf(64 * 1024);
+    while (ifs) {
+        ifs.read(buf.data(), buf.size());
+        hasher.update(buf.data(), static_cast<std::size_t>(ifs.gcount()));
+    }
+
+    return !ifs.bad();
+}
+
+uint64_t _payload_hash(const RS274CommandRecords &records) {
+    _Hasher hasher;
+    hasher.update(records.commands.data(),
+                  records.commands.size() * sizeof(RS274CommandRecord));
+    hasher.update(records.points.data(),
+                  records.points.size() * sizeof(RS274PointRecord));
+    hasher.update(records.string_pool.data(), records.string_pool.size());
+    return hasher.value();
+}
+
+} // namespace
+
+RS274ProgramCache::RS274ProgramCache(std::string cache_dir,
+                                     std::size_t max_entries)
+    : cache_dir_(std::move(cache_dir)),
+      max_entries_(std::max<std::size_t>(max_entries, 1)) {}
+
+std::optional<std::string>
+RS274ProgramCache::ProgramHash(const std::string &program_file) {
+    _Hasher hasher;
+    if (!_hash_file(program_file, hasher)) {
+        s_logger->warn("RS274ProgramCache: hash file failed: {}", program_file);
+        return std::nullopt;
+    }
+
+    return EDM_FMT::format("{:016x}-{:x}", hasher.value(), hasher.size());
+}
+
+std::optional<std::string>
+RS274ProgramCache::make_key(const std::string &program_hash,
+                            const std::string &module_dir) const {
+    _Hasher module_hasher;
+    const auto module_file = (fs::path{module_dir} / "rs274.py").string();
+    if (!_hash_file(module_file, module_hasher)) {
+        s_logger->warn("RS274ProgramCache: hash module failed: {}",
+                       module_file);
+        return std::nullopt;
+    }
+
+    return EDM_FMT::format("{}-{:016x}-v{}", program_hash,
+                           module_hasher.value(), RS274CommandRecordVersion);
+}
+
+std::string RS274ProgramCache::_cache_file(const std::string &key) const {
+    return (fs::path{cache_dir_} / (key + CacheFileExt)).string();
+}
+
+std::optional<RS274CommandRecords>
+RS274ProgramCache::load(const std::string &key) const {
+    const auto filename = _cache_file(key);
+
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        return std::nullopt; // 未命中
+    }
+
+    _CacheHeader header;
+    if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0 ||
+        header.record_version != RS274CommandRecordVersion ||
+        header.header_size != sizeof(_CacheHeader)) {
+        s_logger->warn("RS274ProgramCache: bad header: {}", filename);
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    const auto file_size = fs::file_size(filename, ec);
+    if (ec || file_size < sizeof(_CacheHeader)) {
+        s_logger->warn("RS274ProgramCache: size mismatch: {}", filename);
+        return std::nullopt;
+    }
+
+    // 各项数量先用文件大小限定, 再相乘求和, 防止溢出
+    const uint64_t payload_size = file_size - sizeof(_CacheHeader);
+    if (header.command_count > payload_size / sizeof(RS274CommandRecord) ||
+        header.point_count > payload_size / sizeof(RS274PointRecord) ||
+        header.pool_size > payload_size ||
+        header.command_count * sizeof(RS274CommandRecord) +
+                header.point_count * sizeof(RS274PointRecord) +
+                header.pool_size !=
+            payload_size) {
+        s_logger->warn("RS274ProgramCache: size mismatch: {}", filename);
+        return std::nullopt;
+    }
+
+    // 整块读入并校验哈希后, 再拆分到各记录数组
+    std::vector<char> payload(payload_size);
+    if (!ifs.read(payload.data(), payload.size())) {
+        s_logger->warn("RS274ProgramCache: read failed: {}", filename);
+        return std::nullopt;
+    }
+
+    _Hasher hasher;
+    hasher.update(payload.data(), payload.size());
+    if (hasher.value() != header.payload_hash) {
+        s_logger->warn("RS274ProgramCache: payload corrupted: {}", filename);
+        return std::nullopt;
+    }
+
+    RS274CommandRecords records;
+    records.commands.resize(header.command_count);
+    records.points.resize(header.point_count);
+
+    const char *p = payload.data();
+    const auto commands_bytes =
+        records.commands.size() * sizeof(RS274CommandRecord);
+    const auto points_bytes = records.points.size() * sizeof(RS274PointRecord);
+    if (commands_bytes > 0) {
+        std::memcpy(records.commands.data(), p, commands_bytes);
+    }
+    if (points_bytes > 0) {
+        std::memcpy(records.points.data(), p + commands_bytes, points_bytes);
+    }
+    records.string_pool.assign(p + commands_bytes + points_bytes,
+                               header.pool_size);
+
+    // 更新修改时间, 用于淘汰最久未使用的缓存
+    fs::last_write_time(filename, fs::file_time_type::clock::now(), ec);
+
+    return records;
+}
+
+bool RS274ProgramCache::store(const std::string &key,
+                              const RS274CommandRecords &records) {
+    std::error_code ec;
+    fs::create_directories(cache_dir_, ec);
+    if (ec) {
+        s_logger->warn("RS274ProgramCache: create dir {} failed: {}",
+                       cache_dir_, ec.message());
+        return false;
+    }
+
+    _CacheHeader header;
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.record_version = RS274CommandRecordVersion;
+    header.header_size = sizeof(_CacheHeader);
+    header.command_count = records.commands.size();
+    header.point_count = records.points.size();
+    header.pool_size = records.string_pool.size();
+    header.payload_hash = _payload_hash(records);
+
+    const auto filename = _cache_file(key);
+    const auto tmp_filename = filename + ".tmp";
+
+    {
+        std::ofstream ofs(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            s_logger->warn("RS274ProgramCache: open {} failed", tmp_filename);
+            return false;
+        }
+
+        ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char *>(records.commands.data()),
+                  records.commands.size() * sizeof(RS274CommandRecord));
+        ofs.write(reinterpret_cast<const char *>(records.points.data()),
+                  records.points.size() * sizeof(RS274PointRecord));
+        ofs.write(records.string_pool.data(), records.string_pool.size());
+
+        if (!ofs.flush()) {
+            s_logger->warn("RS274ProgramCache: write {} failed", tmp_filename);
+            ofs.close();
+            fs::remove(tmp_filename, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tmp_filename, filename, ec);
+    if (ec) {
+        s_logger->warn("RS274ProgramCache: rename {} failed: {}", tmp_filename,
+                       ec.message());
+        fs::remove(tmp_filename, ec);
+        return false;
+    }
+
+    _prune();
+    return true;
+}
+
+void RS274ProgramCache::_prune() {
+    std::vector<std::pair<fs::file_time_type, fs::path>> entries;
+
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(cache_dir_, ec)) {
+        if (entry.path().extension() != CacheFileExt) {
+            continue;
+        }
+        auto t = entry.last_write_time(ec);
+        if (!ec) {
+            entries.emplace_back(t, entry.path());
+        }
+    }
+
+    if (entries.size() <= max_entries_) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end());
+    for (std::size_t i = 0; i < entries.size() - max_entries_; ++i) {
+        s_logger->debug("RS274ProgramCache: remove {}",
+                        entries[i].second.string());
+        fs::remove(entries[i].second, ec);
+    }
+}
+
+} // namespace interpreter
+} // namespace edm
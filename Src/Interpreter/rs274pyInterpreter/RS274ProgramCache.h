@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "RS274CommandRecord.h"
+
+namespace edm {
+namespace interpreter {
+
+/**
+ * 已解析G代码程序的磁盘缓存 (内容寻址):
+ * key 由程序文件内容哈希 + rs274.py 内容哈希 + 记录格式版本组成,
+ * 程序或 rs274.py 任何改动都会得到新的key, 旧缓存自然失效;
+ * 值为 RS274CommandRecords 的二进制形式, 命中时直接读入, 不启动Python解释器.
+ *
+ * - 只对程序文件本身取哈希, 程序中 import 的其他文件改动不会被感知
+ * - 写入先写临时文件再rename, 读取时校验长度和数据哈希, 损坏的缓存视为未命中
+ * - 缓存文件数超过 max_entries 时删除最久未使用的
+ */
+class RS274ProgramCache final {
+public:
+    RS274ProgramCache(std::string cache_dir, std::size_t max_entries = 64);
+
+    // 程序文件内容哈希 (含长度), 也用于判断两次打开的是否为同一程序;
+    // 文件读取失败返回nullopt
+    static std::optional<std::string>
+    ProgramHash(const std::string &program_file);
+
+    // 由 ProgramHash 的结果计算缓存key, rs274.py 读取失败返回nullopt
+    std::optional<std::string> make_key(const std::string &program_hash,
+                                        const std::string &module_dir) const;
+
+    // 未命中返回nullopt
+    std::optional<RS274CommandRecords> load(const std::string &key) const;
+
+    bool store(const std::string &key, const RS274CommandRecords &records);
+
+    inline const auto &cache_dir() const { return cache_dir_; }
+
+private:
+    std::string _cache_file(const std::string &key) const;
+
+    void _prune();
+
+private:
+    std::string cache_dir_;
+    std::size_t max_entries_;
+};
+
+} // namespace interpreter
+} // namespace edm
@@ -1,7 +1,10 @@
 from __future__ import annotations
 from enum import Enum, unique
+from bisect import bisect_right
 import json
-from inspect import stack
+import linecache
+import struct
+import sys
 
 __all__ = ["InterpreterException", "RS274Interpreter", "Points"]
         
@@ -207,14 +210,41 @@ class Environment(object):
     def get_feed_speed(self) -> int:
         return self.__feed_speed
     
+# 行号和代码通过调用者的栈帧获取, 不使用 inspect.stack()
+# (stack()每次都构造整个调用栈并读取每一帧的源码上下文, 大程序解析时占绝大部分时间)
+
+# id(code对象) -> (code对象, 指令偏移列表, 行号列表)
+# frame.f_lineno 每次都从头扫描行号表, 对上万行的模块级代码是O(n)的,
+# 这里每个code对象只建一次表, 之后按 f_lasti 二分查找.
+# 用id作key: code对象的hash要遍历整个字节码和常量; 表中持有code对象, id不会被复用
+_line_tables = {}
+
+def _frame_linenumber(frame) -> int:
+    code = frame.f_code
+    table = _line_tables.get(id(code))
+    if (table is None):
+        if (not hasattr(code, "co_lines")): # python < 3.10
+            return frame.f_lineno
+        starts = []
+        lines = []
+        for start, _, line in code.co_lines():
+            starts.append(start)
+            lines.append(line)
+        table = _line_tables[id(code)] = (code, starts, lines)
+    
+    i = bisect_right(table[1], frame.f_lasti) - 1
+    line = table[2][i] if (i >= 0) else None
+    return line if (line is not None) else frame.f_lineno
+
 def _get_caller_linenumber(layer = 1) -> int:
-    return stack()[1 + layer].lineno
+    return _frame_linenumber(sys._getframe(1 + layer))
 
+# 源码行通过 linecache 获取 (文件只读取一次)
 def _get_caller_code(layer = 1) -> str:
-    return stack()[1 + layer].code_context[0][:-1]
+    frame = sys._getframe(1 + layer)
+    return linecache.getline(frame.f_code.co_filename, _frame_linenumber(frame)).rstrip("\r\n")
 
 def _get_stackmessage(layer = 1) -> str:
-    # call_linenum = currentframe().f_back.f_back.f_lineno
     call_linenum = _get_caller_linenumber(layer + 1)
     call_code = _get_caller_code(layer + 1)
     # stack_message = f"In Line {call_linenum}:\n{call_code}"
@@ -222,11 +252,61 @@ def _get_stackmessage(layer = 1) -> str:
     
     return stack_message
 
+# 解析进度回调, 由C++端通过 set_progress_hook 设置:
+# hook(line_number: int) -> bool, 返回False时中止解析
+_progress_hook = None
+_PROGRESS_INTERVAL = 256
+
+def set_progress_hook(hook) -> None:
+    global _progress_hook
+    _progress_hook = hook
+
+# 分块回调 (流水线解析), 由C++端通过 set_chunk_hook 设置:
+# hook(version, cmd_bytes, point_bytes, pool_bytes) -> bool, 返回False时中止解析
+# 每解释出 chunk_size 条命令, 将这些命令打包为一块独立的记录交给C++端
+_chunk_hook = None
+_chunk_size = 1024
+_chunk_owner = None # 分块输出的解释器实例, 只允许一个
+
+def set_chunk_hook(hook, chunk_size: int = 1024) -> None:
+    global _chunk_hook, _chunk_size, _chunk_owner
+    _chunk_hook = hook
+    _chunk_size = max(1, chunk_size)
+    _chunk_owner = None
+
 class RS274Interpreter(object):
     def __init__(self) -> None:
         self.__g_environment = Environment() # 初始化解释器全局环境
         self.__g_command_list = [] # 解释出的command列表
+        self.__chunk_begin = 0 # 尚未分块输出的第一条命令
+        
+    def _append_command(self, command: dict) -> None:
+        self.__g_command_list.append(command)
+        
+        # 每 _PROGRESS_INTERVAL 条命令报告一次进度
+        if (_progress_hook is not None and len(self.__g_command_list) % _PROGRESS_INTERVAL == 0):
+            if (not _progress_hook(command[CommandDictKey.LineNumber.name])):
+                raise InterpreterException("Parse Canceled")
+        
+        if (_chunk_hook is not None and len(self.__g_command_list) - self.__chunk_begin >= _chunk_size):
+            self.flush_chunk()
+    
+    # 将尚未输出的命令作为一块交给分块回调; 文件执行完后由C++端调用一次, 输出最后不足的一块
+    def flush_chunk(self) -> None:
+        global _chunk_owner
+        if (_chunk_hook is None or self.__chunk_begin >= len(self.__g_command_list)):
+            return
         
+        if (_chunk_owner is None):
+            _chunk_owner = self
+        elif (_chunk_owner is not self):
+            raise InterpreterException("Interpeter instances not unique " + _get_stackmessage(3))
+        
+        chunk = _pack_command_records(self.__g_command_list[self.__chunk_begin:])
+        self.__chunk_begin = len(self.__g_command_list)
+        if (not _chunk_hook(*chunk)):
+            raise InterpreterException("Parse Canceled")
+    
     # 检查环境是否valid, 在输出运动指令时调用, 以防止未定义的模式
     def _assert_environment_valid(self) -> None:
         if (self.__g_environment.get_coordinate_mode() == CoordinateMode.Undefined):
@@ -256,7 +336,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # 设置相对坐标模式
@@ -272,7 +352,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
 
     # 延时
@@ -293,7 +373,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # 设置电参数号
@@ -314,7 +394,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # 设置坐标轴序号指令
@@ -336,7 +416,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code(2)
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     def g53(self) -> RS274Interpreter:
@@ -383,7 +463,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code(2)
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     def coord_set_zero(self, x : bool = False, y : bool = False, z : bool = False, b : bool = False, c : bool = False, a : bool = False) -> RS274Interpreter:
@@ -416,7 +496,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # 暂停指令
@@ -430,7 +510,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
 
     @staticmethod
@@ -522,7 +602,7 @@ class RS274Interpreter(object):
         
         command[CommandDictKey.Coordinates.name] = coordinates
             
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # G00快速直线运动
@@ -560,7 +640,7 @@ class RS274Interpreter(object):
         
         command[CommandDictKey.Coordinates.name] = coordinates
             
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     @staticmethod
@@ -602,7 +682,7 @@ class RS274Interpreter(object):
         # print("** g01_group")
         # points.test_print()
         # print(json.dumps(command, indent=2, ensure_ascii=False))
-        self.__g_command_list.append(command)
+        self._append_command(command)
         
         return self
     
@@ -626,7 +706,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
     
     # 穿透检测参数设定(数据库方法) TODO
@@ -678,7 +758,7 @@ class RS274Interpreter(object):
             CommandDictKey.CommandStr.name: _get_caller_code()
         }
         
-        self.__g_command_list.append(command)
+        self._append_command(command)
         return self
 
     # 获取已解析的命令列表
@@ -689,10 +769,185 @@ class RS274Interpreter(object):
     def get_command_list_jsonstr(self) -> str:
         return json.dumps(self.__g_command_list, indent=2, ensure_ascii=False)
 
+    # 获取命令列表的二进制记录形式 (C++端直接按结构体数组读取, 不经过json)
+    # 返回 (版本号, 命令记录bytes, G01组点记录bytes, 字符串池bytes), 格式见 _pack_command_records
+    def get_command_records(self) -> tuple:
+        return _pack_command_records(self.__g_command_list)
+
     # def reset(self) -> None:
     #     self.__init__()
         
 
+# 二进制命令记录, 与 C++ 端 RS274CommandRecord.h 保持一致 (小端, 无填充)
+COMMAND_RECORD_VERSION = 1
+
+# 命令记录:
+#   8d: coords[6], real_value (DelayTime / DrillDepth), real_value2 (DrillSpindleSpeed)
+#   6i: type, line_number, coord_mode, coord_index, feed_speed, int_value (EleparamIndex / DrillHoldTime)
+#   8I: flags, axis_mask (Coordinates有值的轴 / SetZeroAxisList),
+#       str_offset, str_size (CommandStr), opt_offset, opt_size (Options, 每项以'\0'结尾),
+#       point_first, point_count (G01GroupPoints)
+_COMMAND_RECORD = struct.Struct("<8d6i8I")
+# G01组点记录:
+#   6d: coords[6]
+#   3i: coord_mode, line_number, feed_speed
+#   3I: axis_mask, str_offset, str_size
+_POINT_RECORD = struct.Struct("<6d3i3I")
+
+# flags
+_RECORD_FLAG_M05_IGNORE_TOUCH_DETECT = 1 << 0
+_RECORD_FLAG_G00_TOUCH = 1 << 1
+_RECORD_FLAG_DRILL_TOUCH = 1 << 2
+_RECORD_FLAG_DRILL_BREAKOUT = 1 << 3
+_RECORD_FLAG_DRILL_BACK = 1 << 4
+_RECORD_FLAG_HAS_SPINDLE_SPEED = 1 << 5
+_RECORD_FLAG_HAS_OPTIONS = 1 << 6
+
+_COMMAND_TYPE_VALUE = {t.name: t.value for t in CommandType}
+_COORDINATE_MODE_VALUE = {m.name: m.value for m in CoordinateMode}
+_COORDINATE_MODE_VALUE[None] = CoordinateMode.Undefined.value # 没有CoordinateMode的命令
+
+class _StringPool(object):
+    def __init__(self) -> None:
+        self.buf = bytearray()
+        self.__last_str = None # 链式调用的多条命令, CommandStr相同, 只存一份
+        self.__last_ret = (0, 0)
+
+    def add(self, s: str) -> tuple:
+        if (not s):
+            return (0, 0)
+        if (s == self.__last_str):
+            return self.__last_ret
+        b = s.encode("utf-8")
+        offset = len(self.buf)
+        self.buf += b
+        self.__last_str = s
+        self.__last_ret = (offset, len(b))
+        return self.__last_ret
+
+# 循环中不再访问Enum的name属性 (较慢)
+_K_TYPE = CommandDictKey.CommandType.name
+_K_LINE = CommandDictKey.LineNumber.name
+_K_MODE = CommandDictKey.CoordinateMode.name
+_K_INDEX = CommandDictKey.CoordinateIndex.name
+_K_FEED = CommandDictKey.FeedSpeed.name
+_K_COORDS = CommandDictKey.Coordinates.name
+_K_STR = CommandDictKey.CommandStr.name
+_K_OPTIONS = CommandDictKey.Options.name
+_K_M05 = CommandDictKey.M05IgnoreTouchDetect.name
+_K_G00_TOUCH = CommandDictKey.G00Touch.name
+_K_ELEPARAM_INDEX = CommandDictKey.EleparamIndex.name
+_K_DELAY_TIME = CommandDictKey.DelayTime.name
+_K_SET_ZERO_AXIS_LIST = CommandDictKey.SetZeroAxisList.name
+_K_DRILL_DEPTH = CommandDictKey.DrillDepth.name
+_K_DRILL_HOLDTIME = CommandDictKey.DrillHoldTime.name
+_K_DRILL_TOUCH = CommandDictKey.DrillTouch.name
+_K_DRILL_BREAKOUT = CommandDictKey.DrillBreakout.name
+_K_DRILL_BACK = CommandDictKey.DrillBack.name
+_K_DRILL_SPINDLE_SPEED = CommandDictKey.DrillSpindleSpeed.name
+_K_G01_GROUP_POINTS = CommandDictKey.G01GroupPoints.name
+
+_T_G00 = CommandType.G00MotionCommand.value
+_T_ELEPARAM_SET = CommandType.EleparamSetCommand.value
+_T_DELAY = CommandType.DelayCommand.value
+_T_COORD_SET_ZERO = CommandType.CoordSetZeroCommand.value
+_T_DRILL = CommandType.DrillMotionCommand.value
+_T_G01_GROUP = CommandType.G01GroupMotionCommand.value
+
+_NO_COORDS = (0.0, 0.0, 0.0, 0.0, 0.0, 0.0)
+
+def _pack_coords(coords: list) -> tuple:
+    if (coords is None):
+        return (_NO_COORDS, 0)
+    values = [0.0] * 6
+    mask = 0
+    for i, v in enumerate(coords[:6]):
+        if (v is not None):
+            values[i] = v
+            mask |= 1 << i
+    return (values, mask)
+
+def _pack_command_records(command_list: list) -> tuple:
+    record_size = _COMMAND_RECORD.size
+    pack_into = _COMMAND_RECORD.pack_into
+    type_value = _COMMAND_TYPE_VALUE
+    mode_value = _COORDINATE_MODE_VALUE
+
+    cmd_buf = bytearray(record_size * len(command_list))
+    point_buf = bytearray()
+    pool = _StringPool()
+    point_count = 0
+
+    for n, command in enumerate(command_list):
+        type_v = type_value[command[_K_TYPE]]
+        values, axis_mask = _pack_coords(command.get(_K_COORDS))
+        flags = 0
+        real_value = 0.0
+        real_value2 = 0.0
+        int_value = 0
+        point_first = point_count
+        group_count = 0
+
+        if (type_v == _T_G00):
+            if (command[_K_M05]):
+                flags |= _RECORD_FLAG_M05_IGNORE_TOUCH_DETECT
+            if (command[_K_G00_TOUCH]):
+                flags |= _RECORD_FLAG_G00_TOUCH
+        elif (type_v == _T_ELEPARAM_SET):
+            int_value = command[_K_ELEPARAM_INDEX]
+        elif (type_v == _T_DELAY):
+            real_value = command[_K_DELAY_TIME]
+        elif (type_v == _T_COORD_SET_ZERO):
+            for i, v in enumerate(command[_K_SET_ZERO_AXIS_LIST][:6]):
+                if (v):
+                    axis_mask |= 1 << i
+        elif (type_v == _T_DRILL):
+            real_value = command[_K_DRILL_DEPTH]
+            int_value = command[_K_DRILL_HOLDTIME]
+            if (command[_K_DRILL_TOUCH]):
+                flags |= _RECORD_FLAG_DRILL_TOUCH
+            if (command[_K_DRILL_BREAKOUT]):
+                flags |= _RECORD_FLAG_DRILL_BREAKOUT
+            if (command[_K_DRILL_BACK]):
+                flags |= _RECORD_FLAG_DRILL_BACK
+            spindle_speed = command[_K_DRILL_SPINDLE_SPEED]
+            if (spindle_speed is not None):
+                flags |= _RECORD_FLAG_HAS_SPINDLE_SPEED
+                real_value2 = spindle_speed
+        elif (type_v == _T_G01_GROUP):
+            for p in command[_K_G01_GROUP_POINTS]:
+                p_values, p_mask = _pack_coords(p[_K_COORDS])
+                p_str_offset, p_str_size = pool.add(p[_K_STR])
+                point_buf += _POINT_RECORD.pack(
+                    *p_values,
+                    mode_value[p[_K_MODE]], p[_K_LINE], p[_K_FEED],
+                    p_mask, p_str_offset, p_str_size)
+                group_count += 1
+            point_count += group_count
+
+        str_offset, str_size = pool.add(command.get(_K_STR))
+
+        opt_offset = 0
+        opt_size = 0
+        options = command.get(_K_OPTIONS)
+        if (options is not None):
+            flags |= _RECORD_FLAG_HAS_OPTIONS
+            if (options):
+                opt_offset = len(pool.buf)
+                for option in options:
+                    pool.buf += option.encode("utf-8") + b"\0"
+                opt_size = len(pool.buf) - opt_offset
+
+        pack_into(
+            cmd_buf, n * record_size,
+            *values, real_value, real_value2,
+            type_v, command[_K_LINE], mode_value[command.get(_K_MODE)],
+            command.get(_K_INDEX, -1), command.get(_K_FEED, -1), int_value,
+            flags, axis_mask, str_offset, str_size, opt_offset, opt_size,
+            point_first, group_count)
+
+    return (COMMAND_RECORD_VERSION, bytes(cmd_buf), bytes(point_buf), bytes(pool.buf))
+
 def _test():
     i = RS274Interpreter()
     
@@ -22,6 +22,17 @@ struct GlobalThreadPoolDefine {
     MEO_JSONIZATION(MEO_OPT q_size, MEO_OPT thread_count)
 };
 
+// 调用点去重/限流参数 (见 LogRateLimiter), 只对 EDM_RATE_LIMITED_LOG 生效
+struct RateLimitDefine {
+    bool enable = false;
+    double rate = 5.0;     // 每个调用点每秒允许的条数
+    std::size_t burst = 20; // 允许的突发条数
+    std::size_t dedup_ms = 1000; // 相同消息合并的时间窗口, 0: 不去重
+
+    MEO_JSONIZATION(MEO_OPT enable, MEO_OPT rate, MEO_OPT burst,
+                    MEO_OPT dedup_ms)
+};
+
 struct SinkDefine {
     std::string type;     // "file" or "stdout"
     std::string filename; // used for log file if type is "file"
@@ -53,9 +64,12 @@ struct LogDefine {
     std::vector<SinkDefine> sinks;
     bool async_mode = false;
     std::string async_policy{"block"};
+    std::size_t rt_queue_size = 4096; // 实时日志 (RtLogger) 队列长度
+    RateLimitDefine rate_limit;
 
     MEO_JSONIZATION(name, sinks, MEO_OPT async_mode, MEO_OPT async_policy,
-                    MEO_OPT level, MEO_OPT flush_level);
+                    MEO_OPT level, MEO_OPT flush_level,
+                    MEO_OPT rt_queue_size, MEO_OPT rate_limit);
 
     logger_ptr to_logger() const;
 
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Logger/LogManager.h"
+#include "Logger/LogRateLimiter.h"
+
+#include <functional>
+#include <iterator>
+#include <string_view>
 
 #define EDM_GET_LOG_MANAGER() edm::log::LogManager::instance()
 
@@ -13,6 +18,12 @@
     static auto var_name_ = EDM_LOGGER((logger_name_));
 #define EDM_STATIC_LOGGER(var_name_, logger_) static auto var_name_ = (logger_);
 
+// 实时日志 (延迟格式化), 用于运动线程
+#define EDM_RT_LOGGER(logger_name_) \
+    EDM_GET_LOG_MANAGER()->get_rt_logger((logger_name_))
+#define EDM_STATIC_RT_LOGGER_NAME(var_name_, logger_name_) \
+    static auto var_name_ = EDM_RT_LOGGER((logger_name_));
+
 /* 调试打印宏 */
 #define EDM_CYCLIC_LOG(__func, __peroid, fmt, ...) \
     {                                              \
@@ -24,3 +35,40 @@
         }                                          \
     }
 
+// 按调用点去重/限流的日志 (参数为logdefine.json中该logger的rate_limit)
+// 被合并的相同消息和被抑制的条数在该调用点下一次放行时输出
+// 去重时先格式化到栈上的缓冲 (消息不长时不分配内存) 再比较hash
+#define EDM_RATE_LIMITED_LOG(__logger, __level, __fmt, ...)                    \
+    {                                                                          \
+        static edm::log::LogRateLimiter __rate_limiter(                        \
+            EDM_GET_LOG_MANAGER()->get_rate_limit((__logger)->name()));        \
+        if ((__logger)->should_log(__level)) {                                 \
+            uint64_t __repeated = 0, __suppressed = 0;                         \
+            spdlog::memory_buf_t __msg;                                        \
+            std::size_t __hash = 0;                                            \
+            if (__rate_limiter.dedup_enabled()) {                              \
+                spdlog::fmt_lib::format_to(std::back_inserter(__msg), __fmt,   \
+                                           ##__VA_ARGS__);                     \
+                __hash = std::hash<std::string_view>{}(                        \
+                    std::string_view(__msg.data(), __msg.size()));             \
+            }                                                                  \
+            if (__rate_limiter.try_acquire(__hash, __repeated,                 \
+                                           __suppressed)) {                    \
+                if (__repeated > 0) {                                          \
+                    (__logger)->log(__level, "last message repeated {} times", \
+                                    __repeated);                               \
+                }                                                              \
+                if (__suppressed > 0) {                                        \
+                    (__logger)->log(__level,                                   \
+                                    "suppressed {} similar messages",          \
+                                    __suppressed);                             \
+                }                                                              \
+                if (__rate_limiter.dedup_enabled()) {                          \
+                    (__logger)->log(__level, spdlog::string_view_t(            \
+                                                 __msg.data(), __msg.size())); \
+                } else {                                                       \
+                    (__logger)->log(__level, __fmt, ##__VA_ARGS__);            \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    }
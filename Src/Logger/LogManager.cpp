@@ -57,6 +57,39 @@ logger_ptr LogManager::get_root_logger() const {
     return root_logger_; 
 }
 
+RtLogger::ptr LogManager::get_rt_logger(const std::string &logger_name) {
+    auto target = get_logger(logger_name);
+
+    lockguard_t guard(mutex_);
+
+    if (auto it = rt_loggers_.find(logger_name); it != rt_loggers_.end()) {
+        return it->second;
+    }
+
+    std::size_t queue_size = LogDefine{}.rt_queue_size;
+    if (auto it = rt_queue_sizes_.find(logger_name);
+        it != rt_queue_sizes_.end()) {
+        queue_size = it->second;
+    }
+
+    auto rt_logger = std::make_shared<RtLogger>(target, queue_size);
+    rt_loggers_.emplace(logger_name, rt_logger);
+
+    return rt_logger;
+}
+
+const RateLimitDefine &
+LogManager::get_rate_limit(const std::string &logger_name) const {
+    // rate_limits_ 只在构造时 (_init) 写入, 之后只读, 不需要加锁
+    static const RateLimitDefine disabled{};
+
+    if (auto it = rate_limits_.find(logger_name); it != rate_limits_.end()) {
+        return it->second;
+    }
+
+    return disabled;
+}
+
 void LogManager::_init() {
     auto logdefine_file = EDM_CONFIG_DIR + SystemSettings::instance().get_log_config_file();
     std::ifstream ifs(logdefine_file);
@@ -94,6 +127,11 @@ void LogManager::_init() {
     spdlog::default_logger()->set_level(tlds.get_default_logger_level());
     auto loggers = tlds.to_loggers();
 
+    for (const auto &logdefine : tlds.loggers) {
+        rt_queue_sizes_[logdefine.name] = logdefine.rt_queue_size;
+        rate_limits_[logdefine.name] = logdefine.rate_limit;
+    }
+
     if (loggers.empty()) {
         spdlog::warn("logger init: no loggers");
         return;
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "Logger/LogDefine.h"
+#include "Logger/RtLogger.h"
 
 namespace edm {
 
@@ -27,6 +28,18 @@ public:
     // constructed
     logger_ptr get_root_logger() const;
 
+    // Get the realtime (deferred formatting) front end of logger
+    // `logger_name`, created on first call with the logger's rt_queue_size.
+    // Used in the motion thread, see RtLogger
+    RtLogger::ptr get_rt_logger(const std::string &logger_name);
+
+    // Rate limit define of logger `logger_name` (disabled if not configured).
+    // Used by EDM_RATE_LIMITED_LOG call sites, see LogRateLimiter.
+    // Resolved from the config when LogManager is constructed and never
+    // modified afterwards, so this is lock-free and does not allocate
+    // (safe for the first call in the motion thread)
+    const RateLimitDefine &get_rate_limit(const std::string &logger_name) const;
+
 private:
     void _init();
 
@@ -38,6 +51,10 @@ private:
     // when you get a logger from the LogManager instance.
     logger_ptr root_logger_;
 
+    std::unordered_map<std::string, RtLogger::ptr> rt_loggers_;
+    std::unordered_map<std::string, std::size_t> rt_queue_sizes_; // 来自配置
+    std::unordered_map<std::string, RateLimitDefine> rate_limits_; // 来自配置, 构造后只读
+
     mutable mutex_t mutex_;
 
 private:
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "Logger/LogDefine.h"
+
+namespace edm {
+
+namespace log {
+
+/**
+ * 日志调用点去重 + 限流:
+ * 每个调用点一个实例 (见 EDM_RATE_LIMITED_LOG).
+ * - 去重: 与上一条放行的消息内容相同 (hash相同) 且在 dedup_ms 内的,
+ *         不输出只计数, 下一次放行时输出 "重复N次" 的汇总
+ *         (相同消息持续出现时, 每 dedup_ms 放行一次并带上汇总)
+ * - 限流 (令牌桶): 每秒补充 rate 个令牌, 最多积累 burst 个;
+ *         没有令牌时丢弃本条并计数, 下一次放行时输出被抑制的条数
+ * 用于每周期都可能触发的告警 (通讯断开、wkc错误等), 防止挤掉异步队列中的其他日志.
+ * 参数在 LogManager 初始化时从配置读取, 构造时只是拷贝
+ */
+class LogRateLimiter final {
+public:
+    explicit LogRateLimiter(const RateLimitDefine &define)
+        : enable_(define.enable && define.rate > 0.0),
+          rate_per_ns_(define.rate / 1e9),
+          burst_(std::max<double>(1.0, define.burst)),
+          dedup_ns_(static_cast<int64_t>(define.dedup_ms) * 1000000),
+          tokens_(burst_) {}
+
+    // 是否需要消息内容的hash (需要先格式化消息)
+    inline bool dedup_enabled() const { return enable_ && dedup_ns_ > 0; }
+
+    // 返回是否放行; 放行时 repeated 为此前被合并的相同消息条数,
+    // suppressed 为此前被限流丢弃的条数
+    // msg_hash: 消息内容的hash, 不去重时传0
+    inline bool try_acquire(std::size_t msg_hash, uint64_t &repeated,
+                            uint64_t &suppressed) {
+        repeated = 0;
+        suppressed = 0;
+        if (!enable_) {
+            return true;
+        }
+
+        const int64_t now_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+
+        while (lock_.test_and_set(std::memory_order_acquire)) {
+        }
+
+        if (last_ns_ != 0) {
+            tokens_ = std::min(burst_,
+                               tokens_ + (now_ns - last_ns_) * rate_per_ns_);
+        }
+        last_ns_ = now_ns;
+
+        bool allowed = false;
+        if (dedup_ns_ > 0 && last_emit_ns_ != 0 && msg_hash == last_hash_ &&
+            now_ns - last_emit_ns_ < dedup_ns_) {
+            ++repeated_; // 相同消息, 不消耗令牌
+        } else if (tokens_ >= 1.0) {
+            tokens_ -= 1.0;
+            repeated = repeated_;
+            suppressed = suppressed_;
+            repeated_ = suppressed_ = 0;
+            last_hash_ = msg_hash;
+            last_emit_ns_ = now_ns;
+            allowed = true;
+        } else {
+            ++suppressed_;
+        }
+
+        lock_.clear(std::memory_order_release);
+        return allowed;
+    }
+
+private:
+    const bool enable_;
+    const double rate_per_ns_;
+    const double burst_;
+    const int64_t dedup_ns_;
+
+    double tokens_;
+    int64_t last_ns_{0};
+    uint64_t suppressed_{0};
+
+    std::size_t last_hash_{0}; // 上一条放行的消息
+    int64_t last_emit_ns_{0};
+    uint64_t repeated_{0};
+
+    std::atomic_flag lock_ = ATOMIC_FLAG_INIT; // 调用点可能在多个线程中
+};
+
+} // namespace log
+
+} // namespace edm
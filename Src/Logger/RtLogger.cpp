@@ -0,0 +1,102 @@
+#include "RtLogger.h"
+
+#include <chrono>
+
+namespace edm {
+
+namespace log {
+
+static std::size_t _round_up_pow2(std::size_t v) {
+    std::size_t n = 2;
+    while (n < v) {
+        n <<= 1;
+    }
+    return n;
+}
+
+RtLogger::RtLogger(logger_ptr target, std::size_t queue_size)
+    : target_(std::move(target)) {
+    const auto capacity = _round_up_pow2(queue_size);
+    mask_ = capacity - 1;
+
+    // 预分配全部槽位, 运行中不再分配内存
+    ring_ = std::make_unique<_Entry[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        ring_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread(&RtLogger::_run, this);
+}
+
+RtLogger::~RtLogger() {
+    stop_flag_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void RtLogger::flush() {
+    const auto target_pos = enqueue_pos_.load(std::memory_order_acquire);
+    while (dequeue_pos_.load(std::memory_order_acquire) < target_pos &&
+           thread_.joinable()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    target_->flush();
+}
+
+bool RtLogger::_drain() {
+    spdlog::memory_buf_t buf;
+    bool any = false;
+
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        _Entry &e = ring_[pos & mask_];
+        if (e.seq.load(std::memory_order_acquire) != pos + 1) {
+            break; // 空, 或生产者还未提交
+        }
+
+        buf.clear();
+        try {
+            e.format_fn(e, buf);
+        } catch (const std::exception &ex) {
+            buf.clear();
+            spdlog::fmt_lib::format_to(std::back_inserter(buf),
+                                       "[rt log format error] {}: {}",
+                                       std::string_view(e.fmt, e.fmt_size),
+                                       ex.what());
+        }
+
+        target_->log(e.time, spdlog::source_loc{}, e.level,
+                     spdlog::string_view_t(buf.data(), buf.size()));
+
+        // 释放槽位给下一圈的生产者
+        e.seq.store(pos + mask_ + 1, std::memory_order_release);
+        ++pos;
+        dequeue_pos_.store(pos, std::memory_order_release);
+        any = true;
+    }
+
+    auto dropped = dropped_count_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_count_) {
+        target_->warn("rt log queue full, dropped {} messages",
+                      dropped - reported_dropped_count_);
+        reported_dropped_count_ = dropped;
+    }
+
+    return any;
+}
+
+void RtLogger::_run() {
+    // 轮询, 运动线程不需要通知 (避免系统调用)
+    while (!stop_flag_) {
+        if (!_drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    _drain();
+}
+
+} // namespace log
+
+} // namespace edm
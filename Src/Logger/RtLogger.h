@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include <spdlog/spdlog.h>
+
+namespace edm {
+
+namespace log {
+
+using logger_ptr = std::shared_ptr<spdlog::logger>;
+
+/**
+ * 实时日志 (延迟格式化):
+ * 调用方只把格式串指针和参数拷贝到预分配的无锁环形队列,
+ * 后台线程负责格式化并交给目标 spdlog logger (保留原始时间戳).
+ * 用于运动线程, 日志调用中没有格式化、内存分配和锁.
+ *
+ * - 参数只允许算术类型、枚举和字符串常量 (const char*, 必须是静态生存期)
+ * - 队列满时丢弃 (计数), 后台线程随后输出丢弃数
+ * - 有界无锁队列 (每个槽位带序号), 多线程调用安全, 只有一个后台消费线程
+ */
+class RtLogger final {
+private:
+    // 枚举按底层整数类型保存和格式化 (fmt v9 起隐式格式化枚举已弃用)
+    template <typename T>
+    using _RtArgT = typename std::conditional_t<std::is_enum_v<T>,
+                                                std::underlying_type<T>,
+                                                std::type_identity<T>>::type;
+
+    template <typename... Args>
+    using _FormatString = spdlog::format_string_t<_RtArgT<Args>...>;
+
+public:
+    using ptr = std::shared_ptr<RtLogger>;
+
+    static constexpr std::size_t EntrySize = 128;
+
+    // queue_size 会向上取2的幂
+    RtLogger(logger_ptr target, std::size_t queue_size);
+    ~RtLogger();
+
+    RtLogger(const RtLogger &) = delete;
+    RtLogger &operator=(const RtLogger &) = delete;
+
+    inline const auto &target() const { return target_; }
+
+    template <typename... Args>
+    inline void log(spdlog::level::level_enum lvl,
+                    _FormatString<Args...> fmt, Args... args) {
+        static_assert((_IsRtArg<Args>::value && ...),
+                      "RtLogger only accepts arithmetic, enum and const char* "
+                      "(string literal) arguments");
+        static_assert(sizeof(std::tuple<_RtArgT<Args>...>) <=
+                          sizeof(_Entry::args),
+                      "too many RtLogger arguments");
+
+        if (!target_->should_log(lvl)) {
+            return;
+        }
+
+        spdlog::string_view_t sv = fmt;
+        std::size_t pos;
+        _Entry *e = _acquire(pos);
+        if (!e) [[unlikely]] {
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        e->format_fn = &_Format<_RtArgT<Args>...>;
+        e->fmt = sv.data();
+        e->fmt_size = sv.size();
+        e->level = lvl;
+        e->time = spdlog::log_clock::now();
+        ::new (static_cast<void *>(e->args))
+            std::tuple<_RtArgT<Args>...>(static_cast<_RtArgT<Args>>(args)...);
+
+        e->seq.store(pos + 1, std::memory_order_release); // 提交
+    }
+
+    template <typename... Args>
+    inline void trace(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::trace, fmt, args...);
+    }
+    template <typename... Args>
+    inline void debug(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::debug, fmt, args...);
+    }
+    template <typename... Args>
+    inline void info(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::info, fmt, args...);
+    }
+    template <typename... Args>
+    inline void warn(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::warn, fmt, args...);
+    }
+    template <typename... Args>
+    inline void error(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::err, fmt, args...);
+    }
+    template <typename... Args>
+    inline void critical(_FormatString<Args...> fmt, Args... args) {
+        log(spdlog::level::critical, fmt, args...);
+    }
+
+    // 等待队列中已有的日志全部交给目标logger (测试或退出前使用)
+    void flush();
+
+    inline auto dropped_count() const {
+        return dropped_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct _Entry;
+    using _FormatFn = void (*)(const _Entry &, spdlog::memory_buf_t &);
+
+    struct alignas(64) _Entry {
+        std::atomic<std::size_t> seq;
+        _FormatFn format_fn;
+        const char *fmt;
+        uint32_t fmt_size;
+        spdlog::level::level_enum level;
+        spdlog::log_clock::time_point time;
+        alignas(8) char args[EntrySize - 40];
+    };
+    static_assert(sizeof(_Entry) == EntrySize);
+
+    template <typename T>
+    struct _IsRtArg
+        : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                             std::is_same_v<T, const char *>> {};
+
+    template <typename... Args>
+    static void _Format(const _Entry &e, spdlog::memory_buf_t &buf) {
+        const auto &t = *std::launder(
+            reinterpret_cast<const std::tuple<Args...> *>(e.args));
+        std::apply(
+            [&](const Args &...a) {
+                spdlog::fmt_lib::vformat_to(
+                    std::back_inserter(buf),
+                    spdlog::fmt_lib::string_view(e.fmt, e.fmt_size),
+                    spdlog::fmt_lib::make_format_args(a...));
+            },
+            t);
+    }
+
+    // 生产者: 占用一个空位, 队列满时返回nullptr
+    inline _Entry *_acquire(std::size_t &pos) {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            _Entry *e = &ring_[pos & mask_];
+            auto seq = e->seq.load(std::memory_order_acquire);
+            auto dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (enqueue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    return e;
+                }
+            } else if (dif < 0) {
+                return nullptr; // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void _run();
+    bool _drain();
+
+private:
+    logger_ptr target_;
+
+    std::unique_ptr<_Entry[]> ring_;
+    std::size_t mask_{0};
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0}; // 仅后台线程修改
+
+    std::atomic<uint64_t> dropped_count_{0};
+    uint64_t reported_dropped_count_{0};
+
+    std::atomic_bool stop_flag_{false};
+    std::thread thread_;
+};
+
+} // namespace log
+
+} // namespace edm
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Moveruntime/Moveruntime.h"
+#include "MoveDefines.h"
+
+namespace edm
+{
+
+namespace move
+{
+
+// 运动块缓冲(block FIFO)中的一个块
+// 上层预先算好目标位置(电机坐标), 当前任务正常结束后由运动线程在下一周期直接接续,
+// 块与块之间不回到Idle, 也不需要上层一次命令往返
+struct AutoBlock {
+    enum class Type {
+        G00, // 不带接触感知的G00
+        G01,
+        G04
+    };
+
+    Type type {Type::G04};
+    int block_id {-1}; // 上层给出的块号 (G代码node序号), 开始执行时通过info回报
+
+    axis_t target_pos {0.0}; // G00/G01 目标位置 (绝对式, 电机坐标)
+
+    MoveRuntimePlanSpeedInput speed_param; // G00 速度参数
+    unit_t max_jump_height_from_begin {0.0}; // G01 从起点的最大抬刀距离
+    double delay_s {0.0}; // G04 延时
+};
+
+// 运动线程中缓存的块数上限
+constexpr std::size_t AutoBlockFifoCapacity = 16;
+
+} // namespace move
+
+} // namespace edm
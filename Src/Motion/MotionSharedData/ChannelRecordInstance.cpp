@@ -0,0 +1,134 @@
+#include "ChannelRecordInstance.h"
+#include "DataRecordInstance.h"
+
+#include "SystemSettings/SystemSettings.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+namespace edm {
+namespace move {
+
+ChannelRecordInstance::ChannelRecordInstance(const QString &bin_dir,
+                                             const QString &decode_dir)
+    : bin_dir_(bin_dir), decode_dir_(decode_dir) {
+    registry_ = std::make_shared<util::RecordChannelRegistry>();
+    recorder_ = std::make_shared<util::RecordChannelRecorder>();
+
+    _register_channels();
+}
+
+void ChannelRecordInstance::_register_channels() {
+    auto &r = *registry_;
+
+    ids_.cmd_axis = r.register_array_channel<unit_t, EDM_AXIS_NUM>("cmd");
+    ids_.act_axis = r.register_array_channel<unit_t, EDM_AXIS_NUM>("act");
+    ids_.following_error =
+        r.register_array_channel<unit_t, EDM_AXIS_NUM>("err");
+    ids_.v_offset = r.register_array_channel<unit_t, EDM_AXIS_NUM>("voffset");
+
+#ifdef EDM_USE_ZYNQ_SERVOBOARD
+    // zynq伺服板回传的电压为浮点 (V), 不注册没有数据的电流和放电率通道
+    ids_.average_voltage = r.register_channel<float>("voltage");
+    ids_.realtime_voltage = r.register_channel<float>("rtvoltage");
+#else
+    ids_.average_voltage = r.register_channel<uint16_t>("voltage");
+    ids_.current = r.register_channel<uint16_t>("current");
+    ids_.normal_rate = r.register_channel<uint8_t>("normal");
+    ids_.short_rate = r.register_channel<uint8_t>("short");
+    ids_.open_rate = r.register_channel<uint8_t>("open");
+#endif
+
+    ids_.touch_warning = r.register_channel<bool>("touchwarn");
+    ids_.servo_fault = r.register_channel<bool>("servofault");
+
+    ids_.g01_servoing = r.register_channel<bool>("isg01");
+    ids_.g01_servo_cmd = r.register_channel<unit_t>("servo");
+    ids_.g01_state = r.register_channel<uint8_t>("g01state");
+    ids_.g01_servo_substate = r.register_channel<uint8_t>("g01substate");
+
+    ids_.sub_line_num = r.register_channel<int32_t>("subline");
+}
+
+std::optional<QString> ChannelRecordInstance::start_record(
+    const util::RecordChannelSelection &selection) {
+    auto bin_file =
+        bin_dir_ + name_ + "_" +
+        QDateTime::currentDateTime().toString("yyyyMMdd_hh_mm_ss_zzz") + ".bin";
+
+    util::RecordFileInfo info;
+    info.cycle_us = SystemSettings::instance().get_motion_cycle_us();
+    info.block_size = EDM_DATAQUEUERECORDER_BLOCK_SIZE;
+    info.codec = static_cast<util::RecordCodec>(EDM_DATAQUEUERECORDER_CODEC);
+
+    // 抽取系数写入附加文本, 便于解码后查看
+    for (const auto &item : selection.items) {
+        info.comment += item.name + " decimation: " +
+                        std::to_string(item.decimation) + "\n";
+    }
+
+    // 实时流 (可选), 只发送流时不写文件
+    auto stream = OpenRecordStream(name_);
+    recorder_->set_stream_publisher(stream);
+    if (stream &&
+        SystemSettings::instance().get_record_stream_settings().stream_only) {
+        bin_file.clear();
+    }
+
+    auto ret = recorder_->start_record(bin_file.toStdString(), registry_,
+                                       selection, info);
+    if (!ret) {
+        logger_->error("{} start record failed", name_.toStdString());
+        return std::nullopt;
+    }
+
+    if (bin_file.isEmpty()) {
+        return QString{"stream only"};
+    }
+
+    return bin_file;
+}
+
+void ChannelRecordInstance::stop_record(bool wait_for_stopped) {
+    recorder_->stop_record(wait_for_stopped);
+}
+
+std::optional<QString> ChannelRecordInstance::decode_one_file(
+    const QString &bin_filename,
+    const util::RecordFileDecoder::ProgressCallback &progress_cb,
+    const std::atomic_bool *cancel_flag) const {
+    QFileInfo fi(bin_filename);
+    auto decode_filename = decode_dir_ + fi.baseName() + ".txt";
+
+    // 通道记录文件只有新格式, 按文件头中的字段描述解码
+    if (!util::RecordFileReader::IsRecordFile(bin_filename.toStdString())) {
+        logger_->error("not a record file: {}", bin_filename.toStdString());
+        return std::nullopt;
+    }
+
+    util::RecordFileDecoder decoder;
+    decoder.set_progress_callback(progress_cb);
+    decoder.set_cancel_flag(cancel_flag);
+
+    auto result = decoder.decode_record_file(bin_filename.toStdString(),
+                                             decode_filename.toStdString(),
+                                             true);
+
+    if (result.canceled) {
+        logger_->info("decode file canceled: {}", bin_filename.toStdString());
+        return std::nullopt;
+    }
+
+    if (!result.ok) {
+        logger_->error("decode file failed: {}", bin_filename.toStdString());
+        return std::nullopt;
+    }
+
+    logger_->info("Decode Success, saved to: {}",
+                  decode_filename.toStdString());
+
+    return decode_filename;
+}
+
+} // namespace move
+} // namespace edm
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Motion/MoveDefines.h"
+#include "Utils/DataQueueRecorder/RecordChannel.h"
+#include "Utils/DataQueueRecorder/RecordFileDecoder.h"
+#include "config.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include <QString>
+
+#include "Logger/LogMacro.h"
+
+namespace edm {
+namespace move {
+
+// 运动模块注册的记录通道id, 运动线程按id发布
+struct MotionRecordChannels {
+    using ChannelId = util::RecordChannelRegistry::ChannelId;
+
+    // 轴数据 (id连续, 按 publish_array 发布)
+    ChannelId cmd_axis;
+    ChannelId act_axis;
+    ChannelId following_error;
+    ChannelId v_offset;
+
+    // 放电状态
+    ChannelId average_voltage;
+#ifdef EDM_USE_ZYNQ_SERVOBOARD
+    ChannelId realtime_voltage; // zynq伺服板只回传电压, 没有电流和放电率
+#else
+    ChannelId current;
+    ChannelId normal_rate;
+    ChannelId short_rate;
+    ChannelId open_rate;
+#endif
+
+    // 报警
+    ChannelId touch_warning;
+    ChannelId servo_fault;
+
+    // G01
+    ChannelId g01_servoing;
+    ChannelId g01_servo_cmd;
+    ChannelId g01_state;
+    ChannelId g01_servo_substate;
+
+    ChannelId sub_line_num;
+};
+
+/**
+ * 通道记录实例: 与 DataRecordInstance 固定结构体不同,
+ * 记录哪些信号以及各自的抽取系数在运行时由界面选择,
+ * 文件中只保存选中的列 (新增信号只需注册通道, 不改结构体)
+ */
+class ChannelRecordInstance final {
+public:
+    using ptr = std::shared_ptr<ChannelRecordInstance>;
+
+    ChannelRecordInstance(const QString &bin_dir, const QString &decode_dir);
+
+    inline const auto &name() const { return name_; }
+    inline const auto &bin_dir() const { return bin_dir_; }
+    inline const auto &decode_dir() const { return decode_dir_; }
+
+    // 可选通道 (界面显示用)
+    inline const auto &registry() const { return *registry_; }
+    inline const auto &ids() const { return ids_; }
+
+    inline bool is_running() const { return recorder_->is_running(); }
+
+    // 开始记录, 成功的话, 返回文件名
+    std::optional<QString>
+    start_record(const util::RecordChannelSelection &selection);
+    void stop_record(bool wait_for_stopped = true);
+
+    // 解码文件 (可在非GUI线程调用)
+    std::optional<QString> decode_one_file(
+        const QString &bin_filename,
+        const util::RecordFileDecoder::ProgressCallback &progress_cb = nullptr,
+        const std::atomic_bool *cancel_flag = nullptr) const;
+
+public: // 运动线程调用, 仅在 is_running() 时调用
+    template <typename T>
+    inline void publish(util::RecordChannelRegistry::ChannelId id, T value) {
+        registry_->publish<T>(id, value);
+    }
+
+    inline void publish_axis(util::RecordChannelRegistry::ChannelId first,
+                             const axis_t &axis) {
+        registry_->publish_array(first, axis);
+    }
+
+    // 周期结束时调用, 按选择采样并放入记录队列
+    inline void push_cycle(uint64_t tick_us) { recorder_->push_cycle(tick_us); }
+
+private:
+    void _register_channels();
+
+private:
+    util::RecordChannelRegistry::ptr registry_;
+    util::RecordChannelRecorder::ptr recorder_;
+    MotionRecordChannels ids_;
+
+    QString name_{"Channels"};
+
+    QString bin_dir_{};
+    QString decode_dir_{};
+
+    edm::log::logger_ptr logger_ = EDM_LOGGER_ROOT();
+};
+
+} // namespace move
+} // namespace edm
@@ -0,0 +1,65 @@
+#include "DataRecordInstance.h"
+
+EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+
+namespace edm {
+namespace move {
+
+util::RecordStreamPublisher::ptr OpenRecordStream(const QString &name) {
+    const auto &ss = SystemSettings::instance().get_record_stream_settings();
+    if (!ss.enable) {
+        return nullptr;
+    }
+
+    std::string address;
+    if (name == "Data1") {
+        address = ss.data1_address;
+    } else if (name == "Data2") {
+        address = ss.data2_address;
+    } else if (name == "Channels") {
+        address = ss.channels_address;
+    }
+
+    if (address.empty()) {
+        return nullptr;
+    }
+
+    auto stream = std::make_shared<util::RecordStreamPublisher>();
+    if (!stream->open(address)) {
+        s_logger->warn("{} record stream open failed: {}", name.toStdString(),
+                       address);
+        return nullptr;
+    }
+
+    s_logger->info("{} record stream: {}", name.toStdString(), address);
+    return stream;
+}
+
+std::string EventTriggerString(uint32_t trigger_bits) {
+    static const std::pair<uint32_t, const char *> names[] = {
+        {EventTrigger_ShortRateSpike, "short_rate"},
+        {EventTrigger_TouchWarning, "touch"},
+        {EventTrigger_FollowingErrorLimit, "following_error"},
+        {EventTrigger_Breakout, "breakout"},
+        {EventTrigger_ServoFault, "servo_fault"},
+    };
+
+    std::string str;
+    for (const auto &[bit, name] : names) {
+        if (trigger_bits & bit) {
+            if (!str.empty()) {
+                str += '+';
+            }
+            str += name;
+        }
+    }
+
+    if (str.empty()) {
+        str = "unknown";
+    }
+
+    return str;
+}
+
+} // namespace move
+} // namespace edm
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Logger/LogDefine.h"
+#include "SystemSettings/SystemSettings.h"
 #include "Utils/DataQueueRecorder/DataQueueRecorder.h"
+#include "Utils/DataQueueRecorder/EventCaptureRecorder.h"
+#include "Utils/DataQueueRecorder/RecordFileDecoder.h"
 #include "config.h"
 #include <memory>
 #include <optional>
@@ -17,6 +20,22 @@
 namespace edm {
 namespace move {
 
+// 事件触发记录的触发源 (位掩码)
+enum EventTrigger : uint32_t {
+    EventTrigger_ShortRateSpike = 1 << 0,      // 短路率突增
+    EventTrigger_TouchWarning = 1 << 1,        // 接触感知报警
+    EventTrigger_FollowingErrorLimit = 1 << 2, // 跟随误差超限
+    EventTrigger_Breakout = 1 << 3,            // 穿透检测
+    EventTrigger_ServoFault = 1 << 4,          // 驱动器报错
+};
+
+// 触发位转为字符串, 如 "short_rate+touch"
+std::string EventTriggerString(uint32_t trigger_bits);
+
+// 按记录名称 (Data1/Data2/Channels) 打开系统设定中的实时流
+// 未启用或打开失败时返回nullptr
+util::RecordStreamPublisher::ptr OpenRecordStream(const QString &name);
+
 // DataStruct should have `clear()` method
 template <typename DataStruct> class DataRecordInstanceBase {
 public:
@@ -27,6 +46,8 @@ public:
         : name_(name), bin_dir_(bin_dir), decode_dir_(decode_dir) {
         record_data_queuerecorder_ =
             std::make_shared<util::DataQueueRecorder<DataStruct>>();
+        event_capture_recorder_ =
+            std::make_shared<util::EventCaptureRecorder<DataStruct>>();
     }
     virtual ~DataRecordInstanceBase() = default;
 
@@ -46,9 +67,30 @@ public:
         return record_data_queuerecorder_->is_running();
     }
 
-    // 将这一周期缓存的所有记录数据丢给记录器队列(线程)
+    // 判断是否需要采集本周期数据 (连续记录或事件触发记录任一在运行)
+    inline bool is_data_collecting() const {
+        return record_data_queuerecorder_->is_running() ||
+               event_capture_recorder_->is_running();
+    }
+
+    // 将这一周期缓存的所有记录数据丢给记录器队列(线程)和事件触发环形缓冲
     inline void push_data_to_recorder() {
         record_data_queuerecorder_->push_data(record_data_cache_);
+
+        if (event_capture_recorder_->is_running()) {
+            auto trigger_bits = check_event_triggers(record_data_cache_);
+
+            // 新开始的记录: 子类保存的上一周期状态来自上次记录,
+            // 首个周期只用于建立边沿状态, 不触发
+            const auto session = event_capture_recorder_->session();
+            if (session != event_capture_session_) {
+                event_capture_session_ = session;
+                trigger_bits = 0;
+            }
+
+            event_capture_recorder_->push_data(record_data_cache_,
+                                               trigger_bits);
+        }
     }
 
 public:
@@ -58,8 +100,16 @@ public:
         return record_data_queuerecorder_;
     }
 
-    // 创建header字符串
-    virtual std::string generate_data_header() const = 0;
+    // 记录结构描述, 写入记录文件头
+    virtual util::RecordSchema generate_data_schema() const = 0;
+
+    // 记录文件附加文本(如算法参数), 写入记录文件头
+    virtual std::string generate_data_comment() const { return {}; }
+
+    // 创建header字符串 (附加文本 + 列名)
+    std::string generate_data_header() const {
+        return generate_data_comment() + generate_data_schema().column_header();
+    }
 
     // 开始记录, 成功的话, 返回文件名
     std::optional<QString> start_record();
@@ -67,17 +117,40 @@ public:
     // 停止记录
     void stop_record(bool wait_for_stopped = true);
 
-    // 解码文件
-    std::optional<QString> decode_one_file(const QString &bin_filename,
-                                           bool include_header = true) const;
+    // 开始事件触发记录, 参数取自系统设定
+    bool start_event_capture();
+    void stop_event_capture() { event_capture_recorder_->stop_capture(); }
+    inline bool is_event_capture_running() const {
+        return event_capture_recorder_->is_running();
+    }
+    inline auto get_event_capture_recorder() const {
+        return event_capture_recorder_;
+    }
 
-    // 实现bin_to_string
-    virtual std::string bin_to_string(const DataStruct &bin) const = 0;
+    // 解码文件 (多线程并行, 可在非GUI线程调用)
+    // progress_cb: 进度回调, 在调用线程中执行
+    // cancel_flag: 置位后尽快结束解码, 返回nullopt
+    std::optional<QString> decode_one_file(
+        const QString &bin_filename, bool include_header = true,
+        const util::RecordFileDecoder::ProgressCallback &progress_cb = nullptr,
+        const std::atomic_bool *cancel_flag = nullptr) const;
+
+protected:
+    // 运动线程每周期调用, 根据本周期数据判断触发源, 返回触发位
+    // 需要只在状态变化(上升沿)时触发, 由子类保存上一周期状态
+    virtual uint32_t check_event_triggers(const DataStruct &) {
+        return 0;
+    }
 
 protected:
     DataStruct record_data_cache_;
     typename util::DataQueueRecorder<DataStruct>::ptr record_data_queuerecorder_;
 
+    typename util::EventCaptureRecorder<DataStruct>::ptr
+        event_capture_recorder_;
+    _sys::_event_capture_settings event_capture_settings_; // 开始时拷贝
+    uint32_t event_capture_session_{0}; // 运动线程中上次push的记录序号
+
     QString name_;
 
     QString bin_dir_{};
@@ -1,7 +1,10 @@
 #include "DataRecordInstance.h"
 
+#include "SystemSettings/SystemSettings.h"
+
 #include <QDateTime>
 #include <QFileInfo>
+#include <algorithm>
 #include <optional>
 
 namespace edm {
@@ -13,14 +16,33 @@ std::optional<QString> DataRecordInstanceBase<DataStruct>::start_record() {
         bin_dir_ + name_ + "_" +
         QDateTime::currentDateTime().toString("yyyyMMdd_hh_mm_ss_zzz") + ".bin";
 
+    util::RecordFileInfo info;
+    info.comment = generate_data_comment();
+    info.cycle_us = SystemSettings::instance().get_motion_cycle_us();
+    info.block_size = EDM_DATAQUEUERECORDER_BLOCK_SIZE;
+    info.codec = static_cast<util::RecordCodec>(EDM_DATAQUEUERECORDER_CODEC);
+
+    // 实时流 (可选), 只发送流时不写文件
+    auto stream = OpenRecordStream(name_);
+    record_data_queuerecorder_->set_stream_publisher(stream);
+    if (stream &&
+        SystemSettings::instance().get_record_stream_settings().stream_only) {
+        bin_file.clear();
+    }
+
     // start record
-    auto ret = record_data_queuerecorder_->start_record(bin_file.toStdString());
+    auto ret = record_data_queuerecorder_->start_record(
+        bin_file.toStdString(), generate_data_schema(), info);
 
-    if (ret) {
-        return bin_file;
-    } else {
+    if (!ret) {
         return std::nullopt;
     }
+
+    if (bin_file.isEmpty()) {
+        return QString{"stream only"};
+    }
+
+    return bin_file;
 }
 
 template <typename DataStruct>
@@ -29,52 +51,99 @@ void DataRecordInstanceBase<DataStruct>::stop_record(bool wait_for_stopped) {
 }
 
 template <typename DataStruct>
-std::optional<QString>
-DataRecordInstanceBase<DataStruct>::decode_one_file(const QString &bin_filename,
-                                                    bool include_header) const {
-    QFileInfo fi(bin_filename);
-    auto decode_filename = decode_dir_ + fi.baseName() + ".txt";
-
-    std::ifstream ifs(bin_filename.toStdString(), std::ios::binary);
-    if (!ifs.is_open()) {
-        logger_->error("decode file failed: {}, open bin failed",
-                        bin_filename.toStdString());
-        return std::nullopt;
+bool DataRecordInstanceBase<DataStruct>::start_event_capture() {
+    if (event_capture_recorder_->is_running()) {
+        return false;
     }
 
-    std::ofstream ofs(decode_filename.toStdString());
-    if (!ofs.is_open()) {
-        ifs.close();
-        logger_->error("decode file failed: {}, open txt failed",
-                        bin_filename.toStdString());
-        return std::nullopt;
-    }
+    event_capture_settings_ =
+        SystemSettings::instance().get_event_capture_settings();
+    const auto &s = event_capture_settings_;
+
+    // 周期配置错误 (0) 时按1us计, 不要除零
+    const auto cycle_us =
+        std::max(1u, SystemSettings::instance().get_motion_cycle_us());
+    auto ms_to_cycles = [cycle_us](uint32_t ms) -> uint32_t {
+        return (uint64_t)ms * 1000 / cycle_us;
+    };
+
+    // 在记录器后台线程中调用
+    auto file_generator = [this, cycle_us](uint32_t trigger_bits,
+                                           std::string &filename,
+                                           util::RecordFileInfo &info) {
+        auto trigger_str = EventTriggerString(trigger_bits);
+
+        filename = (bin_dir_ + name_ + "_event_" +
+                    QDateTime::currentDateTime().toString(
+                        "yyyyMMdd_hh_mm_ss_zzz") +
+                    "_" + QString::fromStdString(trigger_str) + ".bin")
+                       .toStdString();
+
+        info.comment = "event trigger: " + trigger_str + "\n" +
+                       generate_data_comment();
+        info.cycle_us = cycle_us;
+        info.block_size = EDM_DATAQUEUERECORDER_BLOCK_SIZE;
+        info.codec =
+            static_cast<util::RecordCodec>(EDM_DATAQUEUERECORDER_CODEC);
+
+        logger_->info("event captured: {}", filename);
+        return true;
+    };
+
+    auto ret = event_capture_recorder_->start_capture(
+        generate_data_schema(), std::max(1u, ms_to_cycles(s.pre_trigger_ms)),
+        ms_to_cycles(s.post_trigger_ms), ms_to_cycles(s.holdoff_ms),
+        file_generator);
 
-    ifs.seekg(0, std::ios::end);
-    int size = ifs.tellg();
+    if (ret) {
+        logger_->info("{} event capture started, pre: {} ms, post: {} ms",
+                      name_.toStdString(), s.pre_trigger_ms,
+                      s.post_trigger_ms);
+    } else {
+        logger_->error("{} event capture start failed", name_.toStdString());
+    }
 
-    int data_num = size / sizeof(DataStruct);
-    logger_->debug("size: {}, datas: {}", size, data_num);
+    return ret;
+}
 
-    ifs.seekg(0, std::ios::beg);
+template <typename DataStruct>
+std::optional<QString> DataRecordInstanceBase<DataStruct>::decode_one_file(
+    const QString &bin_filename, bool include_header,
+    const util::RecordFileDecoder::ProgressCallback &progress_cb,
+    const std::atomic_bool *cancel_flag) const {
+    QFileInfo fi(bin_filename);
+    auto decode_filename = decode_dir_ + fi.baseName() + ".txt";
 
-    ofs.setf(std::ios::fixed, std::ios::floatfield);
-    ofs.precision(4);
+    util::RecordFileDecoder decoder;
+    decoder.set_progress_callback(progress_cb);
+    decoder.set_cancel_flag(cancel_flag);
 
-    if (include_header) {
-        ofs << generate_data_header() << '\n';
+    // 新格式按文件头中的字段描述解码, 旧文件按当前结构体布局解码
+    util::RecordDecodeResult result;
+    if (util::RecordFileReader::IsRecordFile(bin_filename.toStdString())) {
+        result = decoder.decode_record_file(bin_filename.toStdString(),
+                                            decode_filename.toStdString(),
+                                            include_header);
+    } else {
+        result = decoder.decode_raw_file(
+            bin_filename.toStdString(), decode_filename.toStdString(),
+            generate_data_schema(),
+            include_header ? generate_data_header() : std::string{});
     }
 
-    for (int i = 0; i < data_num; ++i) {
-        DataStruct data;
-        ifs.read(reinterpret_cast<char *>(&data), sizeof(DataStruct));
-
-        ofs << bin_to_string(data) << '\n';
+    if (result.canceled) {
+        logger_->info("decode file canceled: {}", bin_filename.toStdString());
+        return std::nullopt;
     }
 
-    ifs.close();
-    ofs.close();
+    if (!result.ok) {
+        logger_->error("decode file failed: {}", bin_filename.toStdString());
+        return std::nullopt;
+    }
 
+    logger_->debug("datas: {}, bad blocks: {}, truncated: {}",
+                   result.record_count, result.bad_block_count,
+                   result.truncated);
     logger_->info("Decode Success, saved to: {}",
                    decode_filename.toStdString());
 
@@ -82,4 +151,4 @@ DataRecordInstanceBase<DataStruct>::decode_one_file(const QString &bin_filename,
 }
 
 } // namespace move
-} // namespace edm
\ No newline at end of file
+} // namespace edm
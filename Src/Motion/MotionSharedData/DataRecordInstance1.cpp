@@ -1,48 +1,68 @@
 #include "DataRecordInstance1.h"
 
+#include <cmath>
+
 namespace edm {
 namespace move {
 
-std::string DataRecordInstance1::generate_data_header() const {
-    std::stringstream ss;
-
-    ss << "tick_us" << '\t';
+util::RecordSchema DataRecordInstance1::generate_data_schema() const {
+    util::RecordSchema schema{name_.toStdString(), sizeof(RecordData1)};
 
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << "cmd" << i << '\t';
-    }
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << "act" << i << '\t';
-    }
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << "err" << i << '\t';
-    }
-    ss << "servocmd" << '\t' << "isg01" << '\t' << "avgvol" << '\t' << "current"
-       << '\t' << "normal" << '\t' << "short" << '\t' << "open";
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, thread_tick_us, "tick_us");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, new_cmd_axis, "cmd");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, act_axis, "act");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, following_error_axis, "err");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, g01_servo_cmd, "servocmd");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, is_g01_normal_servoing, "isg01");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, average_voltage, "avgvol");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, current, "current");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, normal_charge_rate, "normal");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, short_charge_rate, "short");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, open_charge_rate, "open");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, touch_warning, "touchwarn");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData1, servo_fault, "servofault");
 
-    return ss.str();
+    return schema;
 }
 
-std::string DataRecordInstance1::bin_to_string(const RecordData1 &bin) const {
-    std::stringstream ss;
+uint32_t DataRecordInstance1::check_event_triggers(const RecordData1 &data) {
+    const auto &s = event_capture_settings_;
 
-    ss << bin.thread_tick_us << '\t';
+#ifdef EDM_USE_ZYNQ_SERVOBOARD
+    // zynq伺服板不回传短路率 (记录中恒为0), 短路率触发不可用
+    const bool short_spike = false;
+#else
+    bool short_spike = data.short_charge_rate >= s.short_rate_threshold;
+#endif
 
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << bin.new_cmd_axis[i] << '\t';
+    bool following_error_over = false;
+    for (auto e : data.following_error_axis) {
+        if (std::abs(e) > s.following_error_limit) {
+            following_error_over = true;
+            break;
+        }
     }
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << bin.act_axis[i] << '\t';
+
+    uint32_t trigger_bits = 0;
+    if (short_spike && !last_short_spike_) {
+        trigger_bits |= EventTrigger_ShortRateSpike;
+    }
+    if (data.touch_warning && !last_touch_warning_) {
+        trigger_bits |= EventTrigger_TouchWarning;
     }
-    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
-        ss << bin.following_error_axis[i] << '\t';
+    if (following_error_over && !last_following_error_over_) {
+        trigger_bits |= EventTrigger_FollowingErrorLimit;
     }
-    ss << bin.g01_servo_cmd << '\t' << (int)bin.is_g01_normal_servoing << '\t'
-       << (int)bin.average_voltage << '\t' << (int)bin.current << '\t'
-       << (int)bin.normal_charge_rate << '\t' << (int)bin.short_charge_rate
-       << '\t' << (int)bin.open_charge_rate ; // << '\n';
+    if (data.servo_fault && !last_servo_fault_) {
+        trigger_bits |= EventTrigger_ServoFault;
+    }
+
+    last_short_spike_ = short_spike;
+    last_touch_warning_ = data.touch_warning;
+    last_following_error_over_ = following_error_over;
+    last_servo_fault_ = data.servo_fault;
 
-    return ss.str();
+    return trigger_bits & s.trigger_mask;
 }
 
 } // namespace move
@@ -37,6 +37,10 @@ struct RecordData1 {
     uint16_t current{0}; // 电流
     uint16_t average_voltage{0};
 
+    // 报警状态 (用于事件触发记录)
+    bool touch_warning{false};
+    bool servo_fault{false};
+
     inline void clear() {
         thread_tick_us = 0;
         new_cmd_axis.fill(0.0);
@@ -50,6 +54,9 @@ struct RecordData1 {
         open_charge_rate = 0;
         current = 0;
         average_voltage = 0;
+
+        touch_warning = false;
+        servo_fault = false;
     }
 };
 
@@ -58,9 +65,17 @@ public:
     DataRecordInstance1(const QString &bin_dir, const QString &decode_dir)
         : DataRecordInstanceBase("Data1", bin_dir, decode_dir) {}
 
-    std::string generate_data_header() const override;
+    util::RecordSchema generate_data_schema() const override;
+
+protected:
+    uint32_t check_event_triggers(const RecordData1 &data) override;
 
-    std::string bin_to_string(const RecordData1 &bin) const override;
+private:
+    // 上一周期的触发状态, 用于检测上升沿
+    bool last_short_spike_{false};
+    bool last_touch_warning_{false};
+    bool last_following_error_over_{false};
+    bool last_servo_fault_{false};
 };
 
 } // namespace move
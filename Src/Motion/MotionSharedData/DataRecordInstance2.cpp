@@ -3,7 +3,7 @@
 namespace edm {
 namespace move {
 
-std::string DataRecordInstance2::generate_data_header() const {
+std::string DataRecordInstance2::generate_data_comment() const {
     std::stringstream ss;
 
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
@@ -35,31 +35,41 @@ std::string DataRecordInstance2::generate_data_header() const {
     }
 #endif
 
-    ss << "tick_us" << '\t' << "cmd_s" << '\t' << "act_s" << '\t';
+    return ss.str();
+}
 
-    ss << "is_drilling" << '\t' << "kn_detected" << '\t' << "breakout_detected" << '\t';
+util::RecordSchema DataRecordInstance2::generate_data_schema() const {
+    util::RecordSchema schema{name_.toStdString(), sizeof(RecordData2)};
 
-    ss << "detect_started" << '\t' << "detect_state" << '\t';
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, thread_tick_us, "tick_us");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, new_cmd_axis_s, "cmd_s");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, act_axis_s, "act_s");
 
-    ss << "realtime_voltage" << '\t' << "averaged_voltage" << '\t' << "kn" << '\t'
-       << "kn_valid_rate" << '\t' << "kn_cnt"; // << '\n';
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, is_drilling, "is_drilling");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, kn_detected, "kn_detected");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, breakout_detected, "breakout_detected");
 
-    return ss.str();
-}
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, detect_started, "detect_started");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, detect_state, "detect_state");
 
-std::string DataRecordInstance2::bin_to_string(const RecordData2 &bin) const {
-    std::stringstream ss;
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, realtime_voltage, "realtime_voltage");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, averaged_voltage, "averaged_voltage");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, kn, "kn");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, kn_valid_rate, "kn_valid_rate");
+    EDM_RECORD_SCHEMA_ADD(schema, RecordData2, kn_cnt, "kn_cnt");
 
-    ss << bin.thread_tick_us << '\t' << bin.new_cmd_axis_s << '\t' << bin.act_axis_s << '\t';
-
-    ss << bin.is_drilling << '\t' << bin.kn_detected << '\t' << bin.breakout_detected << '\t';
+    return schema;
+}
 
-    ss << bin.detect_started << '\t' << bin.detect_state << '\t';
+uint32_t DataRecordInstance2::check_event_triggers(const RecordData2 &data) {
+    uint32_t trigger_bits = 0;
+    if (data.breakout_detected && !last_breakout_detected_) {
+        trigger_bits |= EventTrigger_Breakout;
+    }
 
-    ss << bin.realtime_voltage << '\t' << bin.averaged_voltage << '\t' << bin.kn << '\t'
-       << bin.kn_valid_rate << '\t' << bin.kn_cnt; // << '\n';
+    last_breakout_detected_ = data.breakout_detected;
 
-    return ss.str();
+    return trigger_bits & event_capture_settings_.trigger_mask;
 }
 
 } // namespace move
@@ -56,9 +56,9 @@ public:
     DataRecordInstance2(const QString &bin_dir, const QString &decode_dir)
         : DataRecordInstanceBase("Data2", bin_dir, decode_dir) {}
 
-    std::string generate_data_header() const override;
+    util::RecordSchema generate_data_schema() const override;
 
-    std::string bin_to_string(const RecordData2 &bin) const override;
+    std::string generate_data_comment() const override;
 
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     void set_drill_param(const move::DrillParams &drill_params)
@@ -68,6 +68,12 @@ private:
     std::optional<move::DrillParams> current_drill_params_opt_; 
     // 用于打印header, 记录算法参数(要求记录开始后不更改参数)
 #endif
+
+protected:
+    uint32_t check_event_triggers(const RecordData2 &data) override;
+
+private:
+    bool last_breakout_detected_{false};
 };
 
 } // namespace move
@@ -21,6 +21,9 @@ MotionSharedData::MotionSharedData() {
     data_record_instance2_->set_drill_param(drill_params_);
 #endif
 
+    channel_record_instance_ = std::make_shared<ChannelRecordInstance>(
+        RecordData1BinDir, RecordData1DecodeDir);
+
     MotionUtils::ClearAxis(global_cmd_axis_);
     MotionUtils::ClearAxis(global_v_offsets_);
 
@@ -19,6 +19,7 @@
 
 #include "QtDependComponents/ZynqConnection/ZynqUdpMessageHolder.h"
 
+#include "ChannelRecordInstance.h"
 #include "DataRecordInstance1.h"
 #include "DataRecordInstance2.h"
 #include "Utils/UnitConverter/UnitConverter.h"
@@ -117,6 +118,11 @@ public: // 数据记录相关, 一个周期内可能需要在不同地方记录
     }
 #endif
 
+    // 运行时选择通道的记录
+    inline auto get_channel_record_instance() const {
+        return channel_record_instance_;
+    }
+
 public:
     inline auto get_signal_buffer() const { return signal_buffer_; }
     inline void set_signal_buffer(SignalBuffer::ptr signal_buffer) {
@@ -226,6 +232,8 @@ private:
     std::shared_ptr<DataRecordInstance2> data_record_instance2_;
 #endif
 
+    ChannelRecordInstance::ptr channel_record_instance_;
+
 private:
     // 共享ecat manager, 便于获取数据和设定(如速度偏置控制)
     ecat::EcatManager::ptr ecat_manager_;
@@ -16,6 +16,7 @@ MotionSignalQueue::GetMotionSignalTypeStr(MotionSignalType signal_type) {
         XX_(AutoPaused)
         XX_(AutoResumed)
         XX_(AutoStopped)
+        XX_(AutoBlockSwitched)
 
 #undef XX_
 
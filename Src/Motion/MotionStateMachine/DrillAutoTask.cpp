@@ -7,6 +7,7 @@
 #include <chrono>
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 static auto s_motion_shared = edm::move::MotionSharedData::instance();
 
@@ -420,7 +421,7 @@ void DrillAutoTask::_drillstate_return_backing() {
 
 void DrillAutoTask::run_once() {
     auto data_record_instance2 = s_motion_shared->get_data_record_instance2();
-    if (data_record_instance2->is_data_recorder_running()) {
+    if (data_record_instance2->is_data_collecting()) {
         auto &rd = data_record_instance2->get_record_data_ref();
 
         if (drill_state_ == DrillState::Drilling) {
@@ -525,8 +526,8 @@ const char *DrillAutoTask::GetDrillStateStr(DrillAutoTask::DrillState s) {
 }
 
 void DrillAutoTask::_drillstate_changeto(DrillAutoTask::DrillState new_state) {
-    s_logger->trace("Drill State: {} -> {}", GetDrillStateStr(drill_state_),
-                    GetDrillStateStr(new_state));
+    s_rt_logger->trace("Drill State: {} -> {}", GetDrillStateStr(drill_state_),
+                       GetDrillStateStr(new_state));
 
     drill_state_ = new_state;
 }
@@ -11,10 +11,23 @@ G00AutoTask::G00AutoTask(const axis_t &target_axis,
                          const MoveRuntimePlanSpeedInput &speed_param,
                          bool enable_touch_detect,
                          TouchDetectHandler::ptr touch_detect_handler)
-    : AutoTask(AutoTaskType::G00), enable_touch_detect_(enable_touch_detect),
-      touch_detect_handler_(touch_detect_handler) {
-    pm_handler_.start(speed_param, s_motion_shared->get_global_cmd_axis(),
-                      target_axis);
+    : G00AutoTask(AutoTaskDeferredStart{}, target_axis, speed_param,
+                  enable_touch_detect, touch_detect_handler) {
+    start();
+}
+
+G00AutoTask::G00AutoTask(AutoTaskDeferredStart, const axis_t &target_axis,
+                         const MoveRuntimePlanSpeedInput &speed_param,
+                         bool enable_touch_detect,
+                         TouchDetectHandler::ptr touch_detect_handler)
+    : AutoTask(AutoTaskType::G00), touch_detect_handler_(touch_detect_handler),
+      enable_touch_detect_(enable_touch_detect), target_axis_(target_axis),
+      speed_param_(speed_param) {}
+
+bool G00AutoTask::start() {
+    return pm_handler_.start(speed_param_,
+                             s_motion_shared->get_global_cmd_axis(),
+                             target_axis_);
 }
 
 bool G00AutoTask::pause() { return pm_handler_.pause(); }
@@ -12,6 +12,13 @@ public:
                 const MoveRuntimePlanSpeedInput &speed_param,
                 bool enable_touch_detect,
                 TouchDetectHandler::ptr touch_detect_handler);
+    // 延迟开始, 见 AutoTask::start
+    G00AutoTask(AutoTaskDeferredStart, const axis_t &target_axis,
+                const MoveRuntimePlanSpeedInput &speed_param,
+                bool enable_touch_detect,
+                TouchDetectHandler::ptr touch_detect_handler);
+
+    bool start() override;
 
     bool pause() override;
     bool resume() override;
@@ -36,6 +43,9 @@ private:
     PointMoveHandler pm_handler_;
 
     bool enable_touch_detect_;
+
+    axis_t target_axis_;
+    MoveRuntimePlanSpeedInput speed_param_;
 };
 
 } // namespace move
@@ -5,6 +5,7 @@
 #include <chrono>
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 // static bool s_g01_run_each_servo_cmd =
 //     edm::SystemSettings::instance().get_enable_g01_run_each_servo_cmd();
@@ -21,18 +22,47 @@ G01AutoTask::G01AutoTask(
     TrajectoryLinearSegement::ptr line_traj, unit_t max_jump_height_from_begin,
     const std::function<void(bool)> &cb_enable_votalge_gate,
     const std::function<void(bool)> &cb_mach_on)
+    : G01AutoTask(AutoTaskDeferredStart{}, line_traj,
+                  max_jump_height_from_begin, cb_enable_votalge_gate,
+                  cb_mach_on) {
+    _begin();
+
+    s_logger->debug("dn ms: {}, buffer_blu: {}", jumping_param_.dn_ms,
+                    jumping_param_.buffer_blu);
+}
+
+G01AutoTask::G01AutoTask(
+    AutoTaskDeferredStart, TrajectoryLinearSegement::ptr line_traj,
+    unit_t max_jump_height_from_begin,
+    const std::function<void(bool)> &cb_enable_votalge_gate,
+    const std::function<void(bool)> &cb_mach_on)
     : AutoTask(AutoTaskType::G01), line_traj_(line_traj),
       max_jump_height_from_begin_(max_jump_height_from_begin),
       cb_enable_votalge_gate_(cb_enable_votalge_gate), cb_mach_on_(cb_mach_on) {
 
     assert(line_traj_->at_start());
 
+#ifdef EDM_G01_ENABLE_DYNAMIC_JUMP_JUDGE
+    // 初始化滑动计数器
+    sc_servo_go_.clear();
+    sc_servo_go_.resize(2000 * 1000 / s_motion_shared->get_thread_cycle_us() ); // 等效到2秒窗口
+#endif
+}
+
+bool G01AutoTask::start() {
+    // 入队时还不知道前一个块实际停在哪里, 以当前指令位置为起点
+    // (赋值到已分配的轨迹对象, 不分配内存)
+    *line_traj_ = TrajectoryLinearSegement(
+        s_motion_shared->get_global_cmd_axis(), line_traj_->end_pos());
+
+    _begin();
+    return true;
+}
+
+void G01AutoTask::_begin() {
     // 开始时获取一次抬刀参数
     jumping_param_ = s_motion_shared->get_jump_param();
 
-    s_logger->debug("dn ms: {}, buffer_blu: {}", jumping_param_.dn_ms,
-                    jumping_param_.buffer_blu);
-
     // 设定一个"上一次抬刀结束时间" = "上一次开始放电的时间"
     // 用于根据DN值, 开始下一次抬刀
     last_jump_end_time_ms_ = GetCurrentTimeMs();
@@ -43,12 +73,6 @@ G01AutoTask::G01AutoTask(
         std::chrono::high_resolution_clock::now();
 
     cb_mach_on_(true);
-
-#ifdef EDM_G01_ENABLE_DYNAMIC_JUMP_JUDGE
-    // 初始化滑动计数器
-    sc_servo_go_.clear();
-    sc_servo_go_.resize(2000 * 1000 / s_motion_shared->get_thread_cycle_us() ); // 等效到2秒窗口
-#endif
 }
 
 bool G01AutoTask::pause() {
@@ -135,6 +159,16 @@ bool G01AutoTask::is_stopped() const { return state_ == State::Stopped; }
 bool G01AutoTask::is_over() const { return is_stopped(); }
 
 void G01AutoTask::run_once() {
+    auto channel_record_instance =
+        s_motion_shared->get_channel_record_instance();
+    if (channel_record_instance->is_running()) {
+        const auto &ids = channel_record_instance->ids();
+        channel_record_instance->publish<uint8_t>(ids.g01_state,
+                                                  (uint8_t)state_);
+        channel_record_instance->publish<uint8_t>(ids.g01_servo_substate,
+                                                  (uint8_t)servo_sub_state_);
+    }
+
     switch (state_) {
     case State::NormalRunning:
         _state_normal_running();
@@ -217,29 +251,29 @@ const char *G01AutoTask::GetResumeSubStateStr(ResumeSubState s) {
 }
 
 void G01AutoTask::_state_changeto(State new_s) {
-    s_logger->trace("G01 State: {} -> {}", GetStateStr(state_),
-                    GetStateStr(new_s));
+    s_rt_logger->trace("G01 State: {} -> {}", GetStateStr(state_),
+                       GetStateStr(new_s));
     state_ = new_s;
 }
 
 void G01AutoTask::_servo_substate_changeto(ServoSubState new_s) {
-    s_logger->trace("G01 ServoSubState: {} -> {}",
-                    GetServoSubStateStr(servo_sub_state_),
-                    GetServoSubStateStr(new_s));
+    s_rt_logger->trace("G01 ServoSubState: {} -> {}",
+                       GetServoSubStateStr(servo_sub_state_),
+                       GetServoSubStateStr(new_s));
     servo_sub_state_ = new_s;
 }
 
 void G01AutoTask::_pauseorstop_substate_changeto(PauseOrStopSubState new_s) {
-    s_logger->trace("G01 PauseOrStopSubState: {} -> {}",
-                    GetPauseOrStopSubStateStr(pause_or_stop_sub_state_),
-                    GetPauseOrStopSubStateStr(new_s));
+    s_rt_logger->trace("G01 PauseOrStopSubState: {} -> {}",
+                       GetPauseOrStopSubStateStr(pause_or_stop_sub_state_),
+                       GetPauseOrStopSubStateStr(new_s));
     pause_or_stop_sub_state_ = new_s;
 }
 
 void G01AutoTask::_resume_substate_changeto(ResumeSubState new_s) {
-    s_logger->trace("G01 ResumeSubState: {} -> {}",
-                    GetResumeSubStateStr(resume_sub_state_),
-                    GetResumeSubStateStr(new_s));
+    s_rt_logger->trace("G01 ResumeSubState: {} -> {}",
+                       GetResumeSubStateStr(resume_sub_state_),
+                       GetResumeSubStateStr(new_s));
     resume_sub_state_ = new_s;
 }
 
@@ -485,11 +519,11 @@ void G01AutoTask::_servo_substate_jumpdowning() {
         line_traj_->set_curr_length(servoing_length_before_jump_ -
                                     jumping_param_.buffer_blu);
 
-        s_logger->trace("jump down over: ltcurr-z: "
-                        "{}, curr-z: {}, curr-length: {}",
-                        this->line_traj_->curr_pos()[2],
-                        s_motion_shared->get_global_cmd_axis()[2],
-                        line_traj_->curr_length());
+        s_rt_logger->trace("jump down over: ltcurr-z: "
+                           "{}, curr-z: {}, curr-length: {}",
+                           this->line_traj_->curr_pos()[2],
+                           s_motion_shared->get_global_cmd_axis()[2],
+                           line_traj_->curr_length());
 
         _servo_substate_changeto(ServoSubState::JumpDowningBuffer);
     }
@@ -512,7 +546,7 @@ void G01AutoTask::_servo_substate_jumpdowningbuffer() {
             // 缓冲段最后一次运动
             servo_cmd = buffer_remaining_length;
 
-            s_logger->trace(
+            s_rt_logger->trace(
                 "buffer over, servo_cmd:{}, buffer_remaining_length: {}",
                 servo_cmd, buffer_remaining_length);
 
@@ -524,8 +558,8 @@ void G01AutoTask::_servo_substate_jumpdowningbuffer() {
         s_motion_shared->set_global_cmd_axis(this->line_traj_->curr_pos());
 
     } else if (servo_cmd <= 0.0) {
-        s_logger->trace("buffer interrupted, buffer_remaining_length: {}",
-                        buffer_remaining_length);
+        s_rt_logger->trace("buffer interrupted, buffer_remaining_length: {}",
+                           buffer_remaining_length);
         buffer_interrupted = true; // 缓冲段有回退, 直接退出走正常伺服回退
     }
 
@@ -533,11 +567,11 @@ void G01AutoTask::_servo_substate_jumpdowningbuffer() {
         last_jump_end_time_ms_ =
             GetCurrentTimeMs(); // 更新变量: 上一次抬刀结束时间
 
-        s_logger->trace("jump down buffer over: ltcurr-z: "
-                        "{}, curr-z: {}, curr-length: {}",
-                        this->line_traj_->curr_pos()[2],
-                        s_motion_shared->get_global_cmd_axis()[2],
-                        line_traj_->curr_length());
+        s_rt_logger->trace("jump down buffer over: ltcurr-z: "
+                           "{}, curr-z: {}, curr-length: {}",
+                           this->line_traj_->curr_pos()[2],
+                           s_motion_shared->get_global_cmd_axis()[2],
+                           line_traj_->curr_length());
 
         _servo_substate_changeto(ServoSubState::Servoing); // 抬刀全部结束
         return;
@@ -572,12 +606,12 @@ bool G01AutoTask::_servoing_check_and_plan_jump() { // Jump Trigger
     auto sc_servo_go_valid_rate = sc_servo_go_.valid_rate();
     if (sc_servo_go_valid_rate >= sc_servo_go_valid_rate_threshold1_) {
         // 前进比例超过阈值, 不需要抬刀
-        s_logger->trace("dynamic jump judge: no jump, valid rate: {}",
-            sc_servo_go_valid_rate);
+        s_rt_logger->trace("dynamic jump judge: no jump, valid rate: {}",
+                           sc_servo_go_valid_rate);
         return false;
     } else {
-        s_logger->trace("dynamic jump judge: could jump, valid rate: {}",
-            sc_servo_go_valid_rate);
+        s_rt_logger->trace("dynamic jump judge: could jump, valid rate: {}",
+                           sc_servo_go_valid_rate);
     }
 #endif
 
@@ -624,12 +658,20 @@ bool G01AutoTask::_servoing_do_servothings() {
 
     // 记录数据
     auto data_record_instance1 = s_motion_shared->get_data_record_instance1();
-    if (data_record_instance1->is_data_recorder_running()) {
+    if (data_record_instance1->is_data_collecting()) {
         data_record_instance1->get_record_data_ref().g01_servo_cmd = servo_cmd;
         data_record_instance1->get_record_data_ref().is_g01_normal_servoing =
             true;
     }
 
+    auto channel_record_instance =
+        s_motion_shared->get_channel_record_instance();
+    if (channel_record_instance->is_running()) {
+        const auto &ids = channel_record_instance->ids();
+        channel_record_instance->publish<unit_t>(ids.g01_servo_cmd, servo_cmd);
+        channel_record_instance->publish<bool>(ids.g01_servoing, true);
+    }
+
     if (s_motion_shared->get_settings()
             .enable_g01_servo_with_dynamic_strategy) {
         // test get current pos
@@ -702,12 +744,12 @@ bool G01AutoTask::_plan_jump_up() {
             (up_start_pos[i] - curr_maching_dir[i] * jumping_param_.up_blu);
     }
 
-    s_logger->trace("plan jump up: startpos-z: {}, targetpos-z: {}, ltcurr-z: "
-                    "{}, curr-z: {}, curr-length: {}",
-                    up_start_pos[2], jump_up_target_pos_[2],
-                    this->line_traj_->curr_pos()[2],
-                    s_motion_shared->get_global_cmd_axis()[2],
-                    line_traj_->curr_length());
+    s_rt_logger->trace("plan jump up: startpos-z: {}, targetpos-z: {}, "
+                       "ltcurr-z: {}, curr-z: {}, curr-length: {}",
+                       up_start_pos[2], jump_up_target_pos_[2],
+                       this->line_traj_->curr_pos()[2],
+                       s_motion_shared->get_global_cmd_axis()[2],
+                       line_traj_->curr_length());
 
     return this->jump_pm_handler_.start(
         jumping_param_.speed_param, up_start_pos, this->jump_up_target_pos_);
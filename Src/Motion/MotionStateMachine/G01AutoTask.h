@@ -29,6 +29,13 @@ public:
                 unit_t max_jump_height_from_begin,
                 const std::function<void(bool)> &cb_enable_votalge_gate,
                 const std::function<void(bool)> &cb_mach_on);
+    // 延迟开始, 见 AutoTask::start; start() 时以当前指令位置为轨迹起点
+    G01AutoTask(AutoTaskDeferredStart, TrajectoryLinearSegement::ptr line_traj,
+                unit_t max_jump_height_from_begin,
+                const std::function<void(bool)> &cb_enable_votalge_gate,
+                const std::function<void(bool)> &cb_mach_on);
+
+    bool start() override;
 
     bool pause() override;
     bool resume() override;
@@ -93,6 +100,10 @@ private:
             .count();
     }
 
+private:
+    // 开始加工: 获取抬刀参数, 使能电压位和高频
+    void _begin();
+
 private:
     void _state_changeto(State new_s);
     void _servo_substate_changeto(ServoSubState new_s);
@@ -8,6 +8,7 @@
 #include "Utils/UnitConverter/UnitConverter.h"
 #include <cassert>
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 namespace edm {
 
@@ -69,8 +70,8 @@ const char *G01GroupAutoTask::GetStateStr(G01GroupAutoTask::State s) {
 }
 
 void G01GroupAutoTask::_state_changeto(G01GroupAutoTask::State new_s) {
-    s_logger->trace("G01 State: {} -> {}", GetStateStr(state_),
-                    GetStateStr(new_s));
+    s_rt_logger->trace("G01 State: {} -> {}", GetStateStr(state_),
+                       GetStateStr(new_s));
     state_ = new_s;
 }
 
@@ -23,6 +23,9 @@ enum class AutoTaskType {
     // TODO
 };
 
+// 构造延迟开始的任务 (运动块缓冲中的任务, 见 AutoTask::start)
+struct AutoTaskDeferredStart {};
+
 class AutoTask {
 public:
     using ptr = std::shared_ptr<AutoTask>;
@@ -32,9 +35,12 @@ public:
 
     AutoTaskType type() const { return type_; }
 
-    // Note: no start interface.
-    // when constructed, task should be automatically inited as `started` or
-    // `normal_running` state
+    // Note: when constructed, task should be automatically inited as
+    // `started` or `normal_running` state.
+    // 例外: 运动块缓冲中的任务在入队时以 AutoTaskDeferredStart 构造
+    // (预先分配, 接续时不再分配内存), 接续时调用 start() 才开始,
+    // 以接续时的指令位置为起点; 返回false表示开始失败
+    virtual bool start() { return true; }
 
     virtual bool pause() = 0;
     virtual bool resume() = 0;
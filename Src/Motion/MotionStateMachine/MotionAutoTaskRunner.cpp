@@ -4,6 +4,7 @@
 #include "Logger/LogMacro.h"
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 namespace edm {
 
@@ -20,6 +21,12 @@ AutoTaskRunner::AutoTaskRunner(TouchDetectHandler::ptr touch_detect_handler,
 
 void AutoTaskRunner::reset() {
     curr_task_ = nullptr;
+    _clear_block_fifo();
+    for (auto &queued : block_fifo_) {
+        queued.task = nullptr;
+    }
+    curr_block_id_ = -1;
+    stop_requested_ = false;
     _autostate_switch_to(MotionAutoState::Stopped);
 
     pausemove_controller_->init();
@@ -27,6 +34,11 @@ void AutoTaskRunner::reset() {
 }
 
 bool AutoTaskRunner::restart_task(AutoTask::ptr task) {
+    // 直接启动的任务不属于缓冲中的块
+    _clear_block_fifo();
+    curr_block_id_ = -1;
+    stop_requested_ = false;
+
     if (!curr_task_) {
         curr_task_ = task;
         // curr_cmd_axis_ = task->get_curr_cmd_axis();
@@ -195,6 +207,10 @@ bool AutoTaskRunner::stop(bool immediate) {
         return false;
     }
 
+    // 停止时丢弃缓冲中的块
+    _clear_block_fifo();
+    stop_requested_ = true;
+
     if (domin_state_ == DominatedState::PauseMoveRecoverRunning) {
         switch (state_) {
         case MotionAutoState::Stopping:
@@ -268,8 +284,8 @@ bool AutoTaskRunner::stop_manual_pointmove(bool immediate) {
 }
 
 void AutoTaskRunner::_autostate_switch_to(MotionAutoState new_state) {
-    s_logger->trace("AutoState: {} -> {}", GetAutoStateStr(state_),
-                    GetAutoStateStr(new_state));
+    s_rt_logger->trace("AutoState: {} -> {}", GetAutoStateStr(state_),
+                       GetAutoStateStr(new_state));
     state_ = new_state;
 }
 
@@ -278,7 +294,7 @@ void AutoTaskRunner::_autostate_switch_to_paused() {
     pausemove_controller_->init(); //! 初始化坐标
 }
 
-void AutoTaskRunner::_normal_moving() {
+void AutoTaskRunner::_normal_moving(bool chain_next) {
     //! 要防止G00暂停时少走一个周期
     //! 运行放在前面
 
@@ -290,6 +306,11 @@ void AutoTaskRunner::_normal_moving() {
         return;
     }
 
+    // 本周期正常结束, 直接接续下一个块, 不经过 Stopping 多等一个周期
+    if (chain_next && curr_task_->is_stopped() && _switch_to_next_block()) {
+        return;
+    }
+
     if (curr_task_->is_stopping() || curr_task_->is_stopped()) {
         _autostate_switch_to(MotionAutoState::Stopping);
         return;
@@ -378,12 +399,72 @@ void AutoTaskRunner::_stopping() {
     // curr_cmd_axis_ = curr_task_->get_curr_cmd_axis();
 
     if (curr_task_->is_stopped()) {
+        // 正常结束 (停止时缓冲已被清空), 接续下一个块
+        if (_switch_to_next_block()) {
+            return;
+        }
+
         signal_buffer_->set_signal(MotionSignal_AutoStopped);
         _autostate_switch_to(MotionAutoState::Stopped);
         return;
     }
 }
 
+bool AutoTaskRunner::queue_blocks(const std::vector<AutoBlock> &blocks) {
+    if (!curr_task_ || stop_requested_ ||
+        state_ == MotionAutoState::Stopped || !block_task_maker_) {
+        return false;
+    }
+
+    if (block_fifo_count_ + blocks.size() > block_fifo_.size()) {
+        return false;
+    }
+
+    // 先在空闲的槽中创建全部任务 (入队时分配), 全部成功才计入缓冲
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        auto &queued = block_fifo_[(block_fifo_head_ + block_fifo_count_ + i) %
+                                   block_fifo_.size()];
+        queued.task = block_task_maker_(blocks[i]);
+        if (!queued.task) {
+            s_rt_logger->warn("AutoTaskRunner: block {} task create failed",
+                              blocks[i].block_id);
+            return false;
+        }
+        queued.block_id = blocks[i].block_id;
+    }
+
+    block_fifo_count_ += blocks.size();
+    return true;
+}
+
+bool AutoTaskRunner::_switch_to_next_block() {
+    if (block_fifo_count_ == 0) {
+        return false;
+    }
+
+    auto &queued = block_fifo_[block_fifo_head_];
+    block_fifo_head_ = (block_fifo_head_ + 1) % block_fifo_.size();
+    --block_fifo_count_;
+
+    if (!queued.task->start() || queued.task->is_over()) {
+        // 开始失败: 丢弃剩余的块, 正常停止, 上层会从这个块开始重新逐个启动
+        s_rt_logger->warn("AutoTaskRunner: block {} task start failed",
+                          queued.block_id);
+        _clear_block_fifo();
+        return false;
+    }
+
+    // 结束的任务换到空出的槽中, 接续周期内不释放
+    std::swap(curr_task_, queued.task);
+    curr_block_id_ = queued.block_id;
+    _autostate_switch_to(MotionAutoState::NormalMoving);
+    signal_buffer_->set_signal(MotionSignal_AutoBlockSwitched);
+
+    //! 本周期即运行新任务, 块之间没有空周期
+    _normal_moving(false);
+    return true;
+}
+
 void AutoTaskRunner::_dominated_state_pmrecovering_run_once() {
     switch (state_) {
     case MotionAutoState::NormalMoving: {
@@ -458,8 +539,9 @@ void AutoTaskRunner::_dominated_state_pmrecovering_run_once() {
 
 void AutoTaskRunner::_dominated_state_switch_to(
     DominatedState new_domin_state) {
-    s_logger->trace("dominated state: {} -> {}", GetDominStateStr(domin_state_),
-                    GetDominStateStr(new_domin_state));
+    s_rt_logger->trace("dominated state: {} -> {}",
+                       GetDominStateStr(domin_state_),
+                       GetDominStateStr(new_domin_state));
 
     domin_state_ = new_domin_state;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "MotionAutoTask.h"
 #include "G00AutoTask.h"
@@ -10,6 +13,7 @@
 #include "DrillAutoTask.h"
 #include "G01GroupAutoTask.h"
 
+#include "Motion/AutoBlockDefines.h"
 #include "Motion/SignalBuffer/SignalBuffer.h"
 
 #include "Motion/PauseMoveController/PauseMoveController.h"
@@ -54,6 +58,24 @@ public:
                                 const axis_t &start_pos, const axis_t &target_pos);
     bool stop_manual_pointmove(bool immediate = false);
 
+    // 运动块缓冲 (block FIFO):
+    // 块入队时即创建任务 (延迟开始, 见 AutoTask::start), 当前任务正常结束时
+    // 取下一个任务 start(), 同一周期内接续运行, 接续时不分配也不释放内存;
+    // 不发出AutoStopped, 而是发出AutoBlockSwitched; 停止/复位时清空缓冲
+    // 块 -> 任务 的创建由外部给出 (需要回调, 接触感知等), 需以延迟开始构造
+    using BlockTaskMaker = std::function<AutoTask::ptr(const AutoBlock &)>;
+    void set_block_task_maker(BlockTaskMaker maker) {
+        block_task_maker_ = std::move(maker);
+    }
+
+    // 追加块, 只在任务运行中(未被停止)时接收;
+    // 放不下或有任务创建失败时整批拒绝, 返回false
+    bool queue_blocks(const std::vector<AutoBlock> &blocks);
+
+    // 当前执行的块号, 直接启动的任务为-1
+    int curr_block_id() const { return curr_block_id_; }
+    std::size_t queued_block_count() const { return block_fifo_count_; }
+
     // 当前状态机状态
     auto state() const { return state_; }
 
@@ -68,12 +90,20 @@ private:
     // 切换到暂停需要初始化 PauseMoveController, 特殊操作
     void _autostate_switch_to_paused();
 
-    void _normal_moving();
+    // chain_next: 任务在本周期结束时立即接续下一个块
+    // (每周期最多接续一次, 刚接续的新任务不再接续)
+    void _normal_moving(bool chain_next = true);
     void _pausing();
     void _paused();
     void _resuming();
     void _stopping();
 
+    // 当前任务正常结束后接续缓冲中的下一个块, 接续成功返回true
+    bool _switch_to_next_block();
+
+    // 清空缓冲 (只移动下标, 槽中的任务在被覆盖或复位时释放)
+    void _clear_block_fifo() { block_fifo_head_ = block_fifo_count_ = 0; }
+
     void _dominated_state_pmrecovering_run_once();
 
 public:
@@ -106,6 +136,18 @@ private:
     PauseMoveController::ptr pausemove_controller_;
     SignalBuffer::ptr signal_buffer_;
 
+    // 运动块缓冲 (固定容量的环形缓冲, 运行中不分配)
+    struct _QueuedBlock {
+        int block_id{-1};
+        AutoTask::ptr task; // 出队后存放被替换下来的旧任务, 入队覆盖时释放
+    };
+    std::array<_QueuedBlock, AutoBlockFifoCapacity> block_fifo_;
+    std::size_t block_fifo_head_{0};
+    std::size_t block_fifo_count_{0};
+    BlockTaskMaker block_task_maker_;
+    int curr_block_id_ {-1};
+    bool stop_requested_ {false}; // 已被停止, 不再接收和接续块
+
     // axis_t curr_cmd_axis_;
 };
 
@@ -9,6 +9,7 @@
 #include <cassert>
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 namespace edm {
 
@@ -53,6 +54,8 @@ MotionStateMachine::MotionStateMachine(
 
     auto_task_runner_ =
         std::make_shared<AutoTaskRunner>(touch_detect_handler_, signal_buffer_);
+    auto_task_runner_->set_block_task_maker(
+        std::bind_front(&MotionStateMachine::_make_block_task, this));
 
     touch_detect_handler_->reset();
     reset();
@@ -78,7 +81,7 @@ void MotionStateMachine::run_once() {
     }
 
     auto data_record_instance1 = s_motion_shared->get_data_record_instance1();
-    if (data_record_instance1->is_data_recorder_running()) {
+    if (data_record_instance1->is_data_collecting()) {
         //! 每周期开始, 将记录数据缓存清空
         data_record_instance1->clear_data_record();
 
@@ -102,9 +105,10 @@ void MotionStateMachine::run_once() {
         rd1.average_voltage = csd.averaged_voltage;
         rd1.current = csd.realtime_voltage;            // TODO
 
-        rd1.normal_charge_rate = 0; // TODO
-        rd1.short_charge_rate = 0;  // TODO
-        rd1.open_charge_rate = 0;   // TODO
+        // zynq伺服板不回传放电率, 记为0 (短路率事件触发在此配置下不可用)
+        rd1.normal_charge_rate = 0;
+        rd1.short_charge_rate = 0;
+        rd1.open_charge_rate = 0;
 #else
         auto &csd = s_motion_shared->cached_servo_data();
         rd1.average_voltage = csd.average_voltage;
@@ -115,6 +119,12 @@ void MotionStateMachine::run_once() {
 #endif
     }
 
+    auto channel_record_instance =
+        s_motion_shared->get_channel_record_instance();
+    if (channel_record_instance->is_running()) {
+        _publish_record_channels_begin(*channel_record_instance);
+    }
+
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     // breakout filter
     auto bo_filter = s_motion_shared->get_breakout_filter();
@@ -125,7 +135,7 @@ void MotionStateMachine::run_once() {
         (int)s_motion_shared->cached_udp_message().averaged_voltage);
 
     auto data_record_instance2 = s_motion_shared->get_data_record_instance2();
-    if (data_record_instance2->is_data_recorder_running()) {
+    if (data_record_instance2->is_data_collecting()) {
         data_record_instance2->clear_data_record();
     }
 #endif
@@ -157,15 +167,28 @@ void MotionStateMachine::run_once() {
 
 #endif // (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 
-    if (data_record_instance1->is_data_recorder_running()) {
-        data_record_instance1->get_record_data_ref().new_cmd_axis =
-            s_motion_shared->get_global_cmd_axis();
+    if (data_record_instance1->is_data_collecting()) {
+        auto &rd1 = data_record_instance1->get_record_data_ref();
+
+        rd1.new_cmd_axis = s_motion_shared->get_global_cmd_axis();
+
+        // 报警状态, 用于事件触发记录
+        rd1.touch_warning = touch_detect_handler_->has_warning();
+#ifndef EDM_OFFLINE_RUN_NO_ECAT
+        rd1.servo_fault = s_motion_shared->get_ecat_manager()->servo_has_fault();
+#endif // EDM_OFFLINE_RUN_NO_ECAT
 
         data_record_instance1->push_data_to_recorder();
     }
 
+    if (channel_record_instance->is_running()) {
+        _publish_record_channels_end(*channel_record_instance);
+        channel_record_instance->push_cycle(
+            s_motion_shared->get_thread_tick_us());
+    }
+
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
-    if (data_record_instance2->is_data_recorder_running()) {
+    if (data_record_instance2->is_data_collecting()) {
 
         auto &rd2 = data_record_instance2->get_record_data_ref();
 
@@ -193,6 +216,57 @@ void MotionStateMachine::run_once() {
 #endif
 }
 
+void MotionStateMachine::_publish_record_channels_begin(
+    ChannelRecordInstance &cri) {
+    const auto &ids = cri.ids();
+
+    axis_t axis;
+    if (s_motion_shared->get_act_axis(axis)) {
+        cri.publish_axis(ids.act_axis, axis);
+    }
+
+#ifndef EDM_OFFLINE_RUN_NO_ECAT
+    auto em = s_motion_shared->get_ecat_manager();
+    for (int i = 0; i < EDM_AXIS_NUM; ++i) {
+        axis[i] = em->get_servo_device(i)->get_following_error();
+    }
+    cri.publish_axis(ids.following_error, axis);
+#endif // EDM_OFFLINE_RUN_NO_ECAT
+
+#ifdef EDM_USE_ZYNQ_SERVOBOARD
+    const auto &csd = s_motion_shared->cached_udp_message();
+    cri.publish<float>(ids.average_voltage, csd.averaged_voltage);
+    cri.publish<float>(ids.realtime_voltage, csd.realtime_voltage);
+#else
+    const auto &csd = s_motion_shared->cached_servo_data();
+    cri.publish<uint16_t>(ids.average_voltage, csd.average_voltage);
+    cri.publish<uint16_t>(ids.current, csd.current);
+    cri.publish<uint8_t>(ids.normal_rate, csd.normal_rate);
+    cri.publish<uint8_t>(ids.short_rate, csd.short_rate);
+    cri.publish<uint8_t>(ids.open_rate, csd.open_rate);
+#endif
+
+    // G01伺服相关只在伺服周期内由G01AutoTask发布, 每周期先清零
+    cri.publish<bool>(ids.g01_servoing, false);
+    cri.publish<unit_t>(ids.g01_servo_cmd, 0.0);
+}
+
+void MotionStateMachine::_publish_record_channels_end(
+    ChannelRecordInstance &cri) {
+    const auto &ids = cri.ids();
+
+    cri.publish_axis(ids.cmd_axis, s_motion_shared->get_global_cmd_axis());
+    cri.publish_axis(ids.v_offset, s_motion_shared->get_global_v_offsets());
+
+    cri.publish<bool>(ids.touch_warning, touch_detect_handler_->has_warning());
+#ifndef EDM_OFFLINE_RUN_NO_ECAT
+    cri.publish<bool>(ids.servo_fault,
+                      s_motion_shared->get_ecat_manager()->servo_has_fault());
+#endif // EDM_OFFLINE_RUN_NO_ECAT
+
+    cri.publish<int32_t>(ids.sub_line_num, s_motion_shared->get_sub_line_num());
+}
+
 void MotionStateMachine::reset() {
     enabled_ = false;
     main_mode_ = MotionMainMode::Idle;
@@ -392,6 +466,40 @@ bool MotionStateMachine::start_auto_m00fake() {
     return true;
 }
 
+bool MotionStateMachine::queue_auto_blocks(
+    const std::vector<AutoBlock> &blocks) {
+    s_rt_logger->trace("queue_auto_blocks: {}", blocks.size());
+
+    if (main_mode_ != MotionMainMode::Auto) {
+        return false;
+    }
+
+    return auto_task_runner_->queue_blocks(blocks);
+}
+
+AutoTask::ptr MotionStateMachine::_make_block_task(const AutoBlock &block) {
+    // 入队时创建, 接续时才开始 (起点为接续时的指令位置)
+    switch (block.type) {
+    case AutoBlock::Type::G00:
+        return std::make_shared<G00AutoTask>(
+            AutoTaskDeferredStart{}, block.target_pos, block.speed_param, false,
+            touch_detect_handler_);
+    case AutoBlock::Type::G01: {
+        auto g01_line_traj = std::make_shared<TrajectoryLinearSegement>(
+            block.target_pos, block.target_pos);
+
+        return std::make_shared<G01AutoTask>(
+            AutoTaskDeferredStart{}, g01_line_traj,
+            block.max_jump_height_from_begin,
+            this->cbs_.cb_enable_voltage_gate, this->cbs_.cb_mach_on);
+    }
+    case AutoBlock::Type::G04:
+        return std::make_shared<G04AutoTask>(block.delay_s);
+    default:
+        return nullptr;
+    }
+}
+
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 bool MotionStateMachine::start_auto_drill(
     const DrillStartParams &start_params) {
@@ -503,8 +611,8 @@ void MotionStateMachine::_mainmode_auto() {
 }
 
 void MotionStateMachine::_mainmode_switch_to(MotionMainMode new_main_mode) {
-    s_logger->trace("MainMode: {} -> {}", GetMainModeStr(main_mode_),
-                    GetMainModeStr(new_main_mode));
+    s_rt_logger->trace("MainMode: {} -> {}", GetMainModeStr(main_mode_),
+                       GetMainModeStr(new_main_mode));
     main_mode_ = new_main_mode;
 }
 
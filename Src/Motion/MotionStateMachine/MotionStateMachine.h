@@ -77,6 +77,9 @@ public: // operate interfaces
 
     bool start_auto_m00fake();
 
+    // 运动块缓冲: 当前auto任务(G00/G01/G04等)运行中, 追加后续的块
+    bool queue_auto_blocks(const std::vector<AutoBlock> &blocks);
+
 #if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     bool start_auto_drill(const DrillStartParams &start_params);
 #endif
@@ -94,6 +97,11 @@ public: // state interfaces
 
     MotionAutoState auto_state() const { return auto_task_runner_->state(); }
 
+    int auto_block_id() const { return auto_task_runner_->curr_block_id(); }
+    std::size_t auto_block_queued() const {
+        return auto_task_runner_->queued_block_count();
+    }
+
 private: // inside functions: state process
     void _mainmode_idle();
     void _mainmode_manual();
@@ -101,6 +109,13 @@ private: // inside functions: state process
 
     void _mainmode_switch_to(MotionMainMode new_main_mode);
 
+    // 运动块 -> auto任务, 起点为当前全局指令位置
+    AutoTask::ptr _make_block_task(const AutoBlock &block);
+
+    // 通道记录: 周期开始时发布反馈数据, 周期结束时发布指令数据
+    void _publish_record_channels_begin(ChannelRecordInstance &cri);
+    void _publish_record_channels_end(ChannelRecordInstance &cri);
+
 private:              // state data
     // axis_t cmd_axis_; // 指令位值 (驱动器值, 单位blu)
 
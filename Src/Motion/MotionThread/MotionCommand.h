@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "config.h"
 
+#include "Motion/AutoBlockDefines.h"
 #include "Motion/JumpDefines.h"
 #include "Motion/MotionSharedData/MotionSharedData.h"
 #include "Motion/MotionUtils/MotionUtils.h"
@@ -105,6 +107,9 @@ enum MotionCommandType {
 
     MotionCommandSetting_SetG01SpeedRatio, // 设置G01速度比率
 
+    // 向运动块缓冲追加块 (当前任务正常结束后接续执行)
+    MotionCommandAuto_QueueBlocks,
+
     MotionCommand_Max
 };
 
@@ -450,6 +455,21 @@ private:
     double speed_ratio_{1.0}; // G01速度比率
 };
 
+// 向运动块缓冲追加块, 只在auto任务运行中被接收
+// 缓冲已满或已在停止中时忽略, 上层按正常方式逐个启动即可
+class MotionCommandAutoQueueBlocks final : public MotionCommandBase {
+public:
+    MotionCommandAutoQueueBlocks(std::vector<AutoBlock> blocks)
+        : MotionCommandBase(MotionCommandAuto_QueueBlocks),
+          blocks_(std::move(blocks)) {}
+    ~MotionCommandAutoQueueBlocks() noexcept override = default;
+
+    const auto &blocks() const { return blocks_; }
+
+private:
+    std::vector<AutoBlock> blocks_;
+};
+
 // class MotionCommandStartLinearServoMove final
 //     : public MotionCommandSimpleMoveBase {
 // public:
@@ -26,6 +26,7 @@
 #include "Logger/LogMacro.h"
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 namespace edm {
 
@@ -504,7 +505,8 @@ void MotionThreadController::_threadstate_running() {
         });
 
         if (!ecat_manager_->is_ecat_connected()) {
-            s_logger->warn("in EcatConnectedEnabling, ecat disconnected");
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "in EcatConnectedEnabling, ecat disconnected");
             _switch_ecat_state(EcatState::EcatDisconnected);
             ecat_connect_flag_ = false;
             // 重置 运动状态机
@@ -565,7 +567,8 @@ void MotionThreadController::_threadstate_running() {
 
         // 先检查驱动器情况
         if (!ecat_manager_->is_ecat_connected()) {
-            s_logger->warn("in EcatReady, ecat disconnected");
+            EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                                 "in EcatReady, ecat disconnected");
             _switch_ecat_state(EcatState::EcatDisconnected);
             // 重置 运动状态机
             motion_state_machine_->reset();
@@ -1020,6 +1023,21 @@ void MotionThreadController::_fetch_command_and_handle_and_copy_info_cache() {
 
         break;
     }
+    case MotionCommandAuto_QueueBlocks: {
+        s_logger->trace("Handle MotionCmd: Auto_QueueBlocks");
+        if (ecat_state_ != EcatState::EcatReady ||
+            thread_state_ != ThreadState::Running) {
+            break;
+        }
+
+        auto queue_cmd =
+            std::static_pointer_cast<MotionCommandAutoQueueBlocks>(cmd);
+
+        auto ret = motion_state_machine_->queue_auto_blocks(queue_cmd->blocks());
+
+        accept_cmd_flag = ret;
+        break;
+    }
     case MotionCommandSetting_TestVOffset: {
         s_logger->trace("Handle MotionCmd: Setting_TestVOffset");
 
@@ -1200,6 +1218,9 @@ void MotionThreadController::_copy_info_cache() {
 
     info_cache_.main_mode = motion_state_machine_->main_mode();
     info_cache_.auto_state = motion_state_machine_->auto_state();
+    info_cache_.auto_block_id = motion_state_machine_->auto_block_id();
+    info_cache_.auto_block_queued =
+        static_cast<int>(motion_state_machine_->auto_block_queued());
 
     // info_cache_.latency_data.curr_latency =
     // current_cycle_starttime_latency_ns_; info_cache_.latency_data.avg_latency
@@ -1344,16 +1365,16 @@ const char *MotionThreadController::GetEcatStateStr(EcatState s) {
 
 void MotionThreadController::_switch_thread_state(
     ThreadState new_thread_state) {
-    s_logger->trace("motion thread state: {} -> {}",
-                    GetThreadStateStr(thread_state_),
-                    GetThreadStateStr(new_thread_state));
+    s_rt_logger->trace("motion thread state: {} -> {}",
+                       GetThreadStateStr(thread_state_),
+                       GetThreadStateStr(new_thread_state));
     thread_state_ = new_thread_state;
 }
 
 void MotionThreadController::_switch_ecat_state(EcatState new_ecat_state) {
-    s_logger->trace("motion thread ecat state: {} -> {}",
-                    GetEcatStateStr(ecat_state_),
-                    GetEcatStateStr(new_ecat_state));
+    s_rt_logger->trace("motion thread ecat state: {} -> {}",
+                       GetEcatStateStr(ecat_state_),
+                       GetEcatStateStr(new_ecat_state));
     ecat_state_ = new_ecat_state;
 }
 
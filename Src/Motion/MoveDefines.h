@@ -89,6 +89,10 @@ struct MotionInfo {
     MotionMainMode main_mode{MotionMainMode::Idle};       // 当前主模式
     MotionAutoState auto_state{MotionAutoState::Stopped}; // auto模式下的state
 
+    // 运动块缓冲: 当前执行的块号 (直接启动的任务为-1), 缓冲中等待的块数
+    int auto_block_id{-1};
+    int auto_block_queued{0};
+
     struct LatencyData {
         int curr_latency{};
         // int min_latency{}; // 最小值没必要记录
@@ -151,6 +155,9 @@ enum MotionSignalType {
 
     MotionSignal_AutoNotify,
 
+    // 运动块缓冲中的下一个块已开始执行 (见 MotionInfo::auto_block_id)
+    MotionSignal_AutoBlockSwitched,
+
     // TODO
 
     MotionSignal_MAX
@@ -26,7 +26,8 @@ Moveruntime::Moveruntime() noexcept
 bool Moveruntime::plan(const MoveRuntimePlanSpeedInput& speed_param,
                        unit_t target_length) {
     if (is_running()) {
-        s_logger->trace("moveruntime plan warn: still running");
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::trace,
+                             "moveruntime plan warn: still running");
         //! 不报错, 因为中断减速一般需要replan, 直接调用plan可以节省一次外部clear的开销
     }
 
@@ -50,6 +50,9 @@ public:
 
     unit_t get_current_speed() const;
 
+    // 规划的总周期数 (plan成功后有效), 乘以运动周期即为运动时间
+    inline int32_t get_planned_cycles() const { return impl_.total_N; }
+
 private:
     struct impl {
         double acc0; // blu / s^2
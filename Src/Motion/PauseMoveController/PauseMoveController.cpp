@@ -8,6 +8,7 @@
 #include <cassert>
 
 EDM_STATIC_LOGGER_NAME(s_logger, "motion");
+EDM_STATIC_RT_LOGGER_NAME(s_rt_logger, "motion");
 
 namespace edm {
 
@@ -325,8 +326,8 @@ const char *PauseMoveController::_state_str(State state) {
 }
 
 void PauseMoveController::_switch_state_to(State new_state) {
-    s_logger->trace("PauseMoveController: {} -> {}", _state_str(state_),
-                    _state_str(new_state));
+    s_rt_logger->trace("PauseMoveController: {} -> {}", _state_str(state_),
+                       _state_str(new_state));
 
     state_ = new_state;
 }
@@ -60,6 +60,7 @@ void CanController::terminate() {
         std::lock_guard guard(mutex_worker_map_and_vec_);
         worker_vec_.clear();
         worker_map_.clear();
+        direct_sender_vec_.clear();
     }
 
     terminated_ = true;
@@ -89,6 +90,15 @@ CanWorker *CanController::_get_device(const QString &name) const {
     return find_ret->second;
 }
 
+SocketCanSender::ptr CanController::get_direct_sender(int index) const {
+    std::lock_guard guard(mutex_worker_map_and_vec_);
+    if (index >= direct_sender_vec_.size() || index < 0) {
+        return nullptr;
+    }
+
+    return direct_sender_vec_[index];
+}
+
 int CanController::add_device(const QString &name, uint32_t bitrate) {
     if (!worker_thread_) {
         throw exception{"CanController not init!"};
@@ -118,6 +128,11 @@ int CanController::add_device(const QString &name, uint32_t bitrate) {
     worker_vec_.push_back({name, worker});
     worker_map_.insert(name, {index, worker});
 
+#ifdef EDM_CAN_ENABLE_DIRECT_SEND
+    direct_sender_vec_.push_back(
+        std::make_shared<SocketCanSender>(name.toStdString()));
+#endif // EDM_CAN_ENABLE_DIRECT_SEND
+
     return index;
 }
 
@@ -19,6 +19,8 @@
 
 #include "config.h"
 
+#include "SocketCanSender.h"
+
 // ! 需要注意的是, CanController的正常工作依赖Qt的事件循环 (且为main主线程)
 // ! 也就是说, 任何对于CanController方法的调用, (如add_device,send_frame)
 // ! 都需要来自于已经启动了事件循环的Qt线程
@@ -31,6 +33,8 @@
 // ! 但是, 当然了, 也可以在Motion线程直接调用如
 // ! CanController::instance()->send_frame()的代码, 也是生效的,
 // ! 目前副面作用未知, 但是调用涉及到post_event()操作, 时间成本会有
+// ! 时间关键的帧可以经 get_direct_sender 取得的 SocketCanSender 直接发送,
+// ! 其 trigger/post 可在运动线程中调用
 
 namespace edm {
 
@@ -151,6 +155,11 @@ public:
     void send_frame(int index, const QCanBusFrame &frame);
     void send_frame(const QString &device_name, const QCanBusFrame &frame);
 
+    // 直发通道, 未启用直发时返回nullptr
+    //! 会加锁, 调用者应在初始化时取得并保存, 不要在运动线程中调用
+    //! 同一帧ID的帧应当都用同一种方式发送, 否则事件队列中的旧帧可能在新帧之后发出
+    SocketCanSender::ptr get_direct_sender(int index) const;
+
     bool is_connected(int index) const;
     bool is_connected(const QString &device_name) const;
 
@@ -178,9 +187,12 @@ private:
     QMap<QString, QPair<int, CanWorker *>> worker_map_; // used for management
     QVector<QPair<QString, CanWorker *>> worker_vec_;   // used for index
 
+    // 直发通道, 与 worker_vec_ 下标对应 (未启用直发时为空)
+    QVector<SocketCanSender::ptr> direct_sender_vec_;
+
     mutable std::mutex mutex_worker_map_and_vec_;
     // mutex protect:
-    // 1. worker_map_, worker_vec_:
+    // 1. worker_map_, worker_vec_, direct_sender_vec_:
     //      add_device call (write)
     //      _get_device inside call (read), we assure device get by
     //      `_get_device`
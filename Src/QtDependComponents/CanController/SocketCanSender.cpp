@@ -0,0 +1,293 @@
+#include "SocketCanSender.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Logger/LogMacro.h"
+
+EDM_STATIC_LOGGER(s_logger, EDM_LOGGER_ROOT());
+
+namespace edm {
+
+namespace can {
+
+static inline int64_t _now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+SocketCanSender::SocketCanSender(const std::string &can_if_name)
+    : can_if_name_(can_if_name), reopen_enabled_(true) {
+    // 设备此时可能还不存在, 失败时由发送线程重试
+    _open();
+
+    _start_thread();
+}
+
+SocketCanSender::SocketCanSender(int fd, const std::string &name)
+    : can_if_name_(name), reopen_enabled_(false) {
+    fd_ = fd;
+
+    _start_thread();
+}
+
+SocketCanSender::~SocketCanSender() {
+    thread_exit_flag_ = true;
+    _wake();
+    if (send_thread_.joinable()) {
+        send_thread_.join();
+    }
+
+    _close();
+}
+
+struct can_frame SocketCanSender::MakeFrame(uint32_t frame_id,
+                                            const char *data, int len) {
+    struct can_frame frame;
+    memset(&frame, 0, sizeof(frame));
+
+    frame.can_id = frame_id > CAN_SFF_MASK
+                       ? ((frame_id & CAN_EFF_MASK) | CAN_EFF_FLAG)
+                       : frame_id;
+    frame.can_dlc = static_cast<uint8_t>(std::clamp(len, 0, CAN_MAX_DLEN));
+    memcpy(frame.data, data, frame.can_dlc);
+
+    return frame;
+}
+
+int SocketCanSender::add_source(FrameSource source) {
+    std::lock_guard guard(sources_mutex_);
+    const int id = source_count_.load(std::memory_order_relaxed);
+    if (id >= static_cast<int>(sources_.size())) {
+        s_logger->error("socketcan sender {}: too many frame sources",
+                        can_if_name_);
+        return -1;
+    }
+
+    sources_[id] = std::move(source);
+    source_count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+void SocketCanSender::remove_source(int source_id) {
+    if (source_id < 0 ||
+        source_id >= source_count_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard guard(sources_mutex_);
+    sources_[source_id] = nullptr;
+}
+
+void SocketCanSender::trigger(int source_id) {
+    if (source_id < 0 ||
+        source_id >= source_count_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    dirty_mask_.fetch_or(1u << source_id, std::memory_order_release);
+    _wake();
+}
+
+bool SocketCanSender::post(const struct can_frame &frame) {
+    if (!queue_.push(frame)) {
+        failed_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _wake();
+    return true;
+}
+
+void SocketCanSender::_start_thread() {
+    send_thread_ = std::thread(&SocketCanSender::_thread_run, this);
+}
+
+void SocketCanSender::_wake() {
+    // 发送线程未在等待时 notify 不进入内核, 否则是一次不阻塞的 futex wake
+    post_seq_.fetch_add(1, std::memory_order_release);
+    post_seq_.notify_one();
+}
+
+bool SocketCanSender::_open() {
+    if (!reopen_enabled_) {
+        return false;
+    }
+
+    // 节流, 设备不存在时不要反复尝试
+    const auto now = _now_ms();
+    if (now < next_open_time_ms_) {
+        return false;
+    }
+    next_open_time_ms_ = now + reopen_interval_ms_;
+
+    const unsigned int ifindex = if_nametoindex(can_if_name_.c_str());
+    if (ifindex == 0) {
+        s_logger->warn("socketcan sender: device {} not found", can_if_name_);
+        return false;
+    }
+
+    int fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) {
+        s_logger->error("socketcan sender: create socket failed: {}",
+                        strerror(errno));
+        return false;
+    }
+
+    // 只发不收, 否则内核会把总线上所有帧都排队到这个socket
+    (void)setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0);
+
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = static_cast<int>(ifindex);
+    if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) <
+        0) {
+        s_logger->error("socketcan sender: bind {} failed: {}", can_if_name_,
+                        strerror(errno));
+        (void)close(fd);
+        return false;
+    }
+
+    fd_.store(fd, std::memory_order_release);
+
+    s_logger->info("socketcan sender opened: {}", can_if_name_);
+    return true;
+}
+
+void SocketCanSender::_close() {
+    const int fd = fd_.exchange(-1, std::memory_order_acq_rel);
+    if (fd >= 0) {
+        (void)close(fd);
+    }
+}
+
+void SocketCanSender::_drop_all() {
+    // 帧源每次触发按一帧计
+    uint64_t dropped = pending_count_ - pending_written_;
+    dropped += __builtin_popcount(
+        dirty_mask_.exchange(0, std::memory_order_acq_rel));
+
+    struct can_frame frame;
+    while (queue_.pop(frame)) {
+        ++dropped;
+    }
+
+    pending_count_ = pending_written_ = 0;
+    if (dropped > 0) {
+        failed_count_.fetch_add(dropped, std::memory_order_relaxed);
+    }
+}
+
+bool SocketCanSender::_write_pending() {
+    const int fd = fd_.load(std::memory_order_relaxed);
+
+    while (pending_written_ < pending_count_) {
+        if (::write(fd, &pending_[pending_written_], sizeof(struct can_frame)) ==
+            static_cast<ssize_t>(sizeof(struct can_frame))) {
+            ++pending_written_;
+            continue;
+        }
+
+        const int err = errno;
+
+        // 内核发送队列满, 等待后重试 (同一组剩下的帧, 保持顺序)
+        if ((err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS) &&
+            _now_ms() - pending_since_ms_ < retry_timeout_ms_) {
+            retry_count_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        failed_count_.fetch_add(pending_count_ - pending_written_,
+                                std::memory_order_relaxed);
+        EDM_RATE_LIMITED_LOG(s_logger, spdlog::level::warn,
+                             "socketcan {} write failed: {}, {} frames dropped",
+                             can_if_name_, err,
+                             pending_count_ - pending_written_);
+
+        // 设备被移除 (重新出现后ifindex可能变化), 关闭后重新打开;
+        // 设备down (ENETDOWN) 时socket仍有效, up之后继续可用
+        if (err == ENODEV || err == ENXIO) {
+            _close();
+        }
+        break;
+    }
+
+    pending_count_ = pending_written_ = 0;
+    return true;
+}
+
+void SocketCanSender::_thread_run() {
+    s_logger->info("socketcan sender thread start: {}", can_if_name_);
+
+    // 取下一组要发送的帧: 帧源优先, 其次是队列
+    auto f_next_pending = [this]() -> bool {
+        uint32_t mask;
+        while ((mask = dirty_mask_.load(std::memory_order_acquire)) != 0) {
+            const int id = __builtin_ctz(mask);
+            dirty_mask_.fetch_and(~(1u << id), std::memory_order_acq_rel);
+
+            // 在清除标志之后调用帧源, 之后的触发不会丢失
+            std::lock_guard guard(sources_mutex_);
+            if (!sources_[id]) {
+                continue; // 已移除
+            }
+            const int n = sources_[id](pending_.data());
+            if (n > 0) {
+                pending_count_ = std::min(n, MaxSourceFrames);
+                pending_written_ = 0;
+                pending_since_ms_ = _now_ms();
+                return true;
+            }
+        }
+
+        if (queue_.pop(pending_[0])) {
+            pending_count_ = 1;
+            pending_written_ = 0;
+            pending_since_ms_ = _now_ms();
+            return true;
+        }
+
+        return false;
+    };
+
+    while (!thread_exit_flag_) {
+        // 先取序号再取帧, 取空之后新的触发一定会改变序号, 不会漏唤醒
+        const auto seq = post_seq_.load(std::memory_order_acquire);
+
+        if (!is_open() && !_open()) {
+            // 未打开期间的帧丢弃, 由调用者的备用通道发送
+            _drop_all();
+            if (reopen_enabled_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            } else {
+                post_seq_.wait(seq, std::memory_order_acquire);
+            }
+            continue;
+        }
+
+        if (pending_count_ == 0 && !f_next_pending()) {
+            post_seq_.wait(seq, std::memory_order_acquire);
+            continue;
+        }
+
+        if (!_write_pending()) {
+            std::this_thread::sleep_for(
+                std::chrono::microseconds(retry_interval_us_));
+        }
+    }
+
+    s_logger->info("socketcan sender thread exit: {}", can_if_name_);
+}
+
+} // namespace can
+
+} // namespace edm
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <linux/can.h>
+
+#include <boost/lockfree/queue.hpp>
+
+namespace edm {
+
+namespace can {
+
+/**
+ * SocketCAN 直发通道:
+ * 直接写 CAN_RAW socket, 不经过 Qt 事件循环和 CanWorker,
+ * 用于时间关键的帧 (如抬刀时的电压门控).
+ * socket 的写入和重新打开只在独立的发送线程中进行 (首次打开在构造时),
+ * 调用者 (包括运动线程) 只操作原子变量和无锁队列, 不进入系统调用 (除唤醒).
+ * - trigger(): 触发一个帧源, 发送线程调用帧源按最新的状态生成帧并写出;
+ *              发送之前的多次触发合并为一次, 被后来的状态取代的帧不会发出
+ * - post(): 放入无锁队列, 由发送线程写出
+ * 内核发送队列满 (EAGAIN/ENOBUFS) 时发送线程等待后重试, 超时才丢弃.
+ * socket 只发不收 (空过滤器), 接收仍由 CanWorker 负责;
+ * 设备的 up/down 与重连也由 CanWorker 负责, 这里只在设备被移除后重新打开socket.
+ */
+class SocketCanSender final {
+public:
+    using ptr = std::shared_ptr<SocketCanSender>;
+
+    // 帧源: 在发送线程中调用, 向 frames 写入要发送的帧, 返回帧数
+    // (不超过 MaxSourceFrames, 返回0表示没有要发送的)
+    static constexpr const int MaxSourceFrames = 4;
+    using FrameSource = std::function<int(struct can_frame *frames)>;
+
+    explicit SocketCanSender(const std::string &can_if_name);
+    // 使用已经打开的socket (如测试中的socketpair), 失效后不重新打开
+    SocketCanSender(int fd, const std::string &name);
+    ~SocketCanSender();
+
+    SocketCanSender(const SocketCanSender &) = delete;
+    SocketCanSender &operator=(const SocketCanSender &) = delete;
+
+    // 注册帧源, 返回帧源id, 失败返回-1
+    //! 需在对应的 trigger 之前, 由非实时线程调用
+    int add_source(FrameSource source);
+    // 移除帧源, 返回后发送线程不会再调用它 (帧源的所有者析构前调用)
+    void remove_source(int source_id);
+
+    // wait-free, 可在运动线程中调用
+    void trigger(int source_id);
+
+    // lock-free, 返回是否入队成功 (队列满返回false, 帧被丢弃)
+    bool post(const struct can_frame &frame);
+
+    bool is_open() const { return fd_.load(std::memory_order_acquire) >= 0; }
+
+    // 丢弃的总帧数 (socket未打开, 写失败, 重试超时, 队列满)
+    uint64_t failed_count() const {
+        return failed_count_.load(std::memory_order_relaxed);
+    }
+
+    // 因内核发送队列满而重试的次数
+    uint64_t retry_count() const {
+        return retry_count_.load(std::memory_order_relaxed);
+    }
+
+public:
+    // 构造can帧, 数据超过8字节的部分截断 (不支持CAN FD)
+    static struct can_frame MakeFrame(uint32_t frame_id, const char *data,
+                                      int len);
+
+private:
+    void _start_thread();
+    void _wake();
+
+    //! 以下只在构造函数 (发送线程启动前) 和发送线程中调用
+    bool _open();
+    void _close();
+
+    void _thread_run();
+    // 写出 pending_ 中剩余的帧, 返回是否全部写出 (false: 需要等待后重试)
+    bool _write_pending();
+    // 丢弃所有待发送的帧 (socket未打开时)
+    void _drop_all();
+
+private:
+    std::string can_if_name_;
+    bool reopen_enabled_;
+
+    std::atomic_int fd_{-1};
+    int64_t next_open_time_ms_{0}; // 重新打开的节流
+
+    std::atomic<uint64_t> failed_count_{0};
+    std::atomic<uint64_t> retry_count_{0};
+
+    // 帧源, 触发的帧源在 dirty_mask_ 中置位
+    //! sources_mutex_ 保护帧源的注册/移除与调用, 只在非实时线程之间竞争
+    std::array<FrameSource, 8> sources_;
+    std::mutex sources_mutex_;
+    std::atomic_int source_count_{0};
+    std::atomic<uint32_t> dirty_mask_{0};
+
+    boost::lockfree::queue<struct can_frame, boost::lockfree::capacity<256>>
+        queue_;
+
+    // 发送线程
+    std::thread send_thread_;
+    std::atomic_bool thread_exit_flag_{false};
+    std::atomic<uint32_t> post_seq_{0}; // 用于唤醒发送线程 (atomic wait/notify)
+
+    // 发送线程中正在写出的一组帧 (一组帧按顺序连续写出, 不与其他帧交错)
+    std::array<struct can_frame, MaxSourceFrames> pending_;
+    int pending_count_{0};
+    int pending_written_{0};
+    int64_t pending_since_ms_{0};
+
+    static constexpr const int64_t reopen_interval_ms_ = 1000;
+    static constexpr const int64_t retry_interval_us_ = 500;
+    static constexpr const int64_t retry_timeout_ms_ = 100;
+};
+
+} // namespace can
+
+} // namespace edm
@@ -27,19 +27,90 @@ InfoDispatcher::InfoDispatcher(
     info_get_timer_->start(info_get_time_peroid_ms);
 }
 
+// 每周期最多处理的信号数, 防止信号风暴时一个周期占用GUI线程过久
+static constexpr int s_max_signals_per_tick = 256;
+
 void InfoDispatcher::_info_get_timer_slot() {
-    bool signal_handled = signal_queue_->consume_one(consumer_func_);
+    // 一次取完所有待处理的信号, 一连串的信号 (开始/暂停/停止, G01组通知等)
+    // 不再每个信号等一个周期; 每个信号携带自己的info, 处理时 get_info()
+    // 仍是信号产生时的info
+    for (int i = 0; i < s_max_signals_per_tick; ++i) {
+        if (!signal_queue_->consume_one(consumer_func_)) {
+            break;
+        }
+    }
 
-    // signal 会携带一份info, 所以如果处理了 signal 就不再拷贝info
-    if (!signal_handled) {
+    // 信号中的info可能已经过时, 总是取最新的info发布
 #ifdef EDM_MOTION_INFO_GET_USE_ATOMIC
-        motion_controller_->load_at_info_cache(info_cache_);
+    motion_controller_->load_at_info_cache(info_cache_);
 #else // EDM_MOTION_INFO_GET_USE_ATOMIC
-        info_cache_ = motion_controller_->get_info_cache();
+    info_cache_ = motion_controller_->get_info_cache();
 #endif // EDM_MOTION_INFO_GET_USE_ATOMIC
-    }
 
     emit info_updated(info_cache_);
+
+    const uint32_t change_mask =
+        published_once_ ? _calc_change_mask() : InfoChange_All;
+    if (change_mask != 0) {
+        last_published_info_ = info_cache_;
+        published_once_ = true;
+        emit info_changed(info_cache_, change_mask);
+    }
+}
+
+uint32_t InfoDispatcher::_calc_change_mask() const {
+    const auto &a = info_cache_;
+    const auto &b = last_published_info_;
+
+    uint32_t mask = 0;
+
+    if (a.curr_cmd_axis_blu != b.curr_cmd_axis_blu ||
+        a.curr_act_axis_blu != b.curr_act_axis_blu) {
+        mask |= InfoChange_Axis;
+    }
+
+    if (a.curr_v_offsets_blu != b.curr_v_offsets_blu) {
+        mask |= InfoChange_VOffset;
+    }
+
+    if (a.main_mode != b.main_mode || a.auto_state != b.auto_state ||
+        a.bit_state1 != b.bit_state1 || a.auto_block_id != b.auto_block_id ||
+        a.auto_block_queued != b.auto_block_queued ||
+        a.sub_line_number != b.sub_line_number) {
+        mask |= InfoChange_State;
+    }
+
+    const auto &la = a.latency_data, &lb = b.latency_data;
+    const auto &ta = a.time_use_data, &tb = b.time_use_data;
+    if (la.curr_latency != lb.curr_latency ||
+        la.max_latency != lb.max_latency ||
+        la.avg_latency != lb.avg_latency ||
+        la.warning_count != lb.warning_count ||
+        ta.total_time_use_avg != tb.total_time_use_avg ||
+        ta.total_time_use_max != tb.total_time_use_max ||
+        ta.info_time_use_avg != tb.info_time_use_avg ||
+        ta.info_time_use_max != tb.info_time_use_max ||
+        ta.ecat_time_use_avg != tb.ecat_time_use_avg ||
+        ta.ecat_time_use_max != tb.ecat_time_use_max ||
+        ta.statemachine_time_use_avg != tb.statemachine_time_use_avg ||
+        ta.statemachine_time_use_max != tb.statemachine_time_use_max) {
+        mask |= InfoChange_Latency;
+    }
+
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    const auto &ba = a.breakout_data, &bb = b.breakout_data;
+    if (a.spindle_axis_blu != b.spindle_axis_blu ||
+        a.is_spindle_on != b.is_spindle_on ||
+        a.drill_total_blu != b.drill_total_blu ||
+        a.drill_remaining_blu != b.drill_remaining_blu ||
+        ba.realtime_voltage != bb.realtime_voltage ||
+        ba.averaged_voltage != bb.averaged_voltage || ba.kn != bb.kn ||
+        ba.kn_valid_rate != bb.kn_valid_rate || ba.kn_cnt != bb.kn_cnt) {
+        mask |= InfoChange_Drill;
+    }
+#endif
+
+    return mask;
 }
 
 void InfoDispatcher::_handle_signal_callback(const move::MotionSignal &signal) {
@@ -72,6 +143,9 @@ void InfoDispatcher::_handle_signal_callback(const move::MotionSignal &signal) {
     case move::MotionSignalType::MotionSignal_AutoNotify:
         emit sig_auto_notify();
         break;
+    case move::MotionSignalType::MotionSignal_AutoBlockSwitched:
+        emit sig_auto_block_switched();
+        break;
     default:
         s_logger->warn("recv unknown signal: {}", (int)signal.type);
         break;
@@ -12,6 +12,19 @@
 
 namespace edm {
 
+// info_changed 信号中的变化掩码, 界面按需订阅, 不关心的变化不重绘
+enum InfoChangeMask : uint32_t {
+    InfoChange_Axis = 1 << 0,    // 指令/实际坐标
+    InfoChange_VOffset = 1 << 1, // 速度偏置
+    InfoChange_State = 1 << 2,   // 主模式, auto状态, bit_state, 块号, 子行号
+    InfoChange_Latency = 1 << 3, // 延时及耗时统计
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    InfoChange_Drill = 1 << 4, // 主轴, 打孔深度, 穿透数据
+#endif
+
+    InfoChange_All = 0xFFFFFFFF
+};
+
 class InfoDispatcher final : public QObject {
     Q_OBJECT
 public:
@@ -27,11 +40,19 @@ public:
 private:
     void _info_get_timer_slot();
 
+    // 与上次发布的info比较, 得到变化掩码
+    uint32_t _calc_change_mask() const;
+
     void _handle_signal_callback(const move::MotionSignal &signal);
 
 signals: // info 获取完成信号, 用于那些需要自动刷新的界面
+    // 每个周期都发出, 用于按周期采样的 (如曲线显示)
     void info_updated(const edm::move::MotionInfo &info);
 
+    // 只在有变化时发出, change_mask 见 InfoChangeMask;
+    // 界面应判断自己关心的位, 没有变化就不刷新
+    void info_changed(const edm::move::MotionInfo &info, uint32_t change_mask);
+
 signals: // motion 信号
     void sig_manual_pointmove_started();
     void sig_manual_pointmove_stopped();
@@ -42,6 +63,9 @@ signals: // motion 信号
     void sig_auto_stopped();
 
     void sig_auto_notify();
+
+    // 运动块缓冲中的下一个块开始执行
+    void sig_auto_block_switched();
     
     // TODO other signals
 
@@ -51,6 +75,8 @@ private:
 
     //! 要注意如果改为多线程需要保护, 或使用信号槽
     move::MotionInfo info_cache_; /* main thread info cache */
+    move::MotionInfo last_published_info_; /* 上次 info_changed 发布的 info */
+    bool published_once_{false};
 
     QTimer *info_get_timer_{nullptr};
 
@@ -3,6 +3,7 @@
 #include "Logger/LogMacro.h"
 #include "QtDependComponents/PowerController/EleparamDefine.h"
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
 #include <unordered_set>
@@ -124,90 +125,48 @@ const uint32_t EleparamDecodeResult::io_mask = _CalcCanIOMask();
 
 #endif
 
-EleparamDecodeResult::ptr
-EleparamDecoder::decode(EleparamDecodeInput::ptr input) {
-    auto decoder = EleparamDecoder();
-    decoder._decode(input);
-
-    return decoder._get_result();
-}
-
-void EleparamDecoder::_decode(EleparamDecodeInput::ptr input) {
-    input_ = input; // save input
-
-    // initialize result ptr
-    result_ = std::make_shared<EleparamDecodeResult>();
-
-    // start step by step decode
-
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-    _fill_can_buffer();
 
-    _fill_io_settings();
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU)
-    _zhonggu_handle_on();
-    _zhonggu_handle_off();
-    _zhonggu_handle_ip();
-    _zhonggu_handle_neg();
-    _zhonggu_handle_hp();
-    _zhonggu_handle_mach();
-#elif  (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
-    _zhonggu_handle_cap();
-    _zhonggu_handle_on();
-    _zhonggu_handle_off();
-    _zhonggu_handle_ip();
-
-    _zhonggu_handle_mach();
-#endif
-}
-
-#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-void EleparamDecoder::_fill_can_buffer() {
-    _canframe_fill_fixedbytes();
-
-    _canframe_handle_on();
-    _canframe_handle_off();
-    _canframe_handle_up_and_on();
-    _canframe_handle_ip();
-    _canframe_handle_hp();
-    _canframe_handle_ma();
-    _canframe_handle_sv();
-    _canframe_handle_al();
-    _canframe_handle_ld();
-    _canframe_handle_oc();
-    _canframe_handle_pp();
-    _canframe_handle_lv();
-    _canframe_handle_pl();
-    _canframe_handle_machbit();
-
-    _canframe_handle_pulsecounter();
-    _canframe_calc_crc();
-}
-
-void EleparamDecoder::_fill_io_settings() {
-    _iosettings_handle_NOW();
-    _iosettings_handle_MON_HON();
-    _iosettings_handle_IPx();
-    _iosettings_handle_LVx();
-    _iosettings_handle_PL();
-    _iosettings_handle_MACH();
-    _iosettings_handle_PK();
-    _iosettings_handle_CAPx();
-}
-
-#define CAN_BUFFER                   result_->can_buffer()
-#define OR_EQUAL(__ori, __or_value)  (__ori) = (__ori) | (__or_value)
-#define AND_EQUAL(__ori, __or_value) (__ori) = (__ori) & (__or_value)
-
-void EleparamDecoder::_canframe_fill_fixedbytes() {
-    CAN_BUFFER[0][0] = 0xEB;
-    CAN_BUFFER[0][1] = 0x90;
-    CAN_BUFFER[0][2] = 0xE9;
-    CAN_BUFFER[0][5] = 0x09;
-}
-
-void EleparamDecoder::_canframe_handle_on() {
-    uint8_t param_on = input_->ele_param().pulse_on; // 参数值
+/**
+ * dimen 编码表
+ */
+
+// can帧中的一段位: buffer[frame][byte] 的 (mask << shift) 位 <- value(input)
+struct CanFieldSlot {
+    uint8_t frame;
+    uint8_t byte;
+    uint8_t shift;
+    uint8_t mask;
+    uint8_t (*value)(const EleparamDecodeInput &in);
+};
+
+// 继电器: closed(input) 为 true 时吸合; inverted 为硬件反逻辑 (置0为吸合)
+struct ContactorSlot {
+    uint32_t contactor_index;
+    bool inverted;
+    bool (*closed)(const EleparamDecodeInput &in);
+};
+
+#define VALUE_(expr__)                                                         \
+    [](const EleparamDecodeInput &in) -> uint8_t {                             \
+        return static_cast<uint8_t>(expr__);                                   \
+    }
+#define CLOSED_(expr__)                                                        \
+    [](const EleparamDecodeInput &in) -> bool { return (expr__); }
+#define CONST_(value__)                                                        \
+    [](const EleparamDecodeInput &) -> uint8_t { return (value__); }
+
+static inline bool _is_c90x(const EleparamDecodeInput &in) {
+    // 特殊条件 C901 C902
+    const auto upper_index = in.ele_param().upper_index;
+    return upper_index == 901 || upper_index == 902;
+}
+
+static inline uint8_t _tens(uint32_t v) { return (v / 10) % 10; }
+
+// ON 编码: 0-7, 8-63, 100-107 三段, 由第6,7位区分
+static uint8_t _can_pulse_on(const EleparamDecodeInput &in) {
+    uint8_t param_on = in.ele_param().pulse_on; // 参数值
     uint8_t pulse_on = param_on;
 
     if ((pulse_on > 63 && pulse_on < 100) || pulse_on > 107) {
@@ -218,802 +177,324 @@ void EleparamDecoder::_canframe_handle_on() {
     if (param_on <= 7) {
         pulse_on &= 0x3F; // 第6,7位设为 0
     } else if (param_on < 64) {
-        // pulse_on |= 0x40; // 第6位设为 1
-        // pulse_on &= 0x7F; // 第7位设为 0
         pulse_on |= 0xC0; // 第6,7位设为 1
     } else if (param_on >= 100 && param_on <= 107) {
         pulse_on -= 100;  // 100-107按0-7
         pulse_on &= 0xBF; // 第6位设为0
-        // pulse_on &= 0x7F; // 第7位设为 0
         pulse_on |= 0x80; // 第7为设为1
     }
 
-    if (input_->ele_param().ip == 0 && param_on >= 8) {
+    if (in.ele_param().ip == 0 && param_on >= 8) {
         pulse_on ^= (1 << 7); // 第7位取反
     }
 
-    CAN_BUFFER[0][6] = pulse_on;
-
-    // 设置CK2位
-    if (param_on > 15 && param_on < 64) // CK2设为1
-        OR_EQUAL(CAN_BUFFER[1][6], 0x02);
-    else
-        AND_EQUAL(CAN_BUFFER[1][6], 0xFD);
-}
-
-void EleparamDecoder::_canframe_handle_off() {
-    CAN_BUFFER[0][7] = input_->ele_param().pulse_off;
-}
-
-void EleparamDecoder::_canframe_handle_up_and_on() {
-    // do nothing
-    // TODO up 和 dn 要设置给运动控制(抬刀用), 靠外层设置, 这里只是decode
-    // CAN_BUFFER[1][0] = 0x90; //! 发固定值, 以使on>100表现正常
-    // 2024.04.10 0x41 -> 0x40, up位给0, 防止电源自己切断电压
-
-    CAN_BUFFER[1][0] = 0x00;
-    OR_EQUAL(CAN_BUFFER[1][0], input_->ele_param().dn << 9); // 只发dn=9; up=0
-    // OR_EQUAL(CAN_BUFFER[1][0], input_->ele_param().up); // 只发dn=9; up=0
-}
-
-void EleparamDecoder::_canframe_handle_ip() {
-    uint16_t param_ip = input_->ele_param().ip;
-    uint16_t ip = param_ip;
-    uint8_t ip_decimal_part = ip % 10;                    // ip 的 小数部分
-    uint8_t ip_real_part = static_cast<uint8_t>(ip / 10); // ip 的整数部分
-
-    CAN_BUFFER[1][1] = ip_real_part;
-
-#if 1
-    if (ip_decimal_part == 5) {
-        OR_EQUAL(CAN_BUFFER[1][1], 0x80);
-    } else {
-        AND_EQUAL(CAN_BUFFER[1][1], 0x7F);
-    }
-
-    AND_EQUAL(CAN_BUFFER[1][2], 0xF0);
-    if (ip_decimal_part == 5) {
-        OR_EQUAL(CAN_BUFFER[1][2], 0x02);
-    } else {
-        AND_EQUAL(CAN_BUFFER[1][2], 0xFD);
-    }
-#else
-
-    /**
-     * 0.1  = 0.1
-     * 0.2  =       0.2
-     * 0.3  = 0.1 + 0.2
-     * 0.4 x
-     * 0.5  =             0.5
-     * 0.6  = 0.1 +       0.5
-     * 0.7  =       0.2 + 0.5
-     * 0.8  = 0.1 + 0.2 + 0.5
-     * 0.9 x
-     */
-    if (ip_decimal_part == 1 || ip_decimal_part == 3 || ip_decimal_part == 6 ||
-        ip_decimal_part == 8) {
-        // ip 含有 0.1A
-        OR_EQUAL(CAN_BUFFER[1][1], 0x80);
-    } else {
-        // ip 不含 0.1A
-        AND_EQUAL(CAN_BUFFER[1][1], 0x7F);
-    }
-
-    // 清空 ELEBUFFER[1][2]的低4位
-    AND_EQUAL(CAN_BUFFER[1][2], 0xF0);
-
-    if (ip_decimal_part == 2 || ip_decimal_part == 3 || ip_decimal_part == 7 ||
-        ip_decimal_part == 8) {
-        // ip 含有 0.2A
-        OR_EQUAL(CAN_BUFFER[1][2], 0x01);
-    } else {
-        // ip 不含 0.2A
-        AND_EQUAL(CAN_BUFFER[1][2], 0xFE);
-    }
-
-    if (ip_decimal_part == 5 || ip_decimal_part == 6 || ip_decimal_part == 7 ||
-        ip_decimal_part == 8) {
-        // ip 含有 0.5A
-        OR_EQUAL(CAN_BUFFER[1][2], 0x02);
-    } else {
-        // ip 不含 0.5A
-        AND_EQUAL(CAN_BUFFER[1][2], 0xFD);
-    }
+    return pulse_on;
+}
+
+// NOW 吸合条件
+static bool _now_closed(const EleparamDecodeInput &in) {
+    if (_is_c90x(in)) {
+        return false; // C901 C902 不吸合
+    }
+
+    if (in.ele_param().ip > 70) {
+        return true; // 特殊 IP > 7 吸合
+    }
+
+    return _tens(in.ele_param().hp) < 4; // HP = 0x,1x,2x,3x 吸合
+}
+
+// 电容继电器 Cx, c > 9 按 9
+template <uint8_t X> static bool _cap_closed(const EleparamDecodeInput &in) {
+    return std::min<uint8_t>(in.ele_param().c, 9) == X;
+}
+
+// can帧各位 (心跳[0][3],[0][4] 与校验和[1][7] 除外), 初始全为0
+static constexpr const CanFieldSlot s_can_slots[]{
+    // frame 0
+    {0, 0, 0, 0xFF, CONST_(0xEB)},
+    {0, 1, 0, 0xFF, CONST_(0x90)},
+    {0, 2, 0, 0xFF, CONST_(0xE9)},
+    {0, 5, 0, 0xFF, CONST_(0x09)},
+    {0, 6, 0, 0xFF, _can_pulse_on},
+    {0, 7, 0, 0xFF, VALUE_(in.ele_param().pulse_off)},
+
+    // frame 1
+    // up 和 dn 由运动控制处理(抬刀用), 不发给电源, 给0防止电源自己切断电压
+    {1, 0, 0, 0xFF, CONST_(0x00)},
+    // ip 整数部分, 0.5A 位
+    {1, 1, 0, 0x7F, VALUE_(in.ele_param().ip / 10)},
+    {1, 1, 7, 0x01, VALUE_(in.ele_param().ip % 10 == 5)},
+    {1, 2, 1, 0x01, VALUE_(in.ele_param().ip % 10 == 5)},
+    // hp 个位, 最高位始终给1
+    {1, 2, 4, 0x0F, VALUE_((in.ele_param().hp % 10) | 0x08)},
+    {1, 3, 0, 0x0F, VALUE_(in.ele_param().ma)},
+    // sv 由伺服采样模块处理, 给固定值
+    {1, 3, 4, 0x0F, CONST_(0x05)},
+    {1, 4, 0, 0xFF, VALUE_(in.ele_param().al)},
+    {1, 5, 0, 0x0F, VALUE_(in.ele_param().ld)},
+    {1, 5, 4, 0x0F, VALUE_(in.ele_param().oc)},
+    // CPS: hp 十位为 2,3,6,7
+    {1, 6, 0, 0x01, VALUE_((0xCC >> _tens(in.ele_param().hp)) & 0x01)},
+    // CK2: 15 < on < 64
+    {1, 6, 1, 0x01,
+     VALUE_(in.ele_param().pulse_on > 15 && in.ele_param().pulse_on < 64)},
+    // NWS: pp 个位为奇数 (高频未使能时pp按0)
+    {1, 6, 4, 0x01, VALUE_(in.highpower_flag() && (in.ele_param().pp & 0x01))},
+    // 高频允许 且 高压允许(非抬刀)
+    {1, 6, 5, 0x01, VALUE_(in.highpower_flag() && in.machpower_flag())},
+};
+
+static constexpr const ContactorSlot s_contactor_slots[]{
+    {EleContactorOut_NOW_JFD, true, _now_closed},
+    // pp 十位为1时, hp 十位偶数 MON 吸合, 奇数 HON 吸合
+    {EleContactorOut_MON_JF4, false,
+     CLOSED_(_tens(in.ele_param().pp) == 1 &&
+             _tens(in.ele_param().hp) % 2 == 0)},
+    {EleContactorOut_HON_JF3, false,
+     CLOSED_(_tens(in.ele_param().pp) == 1 &&
+             _tens(in.ele_param().hp) % 2 == 1)},
+    // ip: (0, 7] IP0; (7, 15] IP0 IP7; > 15 全部
+    {EleContactorOut_IP0_JFB, true, CLOSED_(in.ele_param().ip != 0)},
+    {EleContactorOut_IP7_JFC, false, CLOSED_(in.ele_param().ip > 70)},
+    {EleContactorOut_IP15_JFF, false, CLOSED_(in.ele_param().ip > 150)},
+    {EleContactorOut_V1_JV1, false, CLOSED_(in.ele_param().lv == 1)},
+    {EleContactorOut_V2_JV2, false, CLOSED_(in.ele_param().lv == 2)},
+    // pl = 0 正极性, OUT39 = 0; pl = 1 负极性, OUT39 = 1
+    {EleContactorOut_RVNM_JF8, false, CLOSED_(in.ele_param().pl != 0)},
+    {EleContactorOut_MACH_JF0, false, CLOSED_(in.highpower_flag() != 0)},
+    // 只有901, 902不吸合
+    {EleContactorOut_PK_JF6, true, CLOSED_(!_is_c90x(in))},
+    {EleContactorOut_C0_JC0, false, _cap_closed<0>},
+    {EleContactorOut_C1_JC1, false, _cap_closed<1>},
+    {EleContactorOut_C2_JC2, false, _cap_closed<2>},
+    {EleContactorOut_C3_JC3, false, _cap_closed<3>},
+    {EleContactorOut_C4_JC4, false, _cap_closed<4>},
+    {EleContactorOut_C5_JC5, false, _cap_closed<5>},
+    {EleContactorOut_C6_JC6, false, _cap_closed<6>},
+    {EleContactorOut_C7_JC7, false, _cap_closed<7>},
+    {EleContactorOut_C8_JC8, false, _cap_closed<8>},
+    {EleContactorOut_C9_JC9, false, _cap_closed<9>},
+};
+
+#undef VALUE_
+#undef CLOSED_
+#undef CONST_
+
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
+    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+
+/**
+ * 中谷 编码表
+ */
+
+// IO位: value(input) & bit 不为0时置位
+struct IoBitSlot {
+    uint32_t io_index;
+    uint32_t bit;
+    uint32_t (*value)(const EleparamDecodeInput &in);
+};
+
+#define VALUE_(expr__)                                                         \
+    [](const EleparamDecodeInput &in) -> uint32_t {                            \
+        return static_cast<uint32_t>(expr__);                                  \
+    }
+
+static constexpr auto s_on_value = VALUE_(in.ele_param().pulse_on);
+static constexpr auto s_off_value = VALUE_(in.ele_param().pulse_off);
+static constexpr auto s_mach_value = VALUE_(in.highpower_flag() != 0);
+
+#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU)
+// machbit是0时, ip强制给0
+static constexpr auto s_ip_value =
+    VALUE_(in.machpower_flag() ? in.ele_param().ip : 0);
+
+static constexpr const IoBitSlot s_io_slots[]{
+    {ZHONGGU_IOOut_TON1, 0x01, s_on_value},
+    {ZHONGGU_IOOut_TON2, 0x02, s_on_value},
+    {ZHONGGU_IOOut_TON4, 0x04, s_on_value},
+    {ZHONGGU_IOOut_TON8, 0x08, s_on_value},
+    {ZHONGGU_IOOut_TON16, 0x10, s_on_value},
+    {ZHONGGU_IOOut_TOFF1, 0x01, s_off_value},
+    {ZHONGGU_IOOut_TOFF2, 0x02, s_off_value},
+    {ZHONGGU_IOOut_TOFF4, 0x04, s_off_value},
+    {ZHONGGU_IOOut_TOFF8, 0x08, s_off_value},
+    {ZHONGGU_IOOut_IP1, 0x01, s_ip_value},
+    {ZHONGGU_IOOut_IP2, 0x02, s_ip_value},
+    {ZHONGGU_IOOut_IP4, 0x04, s_ip_value},
+    {ZHONGGU_IOOut_IP8, 0x08, s_ip_value},
+    // pl = 1 (对应上位机发的是 (-), 负极性)
+    {ZHONGGU_IOOut_IOOUT2_NEG, 0x01, VALUE_(in.ele_param().pl != 0)},
+    // hp = x1 -> hp1, hp = 1x -> hp2
+    {ZHONGGU_IOOut_IOOUT11_HP1, 0x01, VALUE_(in.ele_param().hp % 10 == 1)},
+    {ZHONGGU_IOOut_IOOUT12_HP2, 0x01,
+     VALUE_((in.ele_param().hp / 10) % 10 == 1)},
+    {ZHONGGU_IOOut_IOOUT3_MACH, 0x01, s_mach_value},
+};
+#else // EDM_POWER_ZHONGGU_DRILL
+static constexpr auto s_ip_value = VALUE_(in.ele_param().ip);
+static constexpr auto s_cap_value = VALUE_(in.ele_param().c);
+
+static constexpr const IoBitSlot s_io_slots[]{
+    {ZHONGGU_IOOut_CAP1, 0x01, s_cap_value},
+    {ZHONGGU_IOOut_CAP2, 0x02, s_cap_value},
+    {ZHONGGU_IOOut_CAP4, 0x04, s_cap_value},
+    {ZHONGGU_IOOut_CAP8, 0x08, s_cap_value},
+    {ZHONGGU_IOOut_TON1, 0x01, s_on_value},
+    {ZHONGGU_IOOut_TON2, 0x02, s_on_value},
+    {ZHONGGU_IOOut_TON4, 0x04, s_on_value},
+    {ZHONGGU_IOOut_TON8, 0x08, s_on_value},
+    {ZHONGGU_IOOut_TOFF1, 0x01, s_off_value},
+    {ZHONGGU_IOOut_TOFF2, 0x02, s_off_value},
+    {ZHONGGU_IOOut_TOFF4, 0x04, s_off_value},
+    {ZHONGGU_IOOut_TOFF8, 0x08, s_off_value},
+    {ZHONGGU_IOOut_IP1, 0x01, s_ip_value},
+    {ZHONGGU_IOOut_IP2, 0x02, s_ip_value},
+    {ZHONGGU_IOOut_IP4, 0x04, s_ip_value},
+    {ZHONGGU_IOOut_IP8, 0x08, s_ip_value},
+    {ZHONGGU_IOOut_IOOUT3_MACH, 0x01, s_mach_value},
+    {ZHONGGU_IOOut_WORK, 0x01, s_mach_value}, // 小孔机特有
+    // 小孔机没有极性IO (IOOUT2 为内冲), pl 不参与编码
+};
 #endif
-}
-
-void EleparamDecoder::_canframe_handle_hp() {
-    uint8_t param_hp = input_->ele_param().hp;
-    uint8_t hp = param_hp;
-    uint8_t hp_units = hp % 10;            // 个位
-    uint8_t hp_tens = (hp / 10) % 10;      // 十位
-    uint8_t hp_hundreds = (hp / 100) % 10; // 百位
 
-    // 清空 ELEBUFFER[1][2]的高4位
-    AND_EQUAL(CAN_BUFFER[1][2], 0x0F);
-    OR_EQUAL(CAN_BUFFER[1][2], hp_units << 4); // hp个位
-
-    OR_EQUAL(CAN_BUFFER[1][2], 0x80); //! 最高位始终给1
-
-    if (hp_tens == 2 || hp_tens == 3 || hp_tens == 6 || hp_tens == 7) {
-        OR_EQUAL(CAN_BUFFER[1][6], 0x01); // CPS bit0 设为1
-    } else {
-        AND_EQUAL(CAN_BUFFER[1][6], 0xFE);
-    }
-}
+#undef VALUE_
 
-void EleparamDecoder::_canframe_handle_ma() {
-    AND_EQUAL(CAN_BUFFER[1][3], 0xF0); // 清空低4位
-    OR_EQUAL(CAN_BUFFER[1][3], (input_->ele_param().ma) & 0x0F); // 低4位设定ma
-}
-
-void EleparamDecoder::_canframe_handle_sv() {
-    // sv 伺服电压 (应当由伺服采样模块(目前为IO采样板)处理, 不需要发送给电源)
-    // TODO 外部要将sv值通过can发送给采样板
-
-    AND_EQUAL(CAN_BUFFER[1][3], 0x0F); // 清空高4位
-    OR_EQUAL(CAN_BUFFER[1][3], 0x50);  // 高4位设定sv //! 给固定值
-
-    // if (input_->ele_param().sv < 10) {
-    //     OR_EQUAL(CAN_BUFFER[1][3], input_->ele_param().sv << 4);
-    // } else {
-    //     uint8_t send_sv {};
-
-    //     if (input_->ele_param().sv > 75) {
-    //         send_sv = 7;
-    //     } else if (input_->ele_param().sv > 65) {
-    //         send_sv = 6;
-    //     } else {
-    //         send_sv = 5;
-    //     }
+#endif
 
-    //     OR_EQUAL(CAN_BUFFER[1][3], send_sv << 4);
-    // }
-}
+EleparamDecodeResult::ptr
+EleparamDecoder::decode(EleparamDecodeInput::ptr input) {
+    auto decoder = EleparamDecoder();
+    decoder._decode(input);
 
-void EleparamDecoder::_canframe_handle_al() {
-    CAN_BUFFER[1][4] = input_->ele_param().al;
+    return decoder._get_result();
 }
 
-void EleparamDecoder::_canframe_handle_ld() {
-    AND_EQUAL(CAN_BUFFER[1][5], 0xF0); // 清空低4位
-    OR_EQUAL(CAN_BUFFER[1][5], (input_->ele_param().ld) & 0x0F); // 低4位设定ld
-}
+void EleparamDecoder::_decode(EleparamDecodeInput::ptr input) {
+    input_ = input; // save input
 
-void EleparamDecoder::_canframe_handle_oc() {
-    AND_EQUAL(CAN_BUFFER[1][5], 0x0F);                       // 清空高4位
-    OR_EQUAL(CAN_BUFFER[1][5], input_->ele_param().oc << 4); // 高4位设定oc
-}
+    // initialize result ptr
+    result_ = std::make_shared<EleparamDecodeResult>();
 
-void EleparamDecoder::_canframe_handle_pp() {
-    uint8_t pp = input_->ele_param().pp;
-    if (input_->highpower_flag() == 0) {
-        pp = 0; // 高频未使能
-    }
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
+    _fill_can_buffer();
 
-    if (pp & 0x01) {
-        // TODO
-        // 如果pp位*1 (?什么意思), 设置NWS bit4 为1
-        OR_EQUAL(CAN_BUFFER[1][6], 0x10);
-    } else {
-        AND_EQUAL(CAN_BUFFER[1][6], 0xEF);
-    }
+    _fill_io_settings();
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
+    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    _fill_io();
+#endif
 }
 
-void EleparamDecoder::_canframe_handle_machbit() {
-    if (input_->highpower_flag() && input_->machpower_flag()) {
-        // 高频允许 且 高压允许(非抬刀)
-        OR_EQUAL(CAN_BUFFER[1][6], 0x20); // 允许高压
-    } else {
-        AND_EQUAL(CAN_BUFFER[1][6], 0xDF); // 切断高压
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
+void EleparamDecoder::_fill_can_buffer() {
+    uint8_t buffer[2][8]{};
+    for (const auto &slot : s_can_slots) {
+        auto &b = buffer[slot.frame][slot.byte];
+        b = (b & ~(slot.mask << slot.shift)) |
+            ((slot.value(*input_) & slot.mask) << slot.shift);
     }
-}
 
-void EleparamDecoder::_canframe_handle_pulsecounter() {
-    auto count = input_->counter();
-    CAN_BUFFER[0][3] = count & 0xFF;
-    CAN_BUFFER[0][4] = (count >> 8) & 0xFF;
-}
-
-void EleparamDecoder::_canframe_calc_crc() {
-    uint16_t end_check = 0x00;
+    // 校验和: frame0 8字节 + frame1 前7字节, 取低8位
+    // 先算除心跳以外的部分, 心跳由 set_pulse_count 加上
+    uint16_t base_sum = 0x00;
     for (int i = 0; i < 2; ++i) {
         for (int j = 0; j < 8 - i; ++j) {
-            end_check += static_cast<uint8_t>(CAN_BUFFER[i][j]);
-        }
-    }
-
-    CAN_BUFFER[1][7] = static_cast<uint8_t>(end_check);
-}
-
-void EleparamDecoder::_set_contactor_io(uint32_t contactor_index, bool enable) {
-    // 处理反逻辑 NOW, PK
-    if (contactor_index == EleContactorOut_NOW_JFD ||
-        contactor_index == EleContactorOut_PK_JF6) {
-        enable = !enable;
-    }
-
-    if (enable) {
-        if (contactor_index < 33) {
-            result_->io_1() |= 1 << (contactor_index - 1);
-        } else {
-            result_->io_2() |= 1 << (contactor_index - 33);
+            base_sum += buffer[i][j];
         }
-    } else {
-        if (contactor_index < 33) {
-            result_->io_1() &= ~(1 << (contactor_index - 1));
-        } else {
-            result_->io_2() &= ~(1 << (contactor_index - 33));
-        }
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_NOW(bool enable) {
-    static const uint32_t now_io = 1 << (EleContactorOut_NOW_JFD - 33);
-
-    //! NOW 反逻辑 enable(吸合) 为 0
-    if (!enable) {
-        result_->io_2() |= now_io;
-    } else {
-        result_->io_2() &= ~now_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_PK(bool enable) {
-    static const uint32_t pk_io = 1 << (EleContactorOut_PK_JF6 - 33);
-
-    //! PK 反逻辑 enable(吸合) 为 0
-    if (!enable) {
-        result_->io_2() |= pk_io;
-    } else {
-        result_->io_2() &= ~pk_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_MON(bool enable) {
-    static const uint32_t mon_io = 1 << (EleContactorOut_MON_JF4 - 33);
-
-    if (enable) {
-        result_->io_2() |= mon_io;
-    } else {
-        result_->io_2() &= ~mon_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_HON(bool enable) {
-    static const uint32_t hon_io = 1 << (EleContactorOut_HON_JF3 - 33);
-
-    if (enable) {
-        result_->io_2() |= hon_io;
-    } else {
-        result_->io_2() &= ~hon_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_IP0(bool enable) {
-    static const uint32_t ip0_io = 1 << (EleContactorOut_IP0_JFB - 33);
-
-    //! IP0 反逻辑 enable(吸合) 为 0
-    if (!enable) {
-        result_->io_2() |= ip0_io;
-    } else {
-        result_->io_2() &= ~ip0_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_IP7(bool enable) {
-    static const uint32_t ip7_io = 1 << (EleContactorOut_IP7_JFC - 33);
-
-    if (enable) {
-        result_->io_2() |= ip7_io;
-    } else {
-        result_->io_2() &= ~ip7_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_IP15(bool enable) {
-    static const uint32_t ip15_io = 1 << (EleContactorOut_IP15_JFF - 33);
-
-    if (enable) {
-        result_->io_2() |= ip15_io;
-    } else {
-        result_->io_2() &= ~ip15_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_LV1(bool enable) {
-    static const uint32_t lv1_io = 1 << (EleContactorOut_V1_JV1 - 1);
-
-    if (enable) {
-        result_->io_1() |= lv1_io;
-    } else {
-        result_->io_1() &= ~lv1_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_LV2(bool enable) {
-    static const uint32_t lv2_io = 1 << (EleContactorOut_V2_JV2 - 1);
-
-    if (enable) {
-        result_->io_1() |= lv2_io;
-    } else {
-        result_->io_1() &= ~lv2_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_RVNM(bool enable) {
-    static const uint32_t rvnm_io = 1 << (EleContactorOut_RVNM_JF8 - 33);
-
-    if (enable) {
-        result_->io_2() |= rvnm_io;
-    } else {
-        result_->io_2() &= ~rvnm_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_MACH(bool enable) {
-    static const uint32_t mach_io = 1 << (EleContactorOut_MACH_JF0 - 1);
-
-    if (enable) {
-        result_->io_1() |= mach_io;
-    } else {
-        result_->io_1() &= ~mach_io;
-    }
-}
-
-void EleparamDecoder::_set_contactor_io_Cx(uint32_t x, bool enable) {
-    if (x > 9) {
-        s_logger->warn("_set_contactor_io_Cx x({}) > 9, set to 9", x);
-        x = 9;
-    }
-
-    uint32_t cx_io = 1 << (EleContactorOut_C0_JC0 + x - 1);
-
-    if (enable) {
-        result_->io_1() |= cx_io;
-    } else {
-        result_->io_1() &= ~cx_io;
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_NOW() {
-    // 先处理特殊条件 C901 C902
-    auto upper_index = input_->ele_param().upper_index;
-    if (upper_index == 901 || upper_index == 902) {
-        _set_contactor_io_NOW(false); // 不吸合
-        return;
     }
 
-    // 处理特殊 IP > 7
-    if (input_->ele_param().ip > 70) {
-        _set_contactor_io_NOW(true); // 吸合
-        return;
-    }
-
-    // 处理普通 HP 控制
-    uint8_t hp_tens = (input_->ele_param().hp / 10) % 10;
-    if (hp_tens < 4) {
-        _set_contactor_io_NOW(true); // HP = 0x,1x,2x,3x 吸合
-    } else {
-        _set_contactor_io_NOW(false); // HP = 4x,5x,6x,7x 不吸合
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_MON_HON() {
-    uint8_t pp_tens = (input_->ele_param().pp / 10) % 10;
-    uint8_t hp_tens = (input_->ele_param().hp / 10) % 10;
-
-    if (pp_tens != 1) {
-        _set_contactor_io_MON(false);
-        _set_contactor_io_HON(false);
-        return;
-    }
-
-    if (hp_tens % 2 == 0) {
-        // hp = *0* *2* *4* *6*
-        // MON 吸合 HON 断开
-        _set_contactor_io_MON(true);
-        _set_contactor_io_HON(false);
-    } else {
-        // hp = *1* *3* *5* *7*
-        // MON 断开 HON 吸合
-        _set_contactor_io_MON(false);
-        _set_contactor_io_HON(true);
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_IPx() {
-    auto ip = input_->ele_param().ip;
-    auto upper_index = input_->ele_param().upper_index;
-    // 特殊情况 C901, C902, 全部关断S
-
-    if (ip == 0 /* || upper_index == 901 || upper_index == 902*/) {
-        _set_contactor_io_IP0(false);
-        _set_contactor_io_IP7(false);
-        _set_contactor_io_IP15(false);
-    } else if (ip <= 70) {
-        // ip > 0, ip <= 7
-        _set_contactor_io_IP0(true);
-        _set_contactor_io_IP7(false);
-        _set_contactor_io_IP15(false);
-    } else if (ip <= 150) {
-        // ip > 7, ip <= 15
-        _set_contactor_io_IP0(true);
-        _set_contactor_io_IP7(true);
-        _set_contactor_io_IP15(false);
-    } else {
-        // ip > 15
-        _set_contactor_io_IP0(true);
-        _set_contactor_io_IP7(true);
-        _set_contactor_io_IP15(true);
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_LVx() {
-    auto lv = input_->ele_param().lv;
-
-    if (lv == 1) {
-        _set_contactor_io_LV1(true);
-        _set_contactor_io_LV2(false);
-    } else if (lv == 2) {
-        _set_contactor_io_LV1(false);
-        _set_contactor_io_LV2(true);
-    } else {
-        _set_contactor_io_LV1(false);
-        _set_contactor_io_LV2(false);
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_PL() {
-    uint8_t pl = input_->ele_param().pl;
-
-    if (pl == 0) { /* pl = 0 (对应上位机发的是 (+), 正极性) */
-        // 正极性, OUT39 = 0, RV继电器实际为吸合(反逻辑)
-        _set_contactor_io_RVNM(false);
-    } else { /* pl = 1 (对应上位机发的是 (-), 负极性) */
-        // 负极性, OUT39 = 1, RV继电器实际为不吸合(反逻辑)
-        _set_contactor_io_RVNM(true);
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_MACH() {
-    if (input_->highpower_flag()) {
-        // 高频打开
-        _set_contactor_io_MACH(true);
-    } else {
-        // 高频关闭
-        _set_contactor_io_MACH(false);
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_PK() {
-    auto upper_index = input_->ele_param().upper_index;
-    if (upper_index == 901 || upper_index == 902) {
-        _set_contactor_io_PK(false); // 不吸合 (只有901, 902不吸合)
-    } else {
-        _set_contactor_io_PK(true); // 吸合
-    }
-}
-
-void EleparamDecoder::_iosettings_handle_CAPx() {
-    uint8_t c = input_->ele_param().c;
-
-    // 先全部设置关闭
-    for (uint32_t i = 0; i <= 9; ++i) {
-        _set_contactor_io_Cx(i, false);
-    }
-
-    // 再设置对应电容继电器开启
-    _set_contactor_io_Cx(c, true);
-}
-
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU)
-
-void EleparamDecoder::_set_io_mach(bool enable) {
-    static const uint32_t mach_io = 1 << (ZHONGGU_IOOut_IOOUT3_MACH - 1);
-
-    if (enable) {
-        result_->io() |= mach_io;
-    } else {
-        result_->io() &= ~mach_io;
-    }
-}
-
-void EleparamDecoder::_set_io_neg(bool enable) {
-    static const uint32_t neg_io = 1 << (ZHONGGU_IOOut_IOOUT2_NEG - 1);
-
-    if (enable) { // enable 为允许负极性
-        result_->io() |= neg_io;
-    } else {
-        result_->io() &= ~neg_io;
-    }
-}
-
-void EleparamDecoder::_set_io_hp1(bool enable) {
-    static const uint32_t hp1_io = 1 << (ZHONGGU_IOOut_IOOUT11_HP1 - 1);
-
-    if (enable) {
-        result_->io() |= hp1_io;
-    } else {
-        result_->io() &= ~hp1_io;
-    }
-}
-
-void EleparamDecoder::_set_io_hp2(bool enable) {
-    static const uint32_t hp2_io = 1 << (ZHONGGU_IOOut_IOOUT12_HP2 - 1);
-
-    if (enable) {
-        result_->io() |= hp2_io;
-    } else {
-        result_->io() &= ~hp2_io;
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_on() {
-    static const uint32_t on1_io = 1 << (ZHONGGU_IOOut_TON1 - 1);
-    static const uint32_t on2_io = 1 << (ZHONGGU_IOOut_TON2 - 1);
-    static const uint32_t on4_io = 1 << (ZHONGGU_IOOut_TON4 - 1);
-    static const uint32_t on8_io = 1 << (ZHONGGU_IOOut_TON8 - 1);
-    static const uint32_t on16_io = 1 << (ZHONGGU_IOOut_TON16 - 1);
-
-    uint8_t on = input_->ele_param().pulse_on;
-
-    if (on & 0x01) {
-        result_->io() |= on1_io;
-    }
-
-    if (on & 0x02) {
-        result_->io() |= on2_io;
-    }
-
-    if (on & 0x04) {
-        result_->io() |= on4_io;
-    }
-
-    if (on & 0x08) {
-        result_->io() |= on8_io;
-    }
-
-    if (on & 0x10) {
-        result_->io() |= on16_io;
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_off() {
-    static const uint32_t off1_io = 1 << (ZHONGGU_IOOut_TOFF1 - 1);
-    static const uint32_t off2_io = 1 << (ZHONGGU_IOOut_TOFF2 - 1);
-    static const uint32_t off4_io = 1 << (ZHONGGU_IOOut_TOFF4 - 1);
-    static const uint32_t off8_io = 1 << (ZHONGGU_IOOut_TOFF8 - 1);
-
-    uint8_t off = input_->ele_param().pulse_off;
-
-    if (off & 0x01) {
-        result_->io() |= off1_io;
-    }
-
-    if (off & 0x02) {
-        result_->io() |= off2_io;
-    }
-
-    if (off & 0x04) {
-        result_->io() |= off4_io;
-    }
-
-    if (off & 0x08) {
-        result_->io() |= off8_io;
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_ip() {
-    static const uint32_t ip1_io = 1 << (ZHONGGU_IOOut_IP1 - 1);
-    static const uint32_t ip2_io = 1 << (ZHONGGU_IOOut_IP2 - 1);
-    static const uint32_t ip4_io = 1 << (ZHONGGU_IOOut_IP4 - 1);
-    static const uint32_t ip8_io = 1 << (ZHONGGU_IOOut_IP8 - 1);
-
-    uint16_t ip = input_->ele_param().ip;
-
-    // 检查machbit, 如果machbit是0, ip强制给0
-    if (input_->machpower_flag() == 0) {
-        ip = 0;
-    }
-
-    // s_logger->debug("ip: {}", ip);
-
-    if (ip & 0x01) {
-        result_->io() |= ip1_io;
-    }
-
-    if (ip & 0x02) {
-        result_->io() |= ip2_io;
-    }
-
-    if (ip & 0x04) {
-        result_->io() |= ip4_io;
-    }
-
-    if (ip & 0x08) {
-        result_->io() |= ip8_io;
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_neg() {
-    uint8_t pl = input_->ele_param().pl;
-
-    if (pl == 0) { /* pl = 0 (对应上位机发的是 (+), 正极性) */
-        _set_io_neg(false);
-    } else { /* pl = 1 (对应上位机发的是 (-), 负极性) */
-        _set_io_neg(true);
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_hp() {
-    uint8_t hp = input_->ele_param().hp;
-
-    _set_io_hp1(false);
-    _set_io_hp2(false);
-
-    // hp = x1
-    if (hp % 10 == 1) {
-        _set_io_hp1(true);
-    }
-
-    // hp = 1x
-    if ((hp / 10) % 10 == 1) {
-        _set_io_hp2(true);
-    }
-
-    // e.g: hp = 00 -> hp1 off, hp2 off
-    // hp = 01 -> hp1 on, hp2 off
-    // hp = 10 -> hp1 off, hp2 on
-    // hp = 11 -> hp1 on, hp2 on
-}
-
-void EleparamDecoder::_zhonggu_handle_mach() {
-    bool mach_on = input_->highpower_flag();
-    _set_io_mach(mach_on);
-}
-
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
-
-void EleparamDecoder::_set_io_mach(bool enable) {
-    static const uint32_t mach_io = 1 << (ZHONGGU_IOOut_IOOUT3_MACH - 1);
-
-    if (enable) {
-        result_->io() |= mach_io;
-    } else {
-        result_->io() &= ~mach_io;
+    auto &can_buffer = result_->can_buffer();
+    for (int i = 0; i < 2; ++i) {
+        can_buffer[i] =
+            QByteArray{reinterpret_cast<const char *>(buffer[i]), 8};
     }
-}
+    result_->can_base_sum_ = base_sum;
 
-void EleparamDecoder::_set_io_work(bool enable) {
-    static const uint32_t work_io = 1 << (ZHONGGU_IOOut_WORK - 1);
-
-    if (enable) {
-        result_->io() |= work_io;
-    } else {
-        result_->io() &= ~work_io;
-    }
+    result_->set_pulse_count(input_->counter());
 }
 
-void EleparamDecoder::_set_io_tool(bool enable) {
-    static const uint32_t tool_io = 1 << (ZHONGGU_IOOut_TOOL - 1);
-
-    if (enable) {
-        result_->io() |= tool_io;
-    } else {
-        result_->io() &= ~tool_io;
-    }
-}
-
-void EleparamDecoder::_zhonggu_handle_cap() {
-    static const uint32_t cap1_io = 1 << (ZHONGGU_IOOut_CAP1 - 1);
-    static const uint32_t cap2_io = 1 << (ZHONGGU_IOOut_CAP2 - 1);
-    static const uint32_t cap4_io = 1 << (ZHONGGU_IOOut_CAP4 - 1);
-    static const uint32_t cap8_io = 1 << (ZHONGGU_IOOut_CAP8 - 1);
-
-    uint8_t cap = input_->ele_param().c;
-
-    if (cap & 0x01) {
-        result_->io() |= cap1_io;
+void EleparamDecoder::_fill_io_settings() {
+    if (input_->ele_param().c > 9) {
+        s_logger->warn("eleparam c({}) > 9, set to 9", input_->ele_param().c);
     }
 
-    if (cap & 0x02) {
-        result_->io() |= cap2_io;
-    }
+    uint32_t io_1 = 0x00;
+    uint32_t io_2 = 0x00;
+    for (const auto &slot : s_contactor_slots) {
+        //! 反逻辑继电器 吸合为 0
+        if (slot.closed(*input_) == slot.inverted) {
+            continue;
+        }
 
-    if (cap & 0x04) {
-        result_->io() |= cap4_io;
+        if (slot.contactor_index < 33) {
+            io_1 |= 1 << (slot.contactor_index - 1);
+        } else {
+            io_2 |= 1 << (slot.contactor_index - 33);
+        }
     }
 
-    if (cap & 0x08) {
-        result_->io() |= cap8_io;
-    }
+    result_->io_1() = io_1;
+    result_->io_2() = io_2;
 }
 
-void EleparamDecoder::_zhonggu_handle_on() {
-    static const uint32_t on1_io = 1 << (ZHONGGU_IOOut_TON1 - 1);
-    static const uint32_t on2_io = 1 << (ZHONGGU_IOOut_TON2 - 1);
-    static const uint32_t on4_io = 1 << (ZHONGGU_IOOut_TON4 - 1);
-    static const uint32_t on8_io = 1 << (ZHONGGU_IOOut_TON8 - 1);
-
-    uint8_t on = input_->ele_param().pulse_on;
-
-    if (on & 0x01) {
-        result_->io() |= on1_io;
-    }
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
+    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 
-    if (on & 0x02) {
-        result_->io() |= on2_io;
-    }
-
-    if (on & 0x04) {
-        result_->io() |= on4_io;
+void EleparamDecoder::_fill_io() {
+    uint32_t io = 0x00;
+    for (const auto &slot : s_io_slots) {
+        if (slot.value(*input_) & slot.bit) {
+            io |= 1 << (slot.io_index - 1);
+        }
     }
 
-    if (on & 0x08) {
-        result_->io() |= on8_io;
-    }
+    result_->io() = io;
 }
 
-void EleparamDecoder::_zhonggu_handle_off() {
-    static const uint32_t off1_io = 1 << (ZHONGGU_IOOut_TOFF1 - 1);
-    static const uint32_t off2_io = 1 << (ZHONGGU_IOOut_TOFF2 - 1);
-    static const uint32_t off4_io = 1 << (ZHONGGU_IOOut_TOFF4 - 1);
-    static const uint32_t off8_io = 1 << (ZHONGGU_IOOut_TOFF8 - 1);
-
-    uint8_t off = input_->ele_param().pulse_off;
+#endif
 
-    if (off & 0x01) {
-        result_->io() |= off1_io;
-    }
+EleparamDecodeResult::ptr EleparamDecodeCache::get(
+    const EleParam_dkd_t &ele_param, uint8_t highpower_flag,
+    uint8_t machpower_flag) {
+    highpower_flag = !!highpower_flag;
+    machpower_flag = !!machpower_flag;
 
-    if (off & 0x02) {
-        result_->io() |= off2_io;
+    auto &entry = entries_[ele_param.upper_index];
+    if (!_same_encode_fields(entry.ele_param, ele_param)) {
+        // 新的电参数号, 或该电参数号被修改过
+        entry.ele_param = ele_param;
+        entry.results.fill(nullptr);
     }
 
-    if (off & 0x04) {
-        result_->io() |= off4_io;
+    auto &result = entry.results[highpower_flag * 2 + machpower_flag];
+    if (!result) {
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
+        auto input = std::make_shared<EleparamDecodeInput>(
+            ele_param, highpower_flag, machpower_flag, 0);
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
+    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+        auto input = std::make_shared<EleparamDecodeInput>(
+            ele_param, highpower_flag, machpower_flag);
+#endif
+        result = EleparamDecoder::decode(input);
     }
 
-    if (off & 0x08) {
-        result_->io() |= off8_io;
-    }
+    return result;
 }
 
-void EleparamDecoder::_zhonggu_handle_ip() {
-    static const uint32_t ip1_io = 1 << (ZHONGGU_IOOut_IP1 - 1);
-    static const uint32_t ip2_io = 1 << (ZHONGGU_IOOut_IP2 - 1);
-    static const uint32_t ip4_io = 1 << (ZHONGGU_IOOut_IP4 - 1);
-    static const uint32_t ip8_io = 1 << (ZHONGGU_IOOut_IP8 - 1);
-
-    uint16_t ip = input_->ele_param().ip;
-
-    if (ip & 0x01) {
-        result_->io() |= ip1_io;
-    }
-
-    if (ip & 0x02) {
-        result_->io() |= ip2_io;
-    }
+bool EleparamDecodeCache::_same_encode_fields(const EleParam_dkd_t &a,
+                                              const EleParam_dkd_t &b) {
+#define XX_(field__)                                                           \
+    if (a.field__ != b.field__)                                                \
+        return false;
 
-    if (ip & 0x04) {
-        result_->io() |= ip4_io;
-    }
+    EDM_ELEPARAM_ENCODE_FIELDS(XX_)
 
-    if (ip & 0x08) {
-        result_->io() |= ip8_io;
-    }
+#undef XX_
+    return true;
 }
 
-void EleparamDecoder::_zhonggu_handle_mach() {
-    bool mach_on = input_->highpower_flag();
-    _set_io_mach(mach_on);
-
-    _set_io_work(mach_on); // 小孔机特有
-}
-
-#endif
-
 } // namespace power
 
 } // namespace edm
@@ -3,6 +3,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 
 #include <QByteArray>
 
@@ -47,19 +48,24 @@ public:
 public:
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     // 提供单独设定新的心跳值的接口
+    // 校验和 = 除心跳外各字节的和 (decode时算好) + 心跳两字节
     void set_pulse_count(uint16_t count) {
-        can_buffer_[0][3] = count & 0xFF;
-        can_buffer_[0][4] = (count >> 8) & 0xFF;
-
-        uint16_t sum = 0x00;
-        // 重新计算校验和
-        for (int i = 0; i < 2; ++i) {
-            for (int j = 0; j < 8 - i; ++j) {
-                sum += static_cast<uint8_t>(can_buffer_[i][j]);
-            }
-        }
-
-        can_buffer_[1][7] = static_cast<uint8_t>(sum);
+        FillPulseCount(reinterpret_cast<uint8_t *>(can_buffer_[0].data()),
+                       reinterpret_cast<uint8_t *>(can_buffer_[1].data()),
+                       can_base_sum_, count);
+    }
+
+    auto can_base_sum() const { return can_base_sum_; }
+
+    // 在两帧数据中填充心跳与校验 (直发缓存的帧也用这个)
+    static void FillPulseCount(uint8_t *frame0, uint8_t *frame1,
+                               uint16_t base_sum, uint16_t count) {
+        const uint8_t lo = count & 0xFF;
+        const uint8_t hi = (count >> 8) & 0xFF;
+
+        frame0[3] = lo;
+        frame0[4] = hi;
+        frame1[7] = static_cast<uint8_t>(base_sum + lo + hi);
     }
 #endif
 
@@ -73,8 +79,11 @@ public:
 #endif
 
 private:
+    friend class EleparamDecoder;
+
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     std::array<QByteArray, 2> can_buffer_;
+    uint16_t can_base_sum_{0}; // 校验范围内除心跳外的字节和
     uint32_t io_1_;
     uint32_t io_2_;
 #elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
@@ -129,6 +138,12 @@ private:
 #endif
 };
 
+/**
+ * 电参数编码 (名字沿用 decode):
+ * 各电源类型的编码规则都写成 EleparamDecoder.cpp 中的常量表,
+ * 表的每一项描述 一个字段(或由字段计算出的值) -> can帧的某几位 / 某个IO,
+ * 编码即按表逐项填充, 再由填充好的字节算出校验和.
+ */
 class EleparamDecoder final {
 public:
     static EleparamDecodeResult::ptr decode(EleparamDecodeInput::ptr input);
@@ -138,107 +153,65 @@ private:
     auto _get_result() const { return result_; }
 
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-private:
-    // decode 总步骤
-    void _fill_can_buffer();  // 填充can frame的buffer
-    void _fill_io_settings(); // 填充(设置)IO值
+    void _fill_can_buffer();  // 按表填充can frame的buffer, 并计算校验和
+    void _fill_io_settings(); // 按表填充(设置)继电器IO值
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
+    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
+    void _fill_io(); // 按表填充IO值
+#endif
 
 private:
-    // can frame 填充步骤
-    void _canframe_fill_fixedbytes();
-
-    void _canframe_handle_on();
-    void _canframe_handle_off();
-    void _canframe_handle_up_and_on();
-    void _canframe_handle_ip();
-    void _canframe_handle_hp();
-    void _canframe_handle_ma();
-    void _canframe_handle_sv();
-    void _canframe_handle_al();
-    void _canframe_handle_ld();
-    void _canframe_handle_oc();
-    void _canframe_handle_pp();
-    void _canframe_handle_lv() {} // do nothing (只影响继电器)
-    void _canframe_handle_pl() {} // do nothing (只影响继电器)
-    void _canframe_handle_machbit();
-
-    void _canframe_handle_pulsecounter(); // 心跳
-    void _canframe_calc_crc();            // 校验
+    EleparamDecoder() = default;
+    ~EleparamDecoder() = default;
 
 private:
-    // io 设置辅助函数
-    //! 要注意 NOW 和 PK 继电器相反的硬件逻辑
-    void _set_contactor_io(uint32_t contactor_index, bool enable);
-
-    //! NOW, PK 单独设置函数(反逻辑)
-    void _set_contactor_io_NOW(bool enable);
-    void _set_contactor_io_PK(bool enable);
-
-    // 其他继电器单独设置函数
-    void _set_contactor_io_MON(bool enable);
-    void _set_contactor_io_HON(bool enable);
-
-    void _set_contactor_io_IP0(bool enable); //! IP0 反逻辑
-    void _set_contactor_io_IP7(bool enable);
-    void _set_contactor_io_IP15(bool enable);
-
-    void _set_contactor_io_LV1(bool enable);
-    void _set_contactor_io_LV2(bool enable);
-
-    void _set_contactor_io_RVNM(bool enable);
+    EleparamDecodeInput::ptr input_;
+    EleparamDecodeResult::ptr result_;
+};
 
-    void _set_contactor_io_MACH(bool enable);
+// 参与编码的电参数字段, 编码结果只取决于这些字段和 高频/machbit 标志位
+// (can帧心跳不在其中, 由 set_pulse_count 单独填充)
+#define EDM_ELEPARAM_ENCODE_FIELDS(XX)                                         \
+    XX(upper_index)                                                            \
+    XX(pulse_on)                                                               \
+    XX(pulse_off)                                                              \
+    XX(ip)                                                                     \
+    XX(hp)                                                                     \
+    XX(ma)                                                                     \
+    XX(al)                                                                     \
+    XX(ld)                                                                     \
+    XX(oc)                                                                     \
+    XX(pp)                                                                     \
+    XX(pl)                                                                     \
+    XX(lv)                                                                     \
+    XX(c)
+
+/**
+ * 编码结果缓存, 按电参数号索引, 每个电参数号按 高频/machbit 标志位缓存4份.
+ * 加工中切换电参数或抬刀切换machbit时, 命中后只需查表.
+ * 同一电参数号的字段被修改(数据库编辑)时, 自动重新编码.
+ * 非线程安全, 由 PowerController 在调用线程中使用.
+ */
+class EleparamDecodeCache final {
+public:
+    //! 返回的结果被缓存共享, dimen的心跳值需要调用者用 set_pulse_count 重新填充
+    EleparamDecodeResult::ptr get(const EleParam_dkd_t &ele_param,
+                                  uint8_t highpower_flag,
+                                  uint8_t machpower_flag);
 
-    // 电容电路继电器, x = 0 ~ 9
-    void _set_contactor_io_Cx(uint32_t x, bool enable);
+    void clear() { entries_.clear(); }
 
 private:
-    // io settings 填充步骤
-    void _iosettings_handle_NOW();
-    void _iosettings_handle_MON_HON();
-    void _iosettings_handle_IPx();
-    void _iosettings_handle_LVx();
-    void _iosettings_handle_PL();
-    void _iosettings_handle_MACH();
-    void _iosettings_handle_PK();
-    void _iosettings_handle_CAPx();
-
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU)
-
-    void _set_io_mach(bool enable);
-    void _set_io_neg(bool enable);
-    void _set_io_hp1(bool enable);
-    void _set_io_hp2(bool enable);
-
-    void _zhonggu_handle_on();
-    void _zhonggu_handle_off();
-    void _zhonggu_handle_ip();
-
-    void _zhonggu_handle_neg();
-    void _zhonggu_handle_hp();
-    void _zhonggu_handle_mach();
-
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
-    void _set_io_mach(bool enable);
-    void _set_io_work(bool enable);
-    void _set_io_tool(bool enable);
-
-    void _zhonggu_handle_cap();
-    void _zhonggu_handle_on();
-    void _zhonggu_handle_off();
-    void _zhonggu_handle_ip();
-
-    void _zhonggu_handle_mach();
-    // TODO Neg
-#endif
+    static bool _same_encode_fields(const EleParam_dkd_t &a,
+                                    const EleParam_dkd_t &b);
 
 private:
-    EleparamDecoder() = default;
-    ~EleparamDecoder() = default;
+    struct Entry {
+        EleParam_dkd_t ele_param;
+        std::array<EleparamDecodeResult::ptr, 4> results; // [highpower][mach]
+    };
 
-private:
-    EleparamDecodeInput::ptr input_;
-    EleparamDecodeResult::ptr result_;
+    std::unordered_map<uint32_t, Entry> entries_;
 };
 
 } // namespace power
@@ -119,7 +119,7 @@ enum ZHONGGU_IOOut {
 };
 #endif
 
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || 
+#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU)
 enum ZHONGGU_IOOut {
     // 407 IO
     ZHONGGU_IOOut_IOOUT1_FULD = 1,
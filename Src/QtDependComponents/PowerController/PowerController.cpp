@@ -43,6 +43,25 @@ PowerController::PowerController(can::CanController::ptr can_ctrler,
 #endif
 
     memset(&curr_eleparam_, 0, sizeof(curr_eleparam_));
+
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN) && defined(EDM_CAN_ENABLE_DIRECT_SEND)
+    direct_sender_ = can_ctrler_->get_direct_sender(can_device_index_);
+    if (direct_sender_) {
+        direct_source_id_ = direct_sender_->add_source(
+            [this](struct can_frame *frames) -> int {
+                return _build_direct_frames(frames);
+            });
+    }
+#endif
+}
+
+PowerController::~PowerController() noexcept {
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
+    // 直发通道可能比自己活得久
+    if (direct_sender_) {
+        direct_sender_->remove_source(direct_source_id_);
+    }
+#endif
 }
 
 void PowerController::set_highpower_on(bool on) {
@@ -94,12 +113,68 @@ bool PowerController::is_finishing_cut_flag_on() const {
 }
 
 void PowerController::_trigger_send_canbuffer() {
-    QCanBusFrame frame1{POWERCAN_TXID, curr_result_->can_buffer()[0]};
-    can_ctrler_->send_frame(can_device_index_, frame1);
+    //! 直发通道可用时电源can帧全部由直发通道发送, 否则与直发的帧之间可能乱序;
+    //! 由发送线程按发送时的标志位组帧, 排队中的旧状态不会覆盖新的状态
+    if (direct_sender_ && direct_sender_->is_open() && direct_frames_valid_) {
+        direct_sender_->trigger(direct_source_id_);
+        return;
+    }
+
+    curr_result_->set_pulse_count(_add_canframe_pulse_value());
 
+    QCanBusFrame frame1{POWERCAN_TXID, curr_result_->can_buffer()[0]};
     QCanBusFrame frame2{POWERCAN_TXID, curr_result_->can_buffer()[1]};
+
+    can_ctrler_->send_frame(can_device_index_, frame1);
     can_ctrler_->send_frame(can_device_index_, frame2);
 }
+
+void PowerController::send_machbit_direct(bool on) {
+    machpower_flag_ = on;
+    if (direct_sender_) {
+        direct_sender_->trigger(direct_source_id_);
+    }
+}
+
+void PowerController::send_highpower_direct(bool on) {
+    highpower_on_flag_ = on;
+    if (direct_sender_) {
+        direct_sender_->trigger(direct_source_id_);
+    }
+}
+
+void PowerController::_update_direct_frames(const EleParam_dkd_t &eleparam) {
+    std::array<DirectPowerFrames, 4> frames;
+    for (int i = 0; i < 4; ++i) {
+        auto result = decode_cache_.get(eleparam, i >> 1, i & 1);
+        for (int j = 0; j < 2; ++j) {
+            const auto &ba = result->can_buffer()[j];
+            frames[i].frames[j] = can::SocketCanSender::MakeFrame(
+                POWERCAN_TXID, ba.constData(), ba.size());
+        }
+        frames[i].base_sum = result->can_base_sum();
+    }
+
+    std::lock_guard guard(direct_frames_mutex_);
+    direct_frames_ = frames;
+    direct_frames_valid_ = true;
+}
+
+int PowerController::_build_direct_frames(struct can_frame *frames) {
+    std::lock_guard guard(direct_frames_mutex_);
+    if (!direct_frames_valid_) {
+        return 0; // 电参数还未初始化
+    }
+
+    const auto &f = direct_frames_[(highpower_on_flag_ ? 2 : 0) +
+                                   (machpower_flag_ ? 1 : 0)];
+    frames[0] = f.frames[0];
+    frames[1] = f.frames[1];
+    EleparamDecodeResult::FillPulseCount(frames[0].data, frames[1].data,
+                                         f.base_sum,
+                                         _add_canframe_pulse_value());
+    return 2;
+}
 #endif
 
 void PowerController::_trigger_send_io_value() {
@@ -152,24 +227,15 @@ void PowerController::_update_eleparam_and_send(
     //     s_logger->trace(s);
     // }
 
-#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-    // 心跳处理
-    _add_canframe_pulse_value();
-
-    // 构造输入
-    auto input = std::make_shared<EleparamDecodeInput>(
-        eleparam, highpower_on_flag_, machpower_flag_, canframe_pulse_value_);
-#elif (EDM_POWER_TYPE == EDM_POWER_ZHONGGU) || \
-    (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
-    auto input = std::make_shared<EleparamDecodeInput>(
-        eleparam, highpower_on_flag_, machpower_flag_);
-#endif
-
-    // 获取decode输出
-    curr_result_ = EleparamDecoder::decode(input);
+    // 获取decode输出 (命中缓存时只是查表)
+    curr_result_ =
+        decode_cache_.get(eleparam, highpower_on_flag_, machpower_flag_);
 
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-    // 发送can buffer
+    // 先更新直发缓存, 直发通道按新的电参数组帧
+    _update_direct_frames(eleparam);
+
+    // 心跳处理并发送can buffer
     _trigger_send_canbuffer();
 #endif
 
@@ -278,11 +344,14 @@ bool PowerController::_is_bz_enable() {
     return is_power_on() && (!is_highpower_on());
 }
 
-void PowerController::_add_canframe_pulse_value() {
-    ++canframe_pulse_value_;
-    if (canframe_pulse_value_ > 0xC3FF) {
-        canframe_pulse_value_ = 0x9C00;
-    }
+uint16_t PowerController::_add_canframe_pulse_value() {
+    uint16_t curr = canframe_pulse_value_.load(std::memory_order_relaxed);
+    uint16_t next;
+    do {
+        next = curr >= 0xC3FF ? 0x9C00 : curr + 1;
+    } while (!canframe_pulse_value_.compare_exchange_weak(
+        curr, next, std::memory_order_relaxed));
+    return next;
 }
 #endif
 
@@ -349,10 +418,7 @@ void PowerController::trigger_send_eleparam() {
         return;
 
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-    _add_canframe_pulse_value();
-    curr_result_->set_pulse_count(canframe_pulse_value_);
-
-    // 发送can buffer
+    // 心跳处理并发送can buffer
     _trigger_send_canbuffer();
 #endif
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -34,7 +35,7 @@ public:
                     zynq::ZynqConnectController::ptr zynq_ctrler,
 #endif
                     int can_device_index);
-    ~PowerController() noexcept = default;
+    ~PowerController() noexcept;
 
     // void init(int can_device_index);
 
@@ -75,13 +76,21 @@ public:
     // 精加工标志位设定
     void set_finishing_cut_flag(bool on);
     bool is_finishing_cut_flag_on() const;
+
+    // 直发电源can帧 (wait-free, 可在运动线程中调用, 如抬刀时的电压门控)
+    // 设置标志位并触发直发通道, 由直发通道的发送线程按最新的标志位,
+    // 从主线程最近一次刷新电参数时预先编码好的帧中选取, 填充心跳与校验后发送
+    //! 不刷新继电器IO, 之后仍需在主线程调用 update_eleparam_and_send 同步IO;
+    //! 直发通道未打开时不发送, 由主线程的同步走Qt通道发出
+    void send_machbit_direct(bool on);
+    void send_highpower_direct(bool on);
 #endif
 
     const auto &get_current_param() const { return curr_eleparam_; }
 
 private:
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
-    void _trigger_send_canbuffer(); // 内部函数, 无锁, 不会操作心跳值
+    void _trigger_send_canbuffer(); // 内部函数, 更新心跳值后发送
     void _trigger_send_ioboard_eleparam(); // 内部函数, 无锁
 #endif
     void _trigger_send_io_value(); // 内部函数, 无锁
@@ -94,7 +103,12 @@ private:
 
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     bool _is_bz_enable();
-    void _add_canframe_pulse_value();
+    uint16_t _add_canframe_pulse_value(); // 线程安全
+
+    // 主线程刷新电参数时, 预先编码4种标志位组合的直发帧
+    void _update_direct_frames(const EleParam_dkd_t &eleparam);
+    // 直发通道的帧源, 在发送线程中调用
+    int _build_direct_frames(struct can_frame *frames);
 #endif
 
 private:
@@ -110,19 +124,35 @@ private:
     mutable std::mutex mutex_;
 
     //! 标志位
+    //! 主线程, 运动线程(直发) 与直发发送线程共用这一组标志位,
+    //! 编码和直发组帧都只从这里读取
     // 高频开关标志位(影响继电器, 切换加工时用)
-    uint8_t highpower_on_flag_ = 0;
+    std::atomic<uint8_t> highpower_on_flag_{0};
 
     // 允许高频标志位(影响电源can帧标志位, 抬刀时切换电压用)
-    uint8_t machpower_flag_ = 1; // 就是mach_bit, dimen是canbuffer里一个bit, 中古用来控制ip输出
+    std::atomic<uint8_t> machpower_flag_{1}; // 就是mach_bit, dimen是canbuffer里一个bit, 中古用来控制ip输出
 
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     // 精加工标志位(发送给IO板标识)
     uint8_t finishing_cut_flag_ = 0;
 
     //! 心跳 16位 9C00 - C3FF
-    // 电参数can帧心跳值
-    uint16_t canframe_pulse_value_ = 0x9C00;
+    // 电参数can帧心跳值 (主线程的Qt通道与直发发送线程共用)
+    std::atomic<uint16_t> canframe_pulse_value_{0x9C00};
+
+    //! 直发通道, 初始化时取得, 运动线程只调用其 trigger
+    can::SocketCanSender::ptr direct_sender_;
+    int direct_source_id_{-1};
+
+    //! 直发缓存, 下标 [highpower * 2 + machbit]
+    //! 主线程写, 直发发送线程读 (运动线程不访问, 锁只在这两个线程之间竞争)
+    struct DirectPowerFrames {
+        std::array<struct can_frame, 2> frames;
+        uint16_t base_sum;
+    };
+    std::array<DirectPowerFrames, 4> direct_frames_;
+    bool direct_frames_valid_{false};
+    std::mutex direct_frames_mutex_;
 #endif
 
     //! decode 缓存
@@ -130,9 +160,12 @@ private:
     bool eleparam_inited_{false};
     EleParam_dkd_t curr_eleparam_;
 
-    // 存储当前的 decode 结果缓存
+    // 存储当前的 decode 结果 (与 decode_cache_ 共享)
     EleparamDecodeResult::ptr curr_result_{nullptr};
 
+    // 各电参数号的 decode 结果缓存
+    EleparamDecodeCache decode_cache_;
+
 #if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
     //! io板发送缓存
     // 存储上一次发送的 伺服参数 结构体
@@ -122,10 +122,11 @@ struct _file_settings {
     std::string interp_module_path_relative_to_root{
         "Src/Interpreter/rs274pyInterpreter/pymodule/"};
     std::string datasave_dir{"Data/"};
+    std::string gcode_cache_dir{"GCodeCache/"}; // 已解析G代码程序的缓存
 
     MEO_JSONIZATION(MEO_OPT coord_config_file, MEO_OPT log_config_file,
                     MEO_OPT qss_file, MEO_OPT power_database_file,
-                    MEO_OPT datasave_dir,
+                    MEO_OPT datasave_dir, MEO_OPT gcode_cache_dir,
                     MEO_OPT interp_module_path_relative_to_root)
 };
 
@@ -138,6 +139,47 @@ struct _time_settings {
                     MEO_OPT monitor_peroid_ms);
 };
 
+// 程序时间预估
+struct _estimate_settings {
+    // G01 名义进给速度, 可由实际加工的平均进给速度校准
+    double g01_feed_mm_min{0.5};
+
+    MEO_JSONIZATION(MEO_OPT g01_feed_mm_min);
+};
+
+// 运动数据事件触发记录 (只在触发时保存前后一段数据)
+struct _event_capture_settings {
+    bool auto_start{false}; // 程序启动时自动开始
+
+    uint32_t pre_trigger_ms{2000}; // 触发前保留时间
+    uint32_t post_trigger_ms{500}; // 触发后继续记录时间
+    uint32_t holdoff_ms{1000};     // 两次事件最小间隔
+
+    uint32_t trigger_mask{0xFFFFFFFF}; // 使能的触发源, 见 move::EventTrigger
+
+    uint32_t short_rate_threshold{60}; // 短路率(%)达到时触发 (zynq伺服板无效)
+    uint32_t following_error_limit{10000}; // 跟随误差(驱动器单位)超过时触发
+
+    MEO_JSONIZATION(MEO_OPT auto_start, MEO_OPT pre_trigger_ms,
+                    MEO_OPT post_trigger_ms, MEO_OPT holdoff_ms,
+                    MEO_OPT trigger_mask, MEO_OPT short_rate_threshold,
+                    MEO_OPT following_error_limit);
+};
+
+// 运动数据实时流 (本机socket, 供外部工具实时绘图分析)
+struct _record_stream_settings {
+    bool enable{false};
+    bool stream_only{false}; // 只发送实时流, 不写记录文件
+
+    // "udp://127.0.0.1:port" 或 "unix:/path/to/socket"
+    std::string data1_address{"udp://127.0.0.1:19001"};
+    std::string data2_address{"udp://127.0.0.1:19002"};
+    std::string channels_address{"udp://127.0.0.1:19003"};
+
+    MEO_JSONIZATION(MEO_OPT enable, MEO_OPT stream_only, MEO_OPT data1_address,
+                    MEO_OPT data2_address, MEO_OPT channels_address);
+};
+
 //#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
 struct _breakout_settings {
     uint32_t voltage_average_filter_window_size{200};
@@ -204,6 +246,12 @@ public: // settings
 
     _time_settings time_settings;
 
+    _estimate_settings estimate_settings;
+
+    _event_capture_settings event_capture_settings;
+
+    _record_stream_settings record_stream_settings;
+
     //#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     _drill_settings drill_settings;
     //#endif
@@ -213,7 +261,9 @@ public: // settings
     MEO_JSONIZATION(MEO_OPT can, ecat, MEO_OPT fast_move_param,
                     MEO_OPT jump_param, MEO_OPT file, MEO_OPT time_settings,
                     MEO_OPT motion_settings, MEO_OPT zynq_settings,
-                    MEO_OPT zynq_adc_settings
+                    MEO_OPT zynq_adc_settings, MEO_OPT estimate_settings,
+                    MEO_OPT event_capture_settings,
+                    MEO_OPT record_stream_settings
                     //#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
                     ,
                     MEO_OPT drill_settings
@@ -303,6 +353,10 @@ public:
         return data_.file.datasave_dir;
     }
 
+    inline const auto &get_gcode_cache_dir() const {
+        return data_.file.gcode_cache_dir;
+    }
+
     uint32_t get_motion_cycle_us() const {
         return data_.time_settings.motion_cycle_us;
     }
@@ -333,6 +387,18 @@ public:
         return data_.zynq_adc_settings;
     }
 
+    inline double get_estimate_g01_feed_mm_min() const {
+        return data_.estimate_settings.g01_feed_mm_min;
+    }
+
+    inline const auto &get_event_capture_settings() const {
+        return data_.event_capture_settings;
+    }
+
+    inline const auto &get_record_stream_settings() const {
+        return data_.record_stream_settings;
+    }
+
     //#if (EDM_POWER_TYPE == EDM_POWER_ZHONGGU_DRILL)
     inline const auto &get_drill_settings() const {
         return data_.drill_settings;
@@ -373,6 +439,10 @@ public:
         data_.jump_param.buffer_um = v;
     }
 
+    inline void set_estimate_g01_feed_mm_min(double v) {
+        data_.estimate_settings.g01_feed_mm_min = v;
+    }
+
     // zynq adc settings change
     inline void
     set_zynq_adc_settings(const _sys::_zynq_adc_settings &zynq_adc_settings) {
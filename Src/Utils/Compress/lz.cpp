@@ -0,0 +1,193 @@
+#include "lz.h"
+
+#include <cstring>
+
+namespace edm {
+
+namespace util {
+
+static constexpr std::size_t s_min_match = 4;
+static constexpr std::size_t s_last_literals = 5; // 末尾必须为字面量
+static constexpr std::size_t s_mf_limit = 12;     // 最后一个匹配的起点限制
+static constexpr std::size_t s_max_offset = 65535;
+
+static constexpr int s_hash_log = 12;
+
+static inline uint32_t _read32(const char *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t _hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - s_hash_log);
+}
+
+static inline char *_write_length(char *op, std::size_t len) {
+    while (len >= 255) {
+        *op++ = (char)255;
+        len -= 255;
+    }
+    *op++ = (char)len;
+    return op;
+}
+
+static inline char *_write_literals(char *op, const char *anchor,
+                                    std::size_t lit_len, uint8_t match_token) {
+    char *token = op++;
+    if (lit_len >= 15) {
+        *token = (char)((15 << 4) | match_token);
+        op = _write_length(op, lit_len - 15);
+    } else {
+        *token = (char)((lit_len << 4) | match_token);
+    }
+
+    std::memcpy(op, anchor, lit_len);
+    return op + lit_len;
+}
+
+std::size_t lz_compress(const char *src, std::size_t src_size, char *dst) {
+    const char *ip = src;
+    const char *anchor = src;
+    const char *const iend = src + src_size;
+    char *op = dst;
+
+    if (src_size >= s_mf_limit + 1) {
+        uint32_t table[1 << s_hash_log];
+        std::memset(table, 0, sizeof(table));
+
+        const char *const mflimit = iend - s_mf_limit;
+        const char *const match_limit = iend - s_last_literals;
+
+        ++ip; // 位置0作为第一个候选
+        while (ip < mflimit) {
+            uint32_t seq = _read32(ip);
+            uint32_t h = _hash(seq);
+            const char *ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+
+            if (ip - ref > (std::ptrdiff_t)s_max_offset || ref >= ip ||
+                _read32(ref) != seq) {
+                ++ip;
+                continue;
+            }
+
+            // 向前扩展匹配
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+
+            // 向后扩展匹配
+            const char *mp = ip + s_min_match;
+            const char *mr = ref + s_min_match;
+            while (mp < match_limit && *mp == *mr) {
+                ++mp;
+                ++mr;
+            }
+
+            std::size_t lit_len = ip - anchor;
+            std::size_t match_len = (mp - ip) - s_min_match;
+
+            uint8_t match_token = match_len >= 15 ? 15 : (uint8_t)match_len;
+            op = _write_literals(op, anchor, lit_len, match_token);
+
+            uint16_t offset = (uint16_t)(ip - ref);
+            *op++ = (char)(offset & 0xFF);
+            *op++ = (char)(offset >> 8);
+
+            if (match_len >= 15) {
+                op = _write_length(op, match_len - 15);
+            }
+
+            ip = mp;
+            anchor = ip;
+
+            if (ip < mflimit) {
+                // 补充匹配末尾附近的位置, 提高后续命中率
+                table[_hash(_read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+            }
+        }
+    }
+
+    // 末尾字面量
+    op = _write_literals(op, anchor, iend - anchor, 0);
+
+    return op - dst;
+}
+
+bool lz_decompress(const char *src, std::size_t src_size, char *dst,
+                   std::size_t dst_size) {
+    const uint8_t *ip = reinterpret_cast<const uint8_t *>(src);
+    const uint8_t *const iend = ip + src_size;
+    char *op = dst;
+    char *const oend = dst + dst_size;
+
+    auto read_length = [&](std::size_t &len) -> bool {
+        uint8_t b;
+        do {
+            if (ip >= iend) {
+                return false;
+            }
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        std::size_t lit_len = token >> 4;
+        if (lit_len == 15 && !read_length(lit_len)) {
+            return false;
+        }
+
+        if (lit_len > (std::size_t)(iend - ip) ||
+            lit_len > (std::size_t)(oend - op)) {
+            return false;
+        }
+
+        std::memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip >= iend) {
+            break; // 最后一个序列只有字面量
+        }
+
+        if (iend - ip < 2) {
+            return false;
+        }
+        std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        std::size_t match_len = token & 0x0F;
+        if (match_len == 15 && !read_length(match_len)) {
+            return false;
+        }
+        match_len += s_min_match;
+
+        if (offset == 0 || offset > (std::size_t)(op - dst) ||
+            match_len > (std::size_t)(oend - op)) {
+            return false;
+        }
+
+        // 可能重叠, 逐字节复制
+        const char *ref = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, ref, match_len);
+            op += match_len;
+        } else {
+            for (std::size_t i = 0; i < match_len; ++i) {
+                *op++ = *ref++;
+            }
+        }
+    }
+
+    return op == oend;
+}
+
+} // namespace util
+
+} // namespace edm
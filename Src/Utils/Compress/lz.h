@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace edm {
+
+namespace util {
+
+// LZ4 block 格式的快速无损压缩 (单线程, 无外部依赖)
+// 只实现 block 格式 (无 frame 头), 输出可被标准 LZ4_decompress_safe 解压
+
+// 最坏情况下的压缩输出大小
+inline constexpr std::size_t lz_compress_bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+// 压缩 src 到 dst, dst 容量至少为 lz_compress_bound(src_size)
+// 返回压缩后的字节数
+std::size_t lz_compress(const char *src, std::size_t src_size, char *dst);
+
+// 解压到 dst, 要求解压结果恰好为 dst_size 字节, 输入损坏时返回false
+bool lz_decompress(const char *src, std::size_t src_size, char *dst,
+                   std::size_t dst_size);
+
+} // namespace util
+
+} // namespace edm
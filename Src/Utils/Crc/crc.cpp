@@ -1,5 +1,7 @@
 #include "crc.h"
 
+#include <array>
+
 namespace edm {
 
 namespace util {
@@ -98,6 +100,28 @@ uint16_t tcp_crc_table_calc(const uint8_t *ptr, int len) {
     return crc;
 }
 
+// CRC-32 Table (reflected, poly 0xEDB88320), 编译期生成
+static constexpr auto s_crc32_table = []() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        table[i] = c;
+    }
+    return table;
+}();
+
+uint32_t crc32_table_calc(const uint8_t *ptr, std::size_t len, uint32_t crc) {
+    crc = ~crc;
+    while (len--) {
+        crc = s_crc32_table[(crc ^ *ptr++) & 0xff] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
 }
 
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace edm {
@@ -12,6 +13,11 @@ uint16_t modbus_crc_table_calc(const uint8_t *ptr, int len);
 // Tcp Use
 uint16_t tcp_crc_table_calc(const uint8_t *ptr, int len);
 
+// CRC-32 (IEEE 802.3), 用于记录文件分块校验
+// crc 传入上一次的返回值可以分段计算
+uint32_t crc32_table_calc(const uint8_t *ptr, std::size_t len,
+                          uint32_t crc = 0);
+
 }
 
 }
\ No newline at end of file
@@ -3,32 +3,38 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
-#include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "Exception/exception.h"
 #include "Utils/Format/edm_format.h"
 #include "config.h"
 
+#include "RecordFile.h"
+#include "RecordStream.h"
+
 namespace edm {
 
 namespace util {
 
+// CacheSize: 队列预留的记录数, 避免运动线程push时分配内存
 template <typename DataType, int CacheSize = 1000>
 class DataQueueRecorder final {
+    static_assert(std::is_trivially_copyable_v<DataType>,
+                  "DataType is written to file as raw bytes");
+
 public:
     using ptr = std::shared_ptr<DataQueueRecorder<DataType, CacheSize>>;
     DataQueueRecorder() {
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-        data_cache_.reserve(CacheSize);
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
+        data_queue_.reserve(CacheSize);
+        write_queue_.reserve(CacheSize);
     }
 
     ~DataQueueRecorder() {
@@ -40,7 +46,22 @@ public:
         }
     }
 
-    inline bool start_record(std::string_view filename) {
+    // 实时记录流, 记录线程每次写文件时同时发送; 仅在未运行时设置
+    inline bool set_stream_publisher(RecordStreamPublisher::ptr stream) {
+        std::lock_guard lg(mutex_);
+        if (running_flag_) {
+            return false;
+        }
+
+        stream_ = std::move(stream);
+        return true;
+    }
+
+    // schema 描述 DataType 的字段, 写入文件头, 解码时不依赖结构体布局
+    // filename 为空时不写文件, 只发送实时流 (需已设置stream)
+    inline bool start_record(std::string_view filename,
+                             const RecordSchema &schema,
+                             const RecordFileInfo &info = {}) {
         std::lock_guard lg(mutex_);
         if (running_flag_) {
             return false;
@@ -50,23 +71,29 @@ public:
             thread_.join(); // 释放上一个线程的资源, 这里应当会立刻返回
         }
 
+        if (schema.record_size() != sizeof(DataType)) {
+            return false;
+        }
+
+        const bool has_stream = stream_ && stream_->is_open();
+        if (filename.empty() && !has_stream) {
+            return false;
+        }
+
         filename_ = filename;
 
-        // init file ostream
-        ofs.open(filename_, std::ios::binary | std::ios::trunc | std::ios::out);
-        if (!ofs.is_open()) {
+        // init file writer (写入文件头)
+        if (!filename_.empty() && !writer_.open(filename_, schema, info)) {
             return false;
         }
 
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-        // clear cache
-        data_cache_.clear();
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
+        if (has_stream) {
+            stream_->begin(schema, info);
+        }
 
         // clear queue
-        while (!data_queue_.empty()) {
-            data_queue_.pop();
-        }
+        data_queue_.clear();
+        write_queue_.clear();
 
         // clear stop flag
         stop_flag_ = false;
@@ -85,7 +112,7 @@ public:
         }
 
         std::lock_guard lg(mutex_);
-        data_queue_.push(data);
+        data_queue_.push_back(data);
         cv_.notify_all();
     }
 
@@ -96,7 +123,7 @@ public:
         }
 
         std::lock_guard lg(mutex_);
-        data_queue_.emplace(std::forward<_Args>(__args)...);
+        data_queue_.emplace_back(std::forward<_Args>(__args)...);
         cv_.notify_all();
     }
 
@@ -106,7 +133,7 @@ public:
             stop_flag_ = true;
             cv_.notify_all();
         }
-        
+
         if (wait_for_stopped && thread_.joinable()) {
             thread_.join();
         }
@@ -114,85 +141,60 @@ public:
 
     inline bool is_running() const { return running_flag_; }
 
+    // 上一次记录是否因写文件失败而中止 (is_running() 为false之后有效)
+    inline bool is_write_failed() const { return writer_.write_failed(); }
+
 private:
     static inline void _ThreadEntry(DataQueueRecorder *dqr) { dqr->_run(); }
 
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-    inline void _flush_cache() {
-        ofs.write((char *)(data_cache_.data()),
-                  data_cache_.size() * sizeof(DataType));
-        data_cache_.clear();
-    }
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
-
-    inline void _flush_and_close_file() {
-        if (ofs.is_open()) {
-
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-            if (!data_cache_.empty()) {
-                _flush_cache();
-            }
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
-
-            ofs.flush();
-            ofs.close();
-        }
-    }
-
     inline void _run() {
         running_flag_ = true;
 
-        DataType fetched_data;
-        while (!stop_flag_) {
-            bool queue_flag = 0;
+        while (true) {
+            bool stop = false;
             {
                 std::unique_lock ul(mutex_);
                 cv_.wait(ul, [this]() -> bool {
                     return this->stop_flag_ || !this->data_queue_.empty();
                 });
 
-                if (!data_queue_.empty()) {
-                    fetched_data = data_queue_.front();
-                    data_queue_.pop();
-                    queue_flag = true;
-                }
+                // 一次取走队列中的全部数据, 减少加锁次数
+                data_queue_.swap(write_queue_);
+                stop = stop_flag_;
             }
 
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-            assert(data_cache_.size() < data_cache_.capacity());
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
-
-            if (queue_flag) {
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-                data_cache_.push_back(fetched_data);
+            if (!write_queue_.empty()) {
+                // 写入器缓存到整块后一次性对齐写入
+                // 写文件失败 (磁盘满等) 时停止记录, 写入器中已记录日志
+                if (writer_.is_open() &&
+                    !writer_.append(write_queue_.data(), write_queue_.size())) {
+                    stop = true;
+                }
 
-                if (data_cache_.size() >= data_cache_.capacity()) {
-                    _flush_cache();
+                if (stream_) {
+                    stream_->publish(write_queue_.data(), write_queue_.size());
                 }
-#else  // EDM_DATAQUEUERECORDER_ENABLE_CACHE
-                ofs.write((char *)&fetched_data, sizeof(fetched_data));
-#endif // EDM_DATAQUEUERECORDER_ENABLE_CACHE
+
+                write_queue_.clear();
             }
 
-            if (stop_flag_) {
+            if (stop) {
                 break;
             }
         }
 
-        _flush_and_close_file();
+        writer_.close();
 
         running_flag_ = false;
     }
 
 private:
     std::string filename_;
-    std::ofstream ofs;
-    std::queue<DataType> data_queue_;
+    RecordFileWriter writer_;
+    RecordStreamPublisher::ptr stream_;
 
-#ifdef EDM_DATAQUEUERECORDER_ENABLE_CACHE
-    std::vector<DataType>
-        data_cache_; // 缓存从队列中写入的数据, 缓存区到达一定数目后一次性写入
-#endif               // EDM_DATAQUEUERECORDER_ENABLE_CACHE
+    std::vector<DataType> data_queue_;  // 运动线程写入
+    std::vector<DataType> write_queue_; // 记录线程取出后写入文件
 
     std::mutex mutex_;
     std::condition_variable cv_;
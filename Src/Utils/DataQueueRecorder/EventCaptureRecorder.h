@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RecordFile.h"
+
+namespace edm {
+
+namespace util {
+
+/**
+ * 事件触发记录器 (pre-trigger capture):
+ * 运动线程每周期push一条记录到内存环形缓冲, 始终保留最近 pre_count 条;
+ * 某周期给出非0的触发位后, 再记录 post_count 条, 然后冻结整个窗口,
+ * 交给后台线程写成一个独立的记录文件. 正常加工期间没有磁盘IO.
+ *
+ * - 两块环形缓冲交替使用, 冻结时只交换指针, push中不分配内存也不阻塞
+ * - 后台线程仍在写上一个事件时, 新事件被丢弃 (计数)
+ */
+template <typename DataType> class EventCaptureRecorder final {
+    static_assert(std::is_trivially_copyable_v<DataType>,
+                  "DataType is written to file as raw bytes");
+
+public:
+    using ptr = std::shared_ptr<EventCaptureRecorder<DataType>>;
+
+    // 在后台线程中调用, 根据触发位生成文件名和文件信息, 返回false则不写文件
+    using EventFileGenerator = std::function<bool(
+        uint32_t trigger_bits, std::string &filename, RecordFileInfo &info)>;
+
+    EventCaptureRecorder() = default;
+    ~EventCaptureRecorder() { stop_capture(); }
+
+    EventCaptureRecorder(const EventCaptureRecorder &) = delete;
+    EventCaptureRecorder &operator=(const EventCaptureRecorder &) = delete;
+
+    // pre_count: 触发前保留的记录数 (包含触发周期)
+    // post_count: 触发后继续记录的记录数
+    // holdoff_count: 一个事件写出后, 至少间隔多少条记录才接受下一次触发
+    inline bool start_capture(const RecordSchema &schema, uint32_t pre_count,
+                              uint32_t post_count, uint32_t holdoff_count,
+                              EventFileGenerator file_generator) {
+        std::lock_guard lg(mutex_);
+        if (running_flag_) {
+            return false;
+        }
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+
+        if (schema.record_size() != sizeof(DataType) || pre_count == 0 ||
+            !file_generator) {
+            return false;
+        }
+
+        schema_ = schema;
+        post_count_ = post_count;
+        holdoff_count_ = holdoff_count;
+        file_generator_ = std::move(file_generator);
+
+        // 预分配, 运行中不再分配内存
+        const std::size_t capacity = (std::size_t)pre_count + post_count;
+        active_ = std::make_unique<_Window>(capacity);
+        free_ = std::make_unique<_Window>(capacity);
+        pending_.reset();
+
+        post_remaining_ = 0;
+        holdoff_remaining_ = 0;
+        capturing_ = false;
+        dropped_count_ = 0;
+        saved_count_ = 0;
+
+        stop_flag_ = false;
+        thread_ = std::thread(_ThreadEntry, this);
+
+        session_.fetch_add(1, std::memory_order_relaxed);
+        running_flag_ = true;
+
+        return true;
+    }
+
+    inline void stop_capture() {
+        running_flag_ = false; // 运动线程不再push
+
+        // 等待运动线程离开 push_data, 之后缓冲才能被释放或重新分配
+        while (in_push_.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        {
+            std::lock_guard lg(mutex_);
+            stop_flag_ = true;
+            cv_.notify_all();
+        }
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    inline bool is_running() const { return running_flag_; }
+
+    // 每次 start_capture 加1, 运动线程据此判断是否是新开始的记录
+    inline uint32_t session() const {
+        return session_.load(std::memory_order_relaxed);
+    }
+
+    // 运动线程调用, trigger_bits 非0表示本周期触发
+    //! in_push_ 与 running_flag_ 均为 seq_cst: 先置 in_push_ 再检查 running_flag_,
+    //! stop_capture 先清 running_flag_ 再等待 in_push_, 两边不会同时错过
+    inline void push_data(const DataType &data, uint32_t trigger_bits) {
+        in_push_.store(true);
+        if (running_flag_) [[likely]] {
+            _push_data(data, trigger_bits);
+        }
+        in_push_.store(false, std::memory_order_release);
+    }
+
+    inline auto dropped_count() const { return dropped_count_.load(); }
+    inline auto saved_count() const { return saved_count_.load(); }
+
+private:
+    inline void _push_data(const DataType &data, uint32_t trigger_bits) {
+        active_->push(data);
+
+        if (holdoff_remaining_ > 0) {
+            --holdoff_remaining_;
+            trigger_bits = 0;
+        }
+
+        if (capturing_) {
+            // 窗口内的后续触发一并记录
+            active_->trigger_bits |= trigger_bits;
+            --post_remaining_;
+        } else if (trigger_bits != 0) [[unlikely]] {
+            capturing_ = true;
+            post_remaining_ = post_count_;
+            active_->trigger_bits = trigger_bits;
+        } else {
+            return;
+        }
+
+        if (post_remaining_ > 0) {
+            return;
+        }
+
+        _freeze();
+    }
+
+    struct _Window {
+        explicit _Window(std::size_t capacity) : ring(capacity) {}
+
+        inline void push(const DataType &data) {
+            ring[head] = data;
+            if (++head == ring.size()) {
+                head = 0;
+            }
+            if (count < ring.size()) {
+                ++count;
+            }
+        }
+
+        inline void reset() {
+            head = 0;
+            count = 0;
+            trigger_bits = 0;
+        }
+
+        std::vector<DataType> ring;
+        std::size_t head{0};  // 下一条写入位置
+        std::size_t count{0}; // 有效记录数
+        uint32_t trigger_bits{0};
+    };
+
+    // 冻结当前窗口, 交给后台线程; 不阻塞运动线程
+    inline void _freeze() {
+        capturing_ = false;
+        holdoff_remaining_ = holdoff_count_;
+
+        std::unique_lock ul(mutex_, std::try_to_lock);
+        if (!ul.owns_lock() || !free_) {
+            // 后台线程忙, 丢弃本次事件, 保留当前缓冲继续记录
+            ++dropped_count_;
+            active_->trigger_bits = 0;
+            return;
+        }
+
+        pending_ = std::move(active_);
+        active_ = std::move(free_);
+        active_->reset();
+
+        cv_.notify_all();
+    }
+
+    static inline void _ThreadEntry(EventCaptureRecorder *ecr) { ecr->_run(); }
+
+    inline void _run() {
+        while (true) {
+            std::unique_ptr<_Window> window;
+            {
+                std::unique_lock ul(mutex_);
+                cv_.wait(ul, [this]() { return stop_flag_ || pending_; });
+
+                if (!pending_) {
+                    break; // stop
+                }
+
+                window = std::move(pending_);
+            }
+
+            _write_window(*window);
+
+            {
+                std::lock_guard lg(mutex_);
+                free_ = std::move(window);
+            }
+        }
+    }
+
+    inline void _write_window(const _Window &window) {
+        std::string filename;
+        RecordFileInfo info;
+        if (!file_generator_(window.trigger_bits, filename, info)) {
+            return;
+        }
+
+        RecordFileWriter writer;
+        if (!writer.open(filename, schema_, info)) {
+            return;
+        }
+
+        // 按时间顺序写出: 环形缓冲中最旧的记录在 head (已写满时)
+        const auto &ring = window.ring;
+        std::size_t begin = window.count < ring.size() ? 0 : window.head;
+        std::size_t first_len = std::min(window.count, ring.size() - begin);
+
+        // 写文件失败时写入器中已记录日志, 不计入已保存
+        if (!writer.append(ring.data() + begin, first_len) ||
+            !writer.append(ring.data(), window.count - first_len) ||
+            !writer.close()) {
+            return;
+        }
+
+        ++saved_count_;
+    }
+
+private:
+    RecordSchema schema_;
+    uint32_t post_count_{0};
+    uint32_t holdoff_count_{0};
+    EventFileGenerator file_generator_;
+
+    // 以下仅运动线程访问
+    std::unique_ptr<_Window> active_;
+    uint32_t post_remaining_{0};
+    uint32_t holdoff_remaining_{0};
+    bool capturing_{false};
+
+    // 以下由 mutex_ 保护
+    std::unique_ptr<_Window> free_;
+    std::unique_ptr<_Window> pending_;
+
+    std::atomic_uint32_t dropped_count_{0};
+    std::atomic_uint32_t saved_count_{0};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_flag_{false};
+    std::atomic_bool running_flag_{false};
+    std::atomic_uint32_t session_{0};
+    std::atomic_bool in_push_{false}; // 运动线程正在 push_data 中
+};
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,198 @@
+#include "RecordChannel.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace edm {
+
+namespace util {
+
+RecordChannelRegistry::ChannelId
+RecordChannelRegistry::register_channel(std::string_view name,
+                                        RecordFieldType type) {
+    auto id = find(name);
+    if (id != InvalidChannel) {
+        return channels_[id].type == type ? id : InvalidChannel;
+    }
+
+    if (RecordFieldTypeSize(type) == 0 ||
+        name.size() >= sizeof(RecordFieldDesc::name)) {
+        return InvalidChannel;
+    }
+
+    channels_.push_back(Channel{std::string{name}, type});
+    slots_.push_back(0);
+
+    return channels_.size() - 1;
+}
+
+RecordChannelRegistry::ChannelId
+RecordChannelRegistry::find(std::string_view name) const {
+    for (std::size_t i = 0; i < channels_.size(); ++i) {
+        if (channels_[i].name == name) {
+            return i;
+        }
+    }
+
+    return InvalidChannel;
+}
+
+bool RecordChannelSampler::init(const RecordChannelRegistry &registry,
+                                const RecordChannelSelection &selection,
+                                std::string_view name) {
+    columns_.clear();
+    row_decimation_ = std::numeric_limits<uint32_t>::max();
+
+    uint32_t offset = sizeof(uint64_t); // tick_us
+    for (const auto &item : selection.items) {
+        auto id = registry.find(item.name);
+        if (id == RecordChannelRegistry::InvalidChannel) {
+            continue;
+        }
+
+        auto size = RecordFieldTypeSize(registry.channels()[id].type);
+        auto decimation = std::max<uint32_t>(1, item.decimation);
+
+        columns_.push_back(_Column{id, offset, (uint32_t)size, decimation});
+        row_decimation_ = std::min(row_decimation_, decimation);
+        offset += size;
+    }
+
+    if (columns_.empty()) {
+        row_decimation_ = 1;
+        return false;
+    }
+
+    schema_ = RecordSchema{name, offset};
+    schema_.add_field("tick_us", RecordFieldType::U64, 0);
+    for (const auto &c : columns_) {
+        const auto &ch = registry.channels()[c.id];
+        schema_.add_field(ch.name, ch.type, c.offset);
+    }
+
+    row_.assign(offset, 0);
+
+    return true;
+}
+
+RecordChannelRecorder::~RecordChannelRecorder() { stop_record(true); }
+
+bool RecordChannelRecorder::set_stream_publisher(
+    RecordStreamPublisher::ptr stream) {
+    std::lock_guard lg(mutex_);
+    if (running_flag_) {
+        return false;
+    }
+
+    stream_ = std::move(stream);
+    return true;
+}
+
+bool RecordChannelRecorder::start_record(
+    std::string_view filename, RecordChannelRegistry::ptr registry,
+    const RecordChannelSelection &selection, const RecordFileInfo &info) {
+    std::lock_guard lg(mutex_);
+    if (running_flag_) {
+        return false;
+    }
+
+    if (thread_.joinable()) {
+        thread_.join(); // 释放上一个线程的资源
+    }
+
+    if (!registry ||
+        !sampler_.init(*registry, selection, "channels")) {
+        return false;
+    }
+
+    const bool has_stream = stream_ && stream_->is_open();
+    if (filename.empty() && !has_stream) {
+        return false;
+    }
+
+    if (!filename.empty() &&
+        !writer_.open(std::string{filename}, sampler_.schema(), info)) {
+        return false;
+    }
+
+    if (has_stream) {
+        stream_->begin(sampler_.schema(), info);
+    }
+
+    registry_ = std::move(registry);
+    cycle_ = 0;
+
+    const auto queue_bytes = CacheSize * sampler_.record_size();
+    data_queue_.clear();
+    write_queue_.clear();
+    data_queue_.reserve(queue_bytes);
+    write_queue_.reserve(queue_bytes);
+
+    stop_flag_ = false;
+    thread_ = std::thread(_ThreadEntry, this);
+
+    running_flag_ = true;
+
+    return true;
+}
+
+void RecordChannelRecorder::stop_record(bool wait_for_stopped) {
+    {
+        std::lock_guard lg(mutex_);
+        stop_flag_ = true;
+        cv_.notify_all();
+    }
+
+    if (wait_for_stopped && thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void RecordChannelRecorder::_run() {
+    const auto record_size = sampler_.record_size();
+
+    while (true) {
+        bool stop = false;
+        {
+            std::unique_lock ul(mutex_);
+            cv_.wait(ul, [this]() -> bool {
+                return this->stop_flag_ || !this->data_queue_.empty();
+            });
+
+            data_queue_.swap(write_queue_);
+            stop = stop_flag_;
+        }
+
+        if (!write_queue_.empty()) {
+            const auto count = write_queue_.size() / record_size;
+            // 写文件失败 (磁盘满等) 时停止记录, 写入器中已记录日志
+            if (writer_.is_open() &&
+                !writer_.append(write_queue_.data(), count)) {
+                stop = true;
+            }
+
+            if (stream_) {
+                stream_->publish(write_queue_.data(), count);
+            }
+
+            write_queue_.clear();
+        }
+
+        if (stop) {
+            break;
+        }
+    }
+
+    writer_.close();
+
+    running_flag_ = false;
+
+    // 等待运动线程离开 push_cycle, 之后 start_record 才能重新初始化采样器
+    while (in_push_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RecordFile.h"
+#include "RecordStream.h"
+
+namespace edm {
+
+namespace util {
+
+/**
+ * 记录通道注册表:
+ * 各模块在初始化时按名称注册信号, 每个通道占一个8字节槽位;
+ * 运动线程每周期把当前值 publish 到槽位, 由记录器按用户选择的通道采样打包.
+ *
+ * - 注册只能在运动线程启动前进行 (槽位表不再重新分配)
+ * - publish 只是一次定长拷贝, 不检查类型, 调用方使用注册时的类型
+ */
+class RecordChannelRegistry final {
+public:
+    using ptr = std::shared_ptr<RecordChannelRegistry>;
+    using ChannelId = uint32_t;
+
+    static constexpr ChannelId InvalidChannel = 0xFFFFFFFF;
+
+    struct Channel {
+        std::string name;
+        RecordFieldType type;
+    };
+
+    // 注册通道, 名称已存在时返回已有的id (类型不一致时返回InvalidChannel)
+    ChannelId register_channel(std::string_view name, RecordFieldType type);
+
+    template <typename T> inline ChannelId register_channel(std::string_view name) {
+        return register_channel(name, RecordFieldTypeOf<std::remove_cv_t<T>>::value);
+    }
+
+    // 注册数组通道 name0, name1, ..., 返回第一个通道的id (id连续)
+    template <typename T, std::size_t N>
+    inline ChannelId register_array_channel(std::string_view name) {
+        ChannelId first = InvalidChannel;
+        for (std::size_t i = 0; i < N; ++i) {
+            auto id = register_channel<T>(std::string{name} + std::to_string(i));
+            if (i == 0) {
+                first = id;
+            } else if (id != first + i) {
+                return InvalidChannel; // 与已有通道交错, 不能按连续id发布
+            }
+        }
+        return first;
+    }
+
+    ChannelId find(std::string_view name) const;
+
+    inline const auto &channels() const { return channels_; }
+    inline std::size_t channel_count() const { return channels_.size(); }
+
+    template <typename T> inline void publish(ChannelId id, T value) {
+        static_assert(sizeof(T) <= sizeof(uint64_t));
+        assert(id < slots_.size());
+        std::memcpy(&slots_[id], &value, sizeof(T));
+    }
+
+    template <typename T, std::size_t N>
+    inline void publish_array(ChannelId first, const std::array<T, N> &values) {
+        for (std::size_t i = 0; i < N; ++i) {
+            publish<T>(first + i, values[i]);
+        }
+    }
+
+    inline const char *slot(ChannelId id) const {
+        return reinterpret_cast<const char *>(&slots_[id]);
+    }
+
+private:
+    std::vector<Channel> channels_;
+    std::vector<uint64_t> slots_;
+};
+
+// 用户选择的通道及其抽取系数 (每 decimation 个周期采样一次)
+struct RecordChannelSelection {
+    struct Item {
+        std::string name;
+        uint32_t decimation{1};
+    };
+
+    std::vector<Item> items;
+};
+
+/**
+ * 按选择的通道从槽位表采样, 打包为紧凑的记录:
+ * | tick_us (u64) | 通道1 | 通道2 | ... |  (按类型大小紧密排列)
+ *
+ * 记录每 min(decimation) 个周期输出一条; 抽取系数更大的通道在非采样周期
+ * 保持上一次的值 (配合 Delta 编码几乎不占空间)
+ */
+class RecordChannelSampler final {
+public:
+    // 选择中不存在的通道会被忽略, 无有效通道时返回false
+    bool init(const RecordChannelRegistry &registry,
+              const RecordChannelSelection &selection, std::string_view name);
+
+    inline const auto &schema() const { return schema_; }
+    inline auto record_size() const { return schema_.record_size(); }
+
+    // 运动线程调用, 本周期需要输出记录时返回打包后的记录, 否则返回nullptr
+    inline const char *sample(const RecordChannelRegistry &registry,
+                              uint64_t cycle, uint64_t tick_us) {
+        bool row_due = cycle % row_decimation_ == 0;
+
+        for (const auto &c : columns_) {
+            if (cycle % c.decimation == 0) {
+                std::memcpy(row_.data() + c.offset, registry.slot(c.id),
+                            c.size);
+            }
+        }
+
+        if (!row_due) {
+            return nullptr;
+        }
+
+        std::memcpy(row_.data(), &tick_us, sizeof(tick_us));
+        return row_.data();
+    }
+
+private:
+    struct _Column {
+        RecordChannelRegistry::ChannelId id;
+        uint32_t offset;
+        uint32_t size;
+        uint32_t decimation;
+    };
+
+    std::vector<_Column> columns_;
+    uint32_t row_decimation_{1};
+
+    RecordSchema schema_;
+    std::vector<char> row_;
+};
+
+/**
+ * 通道记录器: 与 DataQueueRecorder 相同的双队列写线程, 记录内容为
+ * RecordChannelSampler 打包的变长(运行时确定)记录, 文件头中保存所选通道
+ */
+class RecordChannelRecorder final {
+public:
+    using ptr = std::shared_ptr<RecordChannelRecorder>;
+
+    // CacheSize: 队列预留的记录数, 避免运动线程push时分配内存
+    static constexpr std::size_t CacheSize = 1000;
+
+    RecordChannelRecorder() = default;
+    ~RecordChannelRecorder();
+
+    RecordChannelRecorder(const RecordChannelRecorder &) = delete;
+    RecordChannelRecorder &operator=(const RecordChannelRecorder &) = delete;
+
+    // 实时记录流, 仅在未运行时设置
+    bool set_stream_publisher(RecordStreamPublisher::ptr stream);
+
+    // registry 需在记录期间保持有效, 且不再注册新通道
+    // filename 为空时不写文件, 只发送实时流 (需已设置stream)
+    bool start_record(std::string_view filename,
+                      RecordChannelRegistry::ptr registry,
+                      const RecordChannelSelection &selection,
+                      const RecordFileInfo &info = {});
+
+    void stop_record(bool wait_for_stopped = false);
+
+    inline bool is_running() const { return running_flag_; }
+
+    // 上一次记录是否因写文件失败而中止 (is_running() 为false之后有效)
+    inline bool is_write_failed() const { return writer_.write_failed(); }
+
+    // 运动线程每周期调用一次 (各通道已publish本周期的值)
+    //! in_push_ 与 running_flag_ 均为 seq_cst: 先置 in_push_ 再检查 running_flag_;
+    //! 记录线程退出前清 running_flag_ 并等待 in_push_ 清除, start_record 先 join
+    //! 记录线程再重新初始化 sampler_/registry_, 因此不会与这里并发
+    inline void push_cycle(uint64_t tick_us) {
+        in_push_.store(true);
+        if (running_flag_) [[likely]] {
+            _push_cycle(tick_us);
+        }
+        in_push_.store(false, std::memory_order_release);
+    }
+
+private:
+    inline void _push_cycle(uint64_t tick_us) {
+        auto record = sampler_.sample(*registry_, cycle_++, tick_us);
+        if (!record) {
+            return;
+        }
+
+        std::lock_guard lg(mutex_);
+        data_queue_.insert(data_queue_.end(), record,
+                           record + sampler_.record_size());
+        cv_.notify_all();
+    }
+
+    static inline void _ThreadEntry(RecordChannelRecorder *rcr) { rcr->_run(); }
+
+    void _run();
+
+private:
+    RecordChannelRegistry::ptr registry_;
+    RecordChannelSampler sampler_;
+    uint64_t cycle_{0}; // 仅运动线程访问
+
+    RecordFileWriter writer_;
+    RecordStreamPublisher::ptr stream_;
+
+    std::vector<char> data_queue_;  // 运动线程写入
+    std::vector<char> write_queue_; // 记录线程取出后写入文件
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    std::atomic_bool stop_flag_{false};
+    std::atomic_bool running_flag_{false};
+    std::atomic_bool in_push_{false}; // 运动线程正在 push_cycle 中
+};
+
+} // namespace util
+
+} // namespace edm
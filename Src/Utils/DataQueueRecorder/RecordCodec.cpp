@@ -0,0 +1,300 @@
+#include "RecordCodec.h"
+
+#include "Utils/Compress/lz.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace edm {
+
+namespace util {
+
+enum _ColumnMode : uint8_t {
+    _ColumnMode_Delta = 0,
+    _ColumnMode_Raw = 1,
+};
+
+// 定点数的范围限制, 保证差值不溢出
+static constexpr double s_fixed_point_limit = 4.0e18;
+
+static inline uint64_t _zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t _unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline void _put_varint(std::vector<char> &out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((char)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((char)v);
+}
+
+static inline bool _get_varint(const char *&p, const char *end, uint64_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) {
+            return false;
+        }
+        uint8_t b = (uint8_t)*p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool _is_float(RecordFieldType type) {
+    return type == RecordFieldType::F32 || type == RecordFieldType::F64;
+}
+
+static inline double _pow10(uint8_t decimals) {
+    return std::pow(10.0, decimals);
+}
+
+// 整数字段读为64位 (按类型符号扩展)
+static inline uint64_t _load_int(const char *p, RecordFieldType type) {
+    switch (type) {
+    case RecordFieldType::Bool:
+    case RecordFieldType::U8:
+        return *(const uint8_t *)p;
+    case RecordFieldType::I8:
+        return (uint64_t)(int64_t) * (const int8_t *)p;
+    case RecordFieldType::U16: {
+        uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    case RecordFieldType::I16: {
+        int16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return (uint64_t)(int64_t)v;
+    }
+    case RecordFieldType::U32: {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    case RecordFieldType::I32: {
+        int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return (uint64_t)(int64_t)v;
+    }
+    default: {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    }
+}
+
+static inline void _store_int(char *p, RecordFieldType type, uint64_t v) {
+    // 小端, 直接截取低位
+    std::memcpy(p, &v, RecordFieldTypeSize(type));
+}
+
+static inline double _load_float(const char *p, RecordFieldType type) {
+    if (type == RecordFieldType::F32) {
+        float v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    double v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void _store_float(char *p, RecordFieldType type, double v) {
+    if (type == RecordFieldType::F32) {
+        float f = (float)v;
+        std::memcpy(p, &f, sizeof(f));
+    } else {
+        std::memcpy(p, &v, sizeof(v));
+    }
+}
+
+void RecordBlockCodec::_delta_encode(const char *records, uint32_t count,
+                                     std::vector<char> &out) const {
+    const auto record_size = schema_.record_size();
+
+    for (const auto &f : schema_.fields()) {
+        const auto field_size = RecordFieldTypeSize(f.type);
+        const bool is_float = _is_float(f.type);
+        const double scale = is_float ? _pow10(f.decimals) : 1.0;
+
+        // 浮点数: 检查能否全部转为定点数
+        bool raw = is_float && f.decimals == 0;
+        for (uint32_t i = 0; is_float && !raw && i < count; ++i) {
+            double v = _load_float(records + (std::size_t)i * record_size +
+                                       f.offset,
+                                   f.type) *
+                       scale;
+            if (!std::isfinite(v) || std::fabs(v) >= s_fixed_point_limit) {
+                raw = true;
+            }
+        }
+
+        if (raw) {
+            out.push_back((char)_ColumnMode_Raw);
+            for (uint32_t i = 0; i < count; ++i) {
+                const char *p =
+                    records + (std::size_t)i * record_size + f.offset;
+                out.insert(out.end(), p, p + field_size);
+            }
+            continue;
+        }
+
+        out.push_back((char)_ColumnMode_Delta);
+
+        uint64_t prev = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const char *p = records + (std::size_t)i * record_size + f.offset;
+
+            uint64_t v;
+            if (is_float) {
+                v = (uint64_t)std::llround(_load_float(p, f.type) * scale);
+            } else {
+                v = _load_int(p, f.type);
+            }
+
+            _put_varint(out, _zigzag((int64_t)(v - prev)));
+            prev = v;
+        }
+    }
+}
+
+bool RecordBlockCodec::_delta_decode(const char *data, std::size_t size,
+                                     uint32_t count, char *records) const {
+    const auto record_size = schema_.record_size();
+    const char *p = data;
+    const char *const end = data + size;
+
+    std::memset(records, 0, (std::size_t)count * record_size);
+
+    for (const auto &f : schema_.fields()) {
+        const auto field_size = RecordFieldTypeSize(f.type);
+
+        if (p >= end) {
+            return false;
+        }
+        uint8_t mode = (uint8_t)*p++;
+
+        if (mode == _ColumnMode_Raw) {
+            if ((std::size_t)(end - p) < (std::size_t)count * field_size) {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                std::memcpy(records + (std::size_t)i * record_size + f.offset,
+                            p, field_size);
+                p += field_size;
+            }
+            continue;
+        }
+
+        if (mode != _ColumnMode_Delta) {
+            return false;
+        }
+
+        const bool is_float = _is_float(f.type);
+        const double scale = is_float ? _pow10(f.decimals) : 1.0;
+
+        uint64_t prev = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint64_t zz;
+            if (!_get_varint(p, end, zz)) {
+                return false;
+            }
+
+            uint64_t v = prev + (uint64_t)_unzigzag(zz);
+            prev = v;
+
+            char *dst = records + (std::size_t)i * record_size + f.offset;
+            if (is_float) {
+                _store_float(dst, f.type, (double)(int64_t)v / scale);
+            } else {
+                _store_int(dst, f.type, v);
+            }
+        }
+    }
+
+    return p == end;
+}
+
+bool RecordBlockCodec::encode(RecordCodec codec, const char *records,
+                              uint32_t count, std::vector<char> &out) {
+    const std::size_t raw_size = (std::size_t)count * schema_.record_size();
+
+    out.clear();
+
+    switch (codec) {
+    case RecordCodec::Delta:
+        _delta_encode(records, count, out);
+        break;
+    case RecordCodec::DeltaLz: {
+        buffer_.clear();
+        _delta_encode(records, count, buffer_);
+
+        // 前4字节保存 Delta 结果的长度, 用于解压
+        uint32_t delta_size = buffer_.size();
+        out.resize(sizeof(delta_size) + lz_compress_bound(delta_size));
+        std::memcpy(out.data(), &delta_size, sizeof(delta_size));
+        auto n = lz_compress(buffer_.data(), delta_size,
+                             out.data() + sizeof(delta_size));
+        out.resize(sizeof(delta_size) + n);
+        break;
+    }
+    default:
+        return false;
+    }
+
+    return out.size() < raw_size;
+}
+
+bool RecordBlockCodec::decode(RecordCodec codec, const char *data,
+                              std::size_t size, uint32_t count,
+                              std::vector<char> &records) {
+    records.resize((std::size_t)count * schema_.record_size());
+
+    switch (codec) {
+    case RecordCodec::None:
+        if (size != records.size()) {
+            return false;
+        }
+        std::memcpy(records.data(), data, size);
+        return true;
+    case RecordCodec::Delta:
+        return _delta_decode(data, size, count, records.data());
+    case RecordCodec::DeltaLz: {
+        uint32_t delta_size;
+        if (size < sizeof(delta_size)) {
+            return false;
+        }
+        std::memcpy(&delta_size, data, sizeof(delta_size));
+
+        // 每个值的varint至多10字节, 再加每列的模式字节
+        if (delta_size > (std::size_t)count * schema_.fields().size() * 10 +
+                             schema_.fields().size()) {
+            return false;
+        }
+
+        buffer_.resize(delta_size);
+        if (!lz_decompress(data + sizeof(delta_size), size - sizeof(delta_size),
+                           buffer_.data(), delta_size)) {
+            return false;
+        }
+        return _delta_decode(buffer_.data(), delta_size, count,
+                             records.data());
+    }
+    default:
+        return false;
+    }
+}
+
+} // namespace util
+
+} // namespace edm
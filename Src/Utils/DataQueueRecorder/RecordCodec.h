@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RecordFile.h"
+
+namespace edm {
+
+namespace util {
+
+/**
+ * block 编码器 (非线程安全, 每个线程各用一个):
+ *
+ * Delta: 按字段(列)编码, 每列先写1字节模式:
+ *   0: 与上一条记录的差值, zigzag 后按 varint 存储
+ *      浮点数先按字段的 decimals 转为定点整数 (解码后精度为 10^-decimals)
+ *   1: 原始字节 (浮点数非有限值或超出定点范围时)
+ *   每个block的第一条记录与0作差, block之间互不依赖
+ * DeltaLz: Delta 的结果再经过 lz 压缩
+ *
+ * 字段未覆盖的结构体填充字节不保存, 解码后为0
+ */
+class RecordBlockCodec final {
+public:
+    explicit RecordBlockCodec(const RecordSchema &schema) : schema_(schema) {}
+
+    // 编码count条记录到out, 编码结果不小于原始数据时返回false (应原样存储)
+    bool encode(RecordCodec codec, const char *records, uint32_t count,
+                std::vector<char> &out);
+
+    // 解码count条记录到records (count x record_size), 数据损坏时返回false
+    bool decode(RecordCodec codec, const char *data, std::size_t size,
+                uint32_t count, std::vector<char> &records);
+
+private:
+    void _delta_encode(const char *records, uint32_t count,
+                       std::vector<char> &out) const;
+    bool _delta_decode(const char *data, std::size_t size, uint32_t count,
+                       char *records) const;
+
+private:
+    RecordSchema schema_;
+    std::vector<char> buffer_; // Delta 编码的中间结果
+};
+
+} // namespace util
+
+} // namespace edm
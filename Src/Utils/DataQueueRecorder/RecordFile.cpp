@@ -0,0 +1,706 @@
+#include "RecordFile.h"
+#include "RecordCodec.h"
+
+#include "Logger/LogMacro.h"
+#include "Utils/Crc/crc.h"
+#include "Utils/Format/edm_format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifndef EDM_BUILD_VERSION
+#define EDM_BUILD_VERSION "unknown"
+#endif // EDM_BUILD_VERSION
+
+EDM_STATIC_LOGGER(s_logger, EDM_LOGGER_ROOT());
+
+namespace edm {
+
+namespace util {
+
+static inline uint32_t _align_up(uint32_t v, uint32_t align) {
+    return (v + align - 1) / align * align;
+}
+
+std::size_t RecordFieldTypeSize(RecordFieldType type) {
+    switch (type) {
+    case RecordFieldType::Bool:
+    case RecordFieldType::U8:
+    case RecordFieldType::I8:
+        return 1;
+    case RecordFieldType::U16:
+    case RecordFieldType::I16:
+        return 2;
+    case RecordFieldType::U32:
+    case RecordFieldType::I32:
+    case RecordFieldType::F32:
+        return 4;
+    case RecordFieldType::U64:
+    case RecordFieldType::I64:
+    case RecordFieldType::F64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+const char *RecordFieldTypeStr(RecordFieldType type) {
+    switch (type) {
+    case RecordFieldType::Bool:
+        return "bool";
+    case RecordFieldType::U8:
+        return "u8";
+    case RecordFieldType::U16:
+        return "u16";
+    case RecordFieldType::U32:
+        return "u32";
+    case RecordFieldType::U64:
+        return "u64";
+    case RecordFieldType::I8:
+        return "i8";
+    case RecordFieldType::I16:
+        return "i16";
+    case RecordFieldType::I32:
+        return "i32";
+    case RecordFieldType::I64:
+        return "i64";
+    case RecordFieldType::F32:
+        return "f32";
+    case RecordFieldType::F64:
+        return "f64";
+    default:
+        return "unknown";
+    }
+}
+
+const char *RecordCodecStr(RecordCodec codec) {
+    switch (codec) {
+    case RecordCodec::None:
+        return "none";
+    case RecordCodec::Delta:
+        return "delta";
+    case RecordCodec::DeltaLz:
+        return "delta_lz";
+    default:
+        return "unknown";
+    }
+}
+
+void RecordSchema::add_field(std::string_view name, RecordFieldType type,
+                             std::size_t offset, int decimals) {
+    if (decimals < 0) {
+        decimals = (type == RecordFieldType::F32 || type == RecordFieldType::F64)
+                       ? RecordFloatDefaultDecimals
+                       : 0;
+    }
+
+    fields_.push_back(
+        Field{std::string{name}, type, (uint32_t)offset, (uint8_t)decimals});
+}
+
+bool RecordSchema::is_valid() const {
+    if (record_size_ == 0) {
+        return false;
+    }
+
+    for (const auto &f : fields_) {
+        auto size = RecordFieldTypeSize(f.type);
+        if (size == 0 || f.offset + size > record_size_ ||
+            f.name.size() >= sizeof(RecordFieldDesc::name)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string RecordSchema::column_header() const {
+    std::string str;
+    for (std::size_t i = 0; i < fields_.size(); ++i) {
+        if (i != 0) {
+            str += '\t';
+        }
+        str += fields_[i].name;
+    }
+    return str;
+}
+
+template <typename T>
+static inline T _load_field(const char *record, uint32_t offset) {
+    T v;
+    std::memcpy(&v, record + offset, sizeof(T)); // 不要求对齐
+    return v;
+}
+
+void RecordSchema::append_record_string(const char *record,
+                                        std::string &out) const {
+    auto it = std::back_inserter(out);
+
+    for (std::size_t i = 0; i < fields_.size(); ++i) {
+        if (i != 0) {
+            out += '\t';
+        }
+
+        const auto &f = fields_[i];
+        switch (f.type) {
+        case RecordFieldType::Bool:
+            out += _load_field<uint8_t>(record, f.offset) ? '1' : '0';
+            break;
+        case RecordFieldType::U8:
+            EDM_FMT::format_to(it, "{}", _load_field<uint8_t>(record, f.offset));
+            break;
+        case RecordFieldType::U16:
+            EDM_FMT::format_to(it, "{}", _load_field<uint16_t>(record, f.offset));
+            break;
+        case RecordFieldType::U32:
+            EDM_FMT::format_to(it, "{}", _load_field<uint32_t>(record, f.offset));
+            break;
+        case RecordFieldType::U64:
+            EDM_FMT::format_to(it, "{}", _load_field<uint64_t>(record, f.offset));
+            break;
+        case RecordFieldType::I8:
+            EDM_FMT::format_to(it, "{}", _load_field<int8_t>(record, f.offset));
+            break;
+        case RecordFieldType::I16:
+            EDM_FMT::format_to(it, "{}", _load_field<int16_t>(record, f.offset));
+            break;
+        case RecordFieldType::I32:
+            EDM_FMT::format_to(it, "{}", _load_field<int32_t>(record, f.offset));
+            break;
+        case RecordFieldType::I64:
+            EDM_FMT::format_to(it, "{}", _load_field<int64_t>(record, f.offset));
+            break;
+        case RecordFieldType::F32:
+            EDM_FMT::format_to(it, "{:.4f}", _load_field<float>(record, f.offset));
+            break;
+        case RecordFieldType::F64:
+            EDM_FMT::format_to(it, "{:.4f}", _load_field<double>(record, f.offset));
+            break;
+        default:
+            out += '?';
+            break;
+        }
+    }
+}
+
+std::string RecordBuildFileHeader(const RecordSchema &schema,
+                                  const RecordFileInfo &info,
+                                  uint32_t block_size, uint32_t align) {
+    if (align == 0) {
+        return {};
+    }
+
+    RecordFileHeader header{};
+    std::memcpy(header.magic, RecordFileMagic, sizeof(header.magic));
+    header.format_version = RecordFileFormatVersion;
+    header.block_size = block_size;
+    header.record_size = schema.record_size();
+    header.field_count = schema.fields().size();
+    header.comment_size = info.comment.size();
+    header.cycle_us = info.cycle_us;
+    header.codec = static_cast<uint32_t>(info.codec);
+    header.start_time_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    std::strncpy(header.name, schema.name().c_str(), sizeof(header.name) - 1);
+    std::strncpy(header.build_version, EDM_BUILD_VERSION,
+                 sizeof(header.build_version) - 1);
+
+    uint32_t raw_header_size = sizeof(RecordFileHeader) +
+                               header.field_count * sizeof(RecordFieldDesc) +
+                               header.comment_size;
+    header.header_size = _align_up(raw_header_size, align);
+
+    std::string header_buffer(header.header_size, '\0');
+    char *p = header_buffer.data();
+    std::memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+
+    for (const auto &f : schema.fields()) {
+        RecordFieldDesc desc{};
+        std::strncpy(desc.name, f.name.c_str(), sizeof(desc.name) - 1);
+        desc.type = static_cast<uint8_t>(f.type);
+        desc.decimals = f.decimals;
+        desc.offset = f.offset;
+
+        std::memcpy(p, &desc, sizeof(desc));
+        p += sizeof(desc);
+    }
+
+    std::memcpy(p, info.comment.data(), info.comment.size());
+
+    return header_buffer;
+}
+
+void RecordFileWriter::_FreeDeleter::operator()(char *p) const { std::free(p); }
+
+RecordFileWriter::RecordFileWriter() = default;
+
+RecordFileWriter::~RecordFileWriter() { close(); }
+
+bool RecordFileWriter::open(const std::string &filename,
+                            const RecordSchema &schema,
+                            const RecordFileInfo &info) {
+    close();
+
+    if (!schema.is_valid()) {
+        return false;
+    }
+
+    record_size_ = schema.record_size();
+
+    // block 至少容纳一条记录, 且按 RecordFileAlign 对齐
+    block_size_ = _align_up(
+        std::max<uint32_t>(info.block_size,
+                           sizeof(RecordBlockHeader) + record_size_),
+        RecordFileAlign);
+    records_per_block_ = (block_size_ - sizeof(RecordBlockHeader)) / record_size_;
+
+    auto header_buffer =
+        RecordBuildFileHeader(schema, info, block_size_, RecordFileAlign);
+    if (header_buffer.empty()) {
+        return false;
+    }
+
+    // block 缓存
+    void *mem = nullptr;
+    if (posix_memalign(&mem, RecordFileAlign, block_size_) != 0) {
+        return false;
+    }
+    block_buffer_.reset(static_cast<char *>(mem));
+    block_record_count_ = 0;
+    block_index_ = 0;
+    record_count_ = 0;
+
+    codec_ = info.codec;
+    if (codec_ != RecordCodec::None) {
+        block_codec_ = std::make_unique<RecordBlockCodec>(schema);
+        encode_buffer_.reserve(block_size_);
+    } else {
+        block_codec_.reset();
+    }
+
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                 0644);
+    if (fd_ < 0) {
+        block_buffer_.reset();
+        return false;
+    }
+
+    filename_ = filename;
+    write_failed_ = false;
+
+    if (!_write_all(header_buffer.data(), header_buffer.size())) {
+        _close_on_error();
+        return false;
+    }
+
+    return true;
+}
+
+bool RecordFileWriter::append(const void *records, std::size_t count) {
+    if (!is_open()) {
+        return false;
+    }
+
+    auto src = static_cast<const char *>(records);
+    while (count > 0) {
+        auto n = std::min<std::size_t>(count,
+                                       records_per_block_ - block_record_count_);
+
+        std::memcpy(block_buffer_.get() + sizeof(RecordBlockHeader) +
+                        (std::size_t)block_record_count_ * record_size_,
+                    src, n * record_size_);
+
+        block_record_count_ += n;
+        record_count_ += n;
+        src += n * record_size_;
+        count -= n;
+
+        if (block_record_count_ >= records_per_block_ && !_write_block()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RecordFileWriter::close() {
+    if (!is_open()) {
+        return !write_failed_;
+    }
+
+    if (block_record_count_ > 0 && !_write_block()) {
+        return false;
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+    block_buffer_.reset();
+
+    return true;
+}
+
+void RecordFileWriter::_close_on_error() {
+    s_logger->error("record file write failed: {}, {}", filename_,
+                    std::strerror(errno));
+
+    write_failed_ = true;
+    ::close(fd_);
+    fd_ = -1;
+    block_buffer_.reset();
+}
+
+bool RecordFileWriter::_write_all(const char *data, std::size_t size) {
+    while (size > 0) {
+        auto ret = ::write(fd_, data, size);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        data += ret;
+        size -= ret;
+    }
+
+    return true;
+}
+
+bool RecordFileWriter::_write_block() {
+    auto buffer = block_buffer_.get();
+    auto records = buffer + sizeof(RecordBlockHeader);
+    uint32_t payload_size = block_record_count_ * record_size_;
+
+    RecordBlockHeader bh{};
+    bh.magic = RecordBlockMagic;
+    bh.block_index = block_index_;
+    bh.record_count = block_record_count_;
+    bh.codec = static_cast<uint32_t>(RecordCodec::None);
+
+    if (codec_ == RecordCodec::None) {
+        bh.payload_size = payload_size;
+        bh.crc32 = crc32_table_calc(reinterpret_cast<const uint8_t *>(records),
+                                    payload_size);
+        std::memcpy(buffer, &bh, sizeof(bh));
+
+        // 未满的block补0, 保证整块写入
+        std::memset(records + payload_size, 0,
+                    block_size_ - sizeof(RecordBlockHeader) - payload_size);
+
+        if (!_write_all(buffer, block_size_)) {
+            _close_on_error();
+            return false;
+        }
+    } else {
+        // 压缩文件: 编码后变长写入, 编码无收益时原样存储
+        const char *payload = records;
+        if (block_codec_->encode(codec_, records, block_record_count_,
+                                 encode_buffer_)) {
+            payload = encode_buffer_.data();
+            payload_size = encode_buffer_.size();
+            bh.codec = static_cast<uint32_t>(codec_);
+        }
+
+        bh.payload_size = payload_size;
+        bh.crc32 = crc32_table_calc(reinterpret_cast<const uint8_t *>(payload),
+                                    payload_size);
+
+        if (payload != records) {
+            std::memcpy(records, payload, payload_size); // 合并为一次写入
+        }
+        std::memcpy(buffer, &bh, sizeof(bh));
+
+        if (!_write_all(buffer, sizeof(RecordBlockHeader) + payload_size)) {
+            _close_on_error();
+            return false;
+        }
+    }
+
+    ++block_index_;
+    block_record_count_ = 0;
+
+    return true;
+}
+
+bool RecordFileReader::IsRecordFile(const std::string &filename) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(RecordFileMagic)]{};
+    ifs.read(magic, sizeof(magic));
+
+    return ifs.gcount() == sizeof(magic) &&
+           std::memcmp(magic, RecordFileMagic, sizeof(magic)) == 0;
+}
+
+bool RecordFileReader::ParseHeader(const char *data, std::size_t size,
+                                   RecordFileHeader &header,
+                                   RecordSchema &schema, std::string &comment) {
+    if (size < sizeof(RecordFileHeader)) {
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, RecordFileMagic, sizeof(header.magic)) != 0 ||
+        header.format_version > RecordFileFormatVersion) {
+        return false;
+    }
+
+    if (header.record_size == 0 ||
+        header.block_size < sizeof(RecordBlockHeader) + header.record_size ||
+        header.codec > static_cast<uint32_t>(RecordCodec::DeltaLz)) {
+        return false;
+    }
+
+    uint64_t raw_header_size =
+        sizeof(RecordFileHeader) +
+        (uint64_t)header.field_count * sizeof(RecordFieldDesc) +
+        header.comment_size;
+    if (raw_header_size > header.header_size || header.header_size > size) {
+        return false;
+    }
+
+    header.name[sizeof(header.name) - 1] = '\0';
+    header.build_version[sizeof(header.build_version) - 1] = '\0';
+    schema = RecordSchema{header.name, header.record_size};
+
+    const char *p = data + sizeof(RecordFileHeader);
+    for (uint32_t i = 0; i < header.field_count; ++i) {
+        RecordFieldDesc desc;
+        std::memcpy(&desc, p, sizeof(desc));
+        p += sizeof(desc);
+
+        desc.name[sizeof(desc.name) - 1] = '\0';
+        schema.add_field(desc.name, static_cast<RecordFieldType>(desc.type),
+                         desc.offset, desc.decimals);
+    }
+
+    if (!schema.is_valid()) {
+        return false;
+    }
+
+    comment.assign(p, header.comment_size);
+
+    return true;
+}
+
+RecordFileReader::RecordFileReader() = default;
+
+RecordFileReader::~RecordFileReader() = default;
+
+bool RecordFileReader::open(const std::string &filename) {
+    ifs_.close();
+    ifs_.clear();
+    bad_block_count_ = 0;
+    truncated_ = false;
+
+    ifs_.open(filename, std::ios::binary);
+    if (!ifs_.is_open()) {
+        return false;
+    }
+
+    ifs_.seekg(0, std::ios::end);
+    const auto file_size = (uint64_t)(std::streamoff)ifs_.tellg();
+    ifs_.seekg(0, std::ios::beg);
+
+    // 先读取固定文件头获取 header_size, 再读取完整文件头解析
+    // (header_size 来自文件, 分配前先检查不超过文件大小)
+    RecordFileHeader fixed_header;
+    ifs_.read(reinterpret_cast<char *>(&fixed_header), sizeof(fixed_header));
+    if (ifs_.gcount() != sizeof(fixed_header) ||
+        fixed_header.header_size < sizeof(fixed_header) ||
+        fixed_header.header_size > file_size) {
+        return false;
+    }
+
+    std::vector<char> header_buffer(fixed_header.header_size);
+    ifs_.seekg(0, std::ios::beg);
+    ifs_.read(header_buffer.data(), header_buffer.size());
+    if ((std::size_t)ifs_.gcount() != header_buffer.size()) {
+        return false;
+    }
+
+    if (!ParseHeader(header_buffer.data(), header_buffer.size(), header_,
+                     schema_, comment_)) {
+        return false;
+    }
+
+    block_buffer_.resize(header_.block_size);
+
+    if (header_.codec != static_cast<uint32_t>(RecordCodec::None)) {
+        block_codec_ = std::make_unique<RecordBlockCodec>(schema_);
+    } else {
+        block_codec_.reset();
+    }
+
+    return ifs_.good();
+}
+
+bool RecordFileReader::ValidateBlock(const char *block,
+                                     const RecordFileHeader &header,
+                                     uint32_t &record_count) {
+    RecordBlockHeader bh;
+    std::memcpy(&bh, block, sizeof(bh));
+
+    if (bh.magic != RecordBlockMagic ||
+        bh.payload_size > header.block_size - sizeof(RecordBlockHeader) ||
+        (uint64_t)bh.record_count * header.record_size != bh.payload_size) {
+        return false;
+    }
+
+    auto crc = crc32_table_calc(
+        reinterpret_cast<const uint8_t *>(block + sizeof(RecordBlockHeader)),
+        bh.payload_size);
+    if (crc != bh.crc32) {
+        return false;
+    }
+
+    record_count = bh.record_count;
+    return true;
+}
+
+std::size_t RecordFileReader::MaxStoredPayloadSize(const RecordFileHeader &header) {
+    // 编码无收益时原样存储, 所以不会超过原始容量
+    return header.block_size - sizeof(RecordBlockHeader);
+}
+
+bool RecordFileReader::ValidateBlockHeader(const RecordBlockHeader &bh,
+                                           const RecordFileHeader &header) {
+    return bh.magic == RecordBlockMagic &&
+           bh.codec <= static_cast<uint32_t>(RecordCodec::DeltaLz) &&
+           bh.payload_size <= MaxStoredPayloadSize(header) &&
+           (uint64_t)bh.record_count * header.record_size <=
+               MaxStoredPayloadSize(header);
+}
+
+void RecordFileReader::_resync(std::streamoff from) {
+    // 从 from 开始逐块查找下一个block magic
+    char magic[sizeof(RecordBlockMagic)];
+    std::memcpy(magic, &RecordBlockMagic, sizeof(magic));
+
+    std::vector<char> buffer(64 * 1024);
+    ifs_.clear();
+    ifs_.seekg(from);
+    while (true) {
+        ifs_.read(buffer.data(), buffer.size());
+        auto got = (std::size_t)ifs_.gcount();
+        if (got < sizeof(magic)) {
+            break;
+        }
+
+        auto it = std::search(buffer.begin(), buffer.begin() + got,
+                              std::begin(magic), std::end(magic));
+        if (it != buffer.begin() + got) {
+            ifs_.clear();
+            ifs_.seekg(from + (it - buffer.begin()));
+            return;
+        }
+
+        // 保留末尾可能被截断的magic
+        from += got - (sizeof(magic) - 1);
+        ifs_.clear();
+        ifs_.seekg(from);
+    }
+
+    // 没有找到, 定位到文件末尾
+    ifs_.clear();
+    ifs_.seekg(0, std::ios::end);
+}
+
+bool RecordFileReader::_read_packed_block(std::vector<char> &payload,
+                                          uint32_t &record_count) {
+    while (ifs_.is_open()) {
+        auto pos = (std::streamoff)ifs_.tellg();
+
+        RecordBlockHeader bh;
+        ifs_.read(reinterpret_cast<char *>(&bh), sizeof(bh));
+        auto got = ifs_.gcount();
+
+        if (got == 0) {
+            return false; // 文件结束
+        }
+
+        if ((std::size_t)got != sizeof(bh)) {
+            truncated_ = true;
+            return false;
+        }
+
+        if (!ValidateBlockHeader(bh, header_)) {
+            ++bad_block_count_;
+            _resync(pos + 1);
+            continue;
+        }
+
+        block_buffer_.resize(bh.payload_size);
+        ifs_.read(block_buffer_.data(), bh.payload_size);
+        if ((std::size_t)ifs_.gcount() != bh.payload_size) {
+            truncated_ = true;
+            return false;
+        }
+
+        auto crc = crc32_table_calc(
+            reinterpret_cast<const uint8_t *>(block_buffer_.data()),
+            bh.payload_size);
+        if (crc != bh.crc32 ||
+            !block_codec_->decode(static_cast<RecordCodec>(bh.codec),
+                                  block_buffer_.data(), bh.payload_size,
+                                  bh.record_count, payload)) {
+            ++bad_block_count_;
+            continue;
+        }
+
+        record_count = bh.record_count;
+        return true;
+    }
+
+    return false;
+}
+
+bool RecordFileReader::read_block(std::vector<char> &payload,
+                                  uint32_t &record_count) {
+    if (block_codec_) {
+        return _read_packed_block(payload, record_count);
+    }
+
+    while (ifs_.is_open()) {
+        ifs_.read(block_buffer_.data(), block_buffer_.size());
+        auto got = ifs_.gcount();
+
+        if (got == 0) {
+            return false; // 文件结束
+        }
+
+        if ((std::size_t)got != block_buffer_.size()) {
+            truncated_ = true; // 写入中途退出, 最后一个block不完整
+            return false;
+        }
+
+        if (!ValidateBlock(block_buffer_.data(), header_, record_count)) {
+            ++bad_block_count_;
+            continue;
+        }
+
+        auto begin = block_buffer_.begin() + sizeof(RecordBlockHeader);
+        payload.assign(begin, begin + (std::size_t)record_count *
+                                          header_.record_size);
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace edm {
+
+namespace util {
+
+/**
+ * 记录文件格式 (分块, 自描述):
+ *
+ * | RecordFileHeader | RecordFieldDesc x field_count | comment | pad |
+ * | RecordBlockHeader | payload (record_count x record_size) | pad | (block 0)
+ * | RecordBlockHeader | payload ...                          | pad | (block 1)
+ * ...
+ *
+ * - 文件头保存字段名/类型/偏移, 以及构建版本和运动周期,
+ *   解码时按文件头解析, 不依赖读取方的结构体布局
+ * - 每个block固定 block_size 字节, 整块对齐写入; block头中保存本块记录数和
+ *   payload的crc32, 写入中途崩溃只会丢失最后一个不完整的block
+ * - 文件头 codec 非0时为压缩文件: block不再补齐, 每个block占
+ *   RecordBlockHeader + payload_size 字节, payload 按block头中的 codec 编码
+ *   (见 RecordBlockCodec); block_size 此时表示一个block的原始容量
+ * - 所有数值均为小端 (与记录机器一致)
+ */
+
+inline constexpr char RecordFileMagic[8] = {'E', 'D', 'M', 'R',
+                                            'E', 'C', '0', '1'};
+inline constexpr uint32_t RecordFileFormatVersion = 2; // 2: 增加codec
+inline constexpr uint32_t RecordBlockMagic = 0x4B4C4245; // "EBLK"
+
+inline constexpr uint32_t RecordFileAlign = 4096; // 文件头与block的对齐
+inline constexpr uint32_t RecordFileDefaultBlockSize = 64 * 1024;
+
+// 浮点字段默认的定点精度 (小数位数), 与解码输出的格式一致
+inline constexpr uint8_t RecordFloatDefaultDecimals = 4;
+
+enum class RecordCodec : uint32_t {
+    None = 0,    // 原始结构体
+    Delta = 1,   // 按列差值 + zigzag varint
+    DeltaLz = 2, // Delta 之后再 lz 压缩
+};
+
+const char *RecordCodecStr(RecordCodec codec);
+
+enum class RecordFieldType : uint8_t {
+    Bool = 1,
+    U8,
+    U16,
+    U32,
+    U64,
+    I8,
+    I16,
+    I32,
+    I64,
+    F32,
+    F64,
+};
+
+std::size_t RecordFieldTypeSize(RecordFieldType type);
+const char *RecordFieldTypeStr(RecordFieldType type);
+
+template <typename T> struct RecordFieldTypeOf;
+
+#define EDM_RECORD_FIELD_TYPE_OF(type_, enum_)                       \
+    template <> struct RecordFieldTypeOf<type_> {                    \
+        static constexpr RecordFieldType value = RecordFieldType::enum_; \
+    };
+
+EDM_RECORD_FIELD_TYPE_OF(bool, Bool)
+EDM_RECORD_FIELD_TYPE_OF(uint8_t, U8)
+EDM_RECORD_FIELD_TYPE_OF(uint16_t, U16)
+EDM_RECORD_FIELD_TYPE_OF(uint32_t, U32)
+EDM_RECORD_FIELD_TYPE_OF(uint64_t, U64)
+EDM_RECORD_FIELD_TYPE_OF(int8_t, I8)
+EDM_RECORD_FIELD_TYPE_OF(int16_t, I16)
+EDM_RECORD_FIELD_TYPE_OF(int32_t, I32)
+EDM_RECORD_FIELD_TYPE_OF(int64_t, I64)
+EDM_RECORD_FIELD_TYPE_OF(float, F32)
+EDM_RECORD_FIELD_TYPE_OF(double, F64)
+
+#undef EDM_RECORD_FIELD_TYPE_OF
+
+// 文件中的字段描述
+struct RecordFieldDesc {
+    char name[48];
+    uint8_t type;
+    uint8_t decimals; // 浮点字段压缩时的定点精度
+    uint8_t reserved[2];
+    uint32_t offset; // 在一条记录中的字节偏移
+};
+static_assert(sizeof(RecordFieldDesc) == 56);
+
+struct RecordFileHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t header_size; // 首个block在文件中的偏移
+    uint32_t block_size;
+    uint32_t record_size;
+    uint32_t field_count;
+    uint32_t comment_size;
+    uint32_t cycle_us; // 运动周期
+    uint32_t codec;    // RecordCodec, 非0时block为变长存储
+    uint64_t start_time_ms; // 记录开始时间 (unix ms)
+    char name[32];
+    char build_version[32];
+};
+static_assert(sizeof(RecordFileHeader) == 112);
+
+struct RecordBlockHeader {
+    uint32_t magic;
+    uint32_t block_index;
+    uint32_t record_count;
+    uint32_t payload_size;
+    uint32_t crc32; // payload crc32
+    uint32_t codec; // 本block的 RecordCodec (压缩效果不好时为None)
+};
+static_assert(sizeof(RecordBlockHeader) == 24);
+
+// 记录结构的描述, 由各记录结构体给出
+class RecordSchema final {
+public:
+    struct Field {
+        std::string name;
+        RecordFieldType type;
+        uint32_t offset;
+        uint8_t decimals;
+    };
+
+    RecordSchema() = default;
+    RecordSchema(std::string_view name, uint32_t record_size)
+        : name_(name), record_size_(record_size) {}
+
+    // 添加字段, std::array 会展开为 name0, name1, ...
+    template <typename T>
+    void add_field(std::string_view name, std::size_t offset) {
+        if constexpr (_is_std_array<T>::value) {
+            using value_type = typename T::value_type;
+            for (std::size_t i = 0; i < std::tuple_size_v<T>; ++i) {
+                add_field<value_type>(std::string{name} + std::to_string(i),
+                                      offset + i * sizeof(value_type));
+            }
+        } else {
+            add_field(name, RecordFieldTypeOf<std::remove_cv_t<T>>::value,
+                      offset);
+        }
+    }
+
+    // decimals 为 -1 时浮点字段使用 RecordFloatDefaultDecimals
+    void add_field(std::string_view name, RecordFieldType type,
+                   std::size_t offset, int decimals = -1);
+
+    inline const auto &name() const { return name_; }
+    inline auto record_size() const { return record_size_; }
+    inline const auto &fields() const { return fields_; }
+
+    // 字段是否都在记录范围内
+    bool is_valid() const;
+
+    // 字段名以'\t'连接的表头
+    std::string column_header() const;
+
+    // 将一条记录按字段格式化, 追加到out (不含换行)
+    void append_record_string(const char *record, std::string &out) const;
+
+private:
+    template <typename T> struct _is_std_array : std::false_type {};
+    template <typename E, std::size_t N>
+    struct _is_std_array<std::array<E, N>> : std::true_type {};
+
+private:
+    std::string name_;
+    uint32_t record_size_{0};
+    std::vector<Field> fields_;
+};
+
+// 按结构体成员添加字段
+#define EDM_RECORD_SCHEMA_ADD(schema_, struct_, member_, name_)        \
+    (schema_).add_field<decltype(struct_::member_)>((name_),           \
+                                                    offsetof(struct_, member_))
+
+// 记录开始时附带的文件信息
+struct RecordFileInfo {
+    std::string comment; // 附加文本, 如算法参数
+    uint32_t cycle_us{0};
+    uint32_t block_size{RecordFileDefaultBlockSize};
+    RecordCodec codec{RecordCodec::None};
+};
+
+// 生成文件头 (RecordFileHeader + 字段描述 + 附加文本), 按 align 补0对齐
+// 文件写入与实时流的schema包共用
+std::string RecordBuildFileHeader(const RecordSchema &schema,
+                                  const RecordFileInfo &info,
+                                  uint32_t block_size, uint32_t align);
+
+class RecordBlockCodec;
+
+// 分块写入器, 非线程安全, 由记录线程独占使用
+class RecordFileWriter final {
+public:
+    RecordFileWriter();
+    ~RecordFileWriter();
+
+    RecordFileWriter(const RecordFileWriter &) = delete;
+    RecordFileWriter &operator=(const RecordFileWriter &) = delete;
+
+    bool open(const std::string &filename, const RecordSchema &schema,
+              const RecordFileInfo &info);
+
+    // 追加count条记录, 每条记录 record_size 字节
+    // 写文件失败 (磁盘满, IO错误) 时记录日志, 关闭文件并返回false,
+    // 之后的记录全部丢弃; 文件未打开时也返回false
+    bool append(const void *records, std::size_t count);
+
+    // 写出未满的block并关闭, 写文件失败时返回false
+    bool close();
+
+    inline bool is_open() const { return fd_ >= 0; }
+    inline bool write_failed() const { return write_failed_; }
+    inline auto record_count() const { return record_count_; }
+
+private:
+    bool _write_all(const char *data, std::size_t size);
+    bool _write_block();
+    void _close_on_error();
+
+private:
+    struct _FreeDeleter {
+        void operator()(char *p) const;
+    };
+
+    int fd_{-1};
+    std::string filename_;
+    bool write_failed_{false};
+
+    uint32_t block_size_{0};
+    uint32_t record_size_{0};
+    uint32_t records_per_block_{0};
+
+    std::unique_ptr<char[], _FreeDeleter> block_buffer_; // 对齐的block缓存
+    uint32_t block_record_count_{0};
+
+    RecordCodec codec_{RecordCodec::None};
+    std::unique_ptr<RecordBlockCodec> block_codec_;
+    std::vector<char> encode_buffer_;
+    uint32_t block_index_{0};
+
+    uint64_t record_count_{0};
+};
+
+// 分块读取器
+class RecordFileReader final {
+public:
+    // 检查文件头magic, 用于区分旧的裸结构体文件
+    static bool IsRecordFile(const std::string &filename);
+
+    RecordFileReader();
+    ~RecordFileReader();
+
+    bool open(const std::string &filename);
+
+    inline const auto &header() const { return header_; }
+    inline const auto &schema() const { return schema_; }
+    inline const auto &comment() const { return comment_; }
+
+    // 读取下一个有效block, payload中为record_count条连续记录
+    // crc错误的block会被跳过; 文件结束或最后一个block不完整时返回false
+    bool read_block(std::vector<char> &payload, uint32_t &record_count);
+
+    inline auto bad_block_count() const { return bad_block_count_; }
+    inline auto truncated() const { return truncated_; }
+
+    // 压缩文件中单个block payload的上限, 用于校验block头
+    static std::size_t MaxStoredPayloadSize(const RecordFileHeader &header);
+
+    // 从内存解析文件头 (data 至少包含 header_size 字节)
+    static bool ParseHeader(const char *data, std::size_t size,
+                            RecordFileHeader &header, RecordSchema &schema,
+                            std::string &comment);
+
+    // 校验一个完整的block (header + payload), 成功返回payload中的记录数
+    // 用于未压缩文件
+    static bool ValidateBlock(const char *block, const RecordFileHeader &header,
+                              uint32_t &record_count);
+
+    // 校验压缩文件中的block头 (payload 需另外校验crc)
+    static bool ValidateBlockHeader(const RecordBlockHeader &bh,
+                                    const RecordFileHeader &header);
+
+private:
+    bool _read_packed_block(std::vector<char> &payload, uint32_t &record_count);
+    void _resync(std::streamoff from);
+
+private:
+    std::ifstream ifs_;
+
+    RecordFileHeader header_{};
+    RecordSchema schema_;
+    std::string comment_;
+
+    std::vector<char> block_buffer_;
+    std::unique_ptr<RecordBlockCodec> block_codec_;
+
+    uint32_t bad_block_count_{0};
+    bool truncated_{false};
+};
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,409 @@
+#include "RecordFileDecoder.h"
+#include "RecordCodec.h"
+
+#include "Utils/Crc/crc.h"
+
+#include <algorithm>
+#include <cstring>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace edm {
+
+namespace util {
+
+// 每段包含的block数 / 裸文件记录数
+static constexpr std::size_t s_blocks_per_unit = 4;
+static constexpr std::size_t s_raw_records_per_unit = 4096;
+
+// 每个线程最多领先写出位置的段数, 限制内存占用
+static constexpr std::size_t s_units_ahead_per_thread = 4;
+
+namespace {
+
+// 只读mmap整个文件
+class MappedFile final {
+public:
+    explicit MappedFile(const std::string &filename) {
+        fd_ = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            return;
+        }
+
+        // fstat/mmap 失败按打开失败处理, 否则会当作空文件"解码成功"
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            _close();
+            return;
+        }
+
+        size_ = st.st_size;
+        if (size_ == 0) {
+            return; // 空文件, 由文件头校验报错
+        }
+
+        auto p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) {
+            _close();
+            return;
+        }
+
+        data_ = static_cast<const char *>(p);
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    inline bool is_open() const { return fd_ >= 0; }
+    inline const char *data() const { return data_; }
+    inline std::size_t size() const { return size_; }
+
+private:
+    void _close() {
+        ::close(fd_);
+        fd_ = -1;
+        size_ = 0;
+    }
+
+private:
+    int fd_{-1};
+    const char *data_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace
+
+uint32_t RecordFileDecoder::_index_packed_blocks(
+    const char *data, std::size_t size, const RecordFileHeader &header,
+    std::vector<std::size_t> &block_offsets, bool &truncated) {
+    char magic[sizeof(RecordBlockMagic)];
+    std::memcpy(magic, &RecordBlockMagic, sizeof(magic));
+
+    uint32_t bad_block_count = 0;
+    std::size_t pos = header.header_size;
+    while (pos < size) {
+        if (size - pos < sizeof(RecordBlockHeader)) {
+            truncated = true;
+            break;
+        }
+
+        RecordBlockHeader bh;
+        std::memcpy(&bh, data + pos, sizeof(bh));
+
+        if (!RecordFileReader::ValidateBlockHeader(bh, header)) {
+            // block头损坏, 查找下一个magic
+            ++bad_block_count;
+            auto next = std::search(data + pos + 1, data + size,
+                                    std::begin(magic), std::end(magic));
+            pos = next - data;
+            continue;
+        }
+
+        std::size_t block_end = pos + sizeof(bh) + bh.payload_size;
+        if (block_end > size) {
+            truncated = true;
+            break;
+        }
+
+        block_offsets.push_back(pos);
+        pos = block_end;
+    }
+
+    return bad_block_count;
+}
+
+RecordFileDecoder::RecordFileDecoder(unsigned int thread_num)
+    : thread_num_(thread_num) {
+    if (thread_num_ == 0) {
+        thread_num_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+RecordDecodeResult
+RecordFileDecoder::decode_record_file(const std::string &bin_filename,
+                                      const std::string &txt_filename,
+                                      bool include_header) {
+    RecordDecodeResult result;
+
+    MappedFile mf(bin_filename);
+    if (!mf.is_open()) {
+        return result;
+    }
+
+    RecordFileHeader header;
+    RecordSchema schema;
+    std::string comment;
+    if (!RecordFileReader::ParseHeader(mf.data(), mf.size(), header, schema,
+                                       comment)) {
+        return result;
+    }
+
+    std::ofstream ofs(txt_filename, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        return result;
+    }
+
+    if (include_header) {
+        ofs << comment << schema.column_header() << '\n';
+    }
+
+    std::atomic_uint32_t bad_block_count{0};
+    std::atomic_uint64_t record_count{0};
+
+    // 每个block在文件中的偏移
+    std::vector<std::size_t> block_offsets;
+    if (header.codec == static_cast<uint32_t>(RecordCodec::None)) {
+        std::size_t data_size = mf.size() - header.header_size;
+        std::size_t block_count = data_size / header.block_size;
+        result.truncated = data_size % header.block_size != 0;
+
+        block_offsets.reserve(block_count);
+        for (std::size_t b = 0; b < block_count; ++b) {
+            block_offsets.push_back(header.header_size + b * header.block_size);
+        }
+    } else {
+        bad_block_count = _index_packed_blocks(mf.data(), mf.size(), header,
+                                               block_offsets, result.truncated);
+    }
+    const std::size_t block_count = block_offsets.size();
+
+    auto format_unit = [&](std::size_t unit, std::string &out) {
+        auto begin = unit * s_blocks_per_unit;
+        auto end = std::min(begin + s_blocks_per_unit, block_count);
+
+        // 压缩文件的解码缓存, 每段一个, 不跨线程共享
+        std::unique_ptr<RecordBlockCodec> codec;
+        std::vector<char> records;
+
+        uint64_t unit_record_count = 0;
+        for (auto b = begin; b < end; ++b) {
+            const char *block = mf.data() + block_offsets[b];
+
+            uint32_t n = 0;
+            const char *payload = block + sizeof(RecordBlockHeader);
+
+            if (header.codec == static_cast<uint32_t>(RecordCodec::None)) {
+                if (!RecordFileReader::ValidateBlock(block, header, n)) {
+                    bad_block_count.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+            } else {
+                RecordBlockHeader bh;
+                std::memcpy(&bh, block, sizeof(bh));
+
+                if (!codec) {
+                    codec = std::make_unique<RecordBlockCodec>(schema);
+                }
+
+                auto crc = crc32_table_calc(
+                    reinterpret_cast<const uint8_t *>(payload),
+                    bh.payload_size);
+                if (crc != bh.crc32 ||
+                    !codec->decode(static_cast<RecordCodec>(bh.codec), payload,
+                                   bh.payload_size, bh.record_count,
+                                   records)) {
+                    bad_block_count.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                n = bh.record_count;
+                payload = records.data();
+            }
+
+            for (uint32_t i = 0; i < n; ++i) {
+                schema.append_record_string(
+                    payload + (std::size_t)i * header.record_size, out);
+                out += '\n';
+            }
+
+            unit_record_count += n;
+        }
+
+        record_count.fetch_add(unit_record_count, std::memory_order_relaxed);
+    };
+
+    auto unit_count = (block_count + s_blocks_per_unit - 1) / s_blocks_per_unit;
+    result.ok = _run(unit_count, format_unit, ofs, result.canceled);
+
+    result.bad_block_count = bad_block_count;
+    result.record_count = record_count;
+
+    return result;
+}
+
+RecordDecodeResult RecordFileDecoder::decode_raw_file(
+    const std::string &bin_filename, const std::string &txt_filename,
+    const RecordSchema &schema, const std::string &header) {
+    RecordDecodeResult result;
+
+    if (!schema.is_valid()) {
+        return result;
+    }
+
+    MappedFile mf(bin_filename);
+    if (!mf.is_open()) {
+        return result;
+    }
+
+    std::ofstream ofs(txt_filename, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        return result;
+    }
+
+    if (!header.empty()) {
+        ofs << header << '\n';
+    }
+
+    const auto record_size = schema.record_size();
+    std::size_t total_records = mf.size() / record_size;
+    result.truncated = mf.size() % record_size != 0;
+    result.record_count = total_records;
+
+    auto format_unit = [&](std::size_t unit, std::string &out) {
+        auto begin = unit * s_raw_records_per_unit;
+        auto end = std::min(begin + s_raw_records_per_unit, total_records);
+
+        for (auto i = begin; i < end; ++i) {
+            schema.append_record_string(mf.data() + i * record_size, out);
+            out += '\n';
+        }
+    };
+
+    auto unit_count =
+        (total_records + s_raw_records_per_unit - 1) / s_raw_records_per_unit;
+    result.ok = _run(unit_count, format_unit, ofs, result.canceled);
+
+    return result;
+}
+
+bool RecordFileDecoder::_run(std::size_t unit_count,
+                             const UnitFormatter &format_unit,
+                             std::ofstream &ofs, bool &canceled) {
+    canceled = false;
+
+    if (progress_cb_) {
+        progress_cb_(0, unit_count);
+    }
+
+    if (unit_count == 0) {
+        return true;
+    }
+
+    const auto thread_num =
+        std::min<std::size_t>(thread_num_, unit_count);
+    const auto window = thread_num * s_units_ahead_per_thread;
+
+    // 环形槽位, 第i段的结果放在 slots[i % window]
+    std::vector<std::string> slots(window);
+    std::vector<char> ready(window, 0);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t next_unit = 0; // 下一个待格式化的段
+    std::size_t written = 0;   // 已写出的段数
+    bool abort = false;
+
+    auto worker = [&]() {
+        std::string out;
+        while (true) {
+            std::size_t unit;
+            {
+                std::unique_lock ul(mutex);
+                cv.wait(ul, [&]() {
+                    return abort || next_unit >= unit_count ||
+                           next_unit < written + window;
+                });
+
+                if (abort || next_unit >= unit_count) {
+                    return;
+                }
+
+                unit = next_unit++;
+                out.swap(slots[unit % window]); // 复用已写出槽位的内存
+            }
+
+            out.clear();
+            format_unit(unit, out);
+
+            {
+                std::lock_guard lg(mutex);
+                slots[unit % window].swap(out);
+                ready[unit % window] = 1;
+            }
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_num);
+    for (std::size_t i = 0; i < thread_num; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    bool ok = true;
+    std::string chunk;
+    for (std::size_t i = 0; i < unit_count; ++i) {
+        {
+            std::unique_lock ul(mutex);
+            // 定期醒来检查取消标志
+            while (!ready[i % window] && !_is_canceled()) {
+                cv.wait_for(ul, std::chrono::milliseconds(50));
+            }
+
+            if (_is_canceled()) {
+                canceled = true;
+                abort = true;
+            } else {
+                chunk.swap(slots[i % window]);
+                ready[i % window] = 0;
+                ++written;
+            }
+        }
+        cv.notify_all();
+
+        if (canceled) {
+            ok = false;
+            break;
+        }
+
+        ofs.write(chunk.data(), chunk.size());
+        if (!ofs) {
+            std::lock_guard lg(mutex);
+            abort = true;
+            ok = false;
+            break;
+        }
+
+        if (progress_cb_) {
+            progress_cb_(i + 1, unit_count);
+        }
+    }
+    cv.notify_all();
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    return ok;
+}
+
+} // namespace util
+
+} // namespace edm
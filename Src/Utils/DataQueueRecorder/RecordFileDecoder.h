@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "RecordFile.h"
+
+namespace edm {
+
+namespace util {
+
+struct RecordDecodeResult {
+    bool ok{false};
+    bool canceled{false};
+    uint64_t record_count{0};
+    uint32_t bad_block_count{0}; // crc错误被跳过的block
+    bool truncated{false};       // 最后一个block不完整
+};
+
+/**
+ * 记录文件并行解码器:
+ * mmap输入文件, 按block(或固定记录数)划分为若干段, 多个线程并行格式化,
+ * 调用线程按顺序整段写出, 同时通过回调报告进度, 并可随时取消
+ */
+class RecordFileDecoder final {
+public:
+    // done / total: 已写出的段数 / 总段数
+    using ProgressCallback = std::function<void(uint64_t done, uint64_t total)>;
+
+    // thread_num 为0时使用 hardware_concurrency
+    explicit RecordFileDecoder(unsigned int thread_num = 0);
+
+    inline void set_progress_callback(ProgressCallback cb) {
+        progress_cb_ = std::move(cb);
+    }
+
+    // 外部取消标志, 可在任意线程置位
+    inline void set_cancel_flag(const std::atomic_bool *cancel_flag) {
+        cancel_flag_ = cancel_flag;
+    }
+
+    // 解码分块记录文件, 按文件头中的字段描述格式化
+    // include_header: 输出文件头中的附加文本和列名
+    RecordDecodeResult decode_record_file(const std::string &bin_filename,
+                                          const std::string &txt_filename,
+                                          bool include_header);
+
+    // 解码旧的(无文件头的)裸结构体文件, 按给定的当前结构体描述格式化
+    RecordDecodeResult decode_raw_file(const std::string &bin_filename,
+                                       const std::string &txt_filename,
+                                       const RecordSchema &schema,
+                                       const std::string &header);
+
+private:
+    // 顺序扫描压缩文件中的变长block, 返回头部损坏被跳过的数量
+    static uint32_t _index_packed_blocks(const char *data, std::size_t size,
+                                         const RecordFileHeader &header,
+                                         std::vector<std::size_t> &block_offsets,
+                                         bool &truncated);
+
+    using UnitFormatter = std::function<void(std::size_t, std::string &)>;
+
+    // 并行格式化 unit_count 段, 按顺序写入ofs, 返回false表示取消或写入失败
+    bool _run(std::size_t unit_count, const UnitFormatter &format_unit,
+              std::ofstream &ofs, bool &canceled);
+
+    inline bool _is_canceled() const {
+        return cancel_flag_ && cancel_flag_->load(std::memory_order_relaxed);
+    }
+
+private:
+    unsigned int thread_num_;
+
+    ProgressCallback progress_cb_;
+    const std::atomic_bool *cancel_flag_{nullptr};
+};
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,190 @@
+#include "RecordStream.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace edm {
+
+namespace util {
+
+RecordStreamPublisher::~RecordStreamPublisher() { close(); }
+
+// "udp://127.0.0.1:19001"
+static bool _parse_udp_address(std::string_view s, sockaddr_storage &addr,
+                               socklen_t &addr_len) {
+    auto colon = s.rfind(':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+
+    std::string host{s.substr(0, colon)};
+    int port = std::atoi(std::string{s.substr(colon + 1)}.c_str());
+    if (port <= 0 || port > 65535) {
+        return false;
+    }
+
+    auto in = reinterpret_cast<sockaddr_in *>(&addr);
+    in->sin_family = AF_INET;
+    in->sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &in->sin_addr) != 1) {
+        return false;
+    }
+
+    // 只发往本机, 避免运动数据意外发到网络上
+    if ((ntohl(in->sin_addr.s_addr) >> 24) != 127) {
+        return false;
+    }
+
+    addr_len = sizeof(sockaddr_in);
+    return true;
+}
+
+// "unix:/tmp/edm_record.sock"
+static bool _parse_unix_address(std::string_view s, sockaddr_storage &addr,
+                                socklen_t &addr_len) {
+    auto un = reinterpret_cast<sockaddr_un *>(&addr);
+    if (s.empty() || s.size() >= sizeof(un->sun_path)) {
+        return false;
+    }
+
+    un->sun_family = AF_UNIX;
+    std::memcpy(un->sun_path, s.data(), s.size());
+    addr_len = offsetof(sockaddr_un, sun_path) + s.size() + 1;
+    return true;
+}
+
+bool RecordStreamPublisher::open(std::string_view address) {
+    close();
+
+    constexpr std::string_view udp_prefix = "udp://";
+    constexpr std::string_view unix_prefix = "unix:";
+
+    addr_ = {};
+    bool ok = false;
+    if (address.substr(0, udp_prefix.size()) == udp_prefix) {
+        ok = _parse_udp_address(address.substr(udp_prefix.size()), addr_,
+                                addr_len_);
+    } else if (address.substr(0, unix_prefix.size()) == unix_prefix) {
+        ok = _parse_unix_address(address.substr(unix_prefix.size()), addr_,
+                                 addr_len_);
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    fd_ = ::socket(addr_.ss_family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                   0);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    packet_buffer_.reserve(RecordStreamMaxPacketSize);
+
+    return true;
+}
+
+void RecordStreamPublisher::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void RecordStreamPublisher::begin(const RecordSchema &schema,
+                                  const RecordFileInfo &info) {
+    RecordFileInfo stream_info = info;
+    stream_info.codec = RecordCodec::None; // 流中的记录不压缩
+
+    schema_payload_ = RecordBuildFileHeader(schema, stream_info, 0, 1);
+    record_size_ = schema.record_size();
+    records_per_packet_ =
+        record_size_ == 0
+            ? 0
+            : (RecordStreamMaxPacketSize - sizeof(RecordStreamPacketHeader)) /
+                  record_size_;
+
+    ++stream_id_;
+    seq_ = 0;
+
+    if (schema_payload_.size() + sizeof(RecordStreamPacketHeader) >
+        RecordStreamMaxPacketSize) {
+        // 字段或附加文本过多, 去掉附加文本再试
+        stream_info.comment.clear();
+        schema_payload_ = RecordBuildFileHeader(schema, stream_info, 0, 1);
+    }
+
+    _send_schema();
+}
+
+void RecordStreamPublisher::publish(const void *records, std::size_t count) {
+    if (!is_open() || records_per_packet_ == 0) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_schema_time_ >=
+        std::chrono::milliseconds(RecordStreamSchemaIntervalMs)) {
+        _send_schema();
+    }
+
+    auto src = static_cast<const char *>(records);
+    while (count > 0) {
+        auto n = std::min<std::size_t>(count, records_per_packet_);
+        _send_packet(RecordStreamPacketType::Data, n, src, n * record_size_);
+
+        src += n * record_size_;
+        count -= n;
+    }
+}
+
+void RecordStreamPublisher::_send_schema() {
+    last_schema_time_ = std::chrono::steady_clock::now();
+
+    if (!is_open() || schema_payload_.empty()) {
+        return;
+    }
+
+    _send_packet(RecordStreamPacketType::Schema, 0, schema_payload_.data(),
+                 schema_payload_.size());
+}
+
+void RecordStreamPublisher::_send_packet(RecordStreamPacketType type,
+                                         uint32_t record_count,
+                                         const char *payload,
+                                         std::size_t payload_size) {
+    RecordStreamPacketHeader header{};
+    header.magic = RecordStreamMagic;
+    header.type = static_cast<uint16_t>(type);
+    header.stream_id = stream_id_;
+    header.seq = seq_++;
+    header.record_count = record_count;
+    header.payload_size = payload_size;
+
+    packet_buffer_.resize(sizeof(header) + payload_size);
+    std::memcpy(packet_buffer_.data(), &header, sizeof(header));
+    std::memcpy(packet_buffer_.data() + sizeof(header), payload, payload_size);
+
+    auto ret = ::sendto(fd_, packet_buffer_.data(), packet_buffer_.size(),
+                        MSG_DONTWAIT | MSG_NOSIGNAL,
+                        reinterpret_cast<const sockaddr *>(&addr_), addr_len_);
+
+    // EAGAIN: 接收方处理不过来; ECONNREFUSED/ENOENT: 没有接收方
+    // 均直接丢弃, 不重试
+    if (ret < 0) {
+        ++dropped_packet_count_;
+    } else {
+        ++sent_packet_count_;
+    }
+}
+
+} // namespace util
+
+} // namespace edm
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include "RecordFile.h"
+
+namespace edm {
+
+namespace util {
+
+/**
+ * 实时记录流 (数据报):
+ *
+ * | RecordStreamPacketHeader | payload |
+ *
+ * - type Schema: payload 为 RecordBuildFileHeader 生成的文件头 (不对齐),
+ *   开始时发送, 之后每 RecordStreamSchemaIntervalMs 重发一次,
+ *   便于中途连接的客户端解析
+ * - type Data: payload 为 record_count 条连续的原始记录 (不压缩)
+ * - stream_id 每次开始记录时变化, seq 每包递增, 客户端据此判断重启和丢包
+ * - 非阻塞发送, 接收方处理不过来 (发送缓冲满) 或不存在时直接丢弃
+ */
+inline constexpr uint32_t RecordStreamMagic = 0x52545345; // "ESTR"
+inline constexpr uint32_t RecordStreamMaxPacketSize = 60000; // < UDP上限
+inline constexpr uint32_t RecordStreamSchemaIntervalMs = 1000;
+
+enum class RecordStreamPacketType : uint16_t {
+    Schema = 1,
+    Data = 2,
+};
+
+struct RecordStreamPacketHeader {
+    uint32_t magic;
+    uint16_t type; // RecordStreamPacketType
+    uint16_t reserved;
+    uint32_t stream_id;
+    uint32_t seq;
+    uint32_t record_count; // Data包中的记录数
+    uint32_t payload_size;
+};
+static_assert(sizeof(RecordStreamPacketHeader) == 24);
+
+// 记录流发送端, 非线程安全, 由记录线程独占使用
+class RecordStreamPublisher final {
+public:
+    using ptr = std::shared_ptr<RecordStreamPublisher>;
+
+    RecordStreamPublisher() = default;
+    ~RecordStreamPublisher();
+
+    RecordStreamPublisher(const RecordStreamPublisher &) = delete;
+    RecordStreamPublisher &operator=(const RecordStreamPublisher &) = delete;
+
+    // address: "udp://127.0.0.1:19001" 或 "unix:/tmp/edm_record.sock"
+    // 只允许本机地址
+    bool open(std::string_view address);
+    void close();
+
+    inline bool is_open() const { return fd_ >= 0; }
+
+    // 开始一个新的流, 发送schema
+    void begin(const RecordSchema &schema, const RecordFileInfo &info);
+
+    // 发送count条记录 (按包大小拆分), 不阻塞
+    void publish(const void *records, std::size_t count);
+
+    inline auto sent_packet_count() const { return sent_packet_count_.load(); }
+    inline auto dropped_packet_count() const {
+        return dropped_packet_count_.load();
+    }
+
+private:
+    void _send_schema();
+    void _send_packet(RecordStreamPacketType type, uint32_t record_count,
+                      const char *payload, std::size_t payload_size);
+
+private:
+    int fd_{-1};
+    sockaddr_storage addr_{};
+    socklen_t addr_len_{0};
+
+    std::string schema_payload_;
+    uint32_t record_size_{0};
+    uint32_t records_per_packet_{0};
+
+    uint32_t stream_id_{0};
+    uint32_t seq_{0};
+    std::chrono::steady_clock::time_point last_schema_time_;
+
+    std::vector<char> packet_buffer_;
+
+    std::atomic_uint64_t sent_packet_count_{0};
+    std::atomic_uint64_t dropped_packet_count_{0};
+};
+
+} // namespace util
+
+} // namespace edm
@@ -12,6 +12,7 @@
 
 EDM_FMT_NS_BEGIN
 using fmt::format;
+using fmt::format_to;
 EDM_FMT_NS_END
 
 #else // EDM_USE_FMTLIB
@@ -20,6 +21,7 @@ EDM_FMT_NS_END
 
 EDM_FMT_NS_BEGIN
 using std::format;
+using std::format_to;
 EDM_FMT_NS_END
 
 #endif // EDM_USE_FMTLIB
@@ -78,6 +78,10 @@
 #define EDM_CAN_SET_DOWN_WHEN_WORKER_DELETED        // canworker析构时,
                                                     // 将can设备设置down
 
+// 时间关键的帧(电源can帧, 抬刀电压门控)经 SocketCAN 直接发送,
+// 不经过Qt事件循环 (见 SocketCanSender)
+#define EDM_CAN_ENABLE_DIRECT_SEND
+
 // 自定义Qt事件号
 #define EDM_CUSTOM_QTEVENT_TYPE_CanSendFrameEvent   1001
 #define EDM_CUSTOM_QTEVENT_TYPE_CanStartEvent       1002
@@ -117,8 +121,12 @@
 
 #define EDM_USE_ZYNQ_SERVOBOARD
 
-// DataQueueRecorder Cache
-#define EDM_DATAQUEUERECORDER_ENABLE_CACHE // 使能cache缓存
+// DataQueueRecorder 记录文件block大小 (整块对齐写入)
+#define EDM_DATAQUEUERECORDER_BLOCK_SIZE   (64 * 1024)
+
+// DataQueueRecorder 记录文件压缩方式 (在记录线程中按block编码)
+// 0: 不压缩, 1: 按列差值+varint, 2: 差值+varint后再lz压缩
+#define EDM_DATAQUEUERECORDER_CODEC        2
 
 // Motion Thread Stack Size
 #define EDM_MOTION_THREAD_STACK            (64 * 1024)
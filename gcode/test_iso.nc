@@ -0,0 +1,15 @@
+%
+(ISO G代码示例, 由原生解析器处理)
+G54 G90 F200
+E12
+G04 X1.0
+G00 X-4.574 Y-7.401 M05
+G00 Z2.800 M05
+G01 Z-0.200
+G01 X-3.075 Y-4.976
+G91
+G01 Z0.5
+G90
+G00 Z10.000 M05
+M02
+%
@@ -0,0 +1,146 @@
+import argparse
+import os
+import socket
+import struct
+
+import numpy as np
+
+import matplotlib.pyplot as plt
+
+# 运动数据实时流接收 (见 Src/Utils/DataQueueRecorder/RecordStream.h)
+#   python3 record_stream_client.py udp://127.0.0.1:19001 --plot act2 cmd2
+#   python3 record_stream_client.py unix:/tmp/edm_record.sock --print
+
+STREAM_MAGIC = 0x52545345
+PACKET_HEADER = struct.Struct('<IHHIIII')  # magic type reserved stream_id seq record_count payload_size
+PACKET_SCHEMA = 1
+PACKET_DATA = 2
+
+FILE_HEADER = struct.Struct('<8sIIIIIIIIQ32s32s')
+FIELD_DESC = struct.Struct('<48sBBxxI')
+
+FIELD_DTYPES = {
+    1: '?', 2: 'u1', 3: '<u2', 4: '<u4', 5: '<u8',
+    6: 'i1', 7: '<i2', 8: '<i4', 9: '<i8', 10: '<f4', 11: '<f8',
+}
+
+
+def parse_schema(payload: bytes):
+    (magic, version, header_size, block_size, record_size, field_count,
+     comment_size, cycle_us, codec, start_time_ms, name, build_version
+     ) = FILE_HEADER.unpack_from(payload, 0)
+
+    names, formats, offsets = [], [], []
+    pos = FILE_HEADER.size
+    for _ in range(field_count):
+        fname, ftype, decimals, offset = FIELD_DESC.unpack_from(payload, pos)
+        pos += FIELD_DESC.size
+        names.append(fname.split(b'\0')[0].decode())
+        formats.append(FIELD_DTYPES[ftype])
+        offsets.append(offset)
+
+    comment = payload[pos:pos + comment_size].decode(errors='replace')
+    dtype = np.dtype({'names': names, 'formats': formats,
+                      'offsets': offsets, 'itemsize': record_size})
+    return dtype, cycle_us, comment
+
+
+def open_socket(address: str) -> socket.socket:
+    if address.startswith('udp://'):
+        host, port = address[len('udp://'):].rsplit(':', 1)
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind((host, int(port)))
+    elif address.startswith('unix:'):
+        path = address[len('unix:'):]
+        if os.path.exists(path):
+            os.remove(path)
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
+        sock.bind(path)
+    else:
+        raise ValueError(f'unsupported address: {address}')
+
+    # 接收缓冲尽量大, 减少发送端丢包
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 8 * 1024 * 1024)
+    return sock
+
+
+def receive(sock: socket.socket):
+    """yield (dtype, records), 等到schema包之后才开始输出数据"""
+    dtype = None
+    stream_id = None
+    last_seq = None
+    lost = 0
+
+    while True:
+        packet = sock.recv(65536)
+        if len(packet) < PACKET_HEADER.size:
+            continue
+
+        magic, ptype, _, sid, seq, record_count, payload_size = \
+            PACKET_HEADER.unpack_from(packet, 0)
+        if magic != STREAM_MAGIC:
+            continue
+        payload = packet[PACKET_HEADER.size:PACKET_HEADER.size + payload_size]
+
+        if sid != stream_id:
+            # 新的一次记录, 等待schema
+            stream_id, dtype, last_seq = sid, None, None
+
+        if last_seq is not None and seq != last_seq + 1:
+            lost += seq - last_seq - 1
+            print(f'lost packets: {lost}')
+        last_seq = seq
+
+        if ptype == PACKET_SCHEMA:
+            if dtype is None:
+                dtype, cycle_us, comment = parse_schema(payload)
+                print(f'stream {sid}: cycle {cycle_us} us, fields: {dtype.names}')
+                if comment:
+                    print(comment)
+        elif ptype == PACKET_DATA and dtype is not None:
+            yield dtype, np.frombuffer(payload, dtype=dtype, count=record_count)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('address', nargs='?', default='udp://127.0.0.1:19001')
+    parser.add_argument('--plot', nargs='*', default=[], help='columns to plot')
+    parser.add_argument('--window', type=int, default=5000, help='records shown')
+    parser.add_argument('--print', action='store_true', help='print records')
+    args = parser.parse_args()
+
+    sock = open_socket(args.address)
+
+    lines = {}
+    history = None
+    ax = None
+    if args.plot:
+        plt.ion()
+        _, ax = plt.subplots()
+
+    for dtype, records in receive(sock):
+        if args.print:
+            for r in records:
+                print('\t'.join(str(v) for v in r))
+
+        if not args.plot:
+            continue
+
+        if history is None or history.dtype != dtype:
+            history = np.zeros(0, dtype=dtype)
+            ax.clear()
+            lines = {c: ax.plot([], [], label=c)[0]
+                     for c in args.plot if c in dtype.names}
+            ax.legend(loc='upper left')
+
+        history = np.concatenate([history, records])[-args.window:]
+        x = np.arange(len(history))
+        for c, line in lines.items():
+            line.set_data(x, history[c])
+        ax.relim()
+        ax.autoscale_view()
+        plt.pause(0.001)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,208 @@
+#include "QtDependComponents/CanController/SocketCanSender.h"
+
+#include "Logger/LogMacro.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+using namespace edm::can;
+
+// 用 SOCK_SEQPACKET 的 socketpair 代替 CAN_RAW socket:
+// 同样是一次 write 一帧, 非阻塞, 对端不读时发送端返回 EAGAIN
+struct SocketPair {
+    int tx{-1};
+    int rx{-1};
+
+    SocketPair() {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, fds) == 0) {
+            tx = fds[0];
+            rx = fds[1];
+
+            // 发送缓冲区取最小值, 对端不读时很快就满
+            const int sndbuf = 1;
+            setsockopt(tx, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        }
+    }
+    ~SocketPair() {
+        if (rx >= 0) {
+            close(rx);
+        }
+        // tx 由 SocketCanSender 关闭
+    }
+
+    // 读出对端收到的帧, 直到 idle_ms 内没有新的帧
+    std::vector<struct can_frame> read_all(int idle_ms = 50) const {
+        std::vector<struct can_frame> frames;
+        struct pollfd pfd {rx, POLLIN, 0};
+        while (poll(&pfd, 1, idle_ms) > 0) {
+            struct can_frame frame;
+            while (read(rx, &frame, sizeof(frame)) ==
+                   static_cast<ssize_t>(sizeof(frame))) {
+                frames.push_back(frame);
+            }
+        }
+        return frames;
+    }
+};
+
+static struct can_frame make_frame(uint32_t id, uint8_t b0, uint8_t b1) {
+    const char data[2]{static_cast<char>(b0), static_cast<char>(b1)};
+    return SocketCanSender::MakeFrame(id, data, 2);
+}
+
+// 队列中的帧按顺序写出
+static void test_post_order() {
+    SocketPair sp;
+    SocketCanSender sender(sp.tx, "pair");
+
+    for (int i = 0; i < 100; ++i) {
+        sender.post(make_frame(0x100, static_cast<uint8_t>(i), 0));
+    }
+    const auto frames = sp.read_all();
+
+    bool in_order = frames.size() == 100;
+    for (std::size_t i = 0; in_order && i < frames.size(); ++i) {
+        in_order = frames[i].data[0] == i && frames[i].can_id == 0x100;
+    }
+    s_root_logger->info("post: received {}, in order: {}, failed: {} "
+                        "(expect 100, true, 0)",
+                        frames.size(), in_order, sender.failed_count());
+}
+
+// 帧源: 另一个线程不断修改状态并触发, 发出的每组帧是连续且一致的,
+// 最后发出的一定是最新的状态, 与并发 post 的帧交错时也不被拆开
+// (post 比写出快, 队列满时丢弃, 收到的加丢弃的等于 post 的总数)
+static void test_source() {
+    SocketPair sp;
+    SocketCanSender sender(sp.tx, "pair");
+
+    std::atomic<uint8_t> state{0};
+    const int id = sender.add_source([&](struct can_frame *frames) -> int {
+        const uint8_t s = state.load();
+        frames[0] = make_frame(0x200, s, 0);
+        frames[1] = make_frame(0x200, s, 1);
+        return 2;
+    });
+
+    std::vector<struct can_frame> frames;
+    std::atomic_bool stop{false};
+    std::thread reader([&]() {
+        while (!stop) {
+            auto f = sp.read_all(5);
+            frames.insert(frames.end(), f.begin(), f.end());
+        }
+    });
+
+    std::thread poster([&]() {
+        for (int i = 0; i < 2000; ++i) {
+            sender.post(make_frame(0x300, 0, 0));
+        }
+    });
+
+    constexpr int toggles = 20000;
+    for (int i = 1; i <= toggles; ++i) {
+        state = static_cast<uint8_t>(i);
+        sender.trigger(id);
+    }
+    poster.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop = true;
+    reader.join();
+
+    int pairs = 0, broken = 0, posted = 0;
+    uint8_t last_state = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (frames[i].can_id == 0x300) {
+            ++posted;
+            continue;
+        }
+        if (frames[i].data[1] != 0 || i + 1 >= frames.size() ||
+            frames[i + 1].can_id != 0x200 || frames[i + 1].data[1] != 1 ||
+            frames[i + 1].data[0] != frames[i].data[0]) {
+            ++broken;
+            continue;
+        }
+        ++pairs;
+        last_state = frames[i].data[0];
+        ++i;
+    }
+
+    s_root_logger->info("source: {} pairs for {} triggers (coalesced: {}), "
+                        "broken: {} (expect 0), posted + failed: {} "
+                        "(expect 2000), last state: {} (expect {})",
+                        pairs, toggles, pairs < toggles, broken,
+                        posted + sender.failed_count(), last_state,
+                        static_cast<uint8_t>(toggles));
+
+    // 移除之后不再调用
+    sender.remove_source(id);
+    sender.trigger(id);
+    s_root_logger->info("removed source: received {} (expect 0)",
+                        sp.read_all().size());
+}
+
+// 对端暂时不读 (内核发送队列满): 等待后重试, 不丢帧
+static void test_retry() {
+    SocketPair sp;
+    SocketCanSender sender(sp.tx, "pair");
+
+    for (int i = 0; i < 200; ++i) {
+        sender.post(make_frame(0x100, static_cast<uint8_t>(i), 0));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto frames = sp.read_all();
+
+    bool in_order = frames.size() == 200;
+    for (std::size_t i = 0; in_order && i < frames.size(); ++i) {
+        in_order = frames[i].data[0] == i;
+    }
+    s_root_logger->info("retry: received {}, in order: {}, retried: {}, "
+                        "failed: {} (expect 200, true, true, 0)",
+                        frames.size(), in_order, sender.retry_count() > 0,
+                        sender.failed_count());
+}
+
+// 对端一直不读: 重试超时后丢弃并计数, 发送线程不会卡住
+static void test_retry_timeout() {
+    SocketPair sp;
+    SocketCanSender sender(sp.tx, "pair");
+
+    for (int i = 0; i < 100; ++i) {
+        sender.post(make_frame(0x100, static_cast<uint8_t>(i), 0));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    const auto received = sp.read_all().size();
+    s_root_logger->info("retry timeout: received + failed = {} (expect 100), "
+                        "failed > 0: {} (expect true)",
+                        received + sender.failed_count(),
+                        sender.failed_count() > 0);
+}
+
+// socket 不可用: 帧被丢弃并计数
+static void test_closed() {
+    SocketCanSender sender(-1, "closed");
+
+    sender.post(make_frame(0x100, 0, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    s_root_logger->info("closed: open: {}, failed: {} (expect false, 1)",
+                        sender.is_open(), sender.failed_count());
+}
+
+int main(int argc, char **argv) {
+    test_post_order();
+    test_source();
+    test_retry();
+    test_retry_timeout();
+    test_closed();
+    return 0;
+}
@@ -0,0 +1,354 @@
+#include "Utils/DataQueueRecorder/DataQueueRecorder.h"
+#include "Utils/DataQueueRecorder/EventCaptureRecorder.h"
+#include "Utils/DataQueueRecorder/RecordChannel.h"
+#include "Utils/DataQueueRecorder/RecordFileDecoder.h"
+#include "Logger/LogMacro.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include <sys/resource.h>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+struct TestData {
+    uint64_t tick{0};
+    std::array<double, 6> axis{0.0};
+    bool flag{false};
+    uint8_t rate{0};
+    uint16_t voltage{0};
+    int cnt{0};
+};
+
+static edm::util::RecordSchema make_schema() {
+    edm::util::RecordSchema schema{"test", sizeof(TestData)};
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, tick, "tick");
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, axis, "axis");
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, flag, "flag");
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, rate, "rate");
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, voltage, "voltage");
+    EDM_RECORD_SCHEMA_ADD(schema, TestData, cnt, "cnt");
+    return schema;
+}
+
+static void test(const char *filename, int num,
+                 edm::util::RecordCodec codec = edm::util::RecordCodec::None) {
+    edm::util::DataQueueRecorder<TestData> recorder;
+
+    edm::util::RecordFileInfo info;
+    info.comment = "test comment\n";
+    info.cycle_us = 1000;
+    info.codec = codec;
+
+    if (!recorder.start_record(filename, make_schema(), info)) {
+        s_root_logger->error("start record failed");
+        return;
+    }
+
+    for (int i = 0; i < num; ++i) {
+        TestData d;
+        d.tick = i * 1000;
+        d.axis.fill(i * 0.5);
+        d.flag = i % 2;
+        d.rate = i % 100;
+        d.voltage = i;
+        d.cnt = -i;
+        recorder.push_data(d);
+    }
+
+    recorder.stop_record(true);
+
+    edm::util::RecordFileReader reader;
+    if (!reader.open(filename)) {
+        s_root_logger->error("open record file failed");
+        return;
+    }
+
+    s_root_logger->info("header: {}{}", reader.comment(),
+                        reader.schema().column_header());
+
+    std::vector<char> payload;
+    uint32_t record_count = 0;
+    uint64_t total = 0;
+    while (reader.read_block(payload, record_count)) {
+        for (uint32_t i = 0; i < record_count; ++i) {
+            TestData d;
+            std::memcpy(&d, payload.data() + i * sizeof(TestData), sizeof(d));
+            if (d.tick != (total + i) * 1000 || d.cnt != -(int)(total + i)) {
+                s_root_logger->error("data mismatch at {}", total + i);
+                return;
+            }
+        }
+        total += record_count;
+    }
+
+    s_root_logger->info("total: {} / {}, bad blocks: {}, truncated: {}", total,
+                        num, reader.bad_block_count(), reader.truncated());
+}
+
+static void test_decode(const char *filename, const char *txt_filename) {
+    edm::util::RecordFileDecoder decoder;
+    decoder.set_progress_callback([](uint64_t done, uint64_t total) {
+        if (done == total) {
+            s_root_logger->info("decode progress: {} / {}", done, total);
+        }
+    });
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto result = decoder.decode_record_file(filename, txt_filename, true);
+    auto t1 = std::chrono::steady_clock::now();
+
+    s_root_logger->info(
+        "decode ok: {}, records: {}, bad blocks: {}, truncated: {}, {} ms",
+        result.ok, result.record_count, result.bad_block_count,
+        result.truncated,
+        std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count());
+}
+
+static void test_event_capture() {
+    edm::util::EventCaptureRecorder<TestData> capture;
+
+    int file_index = 0;
+    auto file_generator = [&](uint32_t trigger_bits, std::string &filename,
+                              edm::util::RecordFileInfo &info) {
+        filename = "test_event_" + std::to_string(file_index++) + ".bin";
+        info.comment = "trigger: " + std::to_string(trigger_bits) + "\n";
+        return true;
+    };
+
+    // 触发前100条, 触发后20条, 间隔50条
+    if (!capture.start_capture(make_schema(), 100, 20, 50, file_generator)) {
+        s_root_logger->error("start capture failed");
+        return;
+    }
+
+    for (int i = 0; i < 10000; ++i) {
+        TestData d;
+        d.tick = i;
+        uint32_t trigger_bits = (i == 500 || i == 3000) ? 1 : 0;
+        capture.push_data(d, trigger_bits);
+    }
+
+    capture.stop_capture();
+
+    for (int i = 0; i < file_index; ++i) {
+        edm::util::RecordFileReader reader;
+        if (!reader.open("test_event_" + std::to_string(i) + ".bin")) {
+            s_root_logger->error("open event file failed");
+            return;
+        }
+
+        std::vector<char> payload;
+        uint32_t record_count = 0;
+        uint64_t total = 0;
+        while (reader.read_block(payload, record_count)) {
+            total += record_count;
+        }
+
+        s_root_logger->info("event file {}: {}records: {} (expect 120)", i,
+                            reader.comment(), total);
+    }
+
+    s_root_logger->info("saved: {}, dropped: {}", capture.saved_count(),
+                        capture.dropped_count());
+}
+
+// 运动线程持续push时反复 stop/start, 缓冲不能在push中被替换
+static void test_event_capture_restart() {
+    edm::util::EventCaptureRecorder<TestData> capture;
+    auto file_generator = [](uint32_t, std::string &, edm::util::RecordFileInfo &) {
+        return false; // 不写文件
+    };
+
+    std::atomic_bool exit_flag{false};
+    std::thread pusher([&]() {
+        TestData d;
+        for (uint64_t i = 0; !exit_flag; ++i) {
+            d.tick = i;
+            capture.push_data(d, i % 97 == 0 ? 1 : 0);
+        }
+    });
+
+    int started = 0;
+    for (int i = 0; i < 200; ++i) {
+        started += capture.start_capture(make_schema(), 50 + i % 7, 10, 5,
+                                         file_generator);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        capture.stop_capture();
+    }
+
+    exit_flag = true;
+    pusher.join();
+
+    s_root_logger->info("event capture restart: started {} (expect 200)",
+                        started);
+}
+
+static void test_record_channels() {
+    auto registry = std::make_shared<edm::util::RecordChannelRegistry>();
+    auto axis_id = registry->register_array_channel<double, 6>("axis");
+    auto voltage_id = registry->register_channel<uint16_t>("voltage");
+    auto cnt_id = registry->register_channel<int32_t>("cnt");
+    registry->register_channel<bool>("flag"); // 不选择
+
+    // axis0 每周期, voltage 每10周期, cnt 不存在的通道被忽略
+    edm::util::RecordChannelSelection selection;
+    selection.items = {{"axis0", 1}, {"voltage", 10}, {"cnt", 5}, {"nope", 1}};
+
+    edm::util::RecordFileInfo info;
+    info.codec = edm::util::RecordCodec::DeltaLz;
+
+    edm::util::RecordChannelRecorder recorder;
+    if (!recorder.start_record("test_channels.bin", registry, selection,
+                               info)) {
+        s_root_logger->error("start channel record failed");
+        return;
+    }
+
+    for (int i = 0; i < 100000; ++i) {
+        std::array<double, 6> axis;
+        axis.fill(i * 0.5);
+        registry->publish_array(axis_id, axis);
+        registry->publish<uint16_t>(voltage_id, i % 1000);
+        registry->publish<int32_t>(cnt_id, i);
+        recorder.push_cycle(i * 1000);
+    }
+
+    recorder.stop_record(true);
+
+    edm::util::RecordFileReader reader;
+    if (!reader.open("test_channels.bin")) {
+        s_root_logger->error("open channel file failed");
+        return;
+    }
+
+    std::vector<char> payload;
+    uint32_t record_count = 0;
+    uint64_t total = 0;
+    while (reader.read_block(payload, record_count)) {
+        total += record_count;
+    }
+
+    s_root_logger->info("channel file: {}, record size: {}, records: {} "
+                        "(expect 100000)",
+                        reader.schema().column_header(),
+                        reader.header().record_size, total);
+}
+
+// 运动线程持续 push_cycle 时反复 stop/start (选择不同, 记录长度不同)
+static void test_record_channels_restart() {
+    auto registry = std::make_shared<edm::util::RecordChannelRegistry>();
+    auto axis_id = registry->register_array_channel<double, 6>("axis");
+
+    edm::util::RecordChannelRecorder recorder;
+
+    std::atomic_bool exit_flag{false};
+    std::thread pusher([&]() {
+        std::array<double, 6> axis;
+        for (uint64_t i = 0; !exit_flag; ++i) {
+            axis.fill(i);
+            registry->publish_array(axis_id, axis);
+            recorder.push_cycle(i);
+        }
+    });
+
+    int started = 0;
+    for (int i = 0; i < 50; ++i) {
+        edm::util::RecordChannelSelection selection;
+        for (int j = 0; j <= i % 6; ++j) {
+            selection.items.push_back({"axis" + std::to_string(j), 1});
+        }
+
+        started += recorder.start_record("test_channels_restart.bin",
+                                         registry, selection);
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        recorder.stop_record(true);
+    }
+
+    exit_flag = true;
+    pusher.join();
+
+    s_root_logger->info("channel record restart: started {} (expect 50)",
+                        started);
+}
+
+// 用 RLIMIT_FSIZE 模拟磁盘满: 写超过上限时 write 返回 EFBIG,
+// 记录应自行停止并报告失败
+static void test_write_failure() {
+    struct rlimit old_limit;
+    getrlimit(RLIMIT_FSIZE, &old_limit);
+    std::signal(SIGXFSZ, SIG_IGN);
+
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = 256 * 1024;
+    setrlimit(RLIMIT_FSIZE, &limit);
+
+    edm::util::DataQueueRecorder<TestData> recorder;
+    if (!recorder.start_record("test_record_file_full.bin", make_schema())) {
+        s_root_logger->error("start record failed");
+    } else {
+        for (int i = 0; i < 100000; ++i) {
+            TestData d;
+            d.tick = i;
+            recorder.push_data(d);
+        }
+
+        // 写失败后记录线程应已自行退出
+        for (int i = 0; i < 100 && recorder.is_running(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        s_root_logger->info("write failure: running: {}, failed: {} "
+                            "(expect false, true)",
+                            recorder.is_running(), recorder.is_write_failed());
+        recorder.stop_record(true);
+    }
+
+    setrlimit(RLIMIT_FSIZE, &old_limit);
+    std::signal(SIGXFSZ, SIG_DFL);
+}
+
+// 文件头中的 header_size 损坏 (远大于文件): 打开失败, 不按它分配内存
+static void test_corrupt_header(const char *filename) {
+    std::vector<char> data;
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(ifs), {});
+    }
+
+    edm::util::RecordFileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    header.header_size = 0xFFFFFFF0;
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    const char *corrupt_filename = "test_record_file_corrupt.bin";
+    {
+        std::ofstream ofs(corrupt_filename, std::ios::binary);
+        ofs.write(data.data(), data.size());
+    }
+
+    edm::util::RecordFileReader reader;
+    s_root_logger->info("corrupt header_size: open: {} (expect false)",
+                        reader.open(corrupt_filename));
+}
+
+int main(int argc, char **argv) {
+    test("test_record_file.bin", 100000);
+    test_decode("test_record_file.bin", "test_record_file.txt");
+    test_corrupt_header("test_record_file.bin");
+
+    // 压缩文件, 解码结果应与未压缩文件一致
+    test("test_record_file_lz.bin", 100000, edm::util::RecordCodec::DeltaLz);
+    test_decode("test_record_file_lz.bin", "test_record_file_lz.txt");
+    test_event_capture();
+    test_event_capture_restart();
+    test_record_channels();
+    test_record_channels_restart();
+    test_write_failure();
+    return 0;
+}
@@ -361,7 +361,10 @@ static void test_ecat(void) {
 
     auto start_time =
         std::chrono::high_resolution_clock::now().time_since_epoch();
-    data_recorder->start_record("output.bin");
+    edm::util::RecordSchema schema{"ecat", sizeof(Data)};
+    EDM_RECORD_SCHEMA_ADD(schema, Data, act_pos, "act_pos");
+    EDM_RECORD_SCHEMA_ADD(schema, Data, cmd_pos, "cmd_pos");
+    data_recorder->start_record("output.bin", schema);
     std::this_thread::sleep_for(100ms);
 
     record_waiting_thread = std::thread([=]() {
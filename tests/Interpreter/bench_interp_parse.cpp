@@ -0,0 +1,70 @@
+#include "Interpreter/rs274pyInterpreter/RS274InterpreterWrapper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+// 解释器解析耗时基准
+// Usage: bench_interp_parse [file.py] [repeat]
+// 默认解析 gcode/01-天方地圆 - 后处理.py (约2.2万行)
+
+using edm::interpreter::RS274InterpreterWrapper;
+
+template <typename Fn>
+static void bench(const char *name, int repeat, Fn &&fn) {
+    std::vector<double> ms_list;
+    std::size_t count = 0;
+
+    for (int i = 0; i < repeat; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        count = fn();
+        auto t1 = std::chrono::steady_clock::now();
+        ms_list.push_back(
+            std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+
+    double min_ms = ms_list[0], sum_ms = 0;
+    for (auto ms : ms_list) {
+        min_ms = std::min(min_ms, ms);
+        sum_ms += ms;
+    }
+
+    fmt::print("{:<24} min {:>9.1f} ms, avg {:>9.1f} ms, {} items\n", name,
+               min_ms, sum_ms / repeat, count);
+}
+
+int main(int argc, char **argv) {
+    std::string filename =
+        argc > 1 ? argv[1] : EDM_ROOT_DIR "gcode/01-天方地圆 - 后处理.py";
+    int repeat = argc > 2 ? std::max(1, std::stoi(argv[2])) : 3;
+
+    RS274InterpreterWrapper::instance()->set_rs274_py_module_dir(
+        EDM_ROOT_DIR "Src/Interpreter/rs274pyInterpreter/pymodule/");
+
+    fmt::print("file: {}, repeat: {}\n", filename, repeat);
+
+    try {
+        bench("parse_file (json str)", repeat, [&]() {
+            return RS274InterpreterWrapper::parse_file(filename).size();
+        });
+
+        bench("parse_file_to_json", repeat, [&]() {
+            return RS274InterpreterWrapper::parse_file_to_json(filename)
+                .as_array()
+                .size();
+        });
+
+        bench("parse_file_to_records", repeat, [&]() {
+            return RS274InterpreterWrapper::parse_file_to_records(filename)
+                .commands.size();
+        });
+    } catch (const std::exception &e) {
+        fmt::print("error: {}\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
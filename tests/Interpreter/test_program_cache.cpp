@@ -0,0 +1,178 @@
+#include "Interpreter/rs274pyInterpreter/RS274ProgramCache.h"
+#include "Logger/LogMacro.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+namespace fs = std::filesystem;
+using namespace edm::interpreter;
+
+static const char *s_cache_dir = "test_program_cache";
+
+static void write_file(const fs::path &filename, const std::string &content) {
+    std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+    ofs << content;
+}
+
+static RS274CommandRecords make_records(int n) {
+    RS274CommandRecords records;
+
+    RS274CommandRecords chunk;
+    chunk.string_pool = "G01 X1 Y2";
+    for (int i = 0; i < n; ++i) {
+        RS274CommandRecord r{};
+        r.type = i % 7;
+        r.line_number = i + 1;
+        r.coords[0] = i * 0.5;
+        r.coords[2] = -i * 0.25;
+        r.axis_mask = 0b101;
+        r.str_size = static_cast<uint32_t>(chunk.string_pool.size());
+        r.point_first = 0;
+        r.point_count = 2;
+        chunk.commands.push_back(r);
+    }
+    for (int i = 0; i < 2; ++i) {
+        RS274PointRecord p{};
+        p.coords[1] = i;
+        p.line_number = i + 1;
+        p.str_size = 3;
+        chunk.points.push_back(p);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        records.append(chunk);
+    }
+    return records;
+}
+
+static bool same_records(const RS274CommandRecords &a,
+                         const RS274CommandRecords &b) {
+    return a.commands.size() == b.commands.size() &&
+           a.points.size() == b.points.size() &&
+           a.string_pool == b.string_pool &&
+           std::memcmp(a.commands.data(), b.commands.data(),
+                       a.commands.size() * sizeof(RS274CommandRecord)) == 0 &&
+           std::memcmp(a.points.data(), b.points.data(),
+                       a.points.size() * sizeof(RS274PointRecord)) == 0;
+}
+
+// 写入后读回一致
+static void test_round_trip(RS274ProgramCache &cache, const std::string &key) {
+    const auto records = make_records(1000);
+    const bool stored = cache.store(key, records);
+    const auto loaded = cache.load(key);
+
+    s_root_logger->info("round trip: stored: {}, hit: {}, same: {} "
+                        "(expect true, true, true)",
+                        stored, loaded.has_value(),
+                        loaded && same_records(records, *loaded));
+
+    RS274CommandRecords empty;
+    cache.store(key + "-empty", empty);
+    const auto loaded_empty = cache.load(key + "-empty");
+    s_root_logger->info("round trip empty: hit: {}, commands: {} "
+                        "(expect true, 0)",
+                        loaded_empty.has_value(),
+                        loaded_empty ? loaded_empty->commands.size() : 1);
+}
+
+// 截断或损坏的缓存文件视为未命中
+static void test_corrupt(RS274ProgramCache &cache, const std::string &key) {
+    const auto file =
+        fs::path{s_cache_dir} / (key + ".rs274c"); // 与 CacheFileExt 一致
+
+    cache.store(key, make_records(100));
+    const auto full_size = fs::file_size(file);
+
+    fs::resize_file(file, full_size - 10);
+    s_root_logger->info("truncated: hit: {} (expect false)",
+                        cache.load(key).has_value());
+
+    fs::resize_file(file, 20); // 头部也不完整
+    s_root_logger->info("truncated header: hit: {} (expect false)",
+                        cache.load(key).has_value());
+
+    // 数据区翻转一个字节
+    cache.store(key, make_records(100));
+    {
+        std::fstream fs(file, std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekg(full_size / 2);
+        char c = 0;
+        fs.read(&c, 1);
+        c = static_cast<char>(~c);
+        fs.seekp(full_size / 2);
+        fs.write(&c, 1);
+    }
+    s_root_logger->info("corrupt payload: hit: {} (expect false)",
+                        cache.load(key).has_value());
+
+    // 头部的数量被改成很大的值, 相乘溢出后总长度恰好与文件大小一致
+    cache.store(key, make_records(100));
+    {
+        std::fstream fs(file, std::ios::binary | std::ios::in | std::ios::out);
+        const uint64_t huge = 300 + (1ull << 61); // *120 溢出后等于 300*120
+        fs.seekp(16); // _CacheHeader::command_count
+        fs.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+    }
+    s_root_logger->info("huge count: hit: {} (expect false)",
+                        cache.load(key).has_value());
+
+    s_root_logger->info("missing: hit: {} (expect false)",
+                        cache.load(key + "-missing").has_value());
+}
+
+// 程序或 rs274.py 改动得到新的key
+static void test_key() {
+    const auto module_dir = fs::path{s_cache_dir} / "module";
+    fs::create_directories(module_dir);
+
+    const auto program = fs::path{s_cache_dir} / "program.py";
+    write_file(program, "G01(x=1)\n");
+    write_file(module_dir / "rs274.py", "# v1\n");
+
+    RS274ProgramCache cache{s_cache_dir};
+    auto f_key = [&]() -> std::optional<std::string> {
+        auto hash = RS274ProgramCache::ProgramHash(program.string());
+        if (!hash) {
+            return std::nullopt;
+        }
+        return cache.make_key(*hash, module_dir.string());
+    };
+
+    const auto key1 = f_key();
+    const auto key1_again = f_key();
+
+    write_file(module_dir / "rs274.py", "# v2\n");
+    const auto key2 = f_key();
+
+    write_file(program, "G01(x=2)\n");
+    const auto key3 = f_key();
+
+    const auto hash_missing = RS274ProgramCache::ProgramHash(
+        (fs::path{s_cache_dir} / "none.py").string());
+    const auto key_no_module =
+        cache.make_key("0", (fs::path{s_cache_dir} / "none").string());
+
+    s_root_logger->info("key: stable: {}, module changed: {}, program "
+                        "changed: {}, missing file: {}, missing module: {} "
+                        "(expect true, true, true, true, true)",
+                        key1 && key1 == key1_again, key2 && key2 != key1,
+                        key3 && key3 != key2, !hash_missing.has_value(),
+                        !key_no_module.has_value());
+}
+
+int main(int argc, char **argv) {
+    std::error_code ec;
+    fs::remove_all(s_cache_dir, ec);
+
+    RS274ProgramCache cache{s_cache_dir};
+    test_round_trip(cache, "round-trip");
+    test_corrupt(cache, "corrupt");
+    test_key();
+
+    fs::remove_all(s_cache_dir, ec);
+    return 0;
+}
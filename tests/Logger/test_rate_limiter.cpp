@@ -0,0 +1,89 @@
+#include "Logger/LogRateLimiter.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using edm::log::LogRateLimiter;
+using edm::log::RateLimitDefine;
+
+static RateLimitDefine make_define(double rate, std::size_t burst,
+                                   std::size_t dedup_ms) {
+    RateLimitDefine define;
+    define.enable = true;
+    define.rate = rate;
+    define.burst = burst;
+    define.dedup_ms = dedup_ms;
+    return define;
+}
+
+// 相同消息在窗口内合并, 下一条不同的消息放行时带上重复次数
+static void test_dedup() {
+    LogRateLimiter limiter(make_define(1000.0, 1000, 1000));
+    uint64_t repeated = 0, suppressed = 0;
+
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        allowed += limiter.try_acquire(1, repeated, suppressed);
+    }
+    std::cout << "dedup: allowed " << allowed << " (expect 1)" << std::endl;
+
+    const bool ok = limiter.try_acquire(2, repeated, suppressed);
+    std::cout << "dedup: new message allowed " << ok << ", repeated "
+              << repeated << " (expect 1, 99)" << std::endl;
+}
+
+// 相同消息持续出现: 超过窗口后再放行一次并带上汇总
+static void test_dedup_window() {
+    LogRateLimiter limiter(make_define(1000.0, 1000, 20));
+    uint64_t repeated = 0, suppressed = 0;
+
+    limiter.try_acquire(1, repeated, suppressed);
+    for (int i = 0; i < 10; ++i) {
+        limiter.try_acquire(1, repeated, suppressed);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    const bool ok = limiter.try_acquire(1, repeated, suppressed);
+    std::cout << "dedup window: allowed " << ok << ", repeated " << repeated
+              << " (expect 1, 10)" << std::endl;
+}
+
+// 不同的消息按令牌桶限流, 放行时带上被抑制的条数
+static void test_rate_limit() {
+    LogRateLimiter limiter(make_define(1.0, 5, 1000));
+    uint64_t repeated = 0, suppressed = 0;
+
+    int allowed = 0;
+    for (std::size_t i = 0; i < 100; ++i) {
+        allowed += limiter.try_acquire(i, repeated, suppressed);
+    }
+    std::cout << "rate limit: allowed " << allowed << " (expect 5)"
+              << std::endl;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    const bool ok = limiter.try_acquire(1000, repeated, suppressed);
+    std::cout << "rate limit: allowed " << ok << ", suppressed " << suppressed
+              << " (expect 1, 95)" << std::endl;
+}
+
+// 未启用时全部放行
+static void test_disabled() {
+    LogRateLimiter limiter(RateLimitDefine{});
+    uint64_t repeated = 0, suppressed = 0;
+
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        allowed += limiter.try_acquire(1, repeated, suppressed);
+    }
+    std::cout << "disabled: allowed " << allowed << ", dedup "
+              << limiter.dedup_enabled() << " (expect 100, 0)" << std::endl;
+}
+
+int main() {
+    test_dedup();
+    test_dedup_window();
+    test_rate_limit();
+    test_disabled();
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "Logger/RtLogger.h"
+
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+enum TestState { Idle, Running };
+
+// 比较运动线程中直接调用 async logger 与 RtLogger 的单次耗时
+static void bench(const char *name, int n, auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        fn(i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0)
+                  .count();
+    std::cout << name << ": " << (double)ns / n << " ns/call" << std::endl;
+}
+
+int main() {
+    spdlog::init_thread_pool(65536, 1);
+
+    auto sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+    auto async_logger = std::make_shared<spdlog::async_logger>(
+        "async", sink, spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+    async_logger->set_level(spdlog::level::trace);
+
+    auto file_sink =
+        std::make_shared<spdlog::sinks::basic_file_sink_mt>("rt_logger.log", true);
+    auto file_logger = std::make_shared<spdlog::async_logger>(
+        "rt", file_sink, spdlog::thread_pool(),
+        spdlog::async_overflow_policy::block);
+    file_logger->set_level(spdlog::level::trace);
+
+    edm::log::RtLogger rt_null(async_logger, 1 << 16);
+    edm::log::RtLogger rt_file(file_logger, 1 << 10);
+
+    constexpr int n = 50000;
+
+    bench("spdlog async", n, [&](int i) {
+        async_logger->trace("G01 State: {} -> {}, pos: {:.3f}", "Servoing",
+                            "JumpUping", i * 0.001);
+    });
+    rt_null.flush();
+
+    bench("RtLogger", n, [&](int i) {
+        rt_null.trace("G01 State: {} -> {}, pos: {:.3f}", "Servoing",
+                      "JumpUping", i * 0.001);
+    });
+    rt_null.flush();
+
+    // 内容与顺序检查, 小队列下会有丢弃
+    for (int i = 0; i < 5000; ++i) {
+        rt_file.debug("seq {} state {} ok {}", i, Running, i % 2 == 0);
+    }
+    rt_file.flush();
+
+    std::cout << "dropped: " << rt_file.dropped_count()
+              << " (see rt_logger.log)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "QtDependComponents/PowerController/EleparamDecoder.h"
+#include "reference/EleparamDecoderRef.h"
+
+#include "Logger/LogMacro.h"
+
+#include <random>
+#include <vector>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+using namespace edm::power;
+
+// 随机电参数, 覆盖各字段的边界与特殊电参数号 (901/902)
+static EleParam_dkd_t random_eleparam(std::mt19937 &rng) {
+    auto r = [&](int n) { return static_cast<int>(rng() % n); };
+
+    EleParam_dkd_t e{};
+    e.pulse_on = r(4) == 0 ? 100 + r(10) : r(256);
+    e.pulse_off = r(256);
+    e.ip = r(4) == 0 ? r(20) * 10 + r(10) : r(2600);
+    e.hp = r(256);
+    e.ma = r(256);
+    e.al = r(256);
+    e.ld = r(256);
+    e.oc = r(256);
+    e.pp = r(256);
+    e.pl = r(3);
+    e.lv = r(4);
+    e.c = r(16);
+    e.dn = r(256);
+    e.up = r(256);
+
+    const int u = r(6);
+    e.upper_index = u == 0 ? 901 : u == 1 ? 902 : r(30);
+    return e;
+}
+
+// 表驱动的编码 与 重构前的逐字段编码 对随机输入结果一致, 缓存结果也一致
+static void test_equivalence(int count) {
+    std::mt19937 rng(12345);
+    EleparamDecodeCache cache;
+
+    // 越界输入两边都会逐条打印报错, 对比期间关闭
+    const auto level = s_root_logger->level();
+    s_root_logger->set_level(spdlog::level::off);
+
+    std::vector<std::string> mismatch;
+    for (int i = 0; i < count; ++i) {
+        const auto e = random_eleparam(rng);
+        const uint8_t highpower = rng() % 3;
+        const uint8_t machpower = rng() % 3;
+
+#if (EDM_POWER_TYPE == EDM_POWER_DIMEN)
+        const uint16_t counter = rng();
+        const uint16_t counter2 = rng();
+
+        auto r_ref = ref::EleparamDecoder::decode(
+            std::make_shared<ref::EleparamDecodeInput>(e, highpower, machpower,
+                                                       counter));
+        auto r_new = EleparamDecoder::decode(std::make_shared<EleparamDecodeInput>(
+            e, highpower, machpower, counter));
+        auto r_cache = cache.get(e, highpower, machpower);
+        r_cache->set_pulse_count(counter);
+
+        bool ok = r_ref->can_buffer() == r_new->can_buffer() &&
+                  r_ref->io_1() == r_new->io_1() &&
+                  r_ref->io_2() == r_new->io_2() &&
+                  r_cache->can_buffer() == r_new->can_buffer() &&
+                  r_cache->io_1() == r_new->io_1() &&
+                  r_cache->io_2() == r_new->io_2();
+
+        // 单独刷新心跳后校验和一致
+        r_ref->set_pulse_count(counter2);
+        r_new->set_pulse_count(counter2);
+        ok = ok && r_ref->can_buffer() == r_new->can_buffer();
+#else
+        auto r_ref = ref::EleparamDecoder::decode(
+            std::make_shared<ref::EleparamDecodeInput>(e, highpower, machpower));
+        auto r_new = EleparamDecoder::decode(
+            std::make_shared<EleparamDecodeInput>(e, highpower, machpower));
+        auto r_cache = cache.get(e, highpower, machpower);
+
+        const bool ok = r_ref->io() == r_new->io() && r_cache->io() == r_new->io();
+#endif
+
+        if (!ok) {
+            mismatch.push_back(fmt::format(
+                "#{} upper_index {}, on {}, ip {}, hp {}, c {}, highpower {}, "
+                "machpower {}",
+                i, e.upper_index, e.pulse_on, e.ip, e.hp, e.c, highpower,
+                machpower));
+        }
+    }
+
+    s_root_logger->set_level(level);
+
+    for (std::size_t i = 0; i < mismatch.size() && i < 10; ++i) {
+        s_root_logger->error("mismatch: {}", mismatch[i]);
+    }
+    s_root_logger->info("power type {}: {} inputs, mismatch: {} (expect 0)",
+                        EDM_POWER_TYPE, count, mismatch.size());
+}
+
+int main(int argc, char **argv) {
+    test_equivalence(200000);
+    return 0;
+}
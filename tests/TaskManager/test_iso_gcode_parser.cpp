@@ -0,0 +1,158 @@
+#include "TaskManager/GCodeTask.h"
+#include "TaskManager/IsoGCodeParser.h"
+
+#include "Logger/LogMacro.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+using namespace edm::task;
+
+// 逐行解析, 返回生成的任务
+static std::vector<GCodeTaskBase::ptr>
+parse(IsoGCodeParser &parser, const std::vector<std::string> &lines) {
+    std::vector<GCodeTaskBase::ptr> tasks;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        parser.parse_line(lines[i], static_cast<int>(i + 1),
+                          [&tasks](GCodeTaskBase::ptr task) {
+                              tasks.push_back(std::move(task));
+                          });
+    }
+    return tasks;
+}
+
+// 解析一行, 返回异常信息 (未抛出异常时为空)
+static std::string parse_error(IsoGCodeParser &parser, std::string_view line,
+                               int line_number) {
+    try {
+        parser.parse_line(line, line_number, [](GCodeTaskBase::ptr) {});
+    } catch (const IsoGCodeParseException &e) {
+        return e.what();
+    }
+    return {};
+}
+
+static std::string types_str(const std::vector<GCodeTaskBase::ptr> &tasks) {
+    std::string s;
+    for (const auto &t : tasks) {
+        s += std::to_string(static_cast<int>(t->type())) + " ";
+    }
+    return s;
+}
+
+// G90/G91 与 G5x 为模态, 后续段沿用; G00/G01 也为模态
+static void test_modal() {
+    IsoGCodeParser parser;
+    auto tasks = parse(parser, {
+                                   "G90 G54 G00 F500 X1.0",
+                                   "Y2",
+                                   "G91 G01 Z-0.5",
+                                   "X0.1",
+                                   "G55 G90 X3",
+                               });
+
+    // F, G90, G54, G00 | G00 | G91, G01 | G01 | G90, G55, G01
+    s_root_logger->info("modal types: {} (expect 5 2 3 0 0 2 1 1 2 3 1 )",
+                        types_str(tasks));
+    if (tasks.size() != 11) {
+        return;
+    }
+
+    auto g00 = std::static_pointer_cast<GCodeTaskG00Motion>(tasks[4]);
+    s_root_logger->info("line 2: G00 abs: {}, G54: {}, feed: {}, y: {} "
+                        "(expect true, true, 500, 2)",
+                        g00->coord_mode() == GCodeCoordinateMode::AbsoluteMode,
+                        g00->coord_index() == 54, g00->feed_speed(),
+                        g00->cmd_values()[1].value_or(-1));
+
+    auto g01 = std::static_pointer_cast<GCodeTaskG01Motion>(tasks[7]);
+    s_root_logger->info(
+        "line 4: G01 inc: {}, G54: {}, x: {}, z set: {} "
+        "(expect true, true, 0.1, false)",
+        g01->coord_mode() == GCodeCoordinateMode::IncrementMode,
+        g01->coord_index() == 54, g01->cmd_values()[0].value_or(-1),
+        g01->cmd_values()[2].has_value());
+
+    g01 = std::static_pointer_cast<GCodeTaskG01Motion>(tasks[10]);
+    s_root_logger->info(
+        "line 5: G01 abs: {}, G55: {} (expect true, true)",
+        g01->coord_mode() == GCodeCoordinateMode::AbsoluteMode,
+        g01->coord_index() == 55);
+}
+
+// G04: X/T 为秒, P 为毫秒
+static void test_dwell() {
+    IsoGCodeParser parser;
+    auto tasks = parse(parser, {"G04 X1.5", "G04 T0.25", "G04 P1500"});
+
+    std::string delays;
+    for (const auto &t : tasks) {
+        if (t->type() == GCodeTaskType::DelayCommand) {
+            delays += std::to_string(
+                          std::static_pointer_cast<GCodeTaskDeley>(t)->delay_s())
+                          .substr(0, 5) +
+                      " ";
+        }
+    }
+    s_root_logger->info("dwell: {} (expect 1.500 0.250 1.500 )", delays);
+}
+
+// 同一段中的 E F 在运动之前生成, 与字的书写顺序无关
+static void test_same_line_order() {
+    IsoGCodeParser parser;
+    auto tasks = parse(parser, {"G90 G54", "X1 G01 F300 E101"});
+
+    // G90, G54 | E, F, G01
+    s_root_logger->info("same line: {} (expect 2 3 4 5 1 )", types_str(tasks));
+    if (tasks.size() == 5) {
+        auto e = std::static_pointer_cast<GCodeTaskEleparamSet>(tasks[2]);
+        s_root_logger->info("eleparam: {}, line: {} (expect 101, 2)",
+                            e->eleparam_index(), e->line_number());
+    }
+}
+
+// M02 结束程序, 之后的内容 (包括错误) 忽略
+static void test_program_end() {
+    IsoGCodeParser parser;
+    auto tasks = parse(parser, {"G90 G54 G01 F100", "X1 M02", "X2", "Q1"});
+
+    s_root_logger->info("program end: {}, end: {} (expect 5 2 3 1 99 , true)",
+                        types_str(tasks), parser.is_program_end());
+}
+
+static void test_errors() {
+    IsoGCodeParser parser;
+
+    s_root_logger->info("unknown word: '{}' (expect '(line 3): Word 'Q' Not "
+                        "Supported')",
+                        parse_error(parser, "G01 Q1", 3));
+    s_root_logger->info("bad number: '{}' (expect '(line 4): Word 'X' Value "
+                        "Not Valid')",
+                        parse_error(parser, "G01 Xabc", 4));
+    s_root_logger->info("missing number: '{}' (expect '(line 5): Word 'F' "
+                        "Value Not Valid')",
+                        parse_error(parser, "F", 5));
+    s_root_logger->info("unsupported G: '{}' (expect '(line 6): G02 Not "
+                        "Supported')",
+                        parse_error(parser, "G02 X1", 6));
+    s_root_logger->info("repeated word: '{}' (expect '(line 7): Word 'X' "
+                        "Repeated')",
+                        parse_error(parser, "X1 X2", 7));
+
+    // 运动前未设置坐标模式
+    s_root_logger->info("no environment: '{}' (expect '(line 8): "
+                        "CoordinateMode Undefined')",
+                        parse_error(parser, "G01 X1", 8));
+}
+
+int main(int argc, char **argv) {
+    test_modal();
+    test_dwell();
+    test_same_line_order();
+    test_program_end();
+    test_errors();
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "TaskManager/GCodeTask.h"
+#include "TaskManager/GCodeTimeEstimator.h"
+
+#include "Coordinate/CoordinateSystem.h"
+#include "Logger/LogMacro.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <thread>
+
+EDM_STATIC_LOGGER(s_root_logger, EDM_LOGGER_ROOT());
+
+using namespace edm;
+using namespace edm::task;
+
+using values_t = std::vector<std::optional<double>>;
+
+static bool near(double a, double b, double eps = 1e-6) {
+    return std::abs(a - b) <= eps;
+}
+
+// 相对坐标的 G01/G00, 只给 x
+static GCodeTaskBase::ptr g01_x(double x_mm, int line) {
+    return std::make_shared<GCodeTaskG01Motion>(
+        54, GCodeCoordinateMode::IncrementMode,
+        values_t{x_mm, std::nullopt, std::nullopt, std::nullopt,
+                 std::nullopt, std::nullopt},
+        line);
+}
+
+static GCodeTaskBase::ptr g00_x(double x_mm, int line) {
+    return std::make_shared<GCodeTaskG00Motion>(
+        true, false, 1000, 54, GCodeCoordinateMode::IncrementMode,
+        values_t{x_mm, std::nullopt, std::nullopt, std::nullopt,
+                 std::nullopt, std::nullopt},
+        line);
+}
+
+static std::vector<GCodeTaskBase::ptr> make_program() {
+    std::vector<GCodeTaskBase::ptr> list;
+    list.push_back(std::make_shared<GCodeTaskCoordinateIndex>(54, 1));
+    list.push_back(g00_x(10.0, 2));                         // 10mm G00
+    list.push_back(g01_x(1.0, 3));                          // 1mm G01
+    list.push_back(std::make_shared<GCodeTaskDeley>(2.5, 4)); // G04 2.5s
+    list.push_back(g01_x(-0.5, 5));                         // 0.5mm G01
+    list.push_back(std::make_shared<GCodeTaskPauseCommand>(6));
+    list.push_back(std::make_shared<GCodeTaskProgramEnd>(7));
+    return list;
+}
+
+// 汇总: G01 按名义进给速度, G04 为延时, G00 由规划器得出
+static void test_estimate(coord::CoordinateSystem::ptr cs) {
+    GCodeTimeEstimator::Options options;
+    options.g01_feed_mm_min = 0.5;
+
+    auto est = GCodeTimeEstimator::Estimate(make_program(), cs, options);
+
+    // 1.5mm / 0.5mm/min = 3min
+    s_root_logger->info("g01: {:.3f} s, {:.3f} mm (expect 180.000 s, 1.500 mm) "
+                        "ok: {}",
+                        est->g01_s, est->g01_length_mm,
+                        near(est->g01_s, 180.0) &&
+                            near(est->g01_length_mm, 1.5));
+
+    s_root_logger->info("g04: {:.3f} s (expect 2.500) ok: {}", est->g04_s,
+                        near(est->g04_s, 2.5));
+
+    // 10mm at 1000mm/min 至少 0.6s, 加减速只会更长
+    s_root_logger->info("g00: {:.3f} s (expect >= 0.6) ok: {}", est->g00_s,
+                        est->g00_s >= 0.6 - 1e-3);
+
+    s_root_logger->info("total: {:.3f} s ok: {}, unknown: {} (expect 1), "
+                        "error: {} (expect 0), items: {} (expect 4)",
+                        est->total_s,
+                        near(est->total_s,
+                             est->g00_s + est->g01_s + est->g04_s),
+                        est->unknown_count, est->error_count,
+                        est->items.size());
+
+    // 最慢的是 1mm 的 G01 (第3行)
+    auto slowest = est->slowest(1);
+    s_root_logger->info("slowest line: {} (expect 3)",
+                        slowest.empty() ? -1 : slowest[0]->line_number);
+
+    // 名义进给速度加倍, G01 时间减半
+    options.g01_feed_mm_min = 1.0;
+    auto est2 = GCodeTimeEstimator::Estimate(make_program(), cs, options);
+    s_root_logger->info("g01 at double feed: {:.3f} s (expect 90.000) ok: {}",
+                        est2->g01_s, near(est2->g01_s, 90.0));
+}
+
+// 置零: 之后的绝对坐标相对于置零时的位置, 只修改估计用的坐标系副本
+static void test_set_zero(coord::CoordinateSystem::ptr cs) {
+    auto g01_abs_x = [](double x_mm, int line) -> GCodeTaskBase::ptr {
+        return std::make_shared<GCodeTaskG01Motion>(
+            54, GCodeCoordinateMode::AbsoluteMode,
+            values_t{x_mm, std::nullopt, std::nullopt, std::nullopt,
+                     std::nullopt, std::nullopt},
+            line);
+    };
+
+    std::vector<GCodeTaskBase::ptr> list;
+    list.push_back(std::make_shared<GCodeTaskCoordinateIndex>(54, 1));
+    list.push_back(g01_abs_x(2.0, 2)); // 0 -> 2
+    list.push_back(std::make_shared<GCodeTaskCoordSetZeroCommand>(
+        std::vector<bool>{true, false, false, false, false, false}, 3));
+    list.push_back(g01_abs_x(1.0, 4)); // 2 -> 3, 未置零时为 2 -> 1
+
+    GCodeTimeEstimator::Options options;
+    auto est = GCodeTimeEstimator::Estimate(list, cs, options);
+
+    s_root_logger->info("set zero: g01 {:.3f} mm (expect 3.000), error: {} "
+                        "(expect 0) ok: {}",
+                        est->g01_length_mm, est->error_count,
+                        near(est->g01_length_mm, 3.0));
+
+    auto offset = cs->get_cm().get_coord_offset(54);
+    s_root_logger->info("set zero: G54 x offset {} (expect 0)",
+                        offset ? (*offset)[0] : -1.0);
+}
+
+// 对比报告: 只统计执行完的node, 输出实际G01平均进给速度
+static void test_compare(coord::CoordinateSystem::ptr cs) {
+    GCodeTimeEstimator::Options options;
+    auto list = make_program();
+    auto est = GCodeTimeEstimator::Estimate(list, cs, options);
+
+    double measured_feed = -1.0;
+    est->compare(list, 20, &measured_feed);
+    s_root_logger->info("nothing run: measured feed {} (expect 0)",
+                        measured_feed);
+
+    // 第一段G01 (1mm) 用时约 100ms -> 约 600mm/min
+    list[2]->timer().restart();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    list[2]->timer().stop();
+
+    // 第二段G01 正在运行, 不参与统计
+    list[4]->timer().restart();
+
+    auto str_vec = est->compare(list, 20, &measured_feed);
+    for (const auto &s : str_vec) {
+        s_root_logger->info("  {}", s);
+    }
+    s_root_logger->info("measured feed: {:.1f} mm/min (expect ~600) ok: {}",
+                        measured_feed,
+                        measured_feed > 300.0 && measured_feed <= 600.0 + 1e-6);
+}
+
+int main(int argc, char **argv) {
+    // 不存在的坐标系文件: 创建默认的 G54 ~ G59
+    const std::string coord_file = "test_time_estimator_coord.json";
+    std::error_code ec;
+    std::filesystem::remove(coord_file, ec);
+
+    auto cs = std::make_shared<coord::CoordinateSystem>(coord_file);
+
+    test_estimate(cs);
+    test_set_zero(cs);
+    test_compare(cs);
+
+    std::filesystem::remove(coord_file, ec);
+    return 0;
+}